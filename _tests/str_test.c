@@ -3,21 +3,514 @@
 #include "base/base_mem.h"
 #include "base/base_str.h"
 
-#include "os/os.h"
+#include <stdio.h>
+#include <string.h>
 
-i32 main(i32 argc, char* argv[]) {
-    BaseMemory baseMemory = os_getBaseMemory();
+////////////////////////////
+// NOTE(pjako): string conversion, formatting and parsing checks
+
+static bx test_isS16(S16 str, const u16* expected, u64 size) {
+    return str.size == size && memcmp(str.content, expected, size * sizeof(u16)) == 0 && str.content[size] == 0;
+}
+
+static bx test_isS32(S32 str, const u32* expected, u64 size) {
+    return str.size == size && memcmp(str.content, expected, size * sizeof(u32)) == 0 && str.content[size] == 0;
+}
+
+static void test_utf(Arena* arena) {
+    // every byte that does not start a valid sequence becomes one '#'
+    const u16 invalid16[] = {'a', '#', 'b'};
+    ASSERT(test_isS16(str_toS16(arena, s8("a\xFF" "b")), invalid16, countOf(invalid16)));
+    const u32 invalid32[] = {'a', '#', 'b'};
+    ASSERT(test_isS32(str_toS32(arena, s8("a\xFF" "b")), invalid32, countOf(invalid32)));
+
+    // truncated sequence at the end
+    const u16 truncated16[] = {'a', 'b', '#', '#'};
+    ASSERT(test_isS16(str_toS16(arena, s8("ab\xE2\x82")), truncated16, countOf(truncated16)));
+    const u32 truncated32[] = {'a', 'b', '#', '#'};
+    ASSERT(test_isS32(str_toS32(arena, s8("ab\xE2\x82")), truncated32, countOf(truncated32)));
+
+    // encoded surrogates are not valid utf8
+    const u16 surrogate16[] = {'#', '#', '#', 'x'};
+    ASSERT(test_isS16(str_toS16(arena, s8("\xED\xA0\x80x")), surrogate16, countOf(surrogate16)));
 
-    Arena* arena = mem_makeArena(&baseMemory, MEGABYTE(1));
+    // code points above the bmp become a surrogate pair in utf16 and stay one unit in utf32
+    const u16 pair16[] = {'a', 0xD83D, 0xDE00, 0x20AC};
+    ASSERT(test_isS16(str_toS16(arena, s8("a\xF0\x9F\x98\x80\xE2\x82\xAC")), pair16, countOf(pair16)));
+    const u32 pair32[] = {'a', 0x1F600, 0x20AC};
+    ASSERT(test_isS32(str_toS32(arena, s8("a\xF0\x9F\x98\x80\xE2\x82\xAC")), pair32, countOf(pair32)));
 
+    // long ascii runs go through the vector paths before hitting the error
+    S8 longText = s8("0123456789abcdef0123456789abcdef0123456789abcdef\xC3\x28" "0123456789abcdef");
+    S16 long16 = str_toS16(arena, longText);
+    ASSERT(long16.size == longText.size && long16.content[48] == '#' && long16.content[49] == '(');
+    S32 long32 = str_toS32(arena, longText);
+    ASSERT(long32.size == longText.size && long32.content[48] == '#' && long32.content[49] == '(');
 
+    // utf16 back to utf8, unpaired surrogates become '#'
+    u16 pair[] = {'a', 0xD83D, 0xDE00, 'b'};
+    S16 pairStr = {pair, countOf(pair)};
+    ASSERT(str_isEqual(str_fromS16(arena, pairStr), s8("a\xF0\x9F\x98\x80" "b")));
+    u16 lonely[] = {'a', 0xD800, 'b', 0xDC00, 0x20AC, 0xDBFF};
+    S16 lonelyStr = {lonely, countOf(lonely)};
+    S8 lonely8 = str_fromS16(arena, lonelyStr);
+    ASSERT(str_isEqual(lonely8, s8("a#b#\xE2\x82\xAC#")) && lonely8.content[lonely8.size] == '\0');
+    printf("str utf conversion ok\n");
+}
+
+static str_KeyValue test_kvU32(u32 value) {
+    str_KeyValue kv;
+    mem_structSetZero(&kv);
+    kv.value.type = str_argType_u32;
+    kv.value.u32Val = value;
+    return kv;
+}
+
+static void test_fmt(Arena* arena) {
+    // more ops than str_fmt keeps on the stack
+    S8 longTemplate = str_lit("{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-"
+                              "{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-");
+    S8 longExpected = str_lit("7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-7-");
+    u64 pos = arena->pos;
+    ASSERT(str_isEqual(str_fmt(arena, longTemplate, 7), longExpected));
+    ASSERT(arena->pos - pos < longExpected.size + 16 && "scratch left in the arena");
+
+    // more arguments than str_fmt keeps on the stack
+    S8 manyTemplate = str_lit("{} {} {} {} {} {} {} {} {} {} {} {} {} {} {} {} {} {} {} {19}");
+    S8 manyExpected = str_lit("0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15 16 17 18 19");
+    S8 many = str_fmtRaw(arena, manyTemplate, 20, test_kvU32(0), test_kvU32(1), test_kvU32(2), test_kvU32(3), test_kvU32(4),
+        test_kvU32(5), test_kvU32(6), test_kvU32(7), test_kvU32(8), test_kvU32(9), test_kvU32(10), test_kvU32(11), test_kvU32(12),
+        test_kvU32(13), test_kvU32(14), test_kvU32(15), test_kvU32(16), test_kvU32(17), test_kvU32(18), test_kvU32(19));
+    ASSERT(str_isEqual(many, manyExpected));
+
+    // both spill while the caller records into the same arena, the recording only contains the output
+    S8 recorded;
+    str_record(recorded, arena) {
+        str_join(arena, s8("<"));
+        str_fmt(arena, longTemplate, 7);
+        str_fmtRaw(arena, manyTemplate, 20, test_kvU32(0), test_kvU32(1), test_kvU32(2), test_kvU32(3), test_kvU32(4),
+            test_kvU32(5), test_kvU32(6), test_kvU32(7), test_kvU32(8), test_kvU32(9), test_kvU32(10), test_kvU32(11), test_kvU32(12),
+            test_kvU32(13), test_kvU32(14), test_kvU32(15), test_kvU32(16), test_kvU32(17), test_kvU32(18), test_kvU32(19));
+        str_join(arena, s8(">"));
+    }
+    S8 recordedExpected = str_join(arena, s8("<"), longExpected, manyExpected, s8(">"));
+    ASSERT(str_isEqual(recorded, recordedExpected));
+
+    // keys are looked up per call, the program is never written to
+    str_FmtProgram program = str_fmtCompile(arena, s8("{b} {a} {b}"));
+    ASSERT(str_isEqual(str_fmtProgram(arena, &program, str_kv(s8("a"), 1), str_kv(s8("b"), 2)), s8("2 1 2")));
+    ASSERT(str_isEqual(str_fmtProgram(arena, &program, str_kv(s8("b"), 3), str_kv(s8("a"), 4)), s8("3 4 3")));
+    // the first of two arguments with the same key wins, unkeyed arguments are not in the table
+    ASSERT(str_isEqual(str_fmtProgram(arena, &program, 9, str_kv(s8("a"), 5), str_kv(s8("b"), 6), str_kv(s8("a"), 7)), s8("6 5 6")));
+
+    // more keyed arguments than the local key table holds, looked up while the caller records
+    static const char* keyNames[] = {
+        "k0", "k1", "k2", "k3", "k4", "k5", "k6", "k7", "k8", "k9", "k10", "k11", "k12", "k13", "k14", "k15", "k16", "k17", "k18", "k19",
+        "k20", "k21", "k22", "k23", "k24", "k25", "k26", "k27", "k28", "k29", "k30", "k31", "k32", "k33", "k34", "k35", "k36", "k37", "k38", "k39",
+    };
+    str_KeyValue keyed[countOf(keyNames)];
+    for (u32 idx = 0; idx < countOf(keyNames); idx++) {
+        keyed[idx] = test_kvU32(idx * 10);
+        keyed[idx].key = str_fromNullTerminatedCharPtr((char*) keyNames[idx]);
+    }
+    str_FmtProgram keyedProgram = str_fmtCompile(arena, s8("{k39} {k0} {k17} {k39} {k21}"));
+    ASSERT(keyedProgram.keyCount == 5);
+    S8 keyedRecorded;
+    str_record(keyedRecorded, arena) {
+        str_join(arena, s8("<"));
+        str_fmtProgramArgs(arena, &keyedProgram, countOf(keyed), keyed);
+        str_join(arena, s8(">"));
+    }
+    ASSERT(str_isEqual(keyedRecorded, s8("<390 0 170 390 210>")));
+    printf("str fmt ok\n");
+}
+
+static void test_builder(Arena* arena) {
+    BaseMemory baseMem = mem_getMallocBaseMem();
+    Arena* otherArena = mem_makeArena(&baseMem, MEGABYTE(1));
+    u8 reference[4096];
+    u64 referenceSize = 0;
+
+    // small blocks so appends roll over into new blocks, other pushes in between stop the tail from growing in place
+    str_Builder builder = str_builderInit(arena, 64);
+    for (u32 i = 0; i < 40; i++) {
+        S8 piece = str_fmt(otherArena, s8("line {} of the builder test\n"), i);
+        mem_copy(reference + referenceSize, piece.content, piece.size);
+        referenceSize += piece.size;
+        switch (i % 3) {
+            case 0: str_builderAppend(&builder, piece); break;
+            case 1: str_builderFmt(&builder, s8("line {} of the builder test\n"), i); break;
+            case 2: str_builderJoin(&builder, s8("line "), i, s8(" of the builder test\n")); break;
+        }
+        if (i % 7 == 0) {
+            mem_arenaPush(arena, 24);
+        }
+    }
+    // long templates and many arguments must not leave scratch inside the blocks
+    S8 longTemplate = str_lit("{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-"
+                              "{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-{0}-");
+    str_builderFmt(&builder, longTemplate, 7);
+    for (u32 i = 0; i < 40; i++) {
+        reference[referenceSize++] = '7';
+        reference[referenceSize++] = '-';
+    }
+    ASSERT(builder.totalStringSize == referenceSize);
+    ASSERT(builder.blockCount > 1);
+
+    S8 finished = str_builderFinish(&builder, otherArena);
+    ASSERT(finished.size == referenceSize && memcmp(finished.content, reference, referenceSize) == 0);
+    ASSERT((u8*) finished.content > (u8*) otherArena && (u8*) finished.content < (u8*) otherArena + otherArena->pos);
+    S8 finishedSame = str_builderFinish(&builder, arena);
+    ASSERT(str_isEqual(finished, finishedSame));
+
+    u32 spanCount = 0;
+    S8* spans = str_builderSpans(&builder, otherArena, &spanCount);
+    ASSERT(spanCount > 1 && spanCount <= builder.blockCount);
+    u64 offset = 0;
+    for (u32 idx = 0; idx < spanCount; idx++) {
+        ASSERT(spans[idx].size > 0 && offset + spans[idx].size <= referenceSize);
+        ASSERT(memcmp(spans[idx].content, reference + offset, spans[idx].size) == 0);
+        offset += spans[idx].size;
+    }
+    ASSERT(offset == referenceSize);
+
+    // a single block is returned in place when finishing into the builder arena
+    str_Builder single = str_builderInit(arena, 256);
+    str_builderAppend(&single, s8("abc"));
+    str_builderJoin(&single, s8("def"), 42);
+    S8 singleStr = str_builderFinish(&single, arena);
+    ASSERT(single.blockCount == 1 && singleStr.content == single.firstBlock->str.content && str_isEqual(singleStr, s8("abcdef42")));
+    u32 emptyCount = 1;
+    str_Builder empty = str_builderInit(arena, 0);
+    str_builderSpans(&empty, arena, &emptyCount);
+    ASSERT(emptyCount == 0 && str_builderFinish(&empty, arena).size == 0);
+
+    mem_destroyArena(otherArena);
+    printf("str builder ok\n");
+}
+
+static void test_splitter(void) {
+    // tokens: blanks in front of the line break do not hide the end of the line
+    S8 tokenText = s8("a  \nb c\t\r\n  d\t \n\ne");
+    const char* tokens[] = {"a", "b", "c", "d", "e"};
+    u64 tokenLines[] = {1, 2, 2, 3, 5};
+    bx tokenEnds[] = {true, false, true, true, true};
+    u32 tokenCount = 0;
+    str_forEachToken(tokenText, it) {
+        ASSERT(tokenCount < countOf(tokens));
+        ASSERT(str_isEqual(it.piece, str_fromNullTerminatedCharPtr((char*) tokens[tokenCount])));
+        ASSERT(it.line == tokenLines[tokenCount] && it.endOfLine == tokenEnds[tokenCount]);
+        tokenCount++;
+    }
+    ASSERT(tokenCount == countOf(tokens));
+
+    // fields: a trailing delimiter ends with an empty field, a trailing line break does not
+    S8 fieldText = s8("x,y\r\n,\nz,");
+    const char* fields[] = {"x", "y", "", "", "z", ""};
+    u64 fieldLines[] = {1, 1, 2, 2, 3, 3};
+    bx fieldEnds[] = {false, true, false, true, false, true};
+    u32 fieldCount = 0;
+    str_forEachField(fieldText, ',', it) {
+        ASSERT(fieldCount < countOf(fields));
+        ASSERT(str_isEqual(it.piece, str_fromNullTerminatedCharPtr((char*) fields[fieldCount])));
+        ASSERT(it.line == fieldLines[fieldCount] && it.endOfLine == fieldEnds[fieldCount]);
+        fieldCount++;
+    }
+    ASSERT(fieldCount == countOf(fields));
+
+    u32 count = 0;
+    str_forEachField(s8("a,b\n"), ',', it) count++;
+    ASSERT(count == 2);
+    count = 0;
+    str_forEachField(s8(","), ',', it) count++;
+    ASSERT(count == 2);
+    count = 0;
+    str_forEachField(s8(""), ',', it) count++;
+    ASSERT(count == 0);
+    printf("str splitter ok\n");
+}
+
+static u32 test_random(u32* state) {
+    u32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+// scalar references the vectorized encoders are checked against
+static u64 test_hexReference(const u8* data, u64 size, u8* out) {
+    static const char digits[] = "0123456789ABCDEF";
+    for (u64 idx = 0; idx < size; idx++) {
+        out[idx * 2] = (u8) digits[data[idx] >> 4];
+        out[idx * 2 + 1] = (u8) digits[data[idx] & 0xF];
+    }
+    return size * 2;
+}
+
+static u64 test_base64Reference(const u8* data, u64 size, u8* out) {
+    static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    u64 written = 0;
+    for (u64 idx = 0; idx < size; idx += 3) {
+        u32 rest = (u32) minVal(size - idx, 3);
+        u32 bits = (u32) data[idx] << 16 | (rest > 1 ? (u32) data[idx + 1] << 8 : 0) | (rest > 2 ? data[idx + 2] : 0);
+        out[written++] = (u8) alphabet[(bits >> 18) & 63];
+        out[written++] = (u8) alphabet[(bits >> 12) & 63];
+        out[written++] = rest > 1 ? (u8) alphabet[(bits >> 6) & 63] : '=';
+        out[written++] = rest > 2 ? (u8) alphabet[bits & 63] : '=';
+    }
+    return written;
+}
+
+static u64 test_jsonReference(const u8* data, u64 size, u8* out) {
+    static const char digits[] = "0123456789ABCDEF";
+    u64 written = 0;
+    for (u64 idx = 0; idx < size; idx++) {
+        u8 c = data[idx];
+        u8 shortForm = c == '"' ? '"' : c == '\\' ? '\\' : c == '\n' ? 'n' : c == '\r' ? 'r' : c == '\t' ? 't' : c == '\b' ? 'b' : c == '\f' ? 'f' : 0;
+        if (shortForm) {
+            out[written++] = '\\';
+            out[written++] = shortForm;
+        } else if (c < 0x20) {
+            mem_copy(out + written, "\\u00", 4);
+            out[written + 4] = (u8) digits[c >> 4];
+            out[written + 5] = (u8) digits[c & 0xF];
+            written += 6;
+        } else {
+            out[written++] = c;
+        }
+    }
+    return written;
+}
+
+// sizes up to twice the widest vector (32 bytes) plus the odd tails around it
+#define TEST_ENCODER_MAX_SIZE 100
+
+static void test_encoders(Arena* arena) {
+    u8 data[TEST_ENCODER_MAX_SIZE];
+    u8 expected[TEST_ENCODER_MAX_SIZE * 6];
+    u8 out[TEST_ENCODER_MAX_SIZE * 6];
+    u32 seed = 0x9E3779B9u;
+    for (u64 size = 0; size <= TEST_ENCODER_MAX_SIZE; size++) {
+        for (u32 round = 0; round < 8; round++) {
+            for (u64 idx = 0; idx < size; idx++) {
+                data[idx] = (u8) test_random(&seed);
+            }
+            S8 input = str_fromCharPtr(data, size);
+            mem_scoped(scratch, arena) {
+                u64 hexSize = test_hexReference(data, size, expected);
+                ASSERT(str_hexEncodeInto(out, input) == hexSize && memcmp(out, expected, hexSize) == 0);
+                S8 hex = str_hexEncode(scratch.arena, input);
+                ASSERT(str_isEqual(hex, str_fromCharPtr(expected, hexSize)));
+                S8 decoded;
+                ASSERT(str_hexDecode(scratch.arena, hex, &decoded) && str_isEqual(decoded, input));
+                // lower case digits decode to the same bytes
+                S8 lower = str_copyLowerAscii(scratch.arena, hex);
+                ASSERT(str_hexDecode(scratch.arena, lower, &decoded) && str_isEqual(decoded, input));
+
+                u64 base64Size = test_base64Reference(data, size, expected);
+                ASSERT(base64Size == STR_BASE64_ENCODED_SIZE(size));
+                ASSERT(str_base64EncodeInto(out, input) == base64Size && memcmp(out, expected, base64Size) == 0);
+                S8 base64 = str_base64Encode(scratch.arena, input);
+                ASSERT(str_isEqual(base64, str_fromCharPtr(expected, base64Size)));
+                ASSERT(str_base64Decode(scratch.arena, base64, &decoded) && str_isEqual(decoded, input));
+
+                // every byte class the escapers treat differently, the clean runs in between vary in length
+                for (u64 idx = 0; idx < size; idx++) {
+                    static const u8 special[] = {'"', '\\', '\n', '\r', '\t', '\b', '\f', 0x01, 0x1B, 0x1F, ' ', '=', 0x7F, 0xC3, 0xFF};
+                    u32 pick = test_random(&seed);
+                    data[idx] = pick % 5 == 0 ? special[(pick >> 8) % countOf(special)] : (u8) ('a' + (pick >> 8) % 26);
+                }
+                u64 jsonSize = test_jsonReference(data, size, expected);
+                ASSERT(str_isEqual(str_escapeJson(scratch.arena, input), str_fromCharPtr(expected, jsonSize)));
+                bx plain = size > 0;
+                for (u64 idx = 0; idx < size; idx++) {
+                    plain = plain && data[idx] != ' ' && data[idx] != '=' && data[idx] != '"' && data[idx] != '\\' && data[idx] >= 0x20;
+                }
+                S8 logfmt = str_escapeLogfmt(scratch.arena, input);
+                if (plain) {
+                    ASSERT(str_isEqual(logfmt, input));
+                } else {
+                    ASSERT(logfmt.size == jsonSize + 2 && logfmt.content[0] == '"' && logfmt.content[logfmt.size - 1] == '"');
+                    ASSERT(memcmp(logfmt.content + 1, expected, jsonSize) == 0);
+                }
+            }
+        }
+    }
+
+    // padding
+    static const char* base64Vectors[][2] = {
+        {"", ""}, {"f", "Zg=="}, {"fo", "Zm8="}, {"foo", "Zm9v"}, {"foob", "Zm9vYg=="}, {"fooba", "Zm9vYmE="}, {"foobar", "Zm9vYmFy"},
+    };
+    for (u32 idx = 0; idx < countOf(base64Vectors); idx++) {
+        S8 plainText = str_fromNullTerminatedCharPtr((char*) base64Vectors[idx][0]);
+        S8 encoded = str_fromNullTerminatedCharPtr((char*) base64Vectors[idx][1]);
+        S8 decoded;
+        ASSERT(str_isEqual(str_base64Encode(arena, plainText), encoded));
+        ASSERT(str_base64Decode(arena, encoded, &decoded) && str_isEqual(decoded, plainText));
+    }
+    ASSERT(str_isEqual(str_escapeLogfmt(arena, s8("")), s8("\"\"")));
+    ASSERT(str_isEqual(str_escapeJson(arena, s8("a\"b\x1B")), s8("a\\\"b\\u001B")));
+
+    // invalid input
+    static const char* invalidBase64[] = {"Zg=", "Zg", "Z===", "Zg==Zg==", "Zm9v!mFy", "Zm=v", "Zm9vYmFy\n", "====",
+                                          "Zm9vYmFyZm9vYmFyZm9vYmFyZm9vYmFyZm9vYmFyZm9v*mFy"};
+    for (u32 idx = 0; idx < countOf(invalidBase64); idx++) {
+        S8 decoded;
+        ASSERT(!str_base64Decode(arena, str_fromNullTerminatedCharPtr((char*) invalidBase64[idx]), &decoded));
+    }
+    static const char* invalidHex[] = {"0", "ABC", "0G", "zz", "00112233445566778899AABBCCDDEEFF00112233445566778899AABBCCDDEEF-", "12 4"};
+    for (u32 idx = 0; idx < countOf(invalidHex); idx++) {
+        S8 decoded;
+        ASSERT(!str_hexDecode(arena, str_fromNullTerminatedCharPtr((char*) invalidHex[idx]), &decoded));
+    }
+
+    // C array literals
+    u8 bytes[] = {0x01, 0xAB, 0x00, 0xFF, 0x10};
+    ASSERT(str_isEqual(str_cArrayLiteral(arena, str_fromCharPtr(bytes, 5), 1, 2, s8("  ")), s8("  0x01, 0xAB,\n  0x00, 0xFF,\n  0x10")));
+    u32 words[] = {0x12345678, 0xDEADBEEF};
+    ASSERT(str_isEqual(str_cArrayLiteral(arena, str_fromCharPtr((u8*) words, sizeof(words)), 4, 8, s8("")), s8("0x12345678, 0xDEADBEEF")));
+    u64 wide = 0x0123456789ABCDEFull;
+    ASSERT(str_isEqual(str_cArrayLiteral(arena, str_fromCharPtr((u8*) &wide, 8), 8, 1, s8("\t")), s8("\t0x0123456789ABCDEF")));
+    ASSERT(str_cArrayLiteral(arena, STR_NULL, 1, 4, s8("")).size == 0);
+    printf("str encoders ok\n");
+}
+
+static u8 test_lowerReference(u8 c) {
+    return c >= 'A' && c <= 'Z' ? (u8) (c + 32) : c;
+}
+
+static u8 test_upperReference(u8 c) {
+    return c >= 'a' && c <= 'z' ? (u8) (c - 32) : c;
+}
+
+static void test_caseAndWhiteSpace(Arena* arena) {
+    u8 data[600];
+    u8 lower[600];
+    u8 upper[600];
+    u32 seed = 0x2545F491u;
+    // tails around every vector width, the last two sizes go through the chunked NoCase hash
+    static const u64 extraSizes[] = {255, 256, 257, 600};
+    for (u64 step = 0; step <= 100 + countOf(extraSizes); step++) {
+        u64 size = step <= 100 ? step : extraSizes[step - 101];
+        for (u64 idx = 0; idx < size; idx++) {
+            // letters, the bytes next to the letter ranges and non-ASCII bytes whose low 7 bits look like letters
+            static const u8 edges[] = {'@', '[', '`', '{', 0xC1, 0xDA, 0xE1, 0xFA, 0x80, 0xFF};
+            u32 pick = test_random(&seed);
+            data[idx] = pick % 3 == 0 ? edges[(pick >> 8) % countOf(edges)] : (u8) ((pick >> 8) % 2 ? 'a' : 'A') + (u8) ((pick >> 16) % 26);
+            lower[idx] = test_lowerReference(data[idx]);
+            upper[idx] = test_upperReference(data[idx]);
+        }
+        S8 input = str_fromCharPtr(data, size);
+        S8 lowerStr = str_fromCharPtr(lower, size);
+        S8 upperStr = str_fromCharPtr(upper, size);
+        mem_scoped(scratch, arena) {
+            ASSERT(str_isEqual(str_copyLowerAscii(scratch.arena, input), lowerStr));
+            ASSERT(str_isEqual(str_copyUpperAscii(scratch.arena, input), upperStr));
+            S8 inPlace = str_copy(scratch.arena, input);
+            ASSERT(str_isEqual(str_toLowerAscii(inPlace), lowerStr) && str_isEqual(inPlace, lowerStr));
+            ASSERT(str_isEqual(str_toUpperAscii(inPlace), upperStr) && str_isEqual(inPlace, upperStr));
+
+            ASSERT(str_isEqualNoCase(input, upperStr) && str_isEqualNoCase(lowerStr, upperStr));
+            ASSERT(str_hasPrefixNoCase(input, str_fromCharPtr(upper, size / 2)));
+            ASSERT(str_hasSuffixNoCase(input, str_fromCharPtr(lower + size / 3, size - size / 3)));
+            ASSERT(str_hash64NoCase(input) == str_hash64(lowerStr) && str_hash64NoCase(upperStr) == str_hash64(lowerStr));
+            ASSERT(str_hash32NoCase(input) == str_hash32(lowerStr));
+            if (size > 0 && size <= 100) {
+                // a difference of 0x20 only folds for letters
+                for (u64 idx = 0; idx < size; idx++) {
+                    S8 other = str_copy(scratch.arena, upperStr);
+                    other.content[idx] ^= test_lowerReference(other.content[idx]) != test_upperReference(other.content[idx]) ? 0x01 : 0x20;
+                    ASSERT(!str_isEqualNoCase(input, other));
+                    ASSERT(!str_hasPrefixNoCase(input, other));
+                    ASSERT(!str_hasSuffixNoCase(input, other));
+                }
+                ASSERT(!str_isEqualNoCase(input, str_fromCharPtr(upper, size - 1)));
+            }
+        }
+    }
+
+    // all whitespace, then one other byte at every position
+    static const u8 spaces[] = {' ', '\t', '\n', '\v', '\f', '\r'};
+    static const u8 notSpaces[] = {0x08, 0x0E, 0x1F, '!', 0x85, 0xA0, 0x00};
+    for (u64 size = 0; size <= 100; size++) {
+        for (u64 idx = 0; idx < size; idx++) {
+            data[idx] = spaces[test_random(&seed) % countOf(spaces)];
+        }
+        S8 blank = str_fromCharPtr(data, size);
+        ASSERT(str_isWhiteSpace(blank));
+        ASSERT(str_firstNonWhiteSpace(blank) == -1);
+        ASSERT(str_skipWhiteSpace(blank).size == 0);
+        for (u64 idx = 0; idx < size; idx++) {
+            u8 saved = data[idx];
+            data[idx] = notSpaces[test_random(&seed) % countOf(notSpaces)];
+            ASSERT(!str_isWhiteSpace(blank));
+            ASSERT(str_firstNonWhiteSpace(blank) == i64_cast(idx));
+            S8 skipped = str_skipWhiteSpace(blank);
+            ASSERT(skipped.content == data + idx && skipped.size == size - idx);
+            data[idx] = saved;
+        }
+    }
+    printf("str case and whitespace ok\n");
+}
+
+static void test_perfectHash(Arena* arena) {
+    mem_scoped(scratch, arena) {
+        S8 keys[] = {s8("float"), s8("float2"), s8("float3"), s8("float4"), s8("int"), s8("uint"), s8("bool"), s8("struct"), s8("return"), s8("")};
+        str_PerfectHash table;
+        ASSERT(str_perfectHashBuild(scratch.arena, keys, countOf(keys), &table));
+        ASSERT(table.count == countOf(keys));
+        for (u32 idx = 0; idx < countOf(keys); idx++) {
+            ASSERT(str_perfectHashFind(&table, keys[idx]) == idx);
+        }
+        S8 misses[] = {s8("floa"), s8("float5"), s8("Float"), s8("INT"), s8("uint "), s8("structs"), s8("x")};
+        for (u32 idx = 0; idx < countOf(misses); idx++) {
+            ASSERT(str_perfectHashFind(&table, misses[idx]) == table.count);
+        }
+
+        // enough keys that most buckets need a seed search
+        u32 count = 1000;
+        S8* many = mem_arenaPushArray(scratch.arena, S8, count);
+        for (u32 idx = 0; idx < count; idx++) {
+            many[idx] = str_fmt(scratch.arena, s8("key_{}"), idx);
+        }
+        ASSERT(str_perfectHashBuild(scratch.arena, many, count, &table));
+        for (u32 idx = 0; idx < count; idx++) {
+            ASSERT(str_perfectHashFind(&table, many[idx]) == idx);
+        }
+        for (u32 idx = count; idx < count * 2; idx++) {
+            S8 miss = str_fmt(scratch.arena, s8("key_{}"), idx);
+            ASSERT(str_perfectHashFind(&table, miss) == table.count);
+        }
+
+        // duplicates are rejected, adjacent or not
+        S8 duplicates[] = {s8("a"), s8("b"), s8("c"), s8("b")};
+        ASSERT(!str_perfectHashBuild(scratch.arena, duplicates, countOf(duplicates), &table));
+        S8 same[] = {s8("same"), s8("same")};
+        ASSERT(!str_perfectHashBuild(scratch.arena, same, countOf(same), &table));
+
+        ASSERT(str_perfectHashBuild(scratch.arena, NULL, 0, &table));
+        ASSERT(str_perfectHashFind(&table, s8("any")) == table.count);
+    }
+    printf("str perfect hash ok\n");
+}
+
+i32 main(i32 argc, char* argv[]) {
+    BaseMemory baseMem = mem_getMallocBaseMem();
+    Arena* arena = mem_makeArena(&baseMem, MEGABYTE(64));
 
     S8 str1 = str_fmt(arena, s8("{} {} {}"), 1, 2, 3);
+    ASSERT(str_isEqual(str1, s8("1 2 3")));
 
-    os_log(str1);
+    test_utf(arena);
+    test_fmt(arena);
+    test_builder(arena);
+    test_splitter();
+    test_encoders(arena);
+    test_caseAndWhiteSpace(arena);
+    test_perfectHash(arena);
 
     mem_destroyArena(arena);
     return 0;
 }
-
-
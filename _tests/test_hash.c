@@ -0,0 +1,281 @@
+#include "base/base.h"
+#include "base/base_types.h"
+#include "base/base_mem.h"
+#include "base/base_str.h"
+#include "base/base_time.h"
+#include "base/base_checksum.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+////////////////////////////
+// NOTE(pjako): SMHasher style quality checks and throughput benchmarks for the str_hash family and checksums
+
+static u64 test__rngState = u64_val(0x9e3779b97f4a7c15);
+
+static u64 test_rand(void) {
+    // splitmix64
+    u64 z = (test__rngState += u64_val(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * u64_val(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * u64_val(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+static void test_fillRandom(u8* data, u64 size) {
+    for (u64 i = 0; i < size; i++) {
+        data[i] = u8_cast(test_rand());
+    }
+}
+
+static i32 test_compareU64(const void* a, const void* b) {
+    u64 va = *(const u64*) a;
+    u64 vb = *(const u64*) b;
+    return va < vb ? -1 : (va > vb ? 1 : 0);
+}
+
+static u64 test_countCollisions(u64* hashes, u64 count) {
+    qsort(hashes, count, sizeof(u64), test_compareU64);
+    u64 collisions = 0;
+    for (u64 i = 1; i < count; i++) {
+        collisions += hashes[i] == hashes[i - 1];
+    }
+    return collisions;
+}
+
+// counts collisions of the full 64 bit hash and of the lower 32 bits, the latter is compared to the birthday bound
+static void test_checkCollisions(const char* name, u64* hashes, u64 count) {
+    u64* low = (u64*) malloc(count * sizeof(u64));
+    for (u64 i = 0; i < count; i++) {
+        low[i] = hashes[i] & 0xFFFFFFFF;
+    }
+    u64 full = test_countCollisions(hashes, count);
+    u64 low32 = test_countCollisions(low, count);
+    f64 expected = (f64_cast(count) * f64_cast(count - 1)) / (2.0 * 4294967296.0);
+    printf("collisions %-24s keys %8llu: 64bit %llu, low 32bit %llu (expected %.1f)\n", name, (unsigned long long) count, (unsigned long long) full, (unsigned long long) low32, expected);
+    ASSERT(full == 0);
+    ASSERT(f64_cast(low32) < expected * 2.0 + 16.0);
+    free(low);
+}
+
+static void test_streamEquivalence(void) {
+    u8 data[512];
+    test_fillRandom(data, sizeof(data));
+    for (u64 size = 0; size <= sizeof(data); size++) {
+        S8 str = str_fromCharPtr(data, size);
+        u64 seed = test_rand();
+        u64 hash = str_hash64Seed(str, seed);
+        str_Hash128 hash128 = str_hash128(str, seed);
+        ASSERT(hash128.low == hash);
+
+        // byte by byte
+        str_HashStream stream = str_hashStreamInit(seed);
+        for (u64 i = 0; i < size; i++) {
+            str_hashStreamAppend(&stream, str_fromCharPtr(data + i, 1));
+        }
+        ASSERT(str_hashStreamFinish64(&stream) == hash);
+
+        // random split points
+        for (u32 round = 0; round < 8; round++) {
+            stream = str_hashStreamInit(seed);
+            u64 offset = 0;
+            while (offset < size) {
+                u64 chunk = test_rand() % (size - offset + 1);
+                str_hashStreamAppend(&stream, str_fromCharPtr(data + offset, chunk));
+                offset += chunk;
+            }
+            str_Hash128 stream128 = str_hashStreamFinish128(&stream);
+            ASSERT(stream128.low == hash128.low);
+            ASSERT(stream128.high == hash128.high);
+        }
+    }
+}
+
+static void test_seeds(void) {
+    S8 str = s8("the quick brown fox jumps over the lazy dog");
+    ASSERT(str_hash64(str) == str_hash64Seed(str, 0));
+    u64 hashes[4096];
+    for (u64 i = 0; i < countOf(hashes); i++) {
+        hashes[i] = str_hash64Seed(str, i);
+    }
+    test_checkCollisions("seeds", hashes, countOf(hashes));
+
+    // zero filled keys of different length must not collide
+    static u8 zeros[4096];
+    for (u64 i = 0; i < countOf(hashes); i++) {
+        hashes[i] = str_hash64(str_fromCharPtr(zeros, i));
+    }
+    test_checkCollisions("zero keys", hashes, countOf(hashes));
+}
+
+// flips every input bit and checks that every output bit changes with a probability close to 50%
+static void test_avalanche(u64 keySize, bx high) {
+    enum { sampleCount = 4000 };
+    u8 key[128];
+    ASSERT(keySize <= sizeof(key));
+    u32* flips = (u32*) calloc(keySize * 8 * 64, sizeof(u32));
+    for (u32 sample = 0; sample < sampleCount; sample++) {
+        test_fillRandom(key, keySize);
+        str_Hash128 base = str_hash128(str_fromCharPtr(key, keySize), 0);
+        u64 baseValue = high ? base.high : base.low;
+        for (u64 bit = 0; bit < keySize * 8; bit++) {
+            key[bit >> 3] ^= u8_cast(1u << (bit & 7));
+            str_Hash128 hash = str_hash128(str_fromCharPtr(key, keySize), 0);
+            u64 diff = baseValue ^ (high ? hash.high : hash.low);
+            key[bit >> 3] ^= u8_cast(1u << (bit & 7));
+            for (u32 outBit = 0; outBit < 64; outBit++) {
+                flips[bit * 64 + outBit] += (diff >> outBit) & 1;
+            }
+        }
+    }
+    f64 worstBias = 0;
+    for (u64 i = 0; i < keySize * 8 * 64; i++) {
+        f64 bias = f64_cast(flips[i]) / sampleCount - 0.5;
+        bias = bias < 0 ? -bias : bias;
+        worstBias = bias > worstBias ? bias : worstBias;
+    }
+    printf("avalanche %s key size %3llu: worst bias %.2f%%\n", high ? "high" : "low ", (unsigned long long) keySize, worstBias * 100.0);
+    ASSERT(worstBias < 0.05);
+    free(flips);
+}
+
+static void test_keysets(void) {
+    enum { keyCount = 1 << 20 };
+    u64* hashes = (u64*) malloc(keyCount * sizeof(u64));
+
+    // sequential integers
+    for (u32 i = 0; i < keyCount; i++) {
+        hashes[i] = str_hash64(str_fromCharPtr((u8*) &i, sizeof(i)));
+    }
+    test_checkCollisions("sequential u32", hashes, keyCount);
+
+    // text keys with a common prefix
+    for (u32 i = 0; i < keyCount; i++) {
+        char text[32];
+        i32 size = snprintf(text, sizeof(text), "identifier_%u", i);
+        hashes[i] = str_hash64(str_fromCharPtr((u8*) text, u64_cast(size)));
+    }
+    test_checkCollisions("text", hashes, keyCount);
+
+    // sparse 64 byte keys with up to two bits set
+    u8 key[64];
+    u64 count = 0;
+    mem_setZero(key, sizeof(key));
+    hashes[count++] = str_hash64(str_fromCharPtr(key, sizeof(key)));
+    for (u32 a = 0; a < sizeof(key) * 8; a++) {
+        key[a >> 3] ^= u8_cast(1u << (a & 7));
+        hashes[count++] = str_hash64(str_fromCharPtr(key, sizeof(key)));
+        for (u32 b = a + 1; b < sizeof(key) * 8; b++) {
+            key[b >> 3] ^= u8_cast(1u << (b & 7));
+            hashes[count++] = str_hash64(str_fromCharPtr(key, sizeof(key)));
+            key[b >> 3] ^= u8_cast(1u << (b & 7));
+        }
+        key[a >> 3] ^= u8_cast(1u << (a & 7));
+    }
+    test_checkCollisions("sparse 2 bits", hashes, count);
+
+    // 128 bit variant, the high word has to be as good as the low word
+    for (u32 i = 0; i < keyCount; i++) {
+        u8 keyData[24];
+        mem_setZero(keyData, sizeof(keyData));
+        mem_copy(keyData + 8, &i, sizeof(i));
+        hashes[i] = str_hash128(str_fromCharPtr(keyData, sizeof(keyData)), 0).high;
+    }
+    test_checkCollisions("128 high word", hashes, keyCount);
+
+    free(hashes);
+}
+
+static u32 test_crc32cBitwise(const u8* data, u64 size) {
+    u32 crc = 0xFFFFFFFF;
+    for (u64 i = 0; i < size; i++) {
+        crc ^= data[i];
+        for (u32 k = 0; k < 8; k++) {
+            crc = crc & 1 ? (crc >> 1) ^ 0x82f63b78 : crc >> 1;
+        }
+    }
+    return ~crc;
+}
+
+static void test_crc32c(void) {
+    ASSERT(chk_crc32c("123456789", 9) == 0xE3069283);
+    ASSERT(chk_crc32c(NULL, 0) == 0);
+    u8 vector[32];
+    mem_setZero(vector, sizeof(vector));
+    ASSERT(chk_crc32c(vector, sizeof(vector)) == 0x8A9136AA);
+    for (u32 i = 0; i < sizeof(vector); i++) {
+        vector[i] = u8_cast(i);
+    }
+    ASSERT(chk_crc32c(vector, sizeof(vector)) == 0x46DD794E);
+
+    // covers unaligned heads and the 3-way stream merging for short and long blocks
+    u64 bufferSize = 100000;
+    u8* buffer = (u8*) malloc(bufferSize);
+    test_fillRandom(buffer, bufferSize);
+    for (u32 round = 0; round < 200; round++) {
+        u64 offset = test_rand() % 64;
+        u64 size = round < 100 ? test_rand() % 2048 : test_rand() % (bufferSize - offset);
+        u32 expected = test_crc32cBitwise(buffer + offset, size);
+        ASSERT(chk_crc32c(buffer + offset, size) == expected);
+        u64 split = size ? test_rand() % size : 0;
+        u32 crc = chk_crc32cUpdate(0, buffer + offset, split);
+        ASSERT(chk_crc32cUpdate(crc, buffer + offset + split, size - split) == expected);
+    }
+    ASSERT(chk_contentHash64(buffer, bufferSize, 7) == str_hash64Seed(str_fromCharPtr(buffer, bufferSize), 7));
+    free(buffer);
+}
+
+static volatile u64 test__sink;
+
+static void test_benchmark(void) {
+    tm_FrequencyInfo freq = tm_getPerformanceFrequency();
+    u64 bulkSize = MEGABYTE(64);
+    u8* bulk = (u8*) malloc(bulkSize);
+    test_fillRandom(bulk, bulkSize);
+    S8 bulkStr = str_fromCharPtr(bulk, bulkSize);
+
+    u64 start = tm_currentCount();
+    test__sink += str_hash64(bulkStr);
+    f64 wyhashNs = tm_countToNanoSeconds(tm_countToNanoseconds(freq, i64_cast(tm_currentCount() - start)));
+
+    start = tm_currentCount();
+    test__sink += str_hash64Djb2(bulkStr);
+    f64 djb2Ns = tm_countToNanoSeconds(tm_countToNanoseconds(freq, i64_cast(tm_currentCount() - start)));
+
+    start = tm_currentCount();
+    test__sink += chk_crc32c(bulk, bulkSize);
+    f64 crcNs = tm_countToNanoSeconds(tm_countToNanoseconds(freq, i64_cast(tm_currentCount() - start)));
+
+    printf("bulk  str_hash64 %7.2f GB/s, str_hash64Djb2 %7.2f GB/s, chk_crc32c %7.2f GB/s\n", f64_cast(bulkSize) / wyhashNs, f64_cast(bulkSize) / djb2Ns, f64_cast(bulkSize) / crcNs);
+
+    // short keys, the common case for hash tables
+    u64 keySizes[] = {4, 8, 16, 32, 64};
+    for (u32 k = 0; k < countOf(keySizes); k++) {
+        u64 iterations = 1 << 22;
+        start = tm_currentCount();
+        for (u64 i = 0; i < iterations; i++) {
+            test__sink += str_hash64(str_fromCharPtr(bulk + (i & 0xFFFF), keySizes[k]));
+        }
+        f64 ns = tm_countToNanoSeconds(tm_countToNanoseconds(freq, i64_cast(tm_currentCount() - start)));
+        start = tm_currentCount();
+        for (u64 i = 0; i < iterations; i++) {
+            test__sink += str_hash64Djb2(str_fromCharPtr(bulk + (i & 0xFFFF), keySizes[k]));
+        }
+        f64 djb2KeyNs = tm_countToNanoSeconds(tm_countToNanoseconds(freq, i64_cast(tm_currentCount() - start)));
+        printf("key %2llu str_hash64 %6.2f ns/hash, str_hash64Djb2 %6.2f ns/hash\n", (unsigned long long) keySizes[k], ns / iterations, djb2KeyNs / iterations);
+    }
+    free(bulk);
+}
+
+i32 main(i32 argc, char* argv[]) {
+    test_streamEquivalence();
+    test_seeds();
+    u64 avalancheSizes[] = {3, 8, 16, 24, 48, 100};
+    for (u32 i = 0; i < countOf(avalancheSizes); i++) {
+        test_avalanche(avalancheSizes[i], false);
+        test_avalanche(avalancheSizes[i], true);
+    }
+    test_keysets();
+    test_crc32c();
+    test_benchmark();
+    return 0;
+}
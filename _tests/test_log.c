@@ -0,0 +1,611 @@
+// module of every call site in this file, see test_levels
+#define LOG_MODULE "test"
+
+#include "base/base.h"
+#include "base/base_types.h"
+#include "base/base_mem.h"
+#include "base/base_str.h"
+
+#include "os/os.h"
+#include "log/log.h"
+
+#include <stdio.h>
+#include <time.h>
+#if !OS_WIN
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#endif
+
+////////////////////////////
+// NOTE(pjako): binary output
+
+static bx test_contains(S8 text, const char* part) {
+    return str_findFirst(text, str_fromNullTerminatedCharPtr((char*) part), 0) < text.size;
+}
+
+static void test_binaryRoundTrip(Arena* arena) {
+    S8 fileName = s8("test_log.blog");
+    ASSERT(log_binaryStart(fileName));
+    u32 one = 1, two = 2, mask = 255;
+    f64 negative = -2.5;
+    log_infoFmt(arena, s8("round {} of {}"), one, two);
+    log_warnFmt(arena, s8("keyed {name} {}"), str_kv(s8("name"), s8("value")), mask);
+    log_errorFmt(arena, s8("text {} {}"), s8("str"), negative);
+    log_binaryStop();
+    log_asyncStop();
+
+    S8 data = os_fileRead(arena, fileName);
+    ASSERT(data.size > 0);
+    Arena* tmpArena = mem_makeArena(&arena->base, MEGABYTE(16));
+    str_Builder builder = str_builderInit(arena, KILOBYTE(64));
+    ASSERT(log_binaryDecode(tmpArena, data, &builder));
+    S8 text = str_builderFinish(&builder, arena);
+    if (!test_contains(text, "INFO") || !test_contains(text, "round 1 of 2") || !test_contains(text, "keyed value 255") || !test_contains(text, "text str -2.5")) {
+        printf("log_binaryDecode:\n%.*s\n", (i32) text.size, text.content);
+        ASSERT(!"log_binaryDecode");
+    }
+    os_fileDelete(fileName);
+    mem_destroyArena(tmpArena);
+    printf("log binary round trip ok\n");
+}
+
+typedef struct test_BlogWriter {
+    u8 data[512];
+    u32 size;
+    u32 recordStart;
+} test_BlogWriter;
+
+static void test_blogPut(test_BlogWriter* writer, const void* value, u32 size) {
+    ASSERT(writer->size + size <= sizeof(writer->data));
+    mem_copy(writer->data + writer->size, value, size);
+    writer->size += size;
+}
+
+static void test_blogPutU32(test_BlogWriter* writer, u32 value) {
+    test_blogPut(writer, &value, sizeof(value));
+}
+
+static void test_blogBegin(test_BlogWriter* writer, u8 kind) {
+    writer->recordStart = writer->size;
+    test_blogPutU32(writer, 0);
+    test_blogPut(writer, &kind, 1);
+}
+
+static void test_blogEnd(test_BlogWriter* writer) {
+    u32 size = writer->size - writer->recordStart - sizeof(u32);
+    mem_copy(writer->data + writer->recordStart, &size, sizeof(size));
+}
+
+static void test_blogDescriptor(test_BlogWriter* writer, u32 id, const char* template) {
+    u32 line = 1;
+    u8 severity = log_severity_info;
+    test_blogBegin(writer, 2);
+    test_blogPutU32(writer, id);
+    test_blogPutU32(writer, line);
+    test_blogPut(writer, &severity, 1);
+    test_blogPutU32(writer, 1);
+    test_blogPut(writer, "f", 1);
+    S8 templateStr = str_fromNullTerminatedCharPtr((char*) template);
+    test_blogPutU32(writer, u32_cast(templateStr.size));
+    test_blogPut(writer, templateStr.content, u32_cast(templateStr.size));
+    test_blogEnd(writer);
+}
+
+static void test_blogMessage(test_BlogWriter* writer, u32 id, u8 argCount, u32 value) {
+    u64 cycles = 0;
+    u8 type = str_argType_u32;
+    test_blogBegin(writer, 3);
+    test_blogPutU32(writer, id);
+    test_blogPut(writer, &cycles, sizeof(cycles));
+    test_blogPut(writer, &argCount, 1);
+    for (u8 idx = 0; idx < argCount; idx++) {
+        test_blogPut(writer, &type, 1);
+        test_blogPutU32(writer, value);
+    }
+    test_blogEnd(writer);
+}
+
+// a damaged file must neither write out of bounds nor reach the asserts of the formatter
+static void test_binaryDamaged(Arena* arena) {
+    test_BlogWriter writer;
+    mem_structSetZero(&writer);
+    test_blogPut(&writer, "BLOG", 4);
+    test_blogPutU32(&writer, 1);
+    test_blogDescriptor(&writer, 0xFFFFFFFF, "wrapping id {}");
+    test_blogDescriptor(&writer, 1, "missing {name}");
+    test_blogDescriptor(&writer, 2, "short {} {}");
+    test_blogMessage(&writer, 0xFFFFFFFF, 1, 3);
+    test_blogMessage(&writer, 1, 1, 4);
+    test_blogMessage(&writer, 2, 1, 5);
+    test_blogMessage(&writer, 2, 2, 6);
+
+    Arena* tmpArena = mem_makeArena(&arena->base, MEGABYTE(16));
+    str_Builder builder = str_builderInit(arena, KILOBYTE(64));
+    ASSERT(log_binaryDecode(tmpArena, str_fromCharPtr(writer.data, writer.size), &builder));
+    S8 text = str_builderFinish(&builder, arena);
+    if (test_contains(text, "wrapping") || !test_contains(text, "missing {name}") || !test_contains(text, "short {} {}") || !test_contains(text, "short 6 6")) {
+        printf("log_binaryDecode damaged:\n%.*s\n", (i32) text.size, text.content);
+        ASSERT(!"log_binaryDecode damaged");
+    }
+    mem_destroyArena(tmpArena);
+    printf("log binary damaged ok\n");
+}
+
+static u32 test_count(S8 text, const char* part) {
+    S8 partStr = str_fromNullTerminatedCharPtr((char*) part);
+    u32 count = 0;
+    for (u64 pos = str_findFirst(text, partStr, 0); pos < text.size; pos = str_findFirst(text, partStr, pos + partStr.size)) {
+        count++;
+    }
+    return count;
+}
+
+////////////////////////////
+// NOTE(pjako): sinks
+
+static void test_callbackLogs(log_Severity severity, S8 fileName, u64 line, S8 str, void* user) {
+    unusedVars(severity, fileName, line, str);
+    log_warn((Arena*) user, s8("from callback"));
+}
+
+static void test_sinkRotation(Arena* arena) {
+    S8 fileNames[] = {s8("test_log_sink.log"), s8("test_log_sink.log.1"), s8("test_log_sink.log.2"), s8("test_log_sink.log.3")};
+    for (u32 idx = 0; idx < countOf(fileNames); idx++) {
+        os_fileDelete(fileNames[idx]);
+    }
+    log_sinkSetSeverity(0, log_severity_fatal);
+    log_SinkDesc fileDesc;
+    mem_structSetZero(&fileDesc);
+    fileDesc.type = log_sinkType_file;
+    fileDesc.minSeverity = log_severity_info;
+    fileDesc.fileName = fileNames[0];
+    fileDesc.rotateSize = KILOBYTE(4);
+    fileDesc.rotateCount = 2;
+    i32 file = log_sinkAdd(&fileDesc);
+    log_SinkDesc ringDesc;
+    mem_structSetZero(&ringDesc);
+    ringDesc.type = log_sinkType_ring;
+    ringDesc.ringSize = 512;
+    i32 ring = log_sinkAdd(&ringDesc);
+    ASSERT(file > 0 && ring > 0 && file != ring);
+
+    log_debug(arena, s8("below the file severity"));
+    for (u32 idx = 0; idx < 300; idx++) {
+        log_infoFmt(arena, s8("rotate {}"), idx);
+    }
+    log_flush();
+
+    // the ring keeps the newest lines
+    S8 ringText = log_sinkRingRead(arena, ring);
+    ASSERT(ringText.size <= 512 && test_contains(ringText, "rotate 299") && !test_contains(ringText, "rotate 200"));
+
+    S8 current = os_fileRead(arena, fileNames[0]);
+    S8 previous = os_fileRead(arena, fileNames[1]);
+    S8 oldest = os_fileRead(arena, fileNames[2]);
+    ASSERT(current.size > 0 && current.size <= KILOBYTE(4) && test_contains(current, "rotate 299"));
+    ASSERT(previous.size > 0 && previous.size <= KILOBYTE(4) && !test_contains(previous, "rotate 299"));
+    ASSERT(oldest.size > 0 && oldest.size <= KILOBYTE(4));
+    // rotateCount files are kept, the first lines are gone
+    ASSERT(!os_fileExists(fileNames[3]));
+    ASSERT(!test_contains(current, "rotate 0\r") && !test_contains(current, "below"));
+
+    // a removed sink gets no more lines and its slot is used again
+    log_sinkRemove(file);
+    log_info(arena, s8("after remove"));
+    log_flush();
+    ASSERT(!test_contains(os_fileRead(arena, fileNames[0]), "after remove"));
+    ASSERT(test_contains(log_sinkRingRead(arena, ring), "after remove"));
+    i32 again = log_sinkAdd(&fileDesc);
+    ASSERT(again == file);
+    log_sinkRemove(again);
+    log_sinkRemove(ring);
+    log_sinkSetSeverity(0, log_severity_trace);
+    for (u32 idx = 0; idx < countOf(fileNames); idx++) {
+        os_fileDelete(fileNames[idx]);
+    }
+    printf("log sink rotation ok\n");
+}
+
+// a callback that logs runs on the writer, with a full ring under the block policy it would wait for itself
+static void test_callbackReentry(Arena* arena) {
+    BaseMemory baseMem = os_getBaseMemory();
+    Arena* callbackArena = mem_makeArena(&baseMem, MEGABYTE(1));
+    log_sinkSetSeverity(0, log_severity_fatal);
+    log_SinkDesc ringDesc;
+    mem_structSetZero(&ringDesc);
+    ringDesc.type = log_sinkType_ring;
+    ringDesc.ringSize = KILOBYTE(256);
+    i32 ring = log_sinkAdd(&ringDesc);
+    log_SinkDesc callbackDesc;
+    mem_structSetZero(&callbackDesc);
+    callbackDesc.type = log_sinkType_callback;
+    callbackDesc.minSeverity = log_severity_info;
+    callbackDesc.callback = test_callbackLogs;
+    callbackDesc.user = callbackArena;
+    i32 callback = log_sinkAdd(&callbackDesc);
+    ASSERT(ring > 0 && callback > 0);
+
+    log_AsyncDesc asyncDesc;
+    mem_structSetZero(&asyncDesc);
+    asyncDesc.ringSize = KILOBYTE(4);
+    asyncDesc.flushIntervalMs = 1;
+    asyncDesc.policy = log_asyncPolicy_block;
+    ASSERT(log_asyncStart(&asyncDesc));
+    for (u32 idx = 0; idx < 500; idx++) {
+        log_infoFmt(arena, s8("line {}"), idx);
+    }
+    log_flush();
+    log_asyncStop();
+
+    S8 text = log_sinkRingRead(arena, ring);
+    // the callback does not see its own lines, so there is exactly one per logged line
+    ASSERT(test_count(text, "from callback") == 500);
+    ASSERT(test_count(text, "line ") == 500);
+    log_sinkRemove(callback);
+    log_sinkRemove(ring);
+    log_sinkSetSeverity(0, log_severity_trace);
+    mem_destroyArena(callbackArena);
+    printf("log callback reentry ok\n");
+}
+
+////////////////////////////
+// NOTE(pjako): clock
+
+// local time of a line prefix in microseconds since the epoch, digits is the count of sub-second digits found
+static i64 test_lineTime(S8 line, u32* digits) {
+    char buffer[64];
+    u64 size = minVal(line.size, sizeof(buffer) - 1);
+    mem_copy(buffer, line.content, size);
+    buffer[size] = '\0';
+    struct tm local;
+    mem_structSetZero(&local);
+    ASSERT(sscanf(buffer, "%d-%d-%d %d:%d:%d", &local.tm_year, &local.tm_mon, &local.tm_mday, &local.tm_hour, &local.tm_min, &local.tm_sec) == 6);
+    local.tm_year -= 1900;
+    local.tm_mon -= 1;
+    local.tm_isdst = -1;
+    i64 micros = i64_cast(mktime(&local)) * 1000000;
+    *digits = 0;
+    if (buffer[19] == '.') {
+        i64 fraction = 0;
+        for (u32 idx = 20; buffer[idx] >= '0' && buffer[idx] <= '9'; idx++) {
+            fraction = fraction * 10 + (buffer[idx] - '0');
+            *digits += 1;
+        }
+        micros += *digits == 3 ? fraction * 1000 : fraction;
+    }
+    return micros;
+}
+
+static S8 test_lastLine(S8 text) {
+    ASSERT(text.size > 2);
+    u64 end = text.size - 1;
+    u64 start = end;
+    while (start > 0 && text.content[start - 1] != '\n') {
+        start--;
+    }
+    return str_subStr(text, start, end - start);
+}
+
+// the prefix is formatted from the counter between wall clock samples, it has to agree with the wall clock
+static void test_clock(Arena* arena) {
+    log_sinkSetSeverity(0, log_severity_fatal);
+    log_SinkDesc ringDesc;
+    mem_structSetZero(&ringDesc);
+    ringDesc.type = log_sinkType_ring;
+    i32 ring = log_sinkAdd(&ringDesc);
+    ASSERT(ring > 0);
+
+    u32 digits = 0;
+    log_setTimePrecision(log_timePrecision_micro);
+    i64 previous = 0;
+    for (u32 idx = 0; idx < 12; idx++) {
+        i64 before = i64_cast(time(NULL)) * 1000000;
+        log_info(arena, s8("clock"));
+        i64 after = i64_cast(time(NULL)) * 1000000 + 1000000;
+        i64 stamp = test_lineTime(test_lastLine(log_sinkRingRead(arena, ring)), &digits);
+        ASSERT(digits == 6);
+        ASSERT(stamp >= before && stamp < after);
+        if (idx > 0) {
+            // 100ms between the lines, the steps cross second boundaries where the clock is anchored again
+            ASSERT(stamp - previous >= 90000 && stamp - previous < 1000000);
+        }
+        previous = stamp;
+        os_sleep(100);
+    }
+
+    log_setTimePrecision(log_timePrecision_milli);
+    log_info(arena, s8("clock"));
+    test_lineTime(test_lastLine(log_sinkRingRead(arena, ring)), &digits);
+    ASSERT(digits == 3);
+    log_setTimePrecision(log_timePrecision_second);
+    log_info(arena, s8("clock"));
+    test_lineTime(test_lastLine(log_sinkRingRead(arena, ring)), &digits);
+    ASSERT(digits == 0);
+    log_setTimePrecision(log_timePrecision_milli);
+
+    log_sinkRemove(ring);
+    log_sinkSetSeverity(0, log_severity_trace);
+    printf("log clock ok\n");
+}
+
+////////////////////////////
+// NOTE(pjako): runtime levels
+
+static u32 test_levelArgs;
+static u32 test_levelLines;
+
+static u32 test_levelArg(void) {
+    test_levelArgs++;
+    return 1;
+}
+
+static void test_levelCount(log_Severity severity, S8 fileName, u64 line, S8 str, void* user) {
+    unusedVars(severity, fileName, line, str, user);
+    test_levelLines++;
+}
+
+// one trace and one info call site, returns the lines that passed. Filtered sites must not evaluate their arguments
+static u32 test_levelSites(Arena* arena, u32* argsEvaluated) {
+    u32 lines = test_levelLines;
+    u32 args = test_levelArgs;
+    log_traceFmt(arena, s8("trace {}"), test_levelArg());
+    log_infoFmt(arena, s8("info {}"), test_levelArg());
+    *argsEvaluated = test_levelArgs - args;
+    return test_levelLines - lines;
+}
+
+static void test_levels(Arena* arena) {
+    log_sinkSetSeverity(0, log_severity_fatal);
+    log_setCallback(test_levelCount, NULL);
+    u32 args = 0;
+    ASSERT(test_levelSites(arena, &args) == 2 && args == 2);
+
+    log_setModuleLevel(s8("test"), log_severity_warning);
+    ASSERT(test_levelSites(arena, &args) == 0 && args == 0);
+    // a module rule wins over a file rule
+    ASSERT(log_setFileLevel(s8("_tests/test_log.c"), log_severity_trace));
+    ASSERT(test_levelSites(arena, &args) == 0 && args == 0);
+    log_setModuleLevel(s8("test"), log_severity_info);
+    ASSERT(test_levelSites(arena, &args) == 1 && args == 1);
+
+    log_clearLevels();
+    ASSERT(test_levelSites(arena, &args) == 2 && args == 2);
+    ASSERT(log_setLevels(s8("error, _tests/*.c = info")));
+    ASSERT(test_levelSites(arena, &args) == 1 && args == 1);
+    // a broken spec changes nothing
+    ASSERT(!log_setLevels(s8("trace,test=bogus")));
+    ASSERT(test_levelSites(arena, &args) == 1 && args == 1);
+    log_clearLevels();
+    log_setDefaultLevel(log_severity_off);
+    ASSERT(test_levelSites(arena, &args) == 0 && args == 0);
+    ASSERT(log_setLevels(s8("off,test=trace")));
+    ASSERT(test_levelSites(arena, &args) == 2 && args == 2);
+
+    log_clearLevels();
+    log_setCallback(NULL, NULL);
+    log_sinkSetSeverity(0, log_severity_trace);
+    printf("log levels ok\n");
+}
+
+////////////////////////////
+// NOTE(pjako): rate limiting
+
+// the number in front of (or after) part, 0 if part is missing
+static u32 test_countIn(S8 text, const char* part, bx numberBefore) {
+    S8 partStr = str_fromNullTerminatedCharPtr((char*) part);
+    u64 pos = str_findFirst(text, partStr, 0);
+    if (pos >= text.size) {
+        return 0;
+    }
+    u64 start = numberBefore ? pos - 1 : pos + partStr.size;
+    if (numberBefore) {
+        while (start > 0 && text.content[start - 1] >= '0' && text.content[start - 1] <= '9') {
+            start--;
+        }
+    }
+    u32 value = 0;
+    for (u64 idx = start; idx < text.size && text.content[idx] >= '0' && text.content[idx] <= '9'; idx++) {
+        value = value * 10 + (text.content[idx] - '0');
+    }
+    return value;
+}
+
+static void test_rateLimit(Arena* arena) {
+    log_sinkSetSeverity(0, log_severity_fatal);
+    log_SinkDesc ringDesc;
+    mem_structSetZero(&ringDesc);
+    ringDesc.type = log_sinkType_ring;
+    i32 ring = log_sinkAdd(&ringDesc);
+    ASSERT(ring > 0);
+
+    // a burst of 5 and 1 refill per second, the loop takes far less than a second
+    log_RateLimitDesc rateDesc;
+    mem_structSetZero(&rateDesc);
+    rateDesc.perSecond = 1;
+    rateDesc.burst = 5;
+    log_setRateLimit(&rateDesc);
+    for (u32 idx = 0; idx < 50; idx++) {
+        log_infoFmt(arena, s8("burst {}"), idx);
+    }
+    S8 text = log_sinkRingRead(arena, ring);
+    u32 passed = test_count(text, "burst ");
+    ASSERT(passed >= 5 && passed <= 6 && test_count(text, "messages dropped") == 0);
+    log_flush();
+    text = log_sinkRingRead(arena, ring);
+    ASSERT(test_countIn(text, " messages dropped by the rate limit", true) == 50 - passed);
+
+    // identical messages collapse, the count is written when the site logs something else or on log_flush
+    rateDesc.perSecond = 0;
+    rateDesc.burst = 0;
+    rateDesc.repeatWindowMs = 60000;
+    log_setRateLimit(&rateDesc);
+    S8 messages[] = {s8("first"), s8("first"), s8("first"), s8("second"), s8("second")};
+    for (u32 idx = 0; idx < countOf(messages); idx++) {
+        log_info(arena, s8("repeat "), messages[idx]);
+    }
+    text = log_sinkRingRead(arena, ring);
+    ASSERT(test_count(text, "repeat first") == 1 && test_count(text, "repeat second") == 1);
+    ASSERT(test_count(text, "previous message repeated 2 times") == 1);
+    ASSERT(str_findFirst(text, s8("repeated 2 times"), 0) < str_findFirst(text, s8("repeat second"), 0));
+    log_flush();
+    text = log_sinkRingRead(arena, ring);
+    ASSERT(test_count(text, "previous message repeated 1 times") == 1);
+
+    // async: the summary goes through the ring of the thread and log_flush waits for it
+    log_AsyncDesc asyncDesc;
+    mem_structSetZero(&asyncDesc);
+    asyncDesc.flushIntervalMs = 1000;
+    ASSERT(log_asyncStart(&asyncDesc));
+    for (u32 idx = 0; idx < 4; idx++) {
+        log_info(arena, s8("async same"));
+    }
+    log_flush();
+    text = log_sinkRingRead(arena, ring);
+    ASSERT(test_count(text, "async same") == 1 && test_count(text, "previous message repeated 3 times") == 1);
+    log_asyncStop();
+
+    log_setRateLimit(NULL);
+    log_sinkRemove(ring);
+    log_sinkSetSeverity(0, log_severity_trace);
+    printf("log rate limit ok\n");
+}
+
+////////////////////////////
+// NOTE(pjako): mmap sink
+
+static i32 test_mmapSinkAdd(S8 fileName, u32 ringSize) {
+    log_SinkDesc desc;
+    mem_structSetZero(&desc);
+    desc.type = log_sinkType_mmap;
+    desc.fileName = fileName;
+    desc.ringSize = ringSize;
+    return log_sinkAdd(&desc);
+}
+
+static void test_mmapSink(Arena* arena) {
+    S8 fileName = s8("test_log.lmap");
+    os_fileDelete(fileName);
+    log_sinkSetSeverity(0, log_severity_fatal);
+#if !OS_WIN
+    // the lines are in the file without a sync, even when the process is killed right after writing them
+    pid_t child = fork();
+    if (child == 0) {
+        ASSERT(test_mmapSinkAdd(fileName, KILOBYTE(16)) > 0);
+        for (u32 idx = 0; idx < 1000; idx++) {
+            log_infoFmt(arena, s8("mapped {}"), idx);
+        }
+        kill(getpid(), SIGKILL);
+    }
+    i32 status = 0;
+    ASSERT(child > 0 && waitpid(child, &status, 0) == child && WIFSIGNALED(status));
+#else
+    i32 sink = test_mmapSinkAdd(fileName, KILOBYTE(16));
+    ASSERT(sink > 0);
+    for (u32 idx = 0; idx < 1000; idx++) {
+        log_infoFmt(arena, s8("mapped {}"), idx);
+    }
+    log_sinkRemove(sink);
+#endif
+    S8 text = log_mmapDecode(arena, os_fileRead(arena, fileName));
+    ASSERT(text.size > 0 && text.size <= KILOBYTE(16));
+    // the ring wrapped, the oldest lines are gone and the text starts with a whole line
+    ASSERT(test_contains(text, "mapped 999\r\n") && !test_contains(text, "mapped 0\r\n"));
+    ASSERT(text.content[text.size - 1] == '\n' && test_count(text, "\n") == test_count(text, "mapped "));
+
+    // the same size continues the ring of the previous process
+    i32 sink = test_mmapSinkAdd(fileName, KILOBYTE(16));
+    ASSERT(sink > 0);
+    log_info(arena, s8("after restart"));
+    S8 live = log_sinkRingRead(arena, sink);
+    ASSERT(test_contains(live, "mapped 999\r\n") && str_hasSuffix(live, s8("after restart\r\n")));
+    log_sinkRemove(sink);
+    ASSERT(str_isEqual(log_mmapDecode(arena, os_fileRead(arena, fileName)), live));
+
+    // another size starts over
+    sink = test_mmapSinkAdd(fileName, KILOBYTE(8));
+    ASSERT(sink > 0);
+    log_info(arena, s8("new ring"));
+    log_sinkRemove(sink);
+    text = log_mmapDecode(arena, os_fileRead(arena, fileName));
+    ASSERT(!test_contains(text, "mapped") && test_count(text, "new ring") == 1);
+
+    ASSERT(log_mmapDecode(arena, s8("not a mapped log file, not even close to a header")).content == NULL);
+    os_fileDelete(fileName);
+    log_sinkSetSeverity(0, log_severity_trace);
+    printf("log mmap sink ok\n");
+}
+
+////////////////////////////
+// NOTE(pjako): structured output
+
+// a fixed record in the current encoding, the time is checked for its shape and cut off
+static S8 test_encodedRecord(Arena* arena, i32 ring, u32* line) {
+    u32 ms = 3;
+    i64 delta = -7;
+    f64 ratio = 2.5;
+    f64 nan = 0.0;
+    nan = nan / nan;
+    S8 path = s8("a \"b\"");
+    *line = __LINE__ + 1;
+    log_infoFmt(arena, s8("done {ms} in {path}"), str_kv(s8("ms"), ms), str_kv(s8("delta"), delta), str_kv(s8("ratio"), ratio), str_kv(s8("path"), path), str_kv(s8("bad"), nan));
+    S8 text = log_sinkRingRead(arena, ring);
+    u64 start = text.size - 1;
+    while (start > 0 && text.content[start - 1] != '\n') {
+        start--;
+    }
+    S8 record = str_from(text, start);
+    u64 timeStart = str_findFirst(record, s8("time="), 0) == 0 ? 5 : 9;
+    ASSERT(record.size > timeStart + 23);
+    S8 time = str_subStr(record, timeStart, 23);
+    ASSERT(time.content[4] == '-' && time.content[10] == 'T' && time.content[13] == ':' && time.content[19] == '.');
+    return str_from(record, timeStart + 23);
+}
+
+static void test_encoders(Arena* arena) {
+    log_sinkSetSeverity(0, log_severity_fatal);
+    log_SinkDesc ringDesc;
+    mem_structSetZero(&ringDesc);
+    ringDesc.type = log_sinkType_ring;
+    i32 ring = log_sinkAdd(&ringDesc);
+    ASSERT(ring > 0);
+
+    u32 line = 0;
+    log_setEncoding(log_encoding_json);
+    S8 json = test_encodedRecord(arena, ring, &line);
+    S8 expectedJson = str_fmt(arena, s8("\",\"level\":\"info\",\"file\":\"_tests/test_log.c\",\"line\":{},\"module\":\"test\",\"msg\":\"done 3 in a \\\"b\\\"\","
+                                        "\"ms\":3,\"delta\":-7,\"ratio\":2.5,\"path\":\"a \\\"b\\\"\",\"bad\":null}}\n"), line);
+    if (!str_isEqual(json, expectedJson)) {
+        printf("json record:\n%.*s\n", (i32) json.size, json.content);
+        ASSERT(!"json record");
+    }
+
+    log_setEncoding(log_encoding_logfmt);
+    S8 logfmt = test_encodedRecord(arena, ring, &line);
+    S8 expectedLogfmt = str_fmt(arena, s8(" level=info file=_tests/test_log.c line={} module=test msg=\"done 3 in a \\\"b\\\"\" ms=3 delta=-7 ratio=2.5 path=\"a \\\"b\\\"\" bad=NaN\n"), line);
+    if (!str_isEqual(logfmt, expectedLogfmt)) {
+        printf("logfmt record:\n%.*s\n", (i32) logfmt.size, logfmt.content);
+        ASSERT(!"logfmt record");
+    }
+
+    log_setEncoding(log_encoding_text);
+    log_sinkRemove(ring);
+    log_sinkSetSeverity(0, log_severity_trace);
+    printf("log encoders ok\n");
+}
+
+i32 main(i32 argc, char* argv[]) {
+    BaseMemory baseMem = os_getBaseMemory();
+    Arena* arena = mem_makeArena(&baseMem, MEGABYTE(64));
+    test_binaryRoundTrip(arena);
+    test_binaryDamaged(arena);
+    test_sinkRotation(arena);
+    test_callbackReentry(arena);
+    test_clock(arena);
+    test_levels(arena);
+    test_rateLimit(arena);
+    test_mmapSink(arena);
+    test_encoders(arena);
+    mem_destroyArena(arena);
+    return 0;
+}
@@ -0,0 +1,525 @@
+#include "base/base.h"
+#include "base/base_types.h"
+#include "base/base_mem.h"
+#include "base/base_str.h"
+
+#include "os/os.h"
+
+#include <stdio.h>
+#if !OS_WIN
+#include <stdlib.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#endif
+
+////////////////////////////
+// NOTE(pjako): path helpers and directory listing
+
+static void test_fixFilepath(Arena* arena) {
+    static const char* cases[][2] = {
+        {"a/b/../c", "a/c"},
+        {"a\\b\\.\\c", "a/b/c"},
+        {"a/./b/", "a/b/"},
+        {"x/.hidden", "x/.hidden"},
+        {"a/../b", "b"},
+        {"a/b/..", "a"},
+        {"a/..", "."},
+        {"a/b/../..", "."},
+        {"./..", ".."},
+        {"..", ".."},
+        {"../..", "../.."},
+        {"a/../../b", "../b"},
+        {"/", "/"},
+        {"/a/..", "/"},
+        {"/a/b/../c", "/a/c"},
+        {"/..", "/"},
+        {"/../..", "/"},
+        {"/../a", "/a"},
+        {"/a/../..", "/"},
+    };
+    for (u32 idx = 0; idx < countOf(cases); idx++) {
+        S8 fixed = os_fixFilepath(arena, str_fromNullTerminatedCharPtr((char*) cases[idx][0]));
+        if (!str_isEqual(fixed, str_fromNullTerminatedCharPtr((char*) cases[idx][1]))) {
+            printf("os_fixFilepath(\"%s\") = \"%.*s\", expected \"%s\"\n", cases[idx][0], (i32) fixed.size, fixed.content, cases[idx][1]);
+            ASSERT(!"os_fixFilepath");
+        }
+    }
+    printf("os fix filepath ok\n");
+}
+
+#if !OS_WIN
+static void test_touch(const char* path) {
+    FILE* file = fopen(path, "w");
+    ASSERT(file);
+    fclose(file);
+}
+
+static bx test_hasPath(S8* paths, u64 count, const char* path) {
+    for (u64 idx = 0; idx < count; idx++) {
+        if (str_isEqual(paths[idx], str_fromNullTerminatedCharPtr((char*) path))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void test_pathList(Arena* arena) {
+    char root[] = "/tmp/test_os_XXXXXX";
+    ASSERT(mkdtemp(root));
+    S8 rootStr = str_fromNullTerminatedCharPtr(root);
+    char path[256];
+    const char* dirs[] = {"src", "src/sub", "doc"};
+    for (u32 idx = 0; idx < countOf(dirs); idx++) {
+        snprintf(path, sizeof(path), "%s/%s", root, dirs[idx]);
+        ASSERT(mkdir(path, 0755) == 0);
+    }
+    const char* files[] = {"a.c", "src/b.c", "src/c.h", "src/sub/d.c", "doc/e.c"};
+    for (u32 idx = 0; idx < countOf(files); idx++) {
+        snprintf(path, sizeof(path), "%s/%s", root, files[idx]);
+        test_touch(path);
+    }
+
+    os_PathListDesc desc;
+    mem_structSetZero(&desc);
+    u64 count = 0;
+
+    // literal leading directories are where the walk starts, recursive or not
+    desc.pattern = s8("src/*.c");
+    S8* paths = os_pathListFiltered(arena, rootStr, &desc, &count);
+    ASSERT(paths && count == 1 && test_hasPath(paths, count, "src/b.c"));
+
+    desc.pattern = s8("**/*.c");
+    desc.flags = os_pathListFlag_recursive;
+    desc.threadCount = 4;
+    paths = os_pathListFiltered(arena, rootStr, &desc, &count);
+    ASSERT(paths && count == 4);
+    ASSERT(test_hasPath(paths, count, "a.c") && test_hasPath(paths, count, "src/b.c"));
+    ASSERT(test_hasPath(paths, count, "src/sub/d.c") && test_hasPath(paths, count, "doc/e.c"));
+
+    desc.pattern = s8("src/**");
+    desc.flags = os_pathListFlag_recursive | os_pathListFlag_directories;
+    paths = os_pathListFiltered(arena, rootStr, &desc, &count);
+    ASSERT(paths && count == 4 && test_hasPath(paths, count, "src/sub") && test_hasPath(paths, count, "src/sub/d.c"));
+
+    // invalid patterns and missing directories list nothing
+    desc.pattern = s8("src/[a");
+    count = 1;
+    ASSERT(os_pathListFiltered(arena, rootStr, &desc, &count) == NULL && count == 0);
+    desc.pattern = s8("");
+    count = 1;
+    ASSERT(os_pathListFiltered(arena, s8("/tmp/test_os_missing_directory"), &desc, &count) == NULL && count == 0);
+
+    for (i32 idx = countOf(files) - 1; idx >= 0; idx--) {
+        snprintf(path, sizeof(path), "%s/%s", root, files[idx]);
+        unlink(path);
+    }
+    for (i32 idx = countOf(dirs) - 1; idx >= 0; idx--) {
+        snprintf(path, sizeof(path), "%s/%s", root, dirs[idx]);
+        rmdir(path);
+    }
+    rmdir(root);
+    printf("os path list ok\n");
+}
+#endif
+
+#if OS_LINUX
+////////////////////////////
+// NOTE(pjako): filesystem watching
+
+typedef struct test_WatchLog {
+    S8* paths;
+    os_fsAction* actions;
+    u32 count;
+    u32 capacity;
+    Arena* arena;
+} test_WatchLog;
+
+static void test_watchCallback(os_fsPathWatchId id, S8 path, os_fsAction action, void* custom) {
+    unusedVars(id);
+    test_WatchLog* log = (test_WatchLog*) custom;
+    ASSERT(log->count < log->capacity);
+    log->paths[log->count] = str_copy(log->arena, path);
+    log->actions[log->count] = action;
+    log->count++;
+}
+
+// ticks until nothing was reported for a few debounce intervals
+static void test_watchSettle(os_fsPathWatchCtx* ctx, test_WatchLog* log) {
+    u32 quietMs = 0;
+    while (quietMs < OS_FS_WATCH_DEBOUNCE_MS * 4) {
+        u32 count = log->count;
+        os_fsWatchPathTick(ctx);
+        os_sleep(1);
+        quietMs = log->count == count ? quietMs + 1 : 0;
+    }
+}
+
+// action reported for path, 0 if none, asserts that it was reported at most once
+static os_fsAction test_watchAction(test_WatchLog* log, const char* path) {
+    os_fsAction action = (os_fsAction) 0;
+    for (u32 idx = 0; idx < log->count; idx++) {
+        if (str_isEqual(log->paths[idx], str_fromNullTerminatedCharPtr((char*) path))) {
+            ASSERT(action == 0);
+            action = log->actions[idx];
+        }
+    }
+    return action;
+}
+
+static void test_fsWatch(Arena* arena) {
+    char root[] = "/tmp/test_os_XXXXXX";
+    ASSERT(mkdtemp(root));
+    char path[256];
+    char other[256];
+    test_WatchLog log;
+    mem_structSetZero(&log);
+    log.arena = arena;
+    log.capacity = 200000;
+    log.paths = mem_arenaPushArray(arena, S8, log.capacity);
+    log.actions = mem_arenaPushArray(arena, os_fsAction, log.capacity);
+
+    os_fsPathWatchCtx* ctx = os_fsWatchPathCreatCtx(arena);
+    ASSERT(ctx);
+    os_fsPathWatchId id = os_fsWatchPathStart(ctx, str_fromNullTerminatedCharPtr(root), os_fsPathTrackFlag_recursive, test_watchCallback, &log);
+    ASSERT(id.id != 0);
+
+    // merging: a rewrite storm is one modify, create + delete is nothing, a rename inside the tree is delete + move
+    snprintf(path, sizeof(path), "%s/a.txt", root);
+    test_touch(path);
+    test_watchSettle(ctx, &log);
+    ASSERT(test_watchAction(&log, path) == os_fsAction_create);
+    log.count = 0;
+    for (u32 idx = 0; idx < 50; idx++) {
+        test_touch(path);
+    }
+    snprintf(other, sizeof(other), "%s/gone.txt", root);
+    test_touch(other);
+    unlink(other);
+    test_watchSettle(ctx, &log);
+    ASSERT(log.count == 1 && test_watchAction(&log, path) == os_fsAction_modifiy);
+    log.count = 0;
+    snprintf(other, sizeof(other), "%s/b.txt", root);
+    ASSERT(rename(path, other) == 0);
+    test_watchSettle(ctx, &log);
+    ASSERT(log.count == 2 && test_watchAction(&log, path) == os_fsAction_delete && test_watchAction(&log, other) == os_fsAction_move);
+    unlink(other);
+    test_watchSettle(ctx, &log);
+
+    // many paths pending at once, each reported once
+    log.count = 0;
+    u32 fileCount = 4000;
+    for (u32 idx = 0; idx < fileCount; idx++) {
+        snprintf(path, sizeof(path), "%s/many_%u", root, idx);
+        test_touch(path);
+    }
+    test_watchSettle(ctx, &log);
+    ASSERT(log.count == fileCount);
+    for (u32 idx = 0; idx < fileCount; idx += 97) {
+        snprintf(path, sizeof(path), "%s/many_%u", root, idx);
+        ASSERT(test_watchAction(&log, path) == os_fsAction_create);
+    }
+
+    // steady churn: one path is always pending while others come and go, their paths have to stay intact
+    log.count = 0;
+    snprintf(other, sizeof(other), "%s/busy.txt", root);
+    u32 churnCount = 12000;
+    for (u32 idx = 0; idx < churnCount; idx++) {
+        snprintf(path, sizeof(path), "%s/many_%u", root, idx % fileCount);
+        test_touch(path);
+        test_touch(other);
+        if (idx % 200 == 0) {
+            os_fsWatchPathTick(ctx);
+            os_sleep(OS_FS_WATCH_DEBOUNCE_MS / 5);
+        }
+    }
+    test_watchSettle(ctx, &log);
+    for (u32 idx = 0; idx < log.count; idx++) {
+        S8 name = str_from(log.paths[idx], str_fromNullTerminatedCharPtr(root).size);
+        ASSERT(str_hasPrefix(name, s8("/many_")) || str_isEqual(name, s8("/busy.txt")));
+    }
+    ASSERT(test_watchAction(&log, other) != 0);
+
+    // more events than the kernel queue holds: the tree is listed again, files show up as modified and the new
+    // directory with its content as created
+    u32 maxQueued = 16384;
+    FILE* limits = fopen("/proc/sys/fs/inotify/max_queued_events", "r");
+    if (limits) {
+        if (fscanf(limits, "%u", &maxQueued) != 1) {
+            maxQueued = 16384;
+        }
+        fclose(limits);
+    }
+    log.count = 0;
+    for (u32 idx = 0; idx <= maxQueued; idx++) {
+        snprintf(path, sizeof(path), "%s/many_%u", root, idx % fileCount);
+        test_touch(path);
+    }
+    snprintf(path, sizeof(path), "%s/late", root);
+    ASSERT(mkdir(path, 0755) == 0);
+    snprintf(path, sizeof(path), "%s/late/c.txt", root);
+    test_touch(path);
+    test_watchSettle(ctx, &log);
+    snprintf(path, sizeof(path), "%s/late", root);
+    ASSERT(test_watchAction(&log, path) == os_fsAction_create);
+    snprintf(path, sizeof(path), "%s/late/c.txt", root);
+    ASSERT(test_watchAction(&log, path) == os_fsAction_create);
+    for (u32 idx = 0; idx < fileCount; idx++) {
+        snprintf(path, sizeof(path), "%s/many_%u", root, idx);
+        ASSERT(test_watchAction(&log, path) == os_fsAction_modifiy);
+    }
+    // the new directory is watched
+    log.count = 0;
+    snprintf(path, sizeof(path), "%s/late/d.txt", root);
+    test_touch(path);
+    test_watchSettle(ctx, &log);
+    ASSERT(log.count == 1 && test_watchAction(&log, path) == os_fsAction_create);
+
+    os_fsWatchPathStop(ctx, id);
+    os_fsWatchPathDestroyCtx(ctx);
+    for (u32 idx = 0; idx < fileCount; idx++) {
+        snprintf(path, sizeof(path), "%s/many_%u", root, idx);
+        unlink(path);
+    }
+    const char* leftovers[] = {"busy.txt", "late/c.txt", "late/d.txt", "late"};
+    for (u32 idx = 0; idx < countOf(leftovers); idx++) {
+        snprintf(path, sizeof(path), "%s/%s", root, leftovers[idx]);
+        remove(path);
+    }
+    rmdir(root);
+    printf("os fs watch ok\n");
+}
+#endif
+
+#if !OS_WIN
+////////////////////////////
+// NOTE(pjako): fibers
+
+// overwrites the callee saved registers, the compiler saves and restores them around the asm
+#if ARCH_X64
+#define TEST_FIBER_TRASH_REGISTERS() __asm__ volatile( \
+    "movq $-1, %%rbx\n movq $-1, %%r12\n movq $-1, %%r13\n movq $-1, %%r14\n movq $-1, %%r15\n" \
+    "pcmpeqd %%xmm8, %%xmm8\n" ::: "rbx", "r12", "r13", "r14", "r15", "xmm8", "memory")
+#elif ARCH_ARM64
+#define TEST_FIBER_TRASH_REGISTERS() __asm__ volatile( \
+    "mov x19, #-1\n mov x20, #-1\n mov x21, #-1\n mov x22, #-1\n mov x23, #-1\n" \
+    "mov x24, #-1\n mov x25, #-1\n mov x26, #-1\n mov x27, #-1\n mov x28, #-1\n" \
+    "movi d8, #0xffffffffffffffff\n movi d9, #0xffffffffffffffff\n movi d10, #0xffffffffffffffff\n" \
+    "movi d11, #0xffffffffffffffff\n movi d12, #0xffffffffffffffff\n movi d13, #0xffffffffffffffff\n" \
+    "movi d14, #0xffffffffffffffff\n movi d15, #0xffffffffffffffff\n" \
+    ::: "x19", "x20", "x21", "x22", "x23", "x24", "x25", "x26", "x27", "x28", \
+        "d8", "d9", "d10", "d11", "d12", "d13", "d14", "d15", "memory")
+#endif
+
+#if ARCH_X64
+static u32 test_fiberMxcsr(void) {
+    u32 mxcsr;
+    __asm__ volatile("stmxcsr %0" : "=m"(mxcsr));
+    return mxcsr;
+}
+
+static void test_fiberSetMxcsr(u32 mxcsr) {
+    __asm__ volatile("ldmxcsr %0" :: "m"(mxcsr));
+}
+#endif
+
+typedef struct test_FiberState {
+    u32 steps[8];
+    u32 stepCount;
+    u32 yieldCount;
+    u64 seed;
+    bx registersOk;
+} test_FiberState;
+
+static void test_fiberOrder(void* userPtr) {
+    test_FiberState* state = (test_FiberState*) userPtr;
+    for (u32 idx = 0; idx < state->yieldCount; idx++) {
+        state->steps[state->stepCount++] = 100 + idx;
+        os_fiberYield();
+    }
+    state->steps[state->stepCount++] = 200;
+}
+
+// keeps values live in callee saved registers across every yield while the thread trashes its own
+static void test_fiberRegisters(void* userPtr) {
+    test_FiberState* state = (test_FiberState*) userPtr;
+    volatile u64 seed = state->seed;
+    u64 a = seed + 1, b = seed + 2, c = seed + 3, d = seed + 4, e = seed + 5;
+    f64 x = (f64) seed * 0.5, y = (f64) seed * 0.25;
+#if ARCH_X64
+    // round toward zero only inside the fiber, new fibers start with the default control word
+    ASSERT(test_fiberMxcsr() == 0x1F80);
+    test_fiberSetMxcsr(0x7F80);
+#endif
+    bx ok = true;
+    for (u32 idx = 0; idx < state->yieldCount; idx++) {
+        __asm__ volatile("" : "+r"(a), "+r"(b), "+r"(c), "+r"(d), "+r"(e));
+        os_fiberYield();
+        TEST_FIBER_TRASH_REGISTERS();
+        __asm__ volatile("" : "+r"(a), "+r"(b), "+r"(c), "+r"(d), "+r"(e));
+        ok = ok && a == seed + 1 && b == seed + 2 && c == seed + 3 && d == seed + 4 && e == seed + 5;
+        ok = ok && x == (f64) seed * 0.5 && y == (f64) seed * 0.25;
+#if ARCH_X64
+        ok = ok && (test_fiberMxcsr() & 0x6000) == 0x6000;
+#endif
+    }
+    state->registersOk = ok;
+}
+
+static void test_fiberEmpty(void* userPtr) {
+    unusedVars(userPtr);
+    for (;;) {
+        os_fiberYield();
+    }
+}
+
+static void test_fiberGuard(void* userPtr) {
+    // the page right below the stack is the guard page
+    ((volatile u8*) userPtr)[-1] = 1;
+}
+
+static i32 test_fiberThread(os_Thread* thread, void* userData) {
+    unusedVars(thread);
+    os_Fiber* fiber = (os_Fiber*) userData;
+    os_fiberResume(fiber);
+    return 0;
+}
+
+static void test_fiber(Arena* arena) {
+    os_FiberStackPool pool;
+    ASSERT(os_fiberStackPoolInit(&pool, arena, 4, KILOBYTE(64)));
+    ASSERT(pool.stackSize >= KILOBYTE(64) && pool.stackSize % os_memoryPageSize() == 0);
+    void* stacks[5];
+    for (u32 idx = 0; idx < countOf(stacks); idx++) {
+        stacks[idx] = os_fiberStackAcquire(&pool);
+    }
+    ASSERT(stacks[0] && stacks[1] && stacks[2] && stacks[3] && !stacks[4]);
+    for (u32 idx = 0; idx < 4; idx++) {
+        ASSERT((u64_cast(stacks[idx]) & (os_memoryPageSize() - 1)) == 0);
+        os_fiberStackRelease(&pool, stacks[idx]);
+    }
+    void* stack = os_fiberStackAcquire(&pool);
+    void* otherStack = os_fiberStackAcquire(&pool);
+
+    // resume runs the fiber until it yields or returns
+    os_Fiber fiber;
+    test_FiberState state = {0};
+    state.yieldCount = 3;
+    os_fiberInit(&fiber, test_fiberOrder, stack, pool.stackSize, &state);
+    ASSERT(!os_fiberIsDone(&fiber) && state.stepCount == 0);
+    u32 resumeCount = 0;
+    while (!os_fiberIsDone(&fiber)) {
+        os_fiberResume(&fiber);
+        resumeCount++;
+        ASSERT(state.stepCount == resumeCount);
+    }
+    ASSERT(resumeCount == 4);
+    ASSERT(state.steps[0] == 100 && state.steps[1] == 101 && state.steps[2] == 102 && state.steps[3] == 200);
+
+    // two fibers interleave, each keeps its own stack
+    os_Fiber other;
+    test_FiberState otherState = {0};
+    otherState.yieldCount = 1;
+    os_fiberInit(&fiber, test_fiberOrder, stack, pool.stackSize, &state);
+    os_fiberInit(&other, test_fiberOrder, otherStack, pool.stackSize, &otherState);
+    state.stepCount = 0;
+    os_fiberResume(&fiber);
+    os_fiberResume(&other);
+    os_fiberResume(&other);
+    ASSERT(os_fiberIsDone(&other) && !os_fiberIsDone(&fiber));
+    ASSERT(otherState.stepCount == 2 && otherState.steps[1] == 200 && state.stepCount == 1);
+    while (!os_fiberIsDone(&fiber)) {
+        os_fiberResume(&fiber);
+    }
+    ASSERT(state.stepCount == 4 && state.steps[3] == 200);
+
+    // callee saved registers and the float control word survive switches in both directions
+    test_FiberState regState = {0};
+    regState.yieldCount = 16;
+    regState.seed = u64_cast(&regState);
+    os_fiberInit(&fiber, test_fiberRegisters, stack, pool.stackSize, &regState);
+    {
+        volatile u64 seed = regState.seed;
+        u64 a = seed * 3, b = seed * 5, c = seed * 7, d = seed * 9, e = seed * 11;
+        f64 x = (f64) seed * 0.125;
+#if ARCH_X64
+        u32 mxcsr = test_fiberMxcsr();
+#endif
+        bx ok = true;
+        while (!os_fiberIsDone(&fiber)) {
+            __asm__ volatile("" : "+r"(a), "+r"(b), "+r"(c), "+r"(d), "+r"(e));
+            os_fiberResume(&fiber);
+            __asm__ volatile("" : "+r"(a), "+r"(b), "+r"(c), "+r"(d), "+r"(e));
+            ok = ok && a == seed * 3 && b == seed * 5 && c == seed * 7 && d == seed * 9 && e == seed * 11;
+            ok = ok && x == (f64) seed * 0.125;
+#if ARCH_X64
+            ok = ok && test_fiberMxcsr() == mxcsr;
+#endif
+            TEST_FIBER_TRASH_REGISTERS();
+        }
+        ASSERT(ok);
+    }
+    ASSERT(regState.registersOk);
+
+    // a yielded fiber continues on another thread
+    state.stepCount = 0;
+    state.yieldCount = 3;
+    os_fiberInit(&fiber, test_fiberOrder, stack, pool.stackSize, &state);
+    os_fiberResume(&fiber);
+    while (!os_fiberIsDone(&fiber)) {
+        os_Thread thread;
+        ASSERT(os_threadCreate(&thread, test_fiberThread, &fiber, 0, s8("fiber")));
+        os_threadShutdown(&thread);
+    }
+    ASSERT(os_fiberIsDone(&fiber) && state.stepCount == 4 && state.steps[2] == 102 && state.steps[3] == 200);
+
+    // an overflow faults on the guard page instead of writing into the neighbouring stack
+    pid_t pid = fork();
+    ASSERT(pid >= 0);
+    if (pid == 0) {
+        // no sanitizer or debugger handler, the child should die from the fault
+        signal(SIGSEGV, SIG_DFL);
+        signal(SIGBUS, SIG_DFL);
+        os_fiberInit(&fiber, test_fiberGuard, otherStack, pool.stackSize, otherStack);
+        os_fiberResume(&fiber);
+        _exit(0);
+    }
+    i32 status = 0;
+    ASSERT(waitpid(pid, &status, 0) == pid);
+    ASSERT(WIFSIGNALED(status) && (WTERMSIG(status) == SIGSEGV || WTERMSIG(status) == SIGBUS));
+
+    // one resume plus one yield are two switches
+    os_fiberInit(&fiber, test_fiberEmpty, stack, pool.stackSize, NULL);
+    u32 switchCount = 1000000;
+    u64 start = os_timeMicrosecondsNow();
+    for (u32 idx = 0; idx < switchCount / 2; idx++) {
+        os_fiberResume(&fiber);
+    }
+    u64 elapsedUs = os_timeMicrosecondsNow() - start;
+    f64 nsPerSwitch = (f64) elapsedUs * 1000.0 / (f64) switchCount;
+    printf("os fiber switch %.1f ns\n", nsPerSwitch);
+
+    os_fiberStackRelease(&pool, otherStack);
+    os_fiberStackRelease(&pool, stack);
+    os_fiberStackPoolDestroy(&pool);
+    printf("os fiber ok\n");
+}
+#endif
+
+i32 main(i32 argc, char* argv[]) {
+    BaseMemory baseMem = os_getBaseMemory();
+    Arena* arena = mem_makeArena(&baseMem, MEGABYTE(64));
+    test_fixFilepath(arena);
+#if !OS_WIN
+    test_pathList(arena);
+#endif
+#if OS_LINUX
+    test_fsWatch(arena);
+#endif
+#if !OS_WIN
+    test_fiber(arena);
+#endif
+    mem_destroyArena(arena);
+    return 0;
+}
@@ -0,0 +1,131 @@
+#include "base/base.h"
+#include "base/base_types.h"
+#include "base/base_mem.h"
+#include "base/base_str.h"
+#include "base/base_time.h"
+#include "base/base_rope.h"
+
+#include <stdio.h>
+#include <string.h>
+
+////////////////////////////
+// NOTE(pjako): random edits checked against a flat buffer, plus edit throughput on a large text
+
+static u64 test__rngState = u64_val(0x9e3779b97f4a7c15);
+
+static u64 test_rand(void) {
+    // splitmix64
+    u64 z = (test__rngState += u64_val(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * u64_val(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * u64_val(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+static void test_fillText(u8* data, u64 size) {
+    for (u64 i = 0; i < size; i++) {
+        u64 r = test_rand() % 32;
+        data[i] = r == 0 ? '\n' : u8_cast('a' + r % 26);
+    }
+}
+
+static void test_checkAgainst(rope_Rope* rope, Arena* arena, const u8* reference, u64 size) {
+    ASSERT(rope_size(rope) == size);
+    S8 flat = rope_toStr(arena, rope, 0, size);
+    ASSERT(memcmp(flat.content, reference, size) == 0);
+
+    u64 iterated = 0;
+    rope_forEachSpan(rope, 0, size, it) {
+        ASSERT(it.span.size > 0);
+        ASSERT(memcmp(it.span.content, reference + iterated, it.span.size) == 0);
+        iterated += it.span.size;
+    }
+    ASSERT(iterated == size);
+
+    u64 line = 0;
+    u64 lineStart = 0;
+    for (u64 i = 0; i <= size; i++) {
+        if (i < size) {
+            ASSERT(rope_lineFromOffset(rope, i) == line);
+            ASSERT(rope_charAt(rope, i) == reference[i]);
+        }
+        if (i == size || reference[i] == '\n') {
+            ASSERT(rope_lineStart(rope, line) == lineStart);
+            line++;
+            lineStart = i + 1;
+        }
+    }
+    ASSERT(rope_lineCount(rope) == line);
+    ASSERT(rope_lineStart(rope, line) == size);
+}
+
+static void test_randomEdits(Arena* arena) {
+    u64 capacity = 1 << 16;
+    u8* reference = (u8*) mem_arenaPush(arena, capacity);
+    u8* insert = (u8*) mem_arenaPush(arena, 4096);
+    u64 size = 5000;
+    test_fillText(reference, size);
+    u8* original = (u8*) mem_arenaPush(arena, size);
+    mem_copy(original, reference, size);
+    rope_Rope rope = rope_init(arena, str_fromCharPtr(original, size));
+    test_checkAgainst(&rope, arena, reference, size);
+
+    for (u32 round = 0; round < 2000; round++) {
+        u64 offset = test_rand() % (size + 1);
+        if (test_rand() % 3 != 0 && size + 4096 < capacity) {
+            u64 count = test_rand() % 64 == 0 ? test_rand() % 4096 : test_rand() % 16;
+            test_fillText(insert, count);
+            rope_insert(&rope, offset, str_fromCharPtr(insert, count));
+            memmove(reference + offset + count, reference + offset, size - offset);
+            mem_copy(reference + offset, insert, count);
+            size += count;
+        } else {
+            u64 count = test_rand() % 300;
+            count = minVal(count, size - offset);
+            rope_delete(&rope, offset, count);
+            memmove(reference + offset, reference + offset + count, size - offset - count);
+            size -= count;
+        }
+        if (round % 100 == 0) {
+            test_checkAgainst(&rope, arena, reference, size);
+        }
+    }
+    test_checkAgainst(&rope, arena, reference, size);
+
+    S8 sub = rope_toStr(arena, &rope, size / 3, size / 3);
+    ASSERT(memcmp(sub.content, reference + size / 3, size / 3) == 0);
+    printf("rope random edits ok, final size %llu lines %llu\n", (unsigned long long) size, (unsigned long long) rope_lineCount(&rope));
+}
+
+static void test_benchmark(Arena* arena) {
+    tm_FrequencyInfo freq = tm_getPerformanceFrequency();
+    u64 size = MEGABYTE(32);
+    u8* text = (u8*) mem_arenaPush(arena, size);
+    test_fillText(text, size);
+    rope_Rope rope = rope_init(arena, str_fromCharPtr(text, size));
+    u32 edits = 100000;
+    u64 start = tm_currentCount();
+    for (u32 i = 0; i < edits; i++) {
+        u64 offset = test_rand() % rope_size(&rope);
+        if (i & 1) {
+            rope_insert(&rope, offset, str_lit("edit"));
+        } else {
+            rope_delete(&rope, offset, 3);
+        }
+    }
+    f64 editNs = tm_countToNanoSeconds(tm_countToNanoseconds(freq, i64_cast(tm_currentCount() - start))) / edits;
+    start = tm_currentCount();
+    u64 sum = 0;
+    for (u32 i = 0; i < edits; i++) {
+        sum += rope_lineStart(&rope, test_rand() % rope_lineCount(&rope));
+    }
+    f64 lineNs = tm_countToNanoSeconds(tm_countToNanoseconds(freq, i64_cast(tm_currentCount() - start))) / edits;
+    printf("rope 32MB: %.1f ns/edit, %.1f ns/line lookup (%llu)\n", editNs, lineNs, (unsigned long long) (sum & 1));
+}
+
+i32 main(i32 argc, char* argv[]) {
+    BaseMemory baseMem = mem_getMallocBaseMem();
+    Arena* arena = mem_makeArena(&baseMem, MEGABYTE(512));
+    test_randomEdits(arena);
+    test_benchmark(arena);
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include "base/base.h"
+#include "base/base_types.h"
+#include "base/base_mem.h"
+#include "base/base_str.h"
+#include "base/base_str.hpp"
+
+#include <stdio.h>
+
+////////////////////////////
+// NOTE(pjako): base_str.hpp against the C functions it mirrors
+
+static constexpr auto test_keywords = str_perfectHashT("float", "float2", "float3", "int", "uint", "bool", "struct", "return");
+
+// indexOf is a constant expression, so it can be used as a case label
+static_assert(test_keywords.count == 8, "str_perfectHashT count");
+static_assert(test_keywords.indexOf("float") == 0, "str_perfectHashT indexOf");
+static_assert(test_keywords.indexOf("float3") == 2, "str_perfectHashT indexOf");
+static_assert(test_keywords.indexOf("return") == 7, "str_perfectHashT indexOf");
+
+static void test_perfectHashT(Arena* arena) {
+    S8 keys[] = {s8("float"), s8("float2"), s8("float3"), s8("int"), s8("uint"), s8("bool"), s8("struct"), s8("return")};
+    mem_scoped(scratch, arena) {
+        str_PerfectHash table;
+        ASSERT(str_perfectHashBuild(scratch.arena, keys, countOf(keys), &table));
+        ASSERT(table.count == test_keywords.count && table.bucketCount == test_keywords.bucketCount);
+        // same scheme, so the same seeds and slots
+        for (u32 idx = 0; idx < table.bucketCount; idx++) {
+            ASSERT(table.seeds[idx] == test_keywords.seeds[idx]);
+        }
+        for (u32 idx = 0; idx < table.count; idx++) {
+            ASSERT(table.indices[idx] == test_keywords.indices[idx]);
+        }
+        for (u32 idx = 0; idx < countOf(keys); idx++) {
+            ASSERT(test_keywords.find(keys[idx]) == idx);
+            ASSERT(str_perfectHashFind(&table, keys[idx]) == idx);
+        }
+        S8 misses[] = {s8("floa"), s8("float4"), s8("Int"), s8(""), s8("structs")};
+        for (u32 idx = 0; idx < countOf(misses); idx++) {
+            ASSERT(test_keywords.find(misses[idx]) == test_keywords.count);
+            ASSERT(str_perfectHashFind(&table, misses[idx]) == table.count);
+        }
+
+        switch (test_keywords.find(s8("uint"))) {
+            case test_keywords.indexOf("uint"): break;
+            default: ASSERT(!"str_perfectHashT switch");
+        }
+    }
+    printf("str perfect hash T ok\n");
+}
+
+static S8 test_customWriter(Arena* recordArena, S8 fmtInfo, void* userPtr) {
+    u32 value = *(u32*) userPtr;
+    return str_join(recordArena, s8("<"), value, s8(">"));
+}
+
+static void test_fmtT(Arena* arena) {
+    S8 name = s8("Foo");
+    const char* prefix = "rx_";
+    char c = 'x';
+    i32 negative = -42;
+    u32 count = 7;
+    i64 big = -9000000000ll;
+    u64 bigU = 18000000000000000000ull;
+    f32 half = 0.5f;
+    f64 third = 1.0 / 3.0;
+    u32 customValue = 9;
+    str_CustomVal custom = {&customValue, test_customWriter};
+    mem_scoped(scratch, arena) {
+        ASSERT(str_isEqual(str_fmtT(scratch.arena, "typedef struct {0}{1} {{", prefix, name), str_fmt(scratch.arena, s8("typedef struct {0}{1} {{"), prefix, name)));
+        ASSERT(str_isEqual(str_fmtT(scratch.arena, "{} {} {} {}", negative, count, big, bigU), str_fmt(scratch.arena, s8("{} {} {} {}"), negative, count, big, bigU)));
+        ASSERT(str_isEqual(str_fmtT(scratch.arena, "{}|{}|{}", half, third, c), str_fmt(scratch.arena, s8("{}|{}|{}"), half, third, c)));
+        ASSERT(str_isEqual(str_fmtT(scratch.arena, "{1}-{0}-{1}", count, name), str_fmt(scratch.arena, s8("{1}-{0}-{1}"), count, name)));
+        ASSERT(str_isEqual(str_fmtT(scratch.arena, "}}{{ {} }}", custom), str_fmt(scratch.arena, s8("}}{{ {} }}"), custom)));
+        ASSERT(str_isEqual(str_fmtT(scratch.arena, "no args"), s8("no args")));
+        ASSERT(str_isEqual(str_fmtT(scratch.arena, "{}", custom), s8("<9>")));
+
+        ASSERT(str_isEqual(str_joinT(scratch.arena, name, negative, c, count), str_join(scratch.arena, name, negative, c, count)));
+        ASSERT(str_isEqual(str_joinT(scratch.arena, big, s8(" "), bigU, s8(" "), half, s8(" "), third), str_join(scratch.arena, big, s8(" "), bigU, s8(" "), half, s8(" "), third)));
+        ASSERT(str_isEqual(str_joinT(scratch.arena, name, custom), str_join(scratch.arena, name, custom)));
+        ASSERT(str_isEqual(str_joinT(scratch.arena, prefix, name), s8("rx_Foo")));
+    }
+    printf("str fmt T ok\n");
+}
+
+i32 main(i32 argc, char* argv[]) {
+    BaseMemory baseMem = mem_getMallocBaseMem();
+    Arena* arena = mem_makeArena(&baseMem, MEGABYTE(16));
+
+    test_fmtT(arena);
+    test_perfectHashT(arena);
+
+    mem_destroyArena(arena);
+    return 0;
+}
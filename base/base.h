@@ -115,6 +115,40 @@
 #error "Unknown CPU architecture"
 #endif
 
+////////////////////////////////
+// NOTE(pjako): SIMD instruction sets enabled at compile time
+// SSE2 and NEON are part of the x64/arm64 baseline, everything else depends on the compiler flags (e.g. -march=native)
+#define SIMD_SSE2 0
+#define SIMD_SSSE3 0
+#define SIMD_SSE42 0
+#define SIMD_AVX2 0
+#define SIMD_NEON 0
+#define SIMD_ARM_CRC 0
+
+#if ARCH_X64
+#undef SIMD_SSE2
+#define SIMD_SSE2 1
+#if defined(__SSSE3__) || defined(__AVX__)
+#undef SIMD_SSSE3
+#define SIMD_SSSE3 1
+#endif
+#if defined(__SSE4_2__) || defined(__AVX__)
+#undef SIMD_SSE42
+#define SIMD_SSE42 1
+#endif
+#if defined(__AVX2__)
+#undef SIMD_AVX2
+#define SIMD_AVX2 1
+#endif
+#elif ARCH_ARM64
+#undef SIMD_NEON
+#define SIMD_NEON 1
+#if defined(__ARM_FEATURE_CRC32) || defined(_M_ARM64)
+#undef SIMD_ARM_CRC
+#define SIMD_ARM_CRC 1
+#endif
+#endif
+
 #define INLINE static inline
 #if COMPILER_MSVC
 #define FORCE_INLINE static __forceinline
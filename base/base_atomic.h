@@ -13,6 +13,14 @@
 #define a64_compareAndSwap(dst, expected, desired) ((u64) _InterlockedCompareExchange64((volatile long long*)dst, (long long)desired, (long long)expected))
 #define a32_loadAcquire(VALPTR) InterlockedOr(VALPTR, 0)
 #define a64_loadAcquire(VALPTR) InterlockedOr64(VALPTR, 0)
+// plain volatile stores are only ordered with /volatile:ms, which is not the default on ARM64
+#if defined(_M_ARM64)
+#define a32_storeRelease(VALPTR, VAL) __stlr32((unsigned __int32 volatile*) (VALPTR), (u32) (VAL))
+#define a64_storeRelease(VALPTR, VAL) __stlr64((unsigned __int64 volatile*) (VALPTR), (u64) (VAL))
+#else
+#define a32_storeRelease(VALPTR, VAL) ((void) _InterlockedExchange((volatile long*) (VALPTR), (long) (VAL)))
+#define a64_storeRelease(VALPTR, VAL) ((void) _InterlockedExchange64((volatile long long*) (VALPTR), (long long) (VAL)))
+#endif
 
 #define a32_add(dst, val) _InterlockedExchangeAdd((a32*) dst, (u32) val)
 #define a64_add(dst, val) _InterlockedExchangeAdd64((a64*) dst, (u32) val)
@@ -39,6 +47,8 @@
 #define a64_compareAndSwap(dst, expected, desired)      ((u64) __sync_val_compare_and_swap(dst, expected, desired))
 #define a32_loadAcquire(VALPTR)  __atomic_load_n(VALPTR, __ATOMIC_SEQ_CST)
 #define a64_loadAcquire(VALPTR)  __atomic_load_n(VALPTR, __ATOMIC_SEQ_CST)
+#define a32_storeRelease(VALPTR, VAL) __atomic_store_n(VALPTR, (u32) (VAL), __ATOMIC_RELEASE)
+#define a64_storeRelease(VALPTR, VAL) __atomic_store_n(VALPTR, (u64) (VAL), __ATOMIC_RELEASE)
 #define a32_add(dst, val) __atomic_fetch_add((u32*) dst, (u32) val, __ATOMIC_SEQ_CST)
 #define a64_add(dst, val) __atomic_fetch_add((u64*) dst, (u64) val, __ATOMIC_SEQ_CST)
 
@@ -0,0 +1,26 @@
+#ifndef _BASE_CHECKSUM_
+#define _BASE_CHECKSUM_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#pragma mark - CRC32C
+
+// CRC-32C (Castagnoli), uses the SSE4.2/ARMv8 crc instructions when available and slicing-by-8 otherwise
+// chk_crc32c("123456789") == 0xE3069283
+API u32 chk_crc32c(const void* data, u64 size);
+// continue a running checksum: chk_crc32cUpdate(chk_crc32c(a), b) == chk_crc32c(a .. b), start with 0
+API u32 chk_crc32cUpdate(u32 crc, const void* data, u64 size);
+#define chk_crc32cStr(STR) chk_crc32c((STR).content, (STR).size)
+
+#pragma mark - content hash
+
+// 64 bit content hash for integrity checks and content addressing (pack files, shader caches, persisted arenas)
+// same value as str_hash64Seed, use str_HashStream to hash the content incrementally
+API u64 chk_contentHash64(const void* data, u64 size, u64 seed);
+#define chk_contentHash64Str(STR) chk_contentHash64((STR).content, (STR).size, 0)
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif // _BASE_CHECKSUM_
@@ -11,6 +11,7 @@ extern "C" {
 #define mem_arrSetZero(PTR, COUNT) mem_setZero((PTR), sizeof((PTR)[0]) * (COUNT))
 
 #define mem_copy(TO, FROM, SIZE) memcpy(TO, FROM, SIZE)
+#define mem_move(TO, FROM, SIZE) memmove(TO, FROM, SIZE)
 
 
 typedef void* (mem_reserveFunc)(void* ctx, u64 size);
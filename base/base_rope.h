@@ -0,0 +1,64 @@
+#ifndef _BASE_ROPE_
+#define _BASE_ROPE_
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Piece tree for large editable texts (live shader editing, config files, generated sources).
+// The text is a sequence of pieces (views into the original text or into inserted text copied to the arena)
+// kept in a balanced tree that tracks byte and line break counts, so edits and line lookups are O(log n)
+// instead of a full copy per edit. Deleted text is not reclaimed until the arena is reset.
+
+#pragma mark - rope
+
+typedef struct rope__Node rope__Node;
+
+typedef struct rope_Rope {
+    Arena* arena;
+    rope__Node* root;
+    rope__Node* freeNodes;
+    u64 seed;
+} rope_Rope;
+
+// text is referenced, not copied, and has to outlive the rope
+API rope_Rope rope_init(Arena* arena, S8 text);
+// text is copied into the rope arena, offset is clamped to the rope size
+API void rope_insert(rope_Rope* rope, u64 offset, S8 text);
+API void rope_delete(rope_Rope* rope, u64 offset, u64 size);
+API void rope_replace(rope_Rope* rope, u64 offset, u64 size, S8 text);
+
+API u64 rope_size(rope_Rope* rope);
+API u8  rope_charAt(rope_Rope* rope, u64 offset);
+
+#pragma mark - lines
+
+// lines are separated by '\n', a text without line breaks has one line
+API u64 rope_lineCount(rope_Rope* rope);
+// byte offset of the first char of line (0 based), rope_size for lines past the end
+API u64 rope_lineStart(rope_Rope* rope, u64 line);
+// line (0 based) that contains the byte at offset
+API u64 rope_lineFromOffset(rope_Rope* rope, u64 offset);
+
+#pragma mark - iteration
+
+typedef struct rope_Iter {
+    rope_Rope* rope;
+    u64 offset;
+    u64 end;
+    S8 span;
+} rope_Iter;
+
+// iterates the range piece by piece, every rope_iterNext sets iter.span to the next contiguous view
+API rope_Iter rope_iter(rope_Rope* rope, u64 offset, u64 size);
+API bx rope_iterNext(rope_Iter* iter);
+
+// Usage: rope_forEachSpan(&rope, 0, rope_size(&rope), it) { os_log(it.span); }
+#define rope_forEachSpan(ROPE, OFFSET, SIZE, ITER) for (rope_Iter ITER = rope_iter((ROPE), (OFFSET), (SIZE)); rope_iterNext(&ITER);)
+
+// copies the range into one contiguous string
+API S8 rope_toStr(Arena* arena, rope_Rope* rope, u64 offset, u64 size);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+#endif // _BASE_ROPE_
@@ -30,16 +30,18 @@ API str_handle str_poolInject(str_Pool* pool, S8 str);
 API S8 str_poolGet(str_Pool* pool, str_handle handle);
 #endif
 
+// chunk of a str_Builder, the content lives in the builder arena and never moves
 typedef struct str__BuilderBlock {
-    struct str__BuilderBlock* prev;
     struct str__BuilderBlock* next;
     S8 str;
+    u64 capacity;
 } str__BuilderBlock;
 typedef struct str_Builder {
     Arena* arena;
-    u64 arenaLastOffset;
+    u64 arenaLastOffset;   // arena pos after the last append, if nothing else was pushed since the last block can grow in place
     u64 blockDefaultSize;
     u64 totalStringSize;
+    u32 blockCount;
     str__BuilderBlock* firstBlock;
     str__BuilderBlock* lastBlock;
 } str_Builder;
@@ -69,8 +71,11 @@ API S8 str_copy(Arena* arena, S8 sourceStr);
 API S8 str_copyNullTerminated(Arena* arena, S8 str);
 
 
+// ascii case conversion in place (the content of str is modified) or into a copy, other bytes are left alone
 API S8 str_toLowerAscii(S8 str);
 API S8 str_toUpperAscii(S8 str);
+API S8 str_copyLowerAscii(Arena* arena, S8 str);
+API S8 str_copyUpperAscii(Arena* arena, S8 str);
 API S8 str_subStr(S8 str, u64 start, u64 size);
 API S8 str_from(S8 str, u64 from);
 API S8 str_to(S8 str, u64 to);
@@ -78,8 +83,12 @@ API S8 str_to(S8 str, u64 to);
 // returns the ut8 length of the string
 API u64  str_length(S8 str);
 
+// the N variants return the amount of characters consumed, 0 when str doesn't start with a number
+// floats are correctly rounded and accept exponents, inf and nan, integers are clamped to the type range
 API f32  str_parseF32 (S8 str);
 API u64  str_parseF32N(S8 str, f32* f32);
+API f64  str_parseF64 (S8 str);
+API u64  str_parseF64N(S8 str, f64* f64);
 API i64  str_parseS64 (S8 str);
 API u64  str_parseS64N(S8 str, i64* i64);
 API u32  str_parseU32 (S8 str);
@@ -89,12 +98,21 @@ API S8 str_parseQuotedStr(S8 str);
 
 API i64  str_find(S8 str, S8 findExp);
 API i64  str_findChar(S8 str, char c);
+// index of the first c/'\n' or '\r' at or after offset, str.size if there is none. Scans 32 bytes per step.
+API u64  str_findNextChar(S8 str, u64 offset, u8 c);
+API u64  str_findNextLineBreak(S8 str, u64 offset);
 API i64  str_lastIndexOfChar(S8 str, char c);
 API bx str_hasPrefix(S8 str, S8 prefix);
 API bx   str_hasSuffix(S8 str, S8 endsWith);
 API bool str_startsWithChar(S8 str, char startChar);
 API bool str_isEqual(S8 left, S8 right);
+// ascii case insensitive, bytes outside of A-Z/a-z have to match exactly
+API bx   str_isEqualNoCase(S8 left, S8 right);
+API bx   str_hasPrefixNoCase(S8 str, S8 prefix);
+API bx   str_hasSuffixNoCase(S8 str, S8 suffix);
+// whitespace is ' ', '\t', '\n', '\v', '\f' and '\r', an empty string counts as whitespace
 API bool str_isWhiteSpace(S8 str);
+// index of the first char that is not whitespace, -1 if there is none
 API i64  str_firstNonWhiteSpace(S8 str);
 API S8 str_skipWhiteSpace(S8 str);
 
@@ -115,6 +133,89 @@ API u64 str_findFirst(S8 str, S8 findStr, u64 offset);
 API u64 str_findLast(S8 str, S8 findStr, u64 offset);
 API S8 str_replaceAll(Arena* arena, S8 str, S8 replaceStr, S8 replacement);
 
+#pragma mark - Multi pattern search
+
+// Aho-Corasick automaton, built once into an arena and then used for any number of single pass searches over many patterns.
+// Bytes that no pattern uses share one class, so the table is stateCount * classCount instead of stateCount * 256.
+// Outside of a partial match the input is skipped 16 bytes at a time to the next byte that can start a pattern.
+typedef struct str_Matcher {
+    u32* transitions;   // stateCount * classCount, failure links are already resolved
+    u32* output;        // per state: index + 1 of the longest pattern ending in the state, 0 for none
+    u32* depth;         // per state: length of the prefix the state stands for
+    u32* patternSize;
+    u32 stateCount;
+    u32 classCount;
+    u32 patternCount;
+    u32 firstByteCount; // distinct bytes a pattern can start with
+    u8 firstBytes[4];   // compared directly when there are at most four first bytes
+    u8 firstNibbleMask[16]; // nibble table otherwise: low nibble -> bit (high nibble & 7) per first byte
+    u8 byteClass[256];
+} str_Matcher;
+
+typedef struct str_Match {
+    u64 offset;
+    u64 size;
+    u32 pattern;
+} str_Match;
+
+// pattern contents are not referenced after init, empty patterns never match, for duplicates the first one wins
+API str_Matcher* str_matcherInit(Arena* arena, S8* patterns, u32 patternCount);
+// leftmost match at or after offset, the longest pattern if several start at the same position
+API bx str_matcherFind(str_Matcher* matcher, S8 str, u64 offset, str_Match* outMatch);
+// replaces non overlapping matches from left to right with replacements[match.pattern], returns str if nothing matched
+API S8 str_matcherReplace(Arena* arena, str_Matcher* matcher, S8 str, S8* replacements);
+
+#pragma mark - Glob patterns
+
+// Path patterns compiled into a bit parallel automaton, matching is two table lookups per path byte.
+// '*' matches inside of a segment, '**' across segments ("**/" also matches no directory), '?' one char but '/',
+// "[a-z_]" / "[!.]" a char class and '\' escapes the next char. Patterns without a '/' match the last segment only.
+// Leading directories without wildcards are split off into prefix so a directory walk can start there.
+#define STR_GLOB_MAX_ELEMENTS 63
+
+typedef struct str_Glob {
+    u64 accept[256];    // per byte: elements that consume it and move on
+    u64 loop[256];      // per byte: '*' and '**' elements that consume it and stay
+    u64 skip1;          // elements that may match nothing
+    u64 skip2;          // "**/" elements, skipping them also skips their '/'
+    S8  prefix;         // literal leading directories including the trailing '/'
+    u32 elementCount;
+    bx  nameOnly;
+} str_Glob;
+
+// NULL for unterminated char classes and patterns with more than STR_GLOB_MAX_ELEMENTS elements after the prefix
+API str_Glob* str_globCompile(Arena* arena, S8 pattern);
+// path uses '/' separators and is relative to the same directory as the pattern
+API bx str_globMatch(const str_Glob* glob, S8 path);
+// false when no path below directory can match, lets a directory walk skip the whole subtree
+API bx str_globCanMatchBelow(const str_Glob* glob, S8 directory);
+
+#pragma mark - Line, field and token iteration
+
+// Splits str into views without allocating, the separators are found 32 bytes at a time.
+// Lines end at '\n' (a '\r' in front of it is dropped), a trailing line break does not start another line.
+// Fields are separated by delimiter and lines (no quoting), tokens by any whitespace.
+// line is the 1 based line of the current piece, endOfLine is set when it is the last field/token of its line.
+typedef struct str_Splitter {
+    S8 str;
+    u64 offset;
+    u64 nextLine;
+    u64 line;
+    S8 piece;
+    bx endOfLine;
+    u8 delimiter;
+} str_Splitter;
+
+API str_Splitter str_splitter(S8 str, u8 delimiter);
+API bx str_nextLine(str_Splitter* splitter);
+API bx str_nextField(str_Splitter* splitter);
+API bx str_nextToken(str_Splitter* splitter);
+
+// Usage: str_forEachLine(text, it) { log_info("line ", it.line, ": ", it.piece); }
+#define str_forEachLine(STR, ITER) for (str_Splitter ITER = str_splitter((STR), '\n'); str_nextLine(&ITER);)
+#define str_forEachField(STR, DELIMITER, ITER) for (str_Splitter ITER = str_splitter((STR), (DELIMITER)); str_nextField(&ITER);)
+#define str_forEachToken(STR, ITER) for (str_Splitter ITER = str_splitter((STR), ' '); str_nextToken(&ITER);)
+
 #pragma mark - UTF-8 functions
 
 API u64 str_utf8Count(S8 str);
@@ -124,19 +225,76 @@ typedef struct str_StringDecode {
     u32 size;
 } str_StringDecode;
 
+// decodes one code point, invalid or truncated sequences decode to '#' with a size of 1
 API str_StringDecode str_decodeUtf8(u8* str, u64 cap);
 
+// returns the index of the first byte that is not part of a valid utf8 sequence, str.size if the whole string is valid
+API u64 str_utf8Validate(S8 str);
+API bx  str_utf8IsValid(S8 str);
+
+typedef struct str_Transcode {
+    u64 size;       // code units written to the output
+    u64 errorIndex; // input index of the first invalid code unit, equals the input size on success
+} str_Transcode;
+
+#define str_transcodeOk(TRANSCODE, INPUT) ((TRANSCODE).errorIndex == (INPUT).size)
+
+// required output size in code units for valid input
+API u64 str_utf16SizeFromUtf8(S8 str);
+API u64 str_utf8SizeFromUtf16(S16 str);
+
+// out needs room for str.size code units, stops at the first invalid sequence
+API str_Transcode str_utf8ToUtf16(S8 str, u16* out);
+API str_Transcode str_utf8ToUtf32(S8 str, u32* out);
+// out needs room for str.size * 3 bytes, stops at the first unpaired surrogate
+API str_Transcode str_utf16ToUtf8(S16 str, u8* out);
+
+// shortest digits that parse back to the same value (1e-7 < |v| < 1e21 in fixed notation, scientific otherwise)
+// writes at most STR_FLOAT_MAX_CHARS, no null terminator, returns the written size
+#define STR_FLOAT_MAX_CHARS 32
+API u64 str_f32ToChars(f32 value, u8* out);
+API u64 str_f64ToChars(f64 value, u8* out);
+// out needs 20 (u64) or 21 (i64) bytes
+API u64 str_u64ToChars(u64 value, u8* out);
+API u64 str_i64ToChars(i64 value, u8* out);
+
 // limited to 15 fraction digits
 // Store value needs to b at least 15+fracDigits+2 in size
 API S8 str_floatToStr(f64 value, S8 storeStr, i32* decimalPos, i32 fracDigits);
 API S8 str_u32ToHex(Arena* arena, u32 value);
 
+#pragma mark - Binary to text
+
+// bulk encoders write to out without a terminator and return the written size, hex digits are upper case like str_u32ToHex
+#define STR_BASE64_ENCODED_SIZE(SIZE) (((SIZE) + 2) / 3 * 4)
+API u64 str_hexEncodeInto(u8* out, S8 data);
+API S8  str_hexEncode(Arena* arena, S8 data);
+// accepts both cases, fails on odd sizes and anything that is not a hex digit
+API bx  str_hexDecode(Arena* arena, S8 hex, S8* outData);
+API u64 str_base64EncodeInto(u8* out, S8 data);
+API S8  str_base64Encode(Arena* arena, S8 data);
+// standard alphabet with '=' padding, no line breaks or whitespace
+API bx  str_base64Decode(Arena* arena, S8 text, S8* outData);
+// body of a C array initializer: data is read as little endian elements of elementSize (1, 2, 4 or 8) bytes written as
+// fixed width "0x.." literals, elementsPerLine per line and every line starts with indent. No separator after the last element.
+API S8 str_cArrayLiteral(Arena* arena, S8 data, u32 elementSize, u32 elementsPerLine, S8 indent);
+
 API S8  str_fromCharPtr(u8* str, u64 size);
 API S8  str_fromNullTerminatedCharPtr(char* str);
 
+#pragma mark - Escaping
+
+// Both push the result in one contiguous run, so they can write straight into a str_record.
+// The runs that need no escaping are found 32 bytes at a time and copied as they are.
+// '"', '\\' and control chars escaped for a JSON string (\n, \t, \u001B ...), the quotes are not added
+API S8 str_escapeJson(Arena* arena, S8 str);
+// a logfmt value: as is without space, '=', '"', '\\' and control chars, quoted and escaped like JSON otherwise
+API S8 str_escapeLogfmt(Arena* arena, S8 str);
+
 
 #pragma mark - Utf8 to Utf16
 
+// results are null terminated (terminator not part of size), invalid sequences are replaced with '#'
 API S16 str_toS16(Arena* arena, S8 str);
 API S32 str_toS32(Arena *arena, S8 str);
 API S8  str_fromS16(Arena* arena, S16 str);
@@ -144,8 +302,93 @@ API S8  str_fromS16(Arena* arena, S16 str);
 
 #pragma mark - hash
 
+// wyhash based, fast and well distributed, use the seeded variants for hash tables exposed to untrusted input
 API u32 str_hash32(S8 str);
 API u64 str_hash64(S8 str);
+API u64 str_hash64Seed(S8 str, u64 seed);
+// hash of the ascii lower cased string, for case insensitive keys
+API u32 str_hash32NoCase(S8 str);
+API u64 str_hash64NoCase(S8 str);
+
+typedef struct str_Hash128 {
+    u64 low;
+    u64 high;
+} str_Hash128;
+
+// low is identical to str_hash64Seed with the same seed
+API str_Hash128 str_hash128(S8 str, u64 seed);
+
+// incremental hashing, produces the same results as the one shot functions for the concatenated input
+typedef struct str_HashStream {
+    u64 seed;
+    u64 lanes[3];
+    u64 size;
+    u32 bufferSize;
+    u8  buffer[48];
+    u8  lastBlockTail[16];
+} str_HashStream;
+
+API str_HashStream str_hashStreamInit(u64 seed);
+API void str_hashStreamAppend(str_HashStream* stream, S8 str);
+API u64 str_hashStreamFinish64(str_HashStream* stream);
+API str_Hash128 str_hashStreamFinish128(str_HashStream* stream);
+
+// legacy djb2 hashes, kept for data that was persisted with them
+API u32 str_hash32Djb2(S8 str);
+API u64 str_hash64Djb2(S8 str);
+
+#pragma mark - perfect hash
+
+// Minimal perfect hash for fixed keyword sets (parser keywords, config keys, enum names).
+// Every key owns exactly one slot, so a lookup is one hash, one seed load and one compare against the slot key.
+// Tables are built at runtime with str_perfectHashBuild, emitted as C source with tools_src/phash.c
+// or built at compile time with str_perfectHashT from base_str.hpp.
+typedef struct str_PerfectHash {
+    const S8*  keys;     // slot order
+    const u32* indices;  // slot -> index of the key in the list passed to the build
+    const u32* seeds;    // one per bucket
+    u32 count;
+    u32 bucketCount;
+} str_PerfectHash;
+
+// keys are referenced, not copied. Returns false for duplicate keys.
+API bx  str_perfectHashBuild(Arena* arena, S8* keys, u32 count, str_PerfectHash* out);
+// index of key in the list passed to the build, table->count if it is not part of the set
+API u32 str_perfectHashFind(const str_PerfectHash* table, S8 key);
+
+// hashing steps shared with str_perfectHashT, so they are constexpr in C++
+#ifdef __cplusplus
+#define STR__PERFECT_HASH_CONSTEXPR constexpr
+#else
+#define STR__PERFECT_HASH_CONSTEXPR
+#endif
+
+#define STR__PERFECT_HASH_BASIS u64_val(0xcbf29ce484222325)
+
+// FNV-1a, keywords are short so a byte loop beats the setup cost of the bulk hashes
+INLINE STR__PERFECT_HASH_CONSTEXPR u64 str__perfectHashStep(u64 hash, u8 c) {
+    return (hash ^ c) * u64_val(0x100000001b3);
+}
+
+INLINE STR__PERFECT_HASH_CONSTEXPR u64 str__perfectHashMix(u64 x) {
+    x ^= x >> 31;
+    x *= u64_val(0xbf58476d1ce4e5b9);
+    return x ^ (x >> 29);
+}
+
+INLINE STR__PERFECT_HASH_CONSTEXPR u32 str__perfectHashBucket(u64 hash, u32 bucketCount) {
+    return u32_cast(((hash >> 32) * bucketCount) >> 32);
+}
+
+INLINE STR__PERFECT_HASH_CONSTEXPR u32 str__perfectHashSlot(u64 hash, u32 seed, u32 count) {
+    u64 mixed = str__perfectHashMix(hash ^ (seed * u64_val(0x9E3779B97F4A7C15)));
+    return u32_cast(((mixed >> 32) * count) >> 32);
+}
+
+// two keys per bucket on average keeps the seed search short while the seed table stays small
+INLINE STR__PERFECT_HASH_CONSTEXPR u32 str__perfectHashBucketCount(u32 count) {
+    return (count + 1) / 2;
+}
 
 ////////////////////////////
 // NOTE(pjako): fmt parser... do we need that?
@@ -228,21 +471,71 @@ API S8 str_joinVargs(Arena* arena, u32 argCount, va_list list);
 API S8 str_fmtRaw(Arena* arena, S8 fmt, u32 argCount, ...);
 API S8 str_fmtVargs(Arena* arena, S8 fmt, u32 argCount, va_list list);
 
+////////////////////////////
+// NOTE(pjako): precompiled format templates
+// str_fmt parses the template on every call, a str_FmtProgram parses it once into literal spans and argument slots.
+// The program references the template memory, so the template has to outlive it (string literals always do).
+
+typedef enum str_fmtOpKind {
+    str_fmtOpKind_literal,
+    str_fmtOpKind_arg,      // positional "{}" or indexed "{1}"
+    str_fmtOpKind_key,      // named "{key}"
+} str_fmtOpKind;
+
+typedef struct str_FmtOp {
+    u32 offset;      // literal text or the whole placeholder including braces, offset into the template
+    u32 size;
+    u16 specOffset;  // format spec after ':', relative to offset, specSize 0 == no spec
+    u16 specSize;
+    u16 keySize;     // key ops: the key directly follows the '{'
+    u8  kind;
+    u8  argIndex;    // arg ops: argument index
+    u32 keyHash;     // key ops: looked up in a table of the argument keys
+} str_FmtOp;
+
+typedef struct str_FmtProgram {
+    S8 fmt;
+    str_FmtOp* ops;
+    u32 opCount;
+    u32 argCount;    // arguments referenced by position (highest index + 1)
+    u32 keyCount;    // named placeholders
+    bx valid;
+} str_FmtProgram;
+
+// Usage: str_FmtProgram program = str_fmtCompile(arena, s8("{} of {}")); str_fmtProgram(arena, &program, 1, 2) => "1 of 2"
+#define str_fmtProgram(ARENA, PROGRAM, ... ) STR_ARG_OVER_UNDER_FLOW_CHECKER(str_fmtProgramRaw, STR_AT_LEAST_TWO_ARGS, __VA_ARGS__)(ARENA, PROGRAM, STR_ARR_MACRO_CHOOSER(__VA_ARGS__)(str_KeyValue, str__convertToKeyValue, __VA_ARGS__))
+
+API str_FmtProgram str_fmtCompile(Arena* arena, S8 fmt);
+// compile into caller owned op storage, returns false if the template needs more than opCapacity ops
+API bx str_fmtCompileInto(str_FmtProgram* program, str_FmtOp* ops, u32 opCapacity, S8 fmt);
+// programs are only read while formatting, one program can be shared by many threads
+API S8 str_fmtProgramArgs(Arena* arena, const str_FmtProgram* program, u32 argCount, const str_KeyValue* args);
+API S8 str_fmtProgramRaw(Arena* arena, const str_FmtProgram* program, u32 argCount, ...);
+API S8 str_fmtProgramVargs(Arena* arena, const str_FmtProgram* program, u32 argCount, va_list list);
+
 ////////////////////////////
 /// Buikder ////////////////
 ////////////////////////////
 
-#define str_builderFmt(BUILDER, FMTSTR, ... ) STR_ARG_OVER_UNDER_FLOW_CHECKER(str_builderJoinRaw, STR_AT_LEAST_TWO_ARGS, __VA_ARGS__)(ARENA, str__convertToKey(FMTSTR), STR_ARR_MACRO_CHOOSER(__VA_ARGS__)(str_KeyValue, str__convertToKeyValue, __VA_ARGS__))
+// Appends go into arena blocks that never relocate, the builder can share its arena with other allocations.
+// Usage: str_Builder builder = str_builderInit(arena, KILOBYTE(64));
+//        str_builderFmt(&builder, s8("{} = {};\n"), name, value);
+//        os_fileWriteSpans(path, str_builderSpans(&builder, arena, &count), count); or str_builderFinish(&builder, arena)
 
-#define str_builderJoin(BUILDER, ...) STR_ARG_OVER_UNDER_FLOW_CHECKER(str_builderFmtRaw, STR_AT_LEAST_TWO_ARGS, __VA_ARGS__)(ARENA, STR_ARR_MACRO_CHOOSER(__VA_ARGS__)(str_KeyVakue, str__convertToValue, __VA_ARGS__))
+#define str_builderFmt(BUILDER, FMTSTR, ... ) STR_ARG_OVER_UNDER_FLOW_CHECKER(str_builderFmtRaw, STR_AT_LEAST_TWO_ARGS, __VA_ARGS__)(BUILDER, str__convertToKey(FMTSTR), STR_ARR_MACRO_CHOOSER(__VA_ARGS__)(str_KeyValue, str__convertToKeyValue, __VA_ARGS__))
 
-API str_Builder str_builderInit(Arena* arena, u64 blockDefaultSize);
-API S8 str_builderFinish(Arena* targetArena);
+#define str_builderJoin(BUILDER, ...) STR_ARG_OVER_UNDER_FLOW_CHECKER(str_builderJoinRaw, STR_AT_LEAST_TWO_ARGS, __VA_ARGS__)(BUILDER, STR_ARR_MACRO_CHOOSER(__VA_ARGS__)(str_Value, str__convertToValue, __VA_ARGS__))
 
+API str_Builder str_builderInit(Arena* arena, u64 blockDefaultSize);
+API void str_builderAppend(str_Builder* builder, S8 str);
 API void str_builderJoinRaw(str_Builder* builder, u32 argCount, ...);
-// API void str_builderJoinVargs(str_Builder* builder, u32 argCount, va_list list);
+API void str_builderJoinVargs(str_Builder* builder, u32 argCount, va_list list);
 API void str_builderFmtRaw(str_Builder* builder, S8 fmt, u32 argCount, ...);
-// API void str_builderFmtVargs(str_Builder* builder, S8 fmt, u32 argCount, va_list list);
+API void str_builderFmtVargs(str_Builder* builder, S8 fmt, u32 argCount, va_list list);
+// flattens all blocks into one contiguous string, a single block in the target arena is returned without copying
+API S8 str_builderFinish(str_Builder* builder, Arena* targetArena);
+// gather list of the blocks (views into the builder memory) for writev style output
+API S8* str_builderSpans(str_Builder* builder, Arena* arena, u32* spanCount);
 
 #define str_record(STR, ARENA) for (u64 startIdx = mem_arenaStartUnsafeRecord(ARENA) + 1;startIdx != 0; (( (startIdx - 1) < mem_getArenaMemOffsetPos(ARENA) ? (STR.content = &(ARENA)->memory[startIdx - 1], STR.size = (mem_getArenaMemOffsetPos(ARENA) - (startIdx - 1))) : (STR.content = NULL, STR.size = 0)  ), startIdx = 0, mem_arenaStopUnsafeRecord(ARENA)))
 
@@ -470,7 +763,7 @@ INLINE S8 STR_TOKEY(charConst)(const char* val, u32 size, const char* strExpress
         // its a string literal
         str.size = size - 1;
         str.content = (u8*) val;
-    } else if (strExpression[0] != '\0' && strExpression[1] != '\0' && strExpression[2] != '\0' && strExpression[0] != 'u' && strExpression[1] != '8' && strExpression[2] != '"') {
+    } else if (strExpression[0] == 'u' && strExpression[1] == '8' && strExpression[2] == '"') {
         // its a string literal starting with u8"
         str.size = size - 1;
         str.content = (u8*) val;
@@ -504,7 +797,7 @@ INLINE str_KeyValue STR_TOKV(charConst)(const char* val, u32 size, const char* s
         // its a string literal
         str.size = size - 1;
         str.content = (u8*) val;
-    } else if (strExpression[0] != '\0' && strExpression[1] != '\0' && strExpression[2] != '\0' && strExpression[0] != 'u' && strExpression[1] != '8' && strExpression[2] != '"') {
+    } else if (strExpression[0] == 'u' && strExpression[1] == '8' && strExpression[2] == '"') {
         // its a string literal starting with u8"
         str.size = size - 1;
         str.content = (u8*) val;
@@ -0,0 +1,347 @@
+#ifndef _BASE_STR_HPP_
+#define _BASE_STR_HPP_
+// C++17 front-end for str_fmt/str_join, include after base/base_str.h
+// The template is parsed at compile time and every argument goes through a writer picked by its type,
+// so there is no boxing into str_Value, no va_list and no template parsing at runtime.
+// Placeholder/argument count mismatches and unsupported argument types fail to compile.
+//
+// Usage: str_fmtT(arena, "typedef struct {0}{1} {{", prefix, name) => "typedef struct rx_Foo {"
+//        str_joinT(arena, s8("count: "), count, '\n')
+//
+// Differences to str_fmt: the template has to be a string literal and named placeholders ("{key}") are not supported.
+
+#ifndef __cplusplus
+#error "base_str.hpp is C++ only, use str_fmt/str_join from base_str.h in C"
+#endif
+
+#include <type_traits>
+#include <utility>
+
+#define str_fmtT(ARENA, TEMPLATE, ...) str__fmtT([] { \
+    struct str__FmtLiteral { \
+        static constexpr const char* content() { return TEMPLATE; } \
+        static constexpr u64 size() { return sizeof(TEMPLATE) - 1; } \
+    }; \
+    return str__FmtLiteral{}; \
+}(), ARENA, ##__VA_ARGS__)
+
+////////////////////////////
+// NOTE(pjako): compile time template parsing
+
+enum str__fmtTError : u32 {
+    str__fmtTError_none,
+    str__fmtTError_unmatchedOpen,
+    str__fmtTError_unmatchedClose,
+    str__fmtTError_namedPlaceholder,
+};
+
+struct str__FmtTOp {
+    bool isArg;
+    u32 offset;      // literal text, offset into the template
+    u32 size;
+    u32 argIndex;
+    u32 specOffset;  // format spec after ':', passed to str_CustomVal
+    u32 specSize;
+};
+
+template <u64 CAPACITY>
+struct str__FmtTProgram {
+    str__FmtTOp ops[CAPACITY];
+    u32 opCount;
+    u32 argCount;
+    str__fmtTError error;
+};
+
+template <u64 CAPACITY>
+constexpr void str__fmtTPushLiteral(str__FmtTProgram<CAPACITY>& program, u32 offset, u32 size) {
+    if (size == 0) return;
+    program.ops[program.opCount] = str__FmtTOp{false, offset, size, 0, 0, 0};
+    program.opCount += 1;
+}
+
+// same grammar as str_fmtCompileInto
+template <u64 CAPACITY>
+constexpr str__FmtTProgram<CAPACITY> str__fmtTParse(const char* fmt, u32 fmtSize) {
+    str__FmtTProgram<CAPACITY> program{};
+    u32 position = 0;
+    u32 textStart = 0;
+    for (u32 idx = 0; idx < fmtSize; idx++) {
+        char c = fmt[idx];
+        if (c == '{') {
+            if (idx + 1 >= fmtSize) {
+                program.error = str__fmtTError_unmatchedOpen;
+                return program;
+            }
+            if (fmt[idx + 1] == '{') {
+                str__fmtTPushLiteral(program, textStart, idx + 1 - textStart);
+                idx += 1;
+                textStart = idx + 1;
+                continue;
+            }
+            u32 end = idx + 1;
+            for (; end < fmtSize && !(fmt[end] == '}' && fmt[end - 1] != '\\'); end++);
+            if (end >= fmtSize) {
+                program.error = str__fmtTError_unmatchedOpen;
+                return program;
+            }
+            str__fmtTPushLiteral(program, textStart, idx - textStart);
+            str__FmtTOp op{true, idx, end + 1 - idx, position, 0, 0};
+            u32 cursor = idx + 1;
+            if (fmt[cursor] >= '0' && fmt[cursor] <= '9') {
+                op.argIndex = 0;
+                for (; fmt[cursor] >= '0' && fmt[cursor] <= '9'; cursor++) {
+                    op.argIndex = op.argIndex * 10 + u32(fmt[cursor] - '0');
+                }
+            } else if (fmt[cursor] != ':' && cursor != end) {
+                program.error = str__fmtTError_namedPlaceholder;
+                return program;
+            }
+            if (fmt[cursor] == ':') {
+                op.specOffset = cursor + 1;
+                op.specSize = end - (cursor + 1);
+            }
+            program.ops[program.opCount] = op;
+            program.opCount += 1;
+            program.argCount = program.argCount > op.argIndex + 1 ? program.argCount : op.argIndex + 1;
+            position += 1;
+            idx = end;
+            textStart = end + 1;
+        } else if (c == '}') {
+            if (idx + 1 >= fmtSize || fmt[idx + 1] != '}') {
+                program.error = str__fmtTError_unmatchedClose;
+                return program;
+            }
+            str__fmtTPushLiteral(program, textStart, idx + 1 - textStart);
+            idx += 1;
+            textStart = idx + 1;
+        }
+    }
+    str__fmtTPushLiteral(program, textStart, fmtSize - textStart);
+    return program;
+}
+
+template <typename LITERAL>
+struct str__FmtTCompiled {
+    // a template never has more ops than characters plus the trailing literal
+    static constexpr str__FmtTProgram<LITERAL::size() + 1> program = str__fmtTParse<LITERAL::size() + 1>(LITERAL::content(), u32(LITERAL::size()));
+};
+
+////////////////////////////
+// NOTE(pjako): writers, they push straight into the recording arena
+
+template <typename T>
+struct str__fmtTUnsupported : std::false_type {};
+
+INLINE void str__writeT(Arena* arena, const u8* content, u64 size) {
+    if (size == 0) return;
+    mem_copy(mem_arenaPush(arena, size), content, size);
+}
+
+template <typename T>
+INLINE void str__writeArgT(Arena* arena, const T& value, S8 spec) {
+    using Type = std::remove_cv_t<T>;
+    if constexpr (std::is_same_v<Type, S8>) {
+        str__writeT(arena, value.content, value.size);
+    } else if constexpr (std::is_same_v<Type, bool>) {
+        if (value) {
+            str__writeT(arena, (const u8*) "true", 4);
+        } else {
+            str__writeT(arena, (const u8*) "false", 5);
+        }
+    } else if constexpr (std::is_same_v<Type, char> || std::is_same_v<Type, unsigned char>) {
+        // u8 prints as a character, same as the C path
+        *((char*) mem_arenaPush(arena, 1)) = char(value);
+    } else if constexpr (std::is_enum_v<Type>) {
+        str__writeArgT(arena, std::underlying_type_t<Type>(value), spec);
+    } else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+        u8 buffer[24];
+        str__writeT(arena, buffer, str_i64ToChars(i64(value), buffer));
+    } else if constexpr (std::is_integral_v<Type>) {
+        u8 buffer[24];
+        str__writeT(arena, buffer, str_u64ToChars(u64(value), buffer));
+    } else if constexpr (std::is_same_v<Type, f32>) {
+        u8 buffer[STR_FLOAT_MAX_CHARS];
+        str__writeT(arena, buffer, str_f32ToChars(value, buffer));
+    } else if constexpr (std::is_same_v<Type, f64>) {
+        u8 buffer[STR_FLOAT_MAX_CHARS];
+        str__writeT(arena, buffer, str_f64ToChars(value, buffer));
+    } else if constexpr (std::is_same_v<Type, str_CustomVal>) {
+        value.buildStrFn(arena, spec, value.usrPtr);
+    } else if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>) {
+        str__writeT(arena, (const u8*) value, value ? strlen(value) : 0);
+    } else if constexpr (std::is_array_v<Type> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<Type>>, char>) {
+        // char buffers stop at the first terminator, string literals at their end
+        u64 size = 0;
+        for (; size < std::extent_v<Type> && value[size] != '\0'; size++);
+        str__writeT(arena, (const u8*) &value[0], size);
+    } else {
+        static_assert(str__fmtTUnsupported<Type>::value, "str_fmtT/str_joinT: no writer for this argument type");
+    }
+}
+
+template <u64 INDEX, typename FIRST, typename... REST>
+INLINE const auto& str__fmtTArgAt(const FIRST& first, const REST&... rest) {
+    if constexpr (INDEX == 0) {
+        return first;
+    } else {
+        return str__fmtTArgAt<INDEX - 1>(rest...);
+    }
+}
+
+template <typename LITERAL, u64 OP, typename... ARGS>
+INLINE void str__fmtTEmit(Arena* arena, const ARGS&... args) {
+    constexpr str__FmtTOp op = str__FmtTCompiled<LITERAL>::program.ops[OP];
+    const u8* content = (const u8*) LITERAL::content();
+    if constexpr (!op.isArg) {
+        str__writeT(arena, content + op.offset, op.size);
+    } else {
+        S8 spec = {(u8*) content + op.specOffset, op.specSize};
+        str__writeArgT(arena, str__fmtTArgAt<op.argIndex>(args...), spec);
+    }
+}
+
+template <typename LITERAL, typename... ARGS, u64... OPS>
+INLINE void str__fmtTRun(Arena* arena, std::integer_sequence<u64, OPS...>, const ARGS&... args) {
+    (str__fmtTEmit<LITERAL, OPS>(arena, args...), ...);
+}
+
+template <typename LITERAL, typename... ARGS>
+INLINE S8 str__fmtT(LITERAL, Arena* arena, const ARGS&... args) {
+    constexpr auto& program = str__FmtTCompiled<LITERAL>::program;
+    static_assert(program.error != str__fmtTError_unmatchedOpen, "str_fmtT: '{' without closing '}', write '{{' for a literal brace");
+    static_assert(program.error != str__fmtTError_unmatchedClose, "str_fmtT: single '}', write '}}' for a literal brace");
+    static_assert(program.error != str__fmtTError_namedPlaceholder, "str_fmtT: named placeholders are not supported, use str_fmt with str_kv");
+    static_assert(program.error != str__fmtTError_none || program.argCount == sizeof...(ARGS), "str_fmtT: the template does not use the same number of arguments that are passed");
+    S8 out;
+    str_record(out, arena) {
+        str__fmtTRun<LITERAL>(arena, std::make_integer_sequence<u64, program.opCount>{}, args...);
+    }
+    return out;
+}
+
+template <typename... ARGS>
+INLINE S8 str_joinT(Arena* arena, const ARGS&... args) {
+    S8 out;
+    str_record(out, arena) {
+        (str__writeArgT(arena, args, S8{NULL, 0}), ...);
+    }
+    return out;
+}
+
+////////////////////////////
+// NOTE(pjako): compile time perfect hash, same scheme as str_perfectHashBuild
+//
+// Usage: static constexpr auto keywords = str_perfectHashT("float", "float2", "uint");
+//        switch (keywords.find(token)) {
+//            case keywords.indexOf("float"): ...
+//            case keywords.count: // not a keyword
+//        }
+// Duplicate keys and indexOf with a key that is not part of the set fail to compile.
+
+// not constexpr on purpose, reaching them during constant evaluation is the compile error
+INLINE u32 str__perfectHashTDuplicateKey(void) { return 0; }
+INLINE u32 str__perfectHashTUnknownKey(u32 count) { return count; }
+
+template <typename CHAR>
+constexpr u64 str__perfectHashKeyT(const CHAR* content, u64 size) {
+    u64 hash = STR__PERFECT_HASH_BASIS;
+    for (u64 i = 0; i < size; i++) {
+        hash = str__perfectHashStep(hash, u8(content[i]));
+    }
+    return str__perfectHashMix(hash);
+}
+
+template <u32 COUNT>
+struct str_PerfectHashT {
+    static constexpr u32 count = COUNT;
+    static constexpr u32 bucketCount = str__perfectHashBucketCount(COUNT);
+
+    const char* keys[COUNT];  // slot order
+    u32 sizes[COUNT];
+    u32 indices[COUNT];
+    u32 seeds[bucketCount];
+
+    // index of the key in the argument list of str_perfectHashT, count if it is not part of the set
+    u32 find(S8 key) const {
+        u64 hash = str__perfectHashKeyT(key.content, key.size);
+        u32 slot = str__perfectHashSlot(hash, seeds[str__perfectHashBucket(hash, bucketCount)], COUNT);
+        return str_isEqual(S8{(u8*) keys[slot], sizes[slot]}, key) ? indices[slot] : COUNT;
+    }
+
+    template <u64 SIZE>
+    constexpr u32 indexOf(const char (&key)[SIZE]) const {
+        u64 hash = str__perfectHashKeyT(key, SIZE - 1);
+        u32 slot = str__perfectHashSlot(hash, seeds[str__perfectHashBucket(hash, bucketCount)], COUNT);
+        if (sizes[slot] != SIZE - 1) {
+            return str__perfectHashTUnknownKey(COUNT);
+        }
+        for (u64 i = 0; i < SIZE - 1; i++) {
+            if (keys[slot][i] != key[i]) {
+                return str__perfectHashTUnknownKey(COUNT);
+            }
+        }
+        return indices[slot];
+    }
+};
+
+template <typename... KEYS>
+constexpr str_PerfectHashT<sizeof...(KEYS)> str_perfectHashT(const KEYS&... args) {
+    constexpr u32 count = sizeof...(KEYS);
+    constexpr u32 bucketCount = str_PerfectHashT<count>::bucketCount;
+    static_assert(count > 0, "str_perfectHashT: empty key set");
+    const char* keys[count] = {args...};
+    u32 sizes[count] = {u32(sizeof(args) - 1)...};
+    u64 hashes[count] = {};
+    u32 bucketSizes[bucketCount] = {};
+    u32 maxBucketSize = 0;
+    for (u32 i = 0; i < count; i++) {
+        hashes[i] = str__perfectHashKeyT(keys[i], sizes[i]);
+        u32 bucket = str__perfectHashBucket(hashes[i], bucketCount);
+        bucketSizes[bucket] += 1;
+        maxBucketSize = bucketSizes[bucket] > maxBucketSize ? bucketSizes[bucket] : maxBucketSize;
+    }
+
+    str_PerfectHashT<count> table = {};
+    bool taken[count] = {};
+    u32 candidate[count] = {};
+    for (u32 size = maxBucketSize; size > 0; size--) {
+        for (u32 bucket = 0; bucket < bucketCount; bucket++) {
+            if (bucketSizes[bucket] != size) continue;
+            u32 members[count] = {};
+            u32 memberCount = 0;
+            for (u32 i = 0; i < count; i++) {
+                if (str__perfectHashBucket(hashes[i], bucketCount) != bucket) continue;
+                for (u32 j = 0; j < memberCount; j++) {
+                    if (hashes[members[j]] == hashes[i]) {
+                        str__perfectHashTDuplicateKey();
+                    }
+                }
+                members[memberCount++] = i;
+            }
+            for (u32 seed = 1;; seed++) {
+                u32 placed = 0;
+                for (; placed < size; placed++) {
+                    u32 slot = str__perfectHashSlot(hashes[members[placed]], seed, count);
+                    if (taken[slot]) break;
+                    taken[slot] = true;
+                    candidate[placed] = slot;
+                }
+                if (placed == size) {
+                    table.seeds[bucket] = seed;
+                    break;
+                }
+                for (u32 i = 0; i < placed; i++) {
+                    taken[candidate[i]] = false;
+                }
+            }
+            for (u32 i = 0; i < size; i++) {
+                table.keys[candidate[i]] = keys[members[i]];
+                table.sizes[candidate[i]] = sizes[members[i]];
+                table.indices[candidate[i]] = members[i];
+            }
+        }
+    }
+    return table;
+}
+
+#endif // _BASE_STR_HPP_
@@ -15,6 +15,8 @@ API DateTime tm_nowLocal(void);
 
 API tm_FrequencyInfo tm_getPerformanceFrequency(void);
 API u64 tm_currentCount(void);
+// raw cpu counter (rdtsc, cntvct_el0), cheaper than tm_currentCount but its rate has to be calibrated against it
+API u64 tm_cycleCount(void);
 API u64 tm_countToNanoseconds(tm_FrequencyInfo info, i64 count);
 API u64 tm_roundToCommonRefreshRate(u64 nanoSeconds);
 
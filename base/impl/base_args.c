@@ -77,20 +77,21 @@ i32 arg_nextOpt(arg_Ctx* ctx) {
                     case arg_optType_string: break;
                     case arg_optType_f32: {
                         u64 offset = str_parseF32N(value, &ctx->foundF32Value);
-                        if (offset != (value.size - 1)) {
+                        if (offset != value.size) {
                             return arg_error_invalidValue;
                         }
                     } break;
                     case arg_optType_i32: {
                         i64 outVal = 0;
                         u64 offset = str_parseS64N(value, &outVal);
-                        if (offset != (value.size - 1)) {
+                        if (offset != value.size || outVal < -0x80000000ll || outVal > 0x7FFFFFFF) {
                             return arg_error_invalidValue;
                         }
+                        ctx->foundi32Value = i32_cast(outVal);
                     } break;
                     case arg_optType_flags: {
                         u64 offset = str_parseU32N(value, &ctx->foundFlagsValue);
-                        if (offset != (value.size - 1)) {
+                        if (offset != value.size) {
                             return arg_error_invalidValue;
                         }
                     } break;
@@ -0,0 +1,258 @@
+#include "base/base.h"
+#include "base/base_types.h"
+#include "base/base_mem.h"
+#include "base/base_str.h"
+#include "base/base_atomic.h"
+#include "base/base_checksum.h"
+
+////////////////////////////
+// NOTE(pjako): CRC32C hardware selection
+// x64: SSE4.2 is picked at runtime unless the compiler already targets it
+// arm64: the CRC extension is only used when enabled at compile time (always the case on Apple silicon)
+
+#if ARCH_X64 && (SIMD_SSE42 || COMPILER_MSVC)
+#include <nmmintrin.h>
+#define CHK__CRC_HW 1
+#define CHK__CRC_TARGET
+#elif ARCH_X64 && (COMPILER_GCC || COMPILER_CLANG)
+#include <nmmintrin.h>
+#define CHK__CRC_HW 1
+#define CHK__CRC_TARGET __attribute__((target("sse4.2")))
+#elif ARCH_ARM64 && SIMD_ARM_CRC
+#include <arm_acle.h>
+#define CHK__CRC_HW 1
+#define CHK__CRC_TARGET
+#else
+#define CHK__CRC_HW 0
+#endif
+
+#if CHK__CRC_HW && ARCH_X64
+#define CHK__CRC_U64(CRC, VAL) u32_cast(_mm_crc32_u64((CRC), (VAL)))
+#define CHK__CRC_U8(CRC, VAL) _mm_crc32_u8((CRC), (VAL))
+#elif CHK__CRC_HW
+#define CHK__CRC_U64(CRC, VAL) __crc32cd((CRC), (VAL))
+#define CHK__CRC_U8(CRC, VAL) __crc32cb((CRC), (VAL))
+#endif
+
+// reflected Castagnoli polynomial
+#define CHK__CRC32C_POLY 0x82f63b78
+
+// stream sizes for the 3-way interleaved hardware loop, the streams are merged with precomputed shift tables
+#define CHK__CRC_LONG 8192
+#define CHK__CRC_SHORT 256
+
+typedef struct chk__Crc32cTables {
+    u32 slicing[8][256];
+    u32 shiftLong[4][256];
+    u32 shiftShort[4][256];
+    bx  hardware;
+} chk__Crc32cTables;
+
+static chk__Crc32cTables chk__crcTables;
+static a32 chk__crcInitState; // 0 = not initialized, 1 = initializing, 2 = ready
+
+INLINE u64 chk__read64(const u8* p) {
+    u64 v;
+    mem_copy(&v, p, sizeof(v));
+    return v;
+}
+
+////////////////////////////
+// NOTE(pjako): GF(2) helpers to build the operator that appends N zero bytes to a crc (from Mark Adler's crc32c.c)
+
+LOCAL u32 chk__gf2MatrixTimes(const u32* mat, u32 vec) {
+    u32 sum = 0;
+    while (vec) {
+        if (vec & 1) {
+            sum ^= *mat;
+        }
+        vec >>= 1;
+        mat++;
+    }
+    return sum;
+}
+
+LOCAL void chk__gf2MatrixSquare(u32* square, const u32* mat) {
+    for (u32 n = 0; n < 32; n++) {
+        square[n] = chk__gf2MatrixTimes(mat, mat[n]);
+    }
+}
+
+// size has to be a power of two
+LOCAL void chk__crcZerosOperator(u32* even, u64 size) {
+    u32 odd[32];
+    odd[0] = CHK__CRC32C_POLY;
+    u32 row = 1;
+    for (u32 n = 1; n < 32; n++) {
+        odd[n] = row;
+        row <<= 1;
+    }
+    // two zero bits in even, four in odd, then one zero byte in even...
+    chk__gf2MatrixSquare(even, odd);
+    chk__gf2MatrixSquare(odd, even);
+    do {
+        chk__gf2MatrixSquare(even, odd);
+        size >>= 1;
+        if (size == 0) {
+            return;
+        }
+        chk__gf2MatrixSquare(odd, even);
+        size >>= 1;
+    } while (size);
+    mem_copy(even, odd, sizeof(odd));
+}
+
+LOCAL void chk__crcShiftTable(u32 table[4][256], u64 size) {
+    u32 op[32];
+    chk__crcZerosOperator(op, size);
+    for (u32 n = 0; n < 256; n++) {
+        table[0][n] = chk__gf2MatrixTimes(op, n);
+        table[1][n] = chk__gf2MatrixTimes(op, n << 8);
+        table[2][n] = chk__gf2MatrixTimes(op, n << 16);
+        table[3][n] = chk__gf2MatrixTimes(op, n << 24);
+    }
+}
+
+INLINE u32 chk__crcShift(u32 table[4][256], u32 crc) {
+    return table[0][crc & 0xff] ^ table[1][(crc >> 8) & 0xff] ^ table[2][(crc >> 16) & 0xff] ^ table[3][crc >> 24];
+}
+
+LOCAL bx chk__crcHardwareSupported(void) {
+#if !CHK__CRC_HW
+    return false;
+#elif ARCH_ARM64 || SIMD_SSE42
+    return true;
+#elif COMPILER_MSVC
+    i32 info[4];
+    __cpuid(info, 1);
+    return (info[2] & (1 << 20)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2") != 0;
+#endif
+}
+
+LOCAL void chk__crcInit(void) {
+    if (a32_loadAcquire(&chk__crcInitState) == 2) {
+        return;
+    }
+    if (a32_compareAndSwap(&chk__crcInitState, 0, 1) != 0) {
+        while (a32_loadAcquire(&chk__crcInitState) != 2) {}
+        return;
+    }
+    for (u32 n = 0; n < 256; n++) {
+        u32 crc = n;
+        for (u32 k = 0; k < 8; k++) {
+            crc = crc & 1 ? (crc >> 1) ^ CHK__CRC32C_POLY : crc >> 1;
+        }
+        chk__crcTables.slicing[0][n] = crc;
+    }
+    for (u32 n = 0; n < 256; n++) {
+        u32 crc = chk__crcTables.slicing[0][n];
+        for (u32 k = 1; k < 8; k++) {
+            crc = chk__crcTables.slicing[0][crc & 0xff] ^ (crc >> 8);
+            chk__crcTables.slicing[k][n] = crc;
+        }
+    }
+    chk__crcShiftTable(chk__crcTables.shiftLong, CHK__CRC_LONG);
+    chk__crcShiftTable(chk__crcTables.shiftShort, CHK__CRC_SHORT);
+    chk__crcTables.hardware = chk__crcHardwareSupported();
+    a32_compareAndSwap(&chk__crcInitState, 1, 2);
+}
+
+////////////////////////////
+// NOTE(pjako): slicing-by-8 fallback
+
+LOCAL u32 chk__crc32cSoftware(u32 crc, const u8* p, u64 size) {
+    u32 (*t)[256] = chk__crcTables.slicing;
+    while (size && (((umm) p) & 7) != 0) {
+        crc = t[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+        size--;
+    }
+    while (size >= 8) {
+        u64 word = chk__read64(p) ^ crc;
+        crc = t[7][word & 0xff] ^ t[6][(word >> 8) & 0xff] ^ t[5][(word >> 16) & 0xff] ^ t[4][(word >> 24) & 0xff]
+            ^ t[3][(word >> 32) & 0xff] ^ t[2][(word >> 40) & 0xff] ^ t[1][(word >> 48) & 0xff] ^ t[0][word >> 56];
+        p += 8;
+        size -= 8;
+    }
+    while (size--) {
+        crc = t[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+    }
+    return crc;
+}
+
+////////////////////////////
+// NOTE(pjako): hardware path, three independent streams hide the 3 cycle latency of the crc instruction
+
+#if CHK__CRC_HW
+CHK__CRC_TARGET LOCAL u32 chk__crc32cHardware(u32 crc, const u8* p, u64 size) {
+    while (size && (((umm) p) & 7) != 0) {
+        crc = CHK__CRC_U8(crc, *p++);
+        size--;
+    }
+    while (size >= CHK__CRC_LONG * 3) {
+        u32 crc1 = 0;
+        u32 crc2 = 0;
+        const u8* end = p + CHK__CRC_LONG;
+        do {
+            crc  = CHK__CRC_U64(crc,  chk__read64(p));
+            crc1 = CHK__CRC_U64(crc1, chk__read64(p + CHK__CRC_LONG));
+            crc2 = CHK__CRC_U64(crc2, chk__read64(p + CHK__CRC_LONG * 2));
+            p += 8;
+        } while (p < end);
+        crc = chk__crcShift(chk__crcTables.shiftLong, crc) ^ crc1;
+        crc = chk__crcShift(chk__crcTables.shiftLong, crc) ^ crc2;
+        p += CHK__CRC_LONG * 2;
+        size -= CHK__CRC_LONG * 3;
+    }
+    while (size >= CHK__CRC_SHORT * 3) {
+        u32 crc1 = 0;
+        u32 crc2 = 0;
+        const u8* end = p + CHK__CRC_SHORT;
+        do {
+            crc  = CHK__CRC_U64(crc,  chk__read64(p));
+            crc1 = CHK__CRC_U64(crc1, chk__read64(p + CHK__CRC_SHORT));
+            crc2 = CHK__CRC_U64(crc2, chk__read64(p + CHK__CRC_SHORT * 2));
+            p += 8;
+        } while (p < end);
+        crc = chk__crcShift(chk__crcTables.shiftShort, crc) ^ crc1;
+        crc = chk__crcShift(chk__crcTables.shiftShort, crc) ^ crc2;
+        p += CHK__CRC_SHORT * 2;
+        size -= CHK__CRC_SHORT * 3;
+    }
+    while (size >= 8) {
+        crc = CHK__CRC_U64(crc, chk__read64(p));
+        p += 8;
+        size -= 8;
+    }
+    while (size--) {
+        crc = CHK__CRC_U8(crc, *p++);
+    }
+    return crc;
+}
+#endif // CHK__CRC_HW
+
+API u32 chk_crc32cUpdate(u32 crc, const void* data, u64 size) {
+    ASSERT(data || size == 0);
+    chk__crcInit();
+    crc = ~crc;
+#if CHK__CRC_HW
+    if (chk__crcTables.hardware) {
+        return ~chk__crc32cHardware(crc, (const u8*) data, size);
+    }
+#endif
+    return ~chk__crc32cSoftware(crc, (const u8*) data, size);
+}
+
+API u32 chk_crc32c(const void* data, u64 size) {
+    return chk_crc32cUpdate(0, data, size);
+}
+
+////////////////////////////
+// NOTE(pjako): content hash
+
+API u64 chk_contentHash64(const void* data, u64 size, u64 seed) {
+    ASSERT(data || size == 0);
+    return str_hash64Seed(str_fromCharPtr((u8*) data, size), seed);
+}
@@ -0,0 +1,311 @@
+#include "base/base.h"
+#include "base/base_types.h"
+#include "base/base_mem.h"
+#include "base/base_str.h"
+#include "base/base_rope.h"
+
+////////////////////////////
+// NOTE(pjako): treap of pieces, ordered by text position and heap ordered by a random priority.
+// Every node caches the byte and line break count of its subtree which makes position and line lookups a descent.
+
+// pieces are capped so that splitting a piece (and recounting its line breaks) is constant time
+#define ROPE__PIECE_MAX 1024
+
+struct rope__Node {
+    rope__Node* left;
+    rope__Node* right;
+    u8* content;
+    u32 size;
+    u32 lineBreaks;
+    u64 subtreeSize;
+    u64 subtreeLineBreaks;
+    u32 priority;
+};
+
+INLINE u64 rope__size(rope__Node* node) {
+    return node ? node->subtreeSize : 0;
+}
+
+INLINE u64 rope__lineBreaks(rope__Node* node) {
+    return node ? node->subtreeLineBreaks : 0;
+}
+
+INLINE void rope__update(rope__Node* node) {
+    node->subtreeSize = rope__size(node->left) + node->size + rope__size(node->right);
+    node->subtreeLineBreaks = rope__lineBreaks(node->left) + node->lineBreaks + rope__lineBreaks(node->right);
+}
+
+LOCAL u32 rope__countLineBreaks(const u8* content, u64 size) {
+    u32 count = 0;
+    const u8* end = content + size;
+    while (content < end && (content = (const u8*) memchr(content, '\n', end - content)) != NULL) {
+        count++;
+        content++;
+    }
+    return count;
+}
+
+LOCAL u32 rope__random(rope_Rope* rope) {
+    // xorshift64*
+    rope->seed ^= rope->seed >> 12;
+    rope->seed ^= rope->seed << 25;
+    rope->seed ^= rope->seed >> 27;
+    return u32_cast((rope->seed * u64_val(0x2545F4914F6CDD1D)) >> 32);
+}
+
+LOCAL rope__Node* rope__makeNode(rope_Rope* rope, u8* content, u32 size, u32 priority) {
+    rope__Node* node = rope->freeNodes;
+    if (node) {
+        rope->freeNodes = node->right;
+    } else {
+        node = mem_arenaPushStruct(rope->arena, rope__Node);
+    }
+    node->left = NULL;
+    node->right = NULL;
+    node->content = content;
+    node->size = size;
+    node->lineBreaks = rope__countLineBreaks(content, size);
+    node->priority = priority;
+    rope__update(node);
+    return node;
+}
+
+LOCAL void rope__freeTree(rope_Rope* rope, rope__Node* node) {
+    while (node) {
+        rope__freeTree(rope, node->left);
+        rope__Node* right = node->right;
+        node->right = rope->freeNodes;
+        rope->freeNodes = node;
+        node = right;
+    }
+}
+
+LOCAL rope__Node* rope__merge(rope__Node* left, rope__Node* right) {
+    if (!left) return right;
+    if (!right) return left;
+    if (left->priority >= right->priority) {
+        left->right = rope__merge(left->right, right);
+        rope__update(left);
+        return left;
+    }
+    right->left = rope__merge(left, right->left);
+    rope__update(right);
+    return right;
+}
+
+// splits into the first offset bytes and the rest, a piece that contains offset is cut in two
+LOCAL void rope__split(rope_Rope* rope, rope__Node* node, u64 offset, rope__Node** outLeft, rope__Node** outRight) {
+    if (!node) {
+        *outLeft = NULL;
+        *outRight = NULL;
+        return;
+    }
+    u64 leftSize = rope__size(node->left);
+    if (offset <= leftSize) {
+        rope__split(rope, node->left, offset, outLeft, &node->left);
+        rope__update(node);
+        *outRight = node;
+    } else if (offset >= leftSize + node->size) {
+        rope__split(rope, node->right, offset - leftSize - node->size, &node->right, outRight);
+        rope__update(node);
+        *outLeft = node;
+    } else {
+        u32 cut = u32_cast(offset - leftSize);
+        // the tail gets a fresh priority, reusing the one of the cut piece degenerates the tree after many edits
+        rope__Node* tail = rope__makeNode(rope, node->content + cut, node->size - cut, rope__random(rope));
+        rope__Node* rightTree = node->right;
+        node->right = NULL;
+        node->size = cut;
+        node->lineBreaks -= tail->lineBreaks;
+        rope__update(node);
+        *outLeft = node;
+        *outRight = rope__merge(tail, rightTree);
+    }
+}
+
+LOCAL rope__Node* rope__build(rope_Rope* rope, u8* content, u64 size) {
+    rope__Node* root = NULL;
+    for (u64 offset = 0; offset < size; offset += ROPE__PIECE_MAX) {
+        u32 pieceSize = u32_cast(minVal(size - offset, ROPE__PIECE_MAX));
+        root = rope__merge(root, rope__makeNode(rope, content + offset, pieceSize, rope__random(rope)));
+    }
+    return root;
+}
+
+// finds the piece that contains offset, returns the offset inside of the piece
+LOCAL rope__Node* rope__find(rope__Node* node, u64 offset, u64* pieceOffset) {
+    while (node) {
+        u64 leftSize = rope__size(node->left);
+        if (offset < leftSize) {
+            node = node->left;
+        } else if (offset < leftSize + node->size) {
+            *pieceOffset = offset - leftSize;
+            return node;
+        } else {
+            offset -= leftSize + node->size;
+            node = node->right;
+        }
+    }
+    return NULL;
+}
+
+////////////////////////////
+// NOTE(pjako): editing
+
+API rope_Rope rope_init(Arena* arena, S8 text) {
+    ASSERT(arena);
+    rope_Rope rope;
+    mem_structSetZero(&rope);
+    rope.arena = arena;
+    rope.seed = u64_val(0x9E3779B97F4A7C15) ^ u64_cast(text.size);
+    rope.root = rope__build(&rope, text.content, text.size);
+    return rope;
+}
+
+API void rope_insert(rope_Rope* rope, u64 offset, S8 text) {
+    ASSERT(rope);
+    if (text.size == 0) {
+        return;
+    }
+    offset = minVal(offset, rope__size(rope->root));
+    u8* content = (u8*) mem_arenaPush(rope->arena, text.size);
+    mem_copy(content, text.content, text.size);
+    rope__Node* left;
+    rope__Node* right;
+    rope__split(rope, rope->root, offset, &left, &right);
+    rope->root = rope__merge(rope__merge(left, rope__build(rope, content, text.size)), right);
+}
+
+API void rope_delete(rope_Rope* rope, u64 offset, u64 size) {
+    ASSERT(rope);
+    u64 ropeSize = rope__size(rope->root);
+    offset = minVal(offset, ropeSize);
+    size = minVal(size, ropeSize - offset);
+    if (size == 0) {
+        return;
+    }
+    rope__Node* left;
+    rope__Node* middle;
+    rope__Node* right;
+    rope__split(rope, rope->root, offset, &left, &right);
+    rope__split(rope, right, size, &middle, &right);
+    rope__freeTree(rope, middle);
+    rope->root = rope__merge(left, right);
+}
+
+API void rope_replace(rope_Rope* rope, u64 offset, u64 size, S8 text) {
+    rope_delete(rope, offset, size);
+    rope_insert(rope, offset, text);
+}
+
+API u64 rope_size(rope_Rope* rope) {
+    ASSERT(rope);
+    return rope__size(rope->root);
+}
+
+API u8 rope_charAt(rope_Rope* rope, u64 offset) {
+    ASSERT(rope);
+    u64 pieceOffset = 0;
+    rope__Node* node = rope__find(rope->root, offset, &pieceOffset);
+    ASSERT(node && "Offset out of bounds");
+    return node ? node->content[pieceOffset] : 0;
+}
+
+////////////////////////////
+// NOTE(pjako): lines
+
+API u64 rope_lineCount(rope_Rope* rope) {
+    ASSERT(rope);
+    return rope__lineBreaks(rope->root) + 1;
+}
+
+API u64 rope_lineStart(rope_Rope* rope, u64 line) {
+    ASSERT(rope);
+    if (line == 0) {
+        return 0;
+    }
+    // the line starts right after the line-th line break
+    rope__Node* node = rope->root;
+    u64 base = 0;
+    while (node) {
+        u64 leftLineBreaks = rope__lineBreaks(node->left);
+        if (line <= leftLineBreaks) {
+            node = node->left;
+            continue;
+        }
+        base += rope__size(node->left);
+        line -= leftLineBreaks;
+        if (line <= node->lineBreaks) {
+            const u8* end = node->content + node->size;
+            for (const u8* c = node->content; (c = (const u8*) memchr(c, '\n', end - c)) != NULL; c++) {
+                if (--line == 0) {
+                    return base + u64_cast(c - node->content) + 1;
+                }
+            }
+            ASSERT(!"Line break count out of sync");
+        }
+        line -= node->lineBreaks;
+        base += node->size;
+        node = node->right;
+    }
+    return rope__size(rope->root);
+}
+
+API u64 rope_lineFromOffset(rope_Rope* rope, u64 offset) {
+    ASSERT(rope);
+    rope__Node* node = rope->root;
+    u64 line = 0;
+    while (node) {
+        u64 leftSize = rope__size(node->left);
+        if (offset < leftSize) {
+            node = node->left;
+        } else if (offset < leftSize + node->size) {
+            return line + rope__lineBreaks(node->left) + rope__countLineBreaks(node->content, offset - leftSize);
+        } else {
+            line += rope__lineBreaks(node->left) + node->lineBreaks;
+            offset -= leftSize + node->size;
+            node = node->right;
+        }
+    }
+    return line;
+}
+
+////////////////////////////
+// NOTE(pjako): iteration
+
+API rope_Iter rope_iter(rope_Rope* rope, u64 offset, u64 size) {
+    ASSERT(rope);
+    u64 ropeSize = rope__size(rope->root);
+    rope_Iter iter;
+    mem_structSetZero(&iter);
+    iter.rope = rope;
+    iter.offset = minVal(offset, ropeSize);
+    iter.end = iter.offset + minVal(size, ropeSize - iter.offset);
+    return iter;
+}
+
+API bx rope_iterNext(rope_Iter* iter) {
+    ASSERT(iter);
+    if (iter->offset >= iter->end) {
+        iter->span = STR_NULL;
+        return false;
+    }
+    u64 pieceOffset = 0;
+    rope__Node* node = rope__find(iter->rope->root, iter->offset, &pieceOffset);
+    ASSERT(node);
+    iter->span.content = node->content + pieceOffset;
+    iter->span.size = minVal(node->size - pieceOffset, iter->end - iter->offset);
+    iter->offset += iter->span.size;
+    return true;
+}
+
+API S8 rope_toStr(Arena* arena, rope_Rope* rope, u64 offset, u64 size) {
+    rope_Iter iter = rope_iter(rope, offset, size);
+    S8 result = str_alloc(arena, iter.end - iter.offset);
+    u64 written = 0;
+    while (rope_iterNext(&iter)) {
+        mem_copy(result.content + written, iter.span.content, iter.span.size);
+        written += iter.span.size;
+    }
+    return result;
+}
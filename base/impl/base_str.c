@@ -3,6 +3,43 @@
 #include "base/base_math.h"
 #include "base/base_mem.h"
 #include "base/base_str.h"
+#include "base/base_atomic.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#if SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#if SIMD_SSSE3
+#include <tmmintrin.h>
+#endif
+#if SIMD_AVX2
+#include <immintrin.h>
+#endif
+#if SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// full 64x64 -> 128 bit multiply, returns the low word
+INLINE u64 str__mul128(u64 a, u64 b, u64* high) {
+#if defined(__SIZEOF_INT128__)
+    __uint128_t r = (__uint128_t) a * b;
+    *high = u64_cast(r >> 64);
+    return u64_cast(r);
+#elif COMPILER_MSVC && ARCH_X64
+    return _umul128(a, b, high);
+#else
+    u64 ha = a >> 32, hb = b >> 32, la = u32_cast(a), lb = u32_cast(b);
+    u64 rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+    u64 t = rl + (rm0 << 32);
+    u64 carry = t < rl;
+    u64 lo = t + (rm1 << 32);
+    carry += lo < t;
+    *high = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+    return lo;
+#endif
+}
 
 S8 str_makeSized(Arena* arena, u8* arr, u32 size) {
    S8 str;
@@ -22,13 +59,60 @@ i64  str_find(S8 str, S8 findExp) {
     return -1;
 }
 
-i64  str_findChar(S8 str, char c) {
-    for (u64 idx = 0; idx < str.size; idx++) {
-        if (str.content[idx] == c) {
-            return idx;
-        }
+// index of the first byte that is a, b or c (pass the same byte more than once to search for fewer), size if there is none
+LOCAL u64 str__findAny(const u8* ptr, u64 size, u8 a, u8 b, u8 c) {
+    u64 idx = 0;
+#if SIMD_AVX2
+    __m256i va = _mm256_set1_epi8((char) a);
+    __m256i vb = _mm256_set1_epi8((char) b);
+    __m256i vc = _mm256_set1_epi8((char) c);
+    for (; idx + 32 <= size; idx += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (ptr + idx));
+        __m256i hit = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)), _mm256_cmpeq_epi8(v, vc));
+        u32 mask = (u32) _mm256_movemask_epi8(hit);
+        if (mask) return idx + u32_bitScanReverseNonZero(mask);
     }
-    return -1;
+#elif SIMD_SSE2
+    __m128i va = _mm_set1_epi8((char) a);
+    __m128i vb = _mm_set1_epi8((char) b);
+    __m128i vc = _mm_set1_epi8((char) c);
+    for (; idx + 32 <= size; idx += 32) {
+        __m128i v0 = _mm_loadu_si128((const __m128i*) (ptr + idx));
+        __m128i v1 = _mm_loadu_si128((const __m128i*) (ptr + idx + 16));
+        __m128i hit0 = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v0, va), _mm_cmpeq_epi8(v0, vb)), _mm_cmpeq_epi8(v0, vc));
+        __m128i hit1 = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v1, va), _mm_cmpeq_epi8(v1, vb)), _mm_cmpeq_epi8(v1, vc));
+        u32 mask = (u32) _mm_movemask_epi8(hit0) | ((u32) _mm_movemask_epi8(hit1) << 16);
+        if (mask) return idx + u32_bitScanReverseNonZero(mask);
+    }
+#elif SIMD_NEON
+    uint8x16_t va = vdupq_n_u8(a);
+    uint8x16_t vb = vdupq_n_u8(b);
+    uint8x16_t vc = vdupq_n_u8(c);
+    for (; idx + 32 <= size; idx += 32) {
+        uint8x16_t v0 = vld1q_u8(ptr + idx);
+        uint8x16_t v1 = vld1q_u8(ptr + idx + 16);
+        uint8x16_t hit0 = vorrq_u8(vorrq_u8(vceqq_u8(v0, va), vceqq_u8(v0, vb)), vceqq_u8(v0, vc));
+        uint8x16_t hit1 = vorrq_u8(vorrq_u8(vceqq_u8(v1, va), vceqq_u8(v1, vb)), vceqq_u8(v1, vc));
+        if (vmaxvq_u8(vorrq_u8(hit0, hit1))) break;
+    }
+#endif
+    for (; idx < size && ptr[idx] != a && ptr[idx] != b && ptr[idx] != c; idx++);
+    return idx;
+}
+
+i64  str_findChar(S8 str, char c) {
+    u64 idx = str__findAny(str.content, str.size, u8_cast(c), u8_cast(c), u8_cast(c));
+    return idx == str.size ? -1 : i64_cast(idx);
+}
+
+API u64 str_findNextChar(S8 str, u64 offset, u8 c) {
+    if (offset >= str.size) return str.size;
+    return offset + str__findAny(str.content + offset, str.size - offset, c, c, c);
+}
+
+API u64 str_findNextLineBreak(S8 str, u64 offset) {
+    if (offset >= str.size) return str.size;
+    return offset + str__findAny(str.content + offset, str.size - offset, '\n', '\r', '\r');
 }
 API i64 str_lastIndexOfChar(S8 str, char c) {
    for (i64 idx = i64_cast(str.size) - 1; idx >= 0; idx--) {
@@ -68,26 +152,107 @@ bx str_hasSuffix(S8 str, S8 endsWith) {
    return true;
 }
 
-S8 str_toLowerAscii(S8 str) {
-    for (u64 idx = 0; str.size > idx; idx++) {
-        char c = str.content[idx];
-        if (c >= 'A' && c <= 'Z') {
-            str.content[idx] = 'a' + (c - 'A');
-        }
+// flips the case bit (0x20) of every char in [first, first + 25], src and dst may be the same
+LOCAL void str__flipAsciiCase(u8* dst, const u8* src, u64 size, u8 first) {
+    u64 idx = 0;
+#if SIMD_SSE2
+    __m128i firstChar = _mm_set1_epi8((char) first);
+    __m128i last = _mm_set1_epi8(25);
+    __m128i caseBit = _mm_set1_epi8(0x20);
+    for (; idx + 16 <= size; idx += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (src + idx));
+        __m128i offset = _mm_sub_epi8(v, firstChar);
+        __m128i inRange = _mm_cmpeq_epi8(_mm_min_epu8(offset, last), offset);
+        _mm_storeu_si128((__m128i*) (dst + idx), _mm_xor_si128(v, _mm_and_si128(inRange, caseBit)));
     }
+#elif SIMD_NEON
+    uint8x16_t firstChar = vdupq_n_u8(first);
+    uint8x16_t last = vdupq_n_u8(25);
+    uint8x16_t caseBit = vdupq_n_u8(0x20);
+    for (; idx + 16 <= size; idx += 16) {
+        uint8x16_t v = vld1q_u8(src + idx);
+        uint8x16_t inRange = vcleq_u8(vsubq_u8(v, firstChar), last);
+        vst1q_u8(dst + idx, veorq_u8(v, vandq_u8(inRange, caseBit)));
+    }
+#endif
+    for (; idx < size; idx++) {
+        u8 c = src[idx];
+        dst[idx] = u8_cast(c - first) <= 25 ? (c ^ 0x20) : c;
+    }
+}
+
+INLINE u8 str__lowerAscii(u8 c) {
+    return u8_cast(c - 'A') <= 25 ? (c | 0x20) : c;
+}
+
+S8 str_toLowerAscii(S8 str) {
+    str__flipAsciiCase(str.content, str.content, str.size, 'A');
     return str;
 }
 
 S8 str_toUpperAscii(S8 str) {
-    for (u64 idx = 0; str.size > idx; idx++) {
-        char c = str.content[idx];
-        if (c >= 'a' && c <= 'Z') {
-            str.content[idx] = 'A' + (c - 'a');
-        }
-    }
+    str__flipAsciiCase(str.content, str.content, str.size, 'a');
     return str;
 }
 
+API S8 str_copyLowerAscii(Arena* arena, S8 str) {
+    S8 result = str_alloc(arena, str.size);
+    str__flipAsciiCase(result.content, str.content, str.size, 'A');
+    return result;
+}
+
+API S8 str_copyUpperAscii(Arena* arena, S8 str) {
+    S8 result = str_alloc(arena, str.size);
+    str__flipAsciiCase(result.content, str.content, str.size, 'a');
+    return result;
+}
+
+// true if the first size bytes of left and right are equal after lower casing ascii letters
+LOCAL bx str__isEqualNoCase(const u8* left, const u8* right, u64 size) {
+    u64 idx = 0;
+#if SIMD_SSE2
+    __m128i upperA = _mm_set1_epi8('A');
+    __m128i last = _mm_set1_epi8(25);
+    __m128i caseBit = _mm_set1_epi8(0x20);
+    for (; idx + 16 <= size; idx += 16) {
+        __m128i l = _mm_loadu_si128((const __m128i*) (left + idx));
+        __m128i r = _mm_loadu_si128((const __m128i*) (right + idx));
+        __m128i lOffset = _mm_sub_epi8(l, upperA);
+        __m128i rOffset = _mm_sub_epi8(r, upperA);
+        l = _mm_or_si128(l, _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(lOffset, last), lOffset), caseBit));
+        r = _mm_or_si128(r, _mm_and_si128(_mm_cmpeq_epi8(_mm_min_epu8(rOffset, last), rOffset), caseBit));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(l, r)) != 0xFFFF) return false;
+    }
+#elif SIMD_NEON
+    uint8x16_t upperA = vdupq_n_u8('A');
+    uint8x16_t last = vdupq_n_u8(25);
+    uint8x16_t caseBit = vdupq_n_u8(0x20);
+    for (; idx + 16 <= size; idx += 16) {
+        uint8x16_t l = vld1q_u8(left + idx);
+        uint8x16_t r = vld1q_u8(right + idx);
+        l = vorrq_u8(l, vandq_u8(vcleq_u8(vsubq_u8(l, upperA), last), caseBit));
+        r = vorrq_u8(r, vandq_u8(vcleq_u8(vsubq_u8(r, upperA), last), caseBit));
+        if (vminvq_u8(vceqq_u8(l, r)) != 0xFF) return false;
+    }
+#endif
+    for (; idx < size; idx++) {
+        if (str__lowerAscii(left[idx]) != str__lowerAscii(right[idx])) return false;
+    }
+    return true;
+}
+
+API bx str_isEqualNoCase(S8 left, S8 right) {
+    return left.size == right.size && str__isEqualNoCase(left.content, right.content, left.size);
+}
+
+API bx str_hasPrefixNoCase(S8 str, S8 prefix) {
+    return prefix.size <= str.size && str__isEqualNoCase(str.content, prefix.content, prefix.size);
+}
+
+API bx str_hasSuffixNoCase(S8 str, S8 suffix) {
+    return suffix.size <= str.size && str__isEqualNoCase(str.content + (str.size - suffix.size), suffix.content, suffix.size);
+}
+
 S8 str_subStr(S8 str, u64 start, u64 size) {
     if (str.size == 0) {
         return str;
@@ -176,30 +341,1124 @@ bool str_isAlphaChar(char c) {
     return (((c >= 'a') && (c <= 'z')) || ((c >= 'A') && (c <= 'Z')));
 }
 
+bool str_isWhitespaceChar(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+// length of the leading run of bytes that are (whiteSpace) or are not (!whiteSpace) ' ', '\t', '\n', '\v', '\f' or '\r'
+LOCAL u64 str__scanWhiteSpace(const u8* ptr, u64 size, bx whiteSpace) {
+    u64 idx = 0;
+#if SIMD_SSE2
+    __m128i space = _mm_set1_epi8(' ');
+    __m128i tab = _mm_set1_epi8('\t');
+    __m128i controlRange = _mm_set1_epi8('\r' - '\t');
+    u32 flip = whiteSpace ? 0xFFFF : 0;
+    for (; idx + 16 <= size; idx += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (ptr + idx));
+        __m128i control = _mm_sub_epi8(v, tab);
+        __m128i isSpace = _mm_or_si128(_mm_cmpeq_epi8(v, space), _mm_cmpeq_epi8(_mm_min_epu8(control, controlRange), control));
+        u32 mask = ((u32) _mm_movemask_epi8(isSpace)) ^ flip;
+        if (mask) return idx + u32_bitScanReverseNonZero(mask);
+    }
+#elif SIMD_NEON
+    uint8x16_t space = vdupq_n_u8(' ');
+    uint8x16_t tab = vdupq_n_u8('\t');
+    uint8x16_t controlRange = vdupq_n_u8('\r' - '\t');
+    uint8x16_t flip = vdupq_n_u8(whiteSpace ? 0xFF : 0);
+    for (; idx + 16 <= size; idx += 16) {
+        uint8x16_t v = vld1q_u8(ptr + idx);
+        uint8x16_t isSpace = vorrq_u8(vceqq_u8(v, space), vcleq_u8(vsubq_u8(v, tab), controlRange));
+        if (vmaxvq_u8(veorq_u8(isSpace, flip)) != 0) break;
+    }
+#endif
+    for (; idx < size && str_isWhitespaceChar(ptr[idx]) == whiteSpace; idx++);
+    return idx;
+}
+
+// true for empty strings and strings that only contain whitespace
+bool str_isWhiteSpace(S8 str) {
+    return str__scanWhiteSpace(str.content, str.size, true) == str.size;
+}
+
+i64 str_firstNonWhiteSpace(S8 str) {
+    u64 idx = str__scanWhiteSpace(str.content, str.size, true);
+    return idx == str.size ? -1 : i64_cast(idx);
+}
+
+S8 str_skipWhiteSpace(S8 str) {
+    u64 idx = str__scanWhiteSpace(str.content, str.size, true);
+    str.content += idx;
+    str.size -= idx;
+    return str;
+}
+
+////////////////////////////
+// NOTE(pjako): number parsing
+// Integers convert 8 digits at once (SWAR). Floats use the Eisel-Lemire algorithm (https://arxiv.org/abs/2101.11408)
+// with the Clinger fast path in front, the rare inputs it can't decide are handed to strtod/strtof.
+
+// truncated 128 bit approximations of 5^q for q in [-342, 308], high word first
+#define STR__POW5_MIN_EXPONENT (-342)
+static const u64 str__powerOfFive128[] = {
+    u64_val(0xeef453d6923bd65a), u64_val(0x113faa2906a13b3f), // 5^-342
+    u64_val(0x9558b4661b6565f8), u64_val(0x4ac7ca59a424c507), // 5^-341
+    u64_val(0xbaaee17fa23ebf76), u64_val(0x5d79bcf00d2df649), // 5^-340
+    u64_val(0xe95a99df8ace6f53), u64_val(0xf4d82c2c107973dc), // 5^-339
+    u64_val(0x91d8a02bb6c10594), u64_val(0x79071b9b8a4be869), // 5^-338
+    u64_val(0xb64ec836a47146f9), u64_val(0x9748e2826cdee284), // 5^-337
+    u64_val(0xe3e27a444d8d98b7), u64_val(0xfd1b1b2308169b25), // 5^-336
+    u64_val(0x8e6d8c6ab0787f72), u64_val(0xfe30f0f5e50e20f7), // 5^-335
+    u64_val(0xb208ef855c969f4f), u64_val(0xbdbd2d335e51a935), // 5^-334
+    u64_val(0xde8b2b66b3bc4723), u64_val(0xad2c788035e61382), // 5^-333
+    u64_val(0x8b16fb203055ac76), u64_val(0x4c3bcb5021afcc31), // 5^-332
+    u64_val(0xaddcb9e83c6b1793), u64_val(0xdf4abe242a1bbf3d), // 5^-331
+    u64_val(0xd953e8624b85dd78), u64_val(0xd71d6dad34a2af0d), // 5^-330
+    u64_val(0x87d4713d6f33aa6b), u64_val(0x8672648c40e5ad68), // 5^-329
+    u64_val(0xa9c98d8ccb009506), u64_val(0x680efdaf511f18c2), // 5^-328
+    u64_val(0xd43bf0effdc0ba48), u64_val(0x0212bd1b2566def2), // 5^-327
+    u64_val(0x84a57695fe98746d), u64_val(0x014bb630f7604b57), // 5^-326
+    u64_val(0xa5ced43b7e3e9188), u64_val(0x419ea3bd35385e2d), // 5^-325
+    u64_val(0xcf42894a5dce35ea), u64_val(0x52064cac828675b9), // 5^-324
+    u64_val(0x818995ce7aa0e1b2), u64_val(0x7343efebd1940993), // 5^-323
+    u64_val(0xa1ebfb4219491a1f), u64_val(0x1014ebe6c5f90bf8), // 5^-322
+    u64_val(0xca66fa129f9b60a6), u64_val(0xd41a26e077774ef6), // 5^-321
+    u64_val(0xfd00b897478238d0), u64_val(0x8920b098955522b4), // 5^-320
+    u64_val(0x9e20735e8cb16382), u64_val(0x55b46e5f5d5535b0), // 5^-319
+    u64_val(0xc5a890362fddbc62), u64_val(0xeb2189f734aa831d), // 5^-318
+    u64_val(0xf712b443bbd52b7b), u64_val(0xa5e9ec7501d523e4), // 5^-317
+    u64_val(0x9a6bb0aa55653b2d), u64_val(0x47b233c92125366e), // 5^-316
+    u64_val(0xc1069cd4eabe89f8), u64_val(0x999ec0bb696e840a), // 5^-315
+    u64_val(0xf148440a256e2c76), u64_val(0xc00670ea43ca250d), // 5^-314
+    u64_val(0x96cd2a865764dbca), u64_val(0x380406926a5e5728), // 5^-313
+    u64_val(0xbc807527ed3e12bc), u64_val(0xc605083704f5ecf2), // 5^-312
+    u64_val(0xeba09271e88d976b), u64_val(0xf7864a44c633682e), // 5^-311
+    u64_val(0x93445b8731587ea3), u64_val(0x7ab3ee6afbe0211d), // 5^-310
+    u64_val(0xb8157268fdae9e4c), u64_val(0x5960ea05bad82964), // 5^-309
+    u64_val(0xe61acf033d1a45df), u64_val(0x6fb92487298e33bd), // 5^-308
+    u64_val(0x8fd0c16206306bab), u64_val(0xa5d3b6d479f8e056), // 5^-307
+    u64_val(0xb3c4f1ba87bc8696), u64_val(0x8f48a4899877186c), // 5^-306
+    u64_val(0xe0b62e2929aba83c), u64_val(0x331acdabfe94de87), // 5^-305
+    u64_val(0x8c71dcd9ba0b4925), u64_val(0x9ff0c08b7f1d0b14), // 5^-304
+    u64_val(0xaf8e5410288e1b6f), u64_val(0x07ecf0ae5ee44dd9), // 5^-303
+    u64_val(0xdb71e91432b1a24a), u64_val(0xc9e82cd9f69d6150), // 5^-302
+    u64_val(0x892731ac9faf056e), u64_val(0xbe311c083a225cd2), // 5^-301
+    u64_val(0xab70fe17c79ac6ca), u64_val(0x6dbd630a48aaf406), // 5^-300
+    u64_val(0xd64d3d9db981787d), u64_val(0x092cbbccdad5b108), // 5^-299
+    u64_val(0x85f0468293f0eb4e), u64_val(0x25bbf56008c58ea5), // 5^-298
+    u64_val(0xa76c582338ed2621), u64_val(0xaf2af2b80af6f24e), // 5^-297
+    u64_val(0xd1476e2c07286faa), u64_val(0x1af5af660db4aee1), // 5^-296
+    u64_val(0x82cca4db847945ca), u64_val(0x50d98d9fc890ed4d), // 5^-295
+    u64_val(0xa37fce126597973c), u64_val(0xe50ff107bab528a0), // 5^-294
+    u64_val(0xcc5fc196fefd7d0c), u64_val(0x1e53ed49a96272c8), // 5^-293
+    u64_val(0xff77b1fcbebcdc4f), u64_val(0x25e8e89c13bb0f7a), // 5^-292
+    u64_val(0x9faacf3df73609b1), u64_val(0x77b191618c54e9ac), // 5^-291
+    u64_val(0xc795830d75038c1d), u64_val(0xd59df5b9ef6a2417), // 5^-290
+    u64_val(0xf97ae3d0d2446f25), u64_val(0x4b0573286b44ad1d), // 5^-289
+    u64_val(0x9becce62836ac577), u64_val(0x4ee367f9430aec32), // 5^-288
+    u64_val(0xc2e801fb244576d5), u64_val(0x229c41f793cda73f), // 5^-287
+    u64_val(0xf3a20279ed56d48a), u64_val(0x6b43527578c1110f), // 5^-286
+    u64_val(0x9845418c345644d6), u64_val(0x830a13896b78aaa9), // 5^-285
+    u64_val(0xbe5691ef416bd60c), u64_val(0x23cc986bc656d553), // 5^-284
+    u64_val(0xedec366b11c6cb8f), u64_val(0x2cbfbe86b7ec8aa8), // 5^-283
+    u64_val(0x94b3a202eb1c3f39), u64_val(0x7bf7d71432f3d6a9), // 5^-282
+    u64_val(0xb9e08a83a5e34f07), u64_val(0xdaf5ccd93fb0cc53), // 5^-281
+    u64_val(0xe858ad248f5c22c9), u64_val(0xd1b3400f8f9cff68), // 5^-280
+    u64_val(0x91376c36d99995be), u64_val(0x23100809b9c21fa1), // 5^-279
+    u64_val(0xb58547448ffffb2d), u64_val(0xabd40a0c2832a78a), // 5^-278
+    u64_val(0xe2e69915b3fff9f9), u64_val(0x16c90c8f323f516c), // 5^-277
+    u64_val(0x8dd01fad907ffc3b), u64_val(0xae3da7d97f6792e3), // 5^-276
+    u64_val(0xb1442798f49ffb4a), u64_val(0x99cd11cfdf41779c), // 5^-275
+    u64_val(0xdd95317f31c7fa1d), u64_val(0x40405643d711d583), // 5^-274
+    u64_val(0x8a7d3eef7f1cfc52), u64_val(0x482835ea666b2572), // 5^-273
+    u64_val(0xad1c8eab5ee43b66), u64_val(0xda3243650005eecf), // 5^-272
+    u64_val(0xd863b256369d4a40), u64_val(0x90bed43e40076a82), // 5^-271
+    u64_val(0x873e4f75e2224e68), u64_val(0x5a7744a6e804a291), // 5^-270
+    u64_val(0xa90de3535aaae202), u64_val(0x711515d0a205cb36), // 5^-269
+    u64_val(0xd3515c2831559a83), u64_val(0x0d5a5b44ca873e03), // 5^-268
+    u64_val(0x8412d9991ed58091), u64_val(0xe858790afe9486c2), // 5^-267
+    u64_val(0xa5178fff668ae0b6), u64_val(0x626e974dbe39a872), // 5^-266
+    u64_val(0xce5d73ff402d98e3), u64_val(0xfb0a3d212dc8128f), // 5^-265
+    u64_val(0x80fa687f881c7f8e), u64_val(0x7ce66634bc9d0b99), // 5^-264
+    u64_val(0xa139029f6a239f72), u64_val(0x1c1fffc1ebc44e80), // 5^-263
+    u64_val(0xc987434744ac874e), u64_val(0xa327ffb266b56220), // 5^-262
+    u64_val(0xfbe9141915d7a922), u64_val(0x4bf1ff9f0062baa8), // 5^-261
+    u64_val(0x9d71ac8fada6c9b5), u64_val(0x6f773fc3603db4a9), // 5^-260
+    u64_val(0xc4ce17b399107c22), u64_val(0xcb550fb4384d21d3), // 5^-259
+    u64_val(0xf6019da07f549b2b), u64_val(0x7e2a53a146606a48), // 5^-258
+    u64_val(0x99c102844f94e0fb), u64_val(0x2eda7444cbfc426d), // 5^-257
+    u64_val(0xc0314325637a1939), u64_val(0xfa911155fefb5308), // 5^-256
+    u64_val(0xf03d93eebc589f88), u64_val(0x793555ab7eba27ca), // 5^-255
+    u64_val(0x96267c7535b763b5), u64_val(0x4bc1558b2f3458de), // 5^-254
+    u64_val(0xbbb01b9283253ca2), u64_val(0x9eb1aaedfb016f16), // 5^-253
+    u64_val(0xea9c227723ee8bcb), u64_val(0x465e15a979c1cadc), // 5^-252
+    u64_val(0x92a1958a7675175f), u64_val(0x0bfacd89ec191ec9), // 5^-251
+    u64_val(0xb749faed14125d36), u64_val(0xcef980ec671f667b), // 5^-250
+    u64_val(0xe51c79a85916f484), u64_val(0x82b7e12780e7401a), // 5^-249
+    u64_val(0x8f31cc0937ae58d2), u64_val(0xd1b2ecb8b0908810), // 5^-248
+    u64_val(0xb2fe3f0b8599ef07), u64_val(0x861fa7e6dcb4aa15), // 5^-247
+    u64_val(0xdfbdcece67006ac9), u64_val(0x67a791e093e1d49a), // 5^-246
+    u64_val(0x8bd6a141006042bd), u64_val(0xe0c8bb2c5c6d24e0), // 5^-245
+    u64_val(0xaecc49914078536d), u64_val(0x58fae9f773886e18), // 5^-244
+    u64_val(0xda7f5bf590966848), u64_val(0xaf39a475506a899e), // 5^-243
+    u64_val(0x888f99797a5e012d), u64_val(0x6d8406c952429603), // 5^-242
+    u64_val(0xaab37fd7d8f58178), u64_val(0xc8e5087ba6d33b83), // 5^-241
+    u64_val(0xd5605fcdcf32e1d6), u64_val(0xfb1e4a9a90880a64), // 5^-240
+    u64_val(0x855c3be0a17fcd26), u64_val(0x5cf2eea09a55067f), // 5^-239
+    u64_val(0xa6b34ad8c9dfc06f), u64_val(0xf42faa48c0ea481e), // 5^-238
+    u64_val(0xd0601d8efc57b08b), u64_val(0xf13b94daf124da26), // 5^-237
+    u64_val(0x823c12795db6ce57), u64_val(0x76c53d08d6b70858), // 5^-236
+    u64_val(0xa2cb1717b52481ed), u64_val(0x54768c4b0c64ca6e), // 5^-235
+    u64_val(0xcb7ddcdda26da268), u64_val(0xa9942f5dcf7dfd09), // 5^-234
+    u64_val(0xfe5d54150b090b02), u64_val(0xd3f93b35435d7c4c), // 5^-233
+    u64_val(0x9efa548d26e5a6e1), u64_val(0xc47bc5014a1a6daf), // 5^-232
+    u64_val(0xc6b8e9b0709f109a), u64_val(0x359ab6419ca1091b), // 5^-231
+    u64_val(0xf867241c8cc6d4c0), u64_val(0xc30163d203c94b62), // 5^-230
+    u64_val(0x9b407691d7fc44f8), u64_val(0x79e0de63425dcf1d), // 5^-229
+    u64_val(0xc21094364dfb5636), u64_val(0x985915fc12f542e4), // 5^-228
+    u64_val(0xf294b943e17a2bc4), u64_val(0x3e6f5b7b17b2939d), // 5^-227
+    u64_val(0x979cf3ca6cec5b5a), u64_val(0xa705992ceecf9c42), // 5^-226
+    u64_val(0xbd8430bd08277231), u64_val(0x50c6ff782a838353), // 5^-225
+    u64_val(0xece53cec4a314ebd), u64_val(0xa4f8bf5635246428), // 5^-224
+    u64_val(0x940f4613ae5ed136), u64_val(0x871b7795e136be99), // 5^-223
+    u64_val(0xb913179899f68584), u64_val(0x28e2557b59846e3f), // 5^-222
+    u64_val(0xe757dd7ec07426e5), u64_val(0x331aeada2fe589cf), // 5^-221
+    u64_val(0x9096ea6f3848984f), u64_val(0x3ff0d2c85def7621), // 5^-220
+    u64_val(0xb4bca50b065abe63), u64_val(0x0fed077a756b53a9), // 5^-219
+    u64_val(0xe1ebce4dc7f16dfb), u64_val(0xd3e8495912c62894), // 5^-218
+    u64_val(0x8d3360f09cf6e4bd), u64_val(0x64712dd7abbbd95c), // 5^-217
+    u64_val(0xb080392cc4349dec), u64_val(0xbd8d794d96aacfb3), // 5^-216
+    u64_val(0xdca04777f541c567), u64_val(0xecf0d7a0fc5583a0), // 5^-215
+    u64_val(0x89e42caaf9491b60), u64_val(0xf41686c49db57244), // 5^-214
+    u64_val(0xac5d37d5b79b6239), u64_val(0x311c2875c522ced5), // 5^-213
+    u64_val(0xd77485cb25823ac7), u64_val(0x7d633293366b828b), // 5^-212
+    u64_val(0x86a8d39ef77164bc), u64_val(0xae5dff9c02033197), // 5^-211
+    u64_val(0xa8530886b54dbdeb), u64_val(0xd9f57f830283fdfc), // 5^-210
+    u64_val(0xd267caa862a12d66), u64_val(0xd072df63c324fd7b), // 5^-209
+    u64_val(0x8380dea93da4bc60), u64_val(0x4247cb9e59f71e6d), // 5^-208
+    u64_val(0xa46116538d0deb78), u64_val(0x52d9be85f074e608), // 5^-207
+    u64_val(0xcd795be870516656), u64_val(0x67902e276c921f8b), // 5^-206
+    u64_val(0x806bd9714632dff6), u64_val(0x00ba1cd8a3db53b6), // 5^-205
+    u64_val(0xa086cfcd97bf97f3), u64_val(0x80e8a40eccd228a4), // 5^-204
+    u64_val(0xc8a883c0fdaf7df0), u64_val(0x6122cd128006b2cd), // 5^-203
+    u64_val(0xfad2a4b13d1b5d6c), u64_val(0x796b805720085f81), // 5^-202
+    u64_val(0x9cc3a6eec6311a63), u64_val(0xcbe3303674053bb0), // 5^-201
+    u64_val(0xc3f490aa77bd60fc), u64_val(0xbedbfc4411068a9c), // 5^-200
+    u64_val(0xf4f1b4d515acb93b), u64_val(0xee92fb5515482d44), // 5^-199
+    u64_val(0x991711052d8bf3c5), u64_val(0x751bdd152d4d1c4a), // 5^-198
+    u64_val(0xbf5cd54678eef0b6), u64_val(0xd262d45a78a0635d), // 5^-197
+    u64_val(0xef340a98172aace4), u64_val(0x86fb897116c87c34), // 5^-196
+    u64_val(0x9580869f0e7aac0e), u64_val(0xd45d35e6ae3d4da0), // 5^-195
+    u64_val(0xbae0a846d2195712), u64_val(0x8974836059cca109), // 5^-194
+    u64_val(0xe998d258869facd7), u64_val(0x2bd1a438703fc94b), // 5^-193
+    u64_val(0x91ff83775423cc06), u64_val(0x7b6306a34627ddcf), // 5^-192
+    u64_val(0xb67f6455292cbf08), u64_val(0x1a3bc84c17b1d542), // 5^-191
+    u64_val(0xe41f3d6a7377eeca), u64_val(0x20caba5f1d9e4a93), // 5^-190
+    u64_val(0x8e938662882af53e), u64_val(0x547eb47b7282ee9c), // 5^-189
+    u64_val(0xb23867fb2a35b28d), u64_val(0xe99e619a4f23aa43), // 5^-188
+    u64_val(0xdec681f9f4c31f31), u64_val(0x6405fa00e2ec94d4), // 5^-187
+    u64_val(0x8b3c113c38f9f37e), u64_val(0xde83bc408dd3dd04), // 5^-186
+    u64_val(0xae0b158b4738705e), u64_val(0x9624ab50b148d445), // 5^-185
+    u64_val(0xd98ddaee19068c76), u64_val(0x3badd624dd9b0957), // 5^-184
+    u64_val(0x87f8a8d4cfa417c9), u64_val(0xe54ca5d70a80e5d6), // 5^-183
+    u64_val(0xa9f6d30a038d1dbc), u64_val(0x5e9fcf4ccd211f4c), // 5^-182
+    u64_val(0xd47487cc8470652b), u64_val(0x7647c3200069671f), // 5^-181
+    u64_val(0x84c8d4dfd2c63f3b), u64_val(0x29ecd9f40041e073), // 5^-180
+    u64_val(0xa5fb0a17c777cf09), u64_val(0xf468107100525890), // 5^-179
+    u64_val(0xcf79cc9db955c2cc), u64_val(0x7182148d4066eeb4), // 5^-178
+    u64_val(0x81ac1fe293d599bf), u64_val(0xc6f14cd848405530), // 5^-177
+    u64_val(0xa21727db38cb002f), u64_val(0xb8ada00e5a506a7c), // 5^-176
+    u64_val(0xca9cf1d206fdc03b), u64_val(0xa6d90811f0e4851c), // 5^-175
+    u64_val(0xfd442e4688bd304a), u64_val(0x908f4a166d1da663), // 5^-174
+    u64_val(0x9e4a9cec15763e2e), u64_val(0x9a598e4e043287fe), // 5^-173
+    u64_val(0xc5dd44271ad3cdba), u64_val(0x40eff1e1853f29fd), // 5^-172
+    u64_val(0xf7549530e188c128), u64_val(0xd12bee59e68ef47c), // 5^-171
+    u64_val(0x9a94dd3e8cf578b9), u64_val(0x82bb74f8301958ce), // 5^-170
+    u64_val(0xc13a148e3032d6e7), u64_val(0xe36a52363c1faf01), // 5^-169
+    u64_val(0xf18899b1bc3f8ca1), u64_val(0xdc44e6c3cb279ac1), // 5^-168
+    u64_val(0x96f5600f15a7b7e5), u64_val(0x29ab103a5ef8c0b9), // 5^-167
+    u64_val(0xbcb2b812db11a5de), u64_val(0x7415d448f6b6f0e7), // 5^-166
+    u64_val(0xebdf661791d60f56), u64_val(0x111b495b3464ad21), // 5^-165
+    u64_val(0x936b9fcebb25c995), u64_val(0xcab10dd900beec34), // 5^-164
+    u64_val(0xb84687c269ef3bfb), u64_val(0x3d5d514f40eea742), // 5^-163
+    u64_val(0xe65829b3046b0afa), u64_val(0x0cb4a5a3112a5112), // 5^-162
+    u64_val(0x8ff71a0fe2c2e6dc), u64_val(0x47f0e785eaba72ab), // 5^-161
+    u64_val(0xb3f4e093db73a093), u64_val(0x59ed216765690f56), // 5^-160
+    u64_val(0xe0f218b8d25088b8), u64_val(0x306869c13ec3532c), // 5^-159
+    u64_val(0x8c974f7383725573), u64_val(0x1e414218c73a13fb), // 5^-158
+    u64_val(0xafbd2350644eeacf), u64_val(0xe5d1929ef90898fa), // 5^-157
+    u64_val(0xdbac6c247d62a583), u64_val(0xdf45f746b74abf39), // 5^-156
+    u64_val(0x894bc396ce5da772), u64_val(0x6b8bba8c328eb783), // 5^-155
+    u64_val(0xab9eb47c81f5114f), u64_val(0x066ea92f3f326564), // 5^-154
+    u64_val(0xd686619ba27255a2), u64_val(0xc80a537b0efefebd), // 5^-153
+    u64_val(0x8613fd0145877585), u64_val(0xbd06742ce95f5f36), // 5^-152
+    u64_val(0xa798fc4196e952e7), u64_val(0x2c48113823b73704), // 5^-151
+    u64_val(0xd17f3b51fca3a7a0), u64_val(0xf75a15862ca504c5), // 5^-150
+    u64_val(0x82ef85133de648c4), u64_val(0x9a984d73dbe722fb), // 5^-149
+    u64_val(0xa3ab66580d5fdaf5), u64_val(0xc13e60d0d2e0ebba), // 5^-148
+    u64_val(0xcc963fee10b7d1b3), u64_val(0x318df905079926a8), // 5^-147
+    u64_val(0xffbbcfe994e5c61f), u64_val(0xfdf17746497f7052), // 5^-146
+    u64_val(0x9fd561f1fd0f9bd3), u64_val(0xfeb6ea8bedefa633), // 5^-145
+    u64_val(0xc7caba6e7c5382c8), u64_val(0xfe64a52ee96b8fc0), // 5^-144
+    u64_val(0xf9bd690a1b68637b), u64_val(0x3dfdce7aa3c673b0), // 5^-143
+    u64_val(0x9c1661a651213e2d), u64_val(0x06bea10ca65c084e), // 5^-142
+    u64_val(0xc31bfa0fe5698db8), u64_val(0x486e494fcff30a62), // 5^-141
+    u64_val(0xf3e2f893dec3f126), u64_val(0x5a89dba3c3efccfa), // 5^-140
+    u64_val(0x986ddb5c6b3a76b7), u64_val(0xf89629465a75e01c), // 5^-139
+    u64_val(0xbe89523386091465), u64_val(0xf6bbb397f1135823), // 5^-138
+    u64_val(0xee2ba6c0678b597f), u64_val(0x746aa07ded582e2c), // 5^-137
+    u64_val(0x94db483840b717ef), u64_val(0xa8c2a44eb4571cdc), // 5^-136
+    u64_val(0xba121a4650e4ddeb), u64_val(0x92f34d62616ce413), // 5^-135
+    u64_val(0xe896a0d7e51e1566), u64_val(0x77b020baf9c81d17), // 5^-134
+    u64_val(0x915e2486ef32cd60), u64_val(0x0ace1474dc1d122e), // 5^-133
+    u64_val(0xb5b5ada8aaff80b8), u64_val(0x0d819992132456ba), // 5^-132
+    u64_val(0xe3231912d5bf60e6), u64_val(0x10e1fff697ed6c69), // 5^-131
+    u64_val(0x8df5efabc5979c8f), u64_val(0xca8d3ffa1ef463c1), // 5^-130
+    u64_val(0xb1736b96b6fd83b3), u64_val(0xbd308ff8a6b17cb2), // 5^-129
+    u64_val(0xddd0467c64bce4a0), u64_val(0xac7cb3f6d05ddbde), // 5^-128
+    u64_val(0x8aa22c0dbef60ee4), u64_val(0x6bcdf07a423aa96b), // 5^-127
+    u64_val(0xad4ab7112eb3929d), u64_val(0x86c16c98d2c953c6), // 5^-126
+    u64_val(0xd89d64d57a607744), u64_val(0xe871c7bf077ba8b7), // 5^-125
+    u64_val(0x87625f056c7c4a8b), u64_val(0x11471cd764ad4972), // 5^-124
+    u64_val(0xa93af6c6c79b5d2d), u64_val(0xd598e40d3dd89bcf), // 5^-123
+    u64_val(0xd389b47879823479), u64_val(0x4aff1d108d4ec2c3), // 5^-122
+    u64_val(0x843610cb4bf160cb), u64_val(0xcedf722a585139ba), // 5^-121
+    u64_val(0xa54394fe1eedb8fe), u64_val(0xc2974eb4ee658828), // 5^-120
+    u64_val(0xce947a3da6a9273e), u64_val(0x733d226229feea32), // 5^-119
+    u64_val(0x811ccc668829b887), u64_val(0x0806357d5a3f525f), // 5^-118
+    u64_val(0xa163ff802a3426a8), u64_val(0xca07c2dcb0cf26f7), // 5^-117
+    u64_val(0xc9bcff6034c13052), u64_val(0xfc89b393dd02f0b5), // 5^-116
+    u64_val(0xfc2c3f3841f17c67), u64_val(0xbbac2078d443ace2), // 5^-115
+    u64_val(0x9d9ba7832936edc0), u64_val(0xd54b944b84aa4c0d), // 5^-114
+    u64_val(0xc5029163f384a931), u64_val(0x0a9e795e65d4df11), // 5^-113
+    u64_val(0xf64335bcf065d37d), u64_val(0x4d4617b5ff4a16d5), // 5^-112
+    u64_val(0x99ea0196163fa42e), u64_val(0x504bced1bf8e4e45), // 5^-111
+    u64_val(0xc06481fb9bcf8d39), u64_val(0xe45ec2862f71e1d6), // 5^-110
+    u64_val(0xf07da27a82c37088), u64_val(0x5d767327bb4e5a4c), // 5^-109
+    u64_val(0x964e858c91ba2655), u64_val(0x3a6a07f8d510f86f), // 5^-108
+    u64_val(0xbbe226efb628afea), u64_val(0x890489f70a55368b), // 5^-107
+    u64_val(0xeadab0aba3b2dbe5), u64_val(0x2b45ac74ccea842e), // 5^-106
+    u64_val(0x92c8ae6b464fc96f), u64_val(0x3b0b8bc90012929d), // 5^-105
+    u64_val(0xb77ada0617e3bbcb), u64_val(0x09ce6ebb40173744), // 5^-104
+    u64_val(0xe55990879ddcaabd), u64_val(0xcc420a6a101d0515), // 5^-103
+    u64_val(0x8f57fa54c2a9eab6), u64_val(0x9fa946824a12232d), // 5^-102
+    u64_val(0xb32df8e9f3546564), u64_val(0x47939822dc96abf9), // 5^-101
+    u64_val(0xdff9772470297ebd), u64_val(0x59787e2b93bc56f7), // 5^-100
+    u64_val(0x8bfbea76c619ef36), u64_val(0x57eb4edb3c55b65a), // 5^-99
+    u64_val(0xaefae51477a06b03), u64_val(0xede622920b6b23f1), // 5^-98
+    u64_val(0xdab99e59958885c4), u64_val(0xe95fab368e45eced), // 5^-97
+    u64_val(0x88b402f7fd75539b), u64_val(0x11dbcb0218ebb414), // 5^-96
+    u64_val(0xaae103b5fcd2a881), u64_val(0xd652bdc29f26a119), // 5^-95
+    u64_val(0xd59944a37c0752a2), u64_val(0x4be76d3346f0495f), // 5^-94
+    u64_val(0x857fcae62d8493a5), u64_val(0x6f70a4400c562ddb), // 5^-93
+    u64_val(0xa6dfbd9fb8e5b88e), u64_val(0xcb4ccd500f6bb952), // 5^-92
+    u64_val(0xd097ad07a71f26b2), u64_val(0x7e2000a41346a7a7), // 5^-91
+    u64_val(0x825ecc24c873782f), u64_val(0x8ed400668c0c28c8), // 5^-90
+    u64_val(0xa2f67f2dfa90563b), u64_val(0x728900802f0f32fa), // 5^-89
+    u64_val(0xcbb41ef979346bca), u64_val(0x4f2b40a03ad2ffb9), // 5^-88
+    u64_val(0xfea126b7d78186bc), u64_val(0xe2f610c84987bfa8), // 5^-87
+    u64_val(0x9f24b832e6b0f436), u64_val(0x0dd9ca7d2df4d7c9), // 5^-86
+    u64_val(0xc6ede63fa05d3143), u64_val(0x91503d1c79720dbb), // 5^-85
+    u64_val(0xf8a95fcf88747d94), u64_val(0x75a44c6397ce912a), // 5^-84
+    u64_val(0x9b69dbe1b548ce7c), u64_val(0xc986afbe3ee11aba), // 5^-83
+    u64_val(0xc24452da229b021b), u64_val(0xfbe85badce996168), // 5^-82
+    u64_val(0xf2d56790ab41c2a2), u64_val(0xfae27299423fb9c3), // 5^-81
+    u64_val(0x97c560ba6b0919a5), u64_val(0xdccd879fc967d41a), // 5^-80
+    u64_val(0xbdb6b8e905cb600f), u64_val(0x5400e987bbc1c920), // 5^-79
+    u64_val(0xed246723473e3813), u64_val(0x290123e9aab23b68), // 5^-78
+    u64_val(0x9436c0760c86e30b), u64_val(0xf9a0b6720aaf6521), // 5^-77
+    u64_val(0xb94470938fa89bce), u64_val(0xf808e40e8d5b3e69), // 5^-76
+    u64_val(0xe7958cb87392c2c2), u64_val(0xb60b1d1230b20e04), // 5^-75
+    u64_val(0x90bd77f3483bb9b9), u64_val(0xb1c6f22b5e6f48c2), // 5^-74
+    u64_val(0xb4ecd5f01a4aa828), u64_val(0x1e38aeb6360b1af3), // 5^-73
+    u64_val(0xe2280b6c20dd5232), u64_val(0x25c6da63c38de1b0), // 5^-72
+    u64_val(0x8d590723948a535f), u64_val(0x579c487e5a38ad0e), // 5^-71
+    u64_val(0xb0af48ec79ace837), u64_val(0x2d835a9df0c6d851), // 5^-70
+    u64_val(0xdcdb1b2798182244), u64_val(0xf8e431456cf88e65), // 5^-69
+    u64_val(0x8a08f0f8bf0f156b), u64_val(0x1b8e9ecb641b58ff), // 5^-68
+    u64_val(0xac8b2d36eed2dac5), u64_val(0xe272467e3d222f3f), // 5^-67
+    u64_val(0xd7adf884aa879177), u64_val(0x5b0ed81dcc6abb0f), // 5^-66
+    u64_val(0x86ccbb52ea94baea), u64_val(0x98e947129fc2b4e9), // 5^-65
+    u64_val(0xa87fea27a539e9a5), u64_val(0x3f2398d747b36224), // 5^-64
+    u64_val(0xd29fe4b18e88640e), u64_val(0x8eec7f0d19a03aad), // 5^-63
+    u64_val(0x83a3eeeef9153e89), u64_val(0x1953cf68300424ac), // 5^-62
+    u64_val(0xa48ceaaab75a8e2b), u64_val(0x5fa8c3423c052dd7), // 5^-61
+    u64_val(0xcdb02555653131b6), u64_val(0x3792f412cb06794d), // 5^-60
+    u64_val(0x808e17555f3ebf11), u64_val(0xe2bbd88bbee40bd0), // 5^-59
+    u64_val(0xa0b19d2ab70e6ed6), u64_val(0x5b6aceaeae9d0ec4), // 5^-58
+    u64_val(0xc8de047564d20a8b), u64_val(0xf245825a5a445275), // 5^-57
+    u64_val(0xfb158592be068d2e), u64_val(0xeed6e2f0f0d56712), // 5^-56
+    u64_val(0x9ced737bb6c4183d), u64_val(0x55464dd69685606b), // 5^-55
+    u64_val(0xc428d05aa4751e4c), u64_val(0xaa97e14c3c26b886), // 5^-54
+    u64_val(0xf53304714d9265df), u64_val(0xd53dd99f4b3066a8), // 5^-53
+    u64_val(0x993fe2c6d07b7fab), u64_val(0xe546a8038efe4029), // 5^-52
+    u64_val(0xbf8fdb78849a5f96), u64_val(0xde98520472bdd033), // 5^-51
+    u64_val(0xef73d256a5c0f77c), u64_val(0x963e66858f6d4440), // 5^-50
+    u64_val(0x95a8637627989aad), u64_val(0xdde7001379a44aa8), // 5^-49
+    u64_val(0xbb127c53b17ec159), u64_val(0x5560c018580d5d52), // 5^-48
+    u64_val(0xe9d71b689dde71af), u64_val(0xaab8f01e6e10b4a6), // 5^-47
+    u64_val(0x9226712162ab070d), u64_val(0xcab3961304ca70e8), // 5^-46
+    u64_val(0xb6b00d69bb55c8d1), u64_val(0x3d607b97c5fd0d22), // 5^-45
+    u64_val(0xe45c10c42a2b3b05), u64_val(0x8cb89a7db77c506a), // 5^-44
+    u64_val(0x8eb98a7a9a5b04e3), u64_val(0x77f3608e92adb242), // 5^-43
+    u64_val(0xb267ed1940f1c61c), u64_val(0x55f038b237591ed3), // 5^-42
+    u64_val(0xdf01e85f912e37a3), u64_val(0x6b6c46dec52f6688), // 5^-41
+    u64_val(0x8b61313bbabce2c6), u64_val(0x2323ac4b3b3da015), // 5^-40
+    u64_val(0xae397d8aa96c1b77), u64_val(0xabec975e0a0d081a), // 5^-39
+    u64_val(0xd9c7dced53c72255), u64_val(0x96e7bd358c904a21), // 5^-38
+    u64_val(0x881cea14545c7575), u64_val(0x7e50d64177da2e54), // 5^-37
+    u64_val(0xaa242499697392d2), u64_val(0xdde50bd1d5d0b9e9), // 5^-36
+    u64_val(0xd4ad2dbfc3d07787), u64_val(0x955e4ec64b44e864), // 5^-35
+    u64_val(0x84ec3c97da624ab4), u64_val(0xbd5af13bef0b113e), // 5^-34
+    u64_val(0xa6274bbdd0fadd61), u64_val(0xecb1ad8aeacdd58e), // 5^-33
+    u64_val(0xcfb11ead453994ba), u64_val(0x67de18eda5814af2), // 5^-32
+    u64_val(0x81ceb32c4b43fcf4), u64_val(0x80eacf948770ced7), // 5^-31
+    u64_val(0xa2425ff75e14fc31), u64_val(0xa1258379a94d028d), // 5^-30
+    u64_val(0xcad2f7f5359a3b3e), u64_val(0x096ee45813a04330), // 5^-29
+    u64_val(0xfd87b5f28300ca0d), u64_val(0x8bca9d6e188853fc), // 5^-28
+    u64_val(0x9e74d1b791e07e48), u64_val(0x775ea264cf55347e), // 5^-27
+    u64_val(0xc612062576589dda), u64_val(0x95364afe032a819e), // 5^-26
+    u64_val(0xf79687aed3eec551), u64_val(0x3a83ddbd83f52205), // 5^-25
+    u64_val(0x9abe14cd44753b52), u64_val(0xc4926a9672793543), // 5^-24
+    u64_val(0xc16d9a0095928a27), u64_val(0x75b7053c0f178294), // 5^-23
+    u64_val(0xf1c90080baf72cb1), u64_val(0x5324c68b12dd6339), // 5^-22
+    u64_val(0x971da05074da7bee), u64_val(0xd3f6fc16ebca5e04), // 5^-21
+    u64_val(0xbce5086492111aea), u64_val(0x88f4bb1ca6bcf585), // 5^-20
+    u64_val(0xec1e4a7db69561a5), u64_val(0x2b31e9e3d06c32e6), // 5^-19
+    u64_val(0x9392ee8e921d5d07), u64_val(0x3aff322e62439fd0), // 5^-18
+    u64_val(0xb877aa3236a4b449), u64_val(0x09befeb9fad487c3), // 5^-17
+    u64_val(0xe69594bec44de15b), u64_val(0x4c2ebe687989a9b4), // 5^-16
+    u64_val(0x901d7cf73ab0acd9), u64_val(0x0f9d37014bf60a11), // 5^-15
+    u64_val(0xb424dc35095cd80f), u64_val(0x538484c19ef38c95), // 5^-14
+    u64_val(0xe12e13424bb40e13), u64_val(0x2865a5f206b06fba), // 5^-13
+    u64_val(0x8cbccc096f5088cb), u64_val(0xf93f87b7442e45d4), // 5^-12
+    u64_val(0xafebff0bcb24aafe), u64_val(0xf78f69a51539d749), // 5^-11
+    u64_val(0xdbe6fecebdedd5be), u64_val(0xb573440e5a884d1c), // 5^-10
+    u64_val(0x89705f4136b4a597), u64_val(0x31680a88f8953031), // 5^-9
+    u64_val(0xabcc77118461cefc), u64_val(0xfdc20d2b36ba7c3e), // 5^-8
+    u64_val(0xd6bf94d5e57a42bc), u64_val(0x3d32907604691b4d), // 5^-7
+    u64_val(0x8637bd05af6c69b5), u64_val(0xa63f9a49c2c1b110), // 5^-6
+    u64_val(0xa7c5ac471b478423), u64_val(0x0fcf80dc33721d54), // 5^-5
+    u64_val(0xd1b71758e219652b), u64_val(0xd3c36113404ea4a9), // 5^-4
+    u64_val(0x83126e978d4fdf3b), u64_val(0x645a1cac083126ea), // 5^-3
+    u64_val(0xa3d70a3d70a3d70a), u64_val(0x3d70a3d70a3d70a4), // 5^-2
+    u64_val(0xcccccccccccccccc), u64_val(0xcccccccccccccccd), // 5^-1
+    u64_val(0x8000000000000000), u64_val(0x0000000000000000), // 5^0
+    u64_val(0xa000000000000000), u64_val(0x0000000000000000), // 5^1
+    u64_val(0xc800000000000000), u64_val(0x0000000000000000), // 5^2
+    u64_val(0xfa00000000000000), u64_val(0x0000000000000000), // 5^3
+    u64_val(0x9c40000000000000), u64_val(0x0000000000000000), // 5^4
+    u64_val(0xc350000000000000), u64_val(0x0000000000000000), // 5^5
+    u64_val(0xf424000000000000), u64_val(0x0000000000000000), // 5^6
+    u64_val(0x9896800000000000), u64_val(0x0000000000000000), // 5^7
+    u64_val(0xbebc200000000000), u64_val(0x0000000000000000), // 5^8
+    u64_val(0xee6b280000000000), u64_val(0x0000000000000000), // 5^9
+    u64_val(0x9502f90000000000), u64_val(0x0000000000000000), // 5^10
+    u64_val(0xba43b74000000000), u64_val(0x0000000000000000), // 5^11
+    u64_val(0xe8d4a51000000000), u64_val(0x0000000000000000), // 5^12
+    u64_val(0x9184e72a00000000), u64_val(0x0000000000000000), // 5^13
+    u64_val(0xb5e620f480000000), u64_val(0x0000000000000000), // 5^14
+    u64_val(0xe35fa931a0000000), u64_val(0x0000000000000000), // 5^15
+    u64_val(0x8e1bc9bf04000000), u64_val(0x0000000000000000), // 5^16
+    u64_val(0xb1a2bc2ec5000000), u64_val(0x0000000000000000), // 5^17
+    u64_val(0xde0b6b3a76400000), u64_val(0x0000000000000000), // 5^18
+    u64_val(0x8ac7230489e80000), u64_val(0x0000000000000000), // 5^19
+    u64_val(0xad78ebc5ac620000), u64_val(0x0000000000000000), // 5^20
+    u64_val(0xd8d726b7177a8000), u64_val(0x0000000000000000), // 5^21
+    u64_val(0x878678326eac9000), u64_val(0x0000000000000000), // 5^22
+    u64_val(0xa968163f0a57b400), u64_val(0x0000000000000000), // 5^23
+    u64_val(0xd3c21bcecceda100), u64_val(0x0000000000000000), // 5^24
+    u64_val(0x84595161401484a0), u64_val(0x0000000000000000), // 5^25
+    u64_val(0xa56fa5b99019a5c8), u64_val(0x0000000000000000), // 5^26
+    u64_val(0xcecb8f27f4200f3a), u64_val(0x0000000000000000), // 5^27
+    u64_val(0x813f3978f8940984), u64_val(0x4000000000000000), // 5^28
+    u64_val(0xa18f07d736b90be5), u64_val(0x5000000000000000), // 5^29
+    u64_val(0xc9f2c9cd04674ede), u64_val(0xa400000000000000), // 5^30
+    u64_val(0xfc6f7c4045812296), u64_val(0x4d00000000000000), // 5^31
+    u64_val(0x9dc5ada82b70b59d), u64_val(0xf020000000000000), // 5^32
+    u64_val(0xc5371912364ce305), u64_val(0x6c28000000000000), // 5^33
+    u64_val(0xf684df56c3e01bc6), u64_val(0xc732000000000000), // 5^34
+    u64_val(0x9a130b963a6c115c), u64_val(0x3c7f400000000000), // 5^35
+    u64_val(0xc097ce7bc90715b3), u64_val(0x4b9f100000000000), // 5^36
+    u64_val(0xf0bdc21abb48db20), u64_val(0x1e86d40000000000), // 5^37
+    u64_val(0x96769950b50d88f4), u64_val(0x1314448000000000), // 5^38
+    u64_val(0xbc143fa4e250eb31), u64_val(0x17d955a000000000), // 5^39
+    u64_val(0xeb194f8e1ae525fd), u64_val(0x5dcfab0800000000), // 5^40
+    u64_val(0x92efd1b8d0cf37be), u64_val(0x5aa1cae500000000), // 5^41
+    u64_val(0xb7abc627050305ad), u64_val(0xf14a3d9e40000000), // 5^42
+    u64_val(0xe596b7b0c643c719), u64_val(0x6d9ccd05d0000000), // 5^43
+    u64_val(0x8f7e32ce7bea5c6f), u64_val(0xe4820023a2000000), // 5^44
+    u64_val(0xb35dbf821ae4f38b), u64_val(0xdda2802c8a800000), // 5^45
+    u64_val(0xe0352f62a19e306e), u64_val(0xd50b2037ad200000), // 5^46
+    u64_val(0x8c213d9da502de45), u64_val(0x4526f422cc340000), // 5^47
+    u64_val(0xaf298d050e4395d6), u64_val(0x9670b12b7f410000), // 5^48
+    u64_val(0xdaf3f04651d47b4c), u64_val(0x3c0cdd765f114000), // 5^49
+    u64_val(0x88d8762bf324cd0f), u64_val(0xa5880a69fb6ac800), // 5^50
+    u64_val(0xab0e93b6efee0053), u64_val(0x8eea0d047a457a00), // 5^51
+    u64_val(0xd5d238a4abe98068), u64_val(0x72a4904598d6d880), // 5^52
+    u64_val(0x85a36366eb71f041), u64_val(0x47a6da2b7f864750), // 5^53
+    u64_val(0xa70c3c40a64e6c51), u64_val(0x999090b65f67d924), // 5^54
+    u64_val(0xd0cf4b50cfe20765), u64_val(0xfff4b4e3f741cf6d), // 5^55
+    u64_val(0x82818f1281ed449f), u64_val(0xbff8f10e7a8921a4), // 5^56
+    u64_val(0xa321f2d7226895c7), u64_val(0xaff72d52192b6a0d), // 5^57
+    u64_val(0xcbea6f8ceb02bb39), u64_val(0x9bf4f8a69f764490), // 5^58
+    u64_val(0xfee50b7025c36a08), u64_val(0x02f236d04753d5b4), // 5^59
+    u64_val(0x9f4f2726179a2245), u64_val(0x01d762422c946590), // 5^60
+    u64_val(0xc722f0ef9d80aad6), u64_val(0x424d3ad2b7b97ef5), // 5^61
+    u64_val(0xf8ebad2b84e0d58b), u64_val(0xd2e0898765a7deb2), // 5^62
+    u64_val(0x9b934c3b330c8577), u64_val(0x63cc55f49f88eb2f), // 5^63
+    u64_val(0xc2781f49ffcfa6d5), u64_val(0x3cbf6b71c76b25fb), // 5^64
+    u64_val(0xf316271c7fc3908a), u64_val(0x8bef464e3945ef7a), // 5^65
+    u64_val(0x97edd871cfda3a56), u64_val(0x97758bf0e3cbb5ac), // 5^66
+    u64_val(0xbde94e8e43d0c8ec), u64_val(0x3d52eeed1cbea317), // 5^67
+    u64_val(0xed63a231d4c4fb27), u64_val(0x4ca7aaa863ee4bdd), // 5^68
+    u64_val(0x945e455f24fb1cf8), u64_val(0x8fe8caa93e74ef6a), // 5^69
+    u64_val(0xb975d6b6ee39e436), u64_val(0xb3e2fd538e122b44), // 5^70
+    u64_val(0xe7d34c64a9c85d44), u64_val(0x60dbbca87196b616), // 5^71
+    u64_val(0x90e40fbeea1d3a4a), u64_val(0xbc8955e946fe31cd), // 5^72
+    u64_val(0xb51d13aea4a488dd), u64_val(0x6babab6398bdbe41), // 5^73
+    u64_val(0xe264589a4dcdab14), u64_val(0xc696963c7eed2dd1), // 5^74
+    u64_val(0x8d7eb76070a08aec), u64_val(0xfc1e1de5cf543ca2), // 5^75
+    u64_val(0xb0de65388cc8ada8), u64_val(0x3b25a55f43294bcb), // 5^76
+    u64_val(0xdd15fe86affad912), u64_val(0x49ef0eb713f39ebe), // 5^77
+    u64_val(0x8a2dbf142dfcc7ab), u64_val(0x6e3569326c784337), // 5^78
+    u64_val(0xacb92ed9397bf996), u64_val(0x49c2c37f07965404), // 5^79
+    u64_val(0xd7e77a8f87daf7fb), u64_val(0xdc33745ec97be906), // 5^80
+    u64_val(0x86f0ac99b4e8dafd), u64_val(0x69a028bb3ded71a3), // 5^81
+    u64_val(0xa8acd7c0222311bc), u64_val(0xc40832ea0d68ce0c), // 5^82
+    u64_val(0xd2d80db02aabd62b), u64_val(0xf50a3fa490c30190), // 5^83
+    u64_val(0x83c7088e1aab65db), u64_val(0x792667c6da79e0fa), // 5^84
+    u64_val(0xa4b8cab1a1563f52), u64_val(0x577001b891185938), // 5^85
+    u64_val(0xcde6fd5e09abcf26), u64_val(0xed4c0226b55e6f86), // 5^86
+    u64_val(0x80b05e5ac60b6178), u64_val(0x544f8158315b05b4), // 5^87
+    u64_val(0xa0dc75f1778e39d6), u64_val(0x696361ae3db1c721), // 5^88
+    u64_val(0xc913936dd571c84c), u64_val(0x03bc3a19cd1e38e9), // 5^89
+    u64_val(0xfb5878494ace3a5f), u64_val(0x04ab48a04065c723), // 5^90
+    u64_val(0x9d174b2dcec0e47b), u64_val(0x62eb0d64283f9c76), // 5^91
+    u64_val(0xc45d1df942711d9a), u64_val(0x3ba5d0bd324f8394), // 5^92
+    u64_val(0xf5746577930d6500), u64_val(0xca8f44ec7ee36479), // 5^93
+    u64_val(0x9968bf6abbe85f20), u64_val(0x7e998b13cf4e1ecb), // 5^94
+    u64_val(0xbfc2ef456ae276e8), u64_val(0x9e3fedd8c321a67e), // 5^95
+    u64_val(0xefb3ab16c59b14a2), u64_val(0xc5cfe94ef3ea101e), // 5^96
+    u64_val(0x95d04aee3b80ece5), u64_val(0xbba1f1d158724a12), // 5^97
+    u64_val(0xbb445da9ca61281f), u64_val(0x2a8a6e45ae8edc97), // 5^98
+    u64_val(0xea1575143cf97226), u64_val(0xf52d09d71a3293bd), // 5^99
+    u64_val(0x924d692ca61be758), u64_val(0x593c2626705f9c56), // 5^100
+    u64_val(0xb6e0c377cfa2e12e), u64_val(0x6f8b2fb00c77836c), // 5^101
+    u64_val(0xe498f455c38b997a), u64_val(0x0b6dfb9c0f956447), // 5^102
+    u64_val(0x8edf98b59a373fec), u64_val(0x4724bd4189bd5eac), // 5^103
+    u64_val(0xb2977ee300c50fe7), u64_val(0x58edec91ec2cb657), // 5^104
+    u64_val(0xdf3d5e9bc0f653e1), u64_val(0x2f2967b66737e3ed), // 5^105
+    u64_val(0x8b865b215899f46c), u64_val(0xbd79e0d20082ee74), // 5^106
+    u64_val(0xae67f1e9aec07187), u64_val(0xecd8590680a3aa11), // 5^107
+    u64_val(0xda01ee641a708de9), u64_val(0xe80e6f4820cc9495), // 5^108
+    u64_val(0x884134fe908658b2), u64_val(0x3109058d147fdcdd), // 5^109
+    u64_val(0xaa51823e34a7eede), u64_val(0xbd4b46f0599fd415), // 5^110
+    u64_val(0xd4e5e2cdc1d1ea96), u64_val(0x6c9e18ac7007c91a), // 5^111
+    u64_val(0x850fadc09923329e), u64_val(0x03e2cf6bc604ddb0), // 5^112
+    u64_val(0xa6539930bf6bff45), u64_val(0x84db8346b786151c), // 5^113
+    u64_val(0xcfe87f7cef46ff16), u64_val(0xe612641865679a63), // 5^114
+    u64_val(0x81f14fae158c5f6e), u64_val(0x4fcb7e8f3f60c07e), // 5^115
+    u64_val(0xa26da3999aef7749), u64_val(0xe3be5e330f38f09d), // 5^116
+    u64_val(0xcb090c8001ab551c), u64_val(0x5cadf5bfd3072cc5), // 5^117
+    u64_val(0xfdcb4fa002162a63), u64_val(0x73d9732fc7c8f7f6), // 5^118
+    u64_val(0x9e9f11c4014dda7e), u64_val(0x2867e7fddcdd9afa), // 5^119
+    u64_val(0xc646d63501a1511d), u64_val(0xb281e1fd541501b8), // 5^120
+    u64_val(0xf7d88bc24209a565), u64_val(0x1f225a7ca91a4226), // 5^121
+    u64_val(0x9ae757596946075f), u64_val(0x3375788de9b06958), // 5^122
+    u64_val(0xc1a12d2fc3978937), u64_val(0x0052d6b1641c83ae), // 5^123
+    u64_val(0xf209787bb47d6b84), u64_val(0xc0678c5dbd23a49a), // 5^124
+    u64_val(0x9745eb4d50ce6332), u64_val(0xf840b7ba963646e0), // 5^125
+    u64_val(0xbd176620a501fbff), u64_val(0xb650e5a93bc3d898), // 5^126
+    u64_val(0xec5d3fa8ce427aff), u64_val(0xa3e51f138ab4cebe), // 5^127
+    u64_val(0x93ba47c980e98cdf), u64_val(0xc66f336c36b10137), // 5^128
+    u64_val(0xb8a8d9bbe123f017), u64_val(0xb80b0047445d4184), // 5^129
+    u64_val(0xe6d3102ad96cec1d), u64_val(0xa60dc059157491e5), // 5^130
+    u64_val(0x9043ea1ac7e41392), u64_val(0x87c89837ad68db2f), // 5^131
+    u64_val(0xb454e4a179dd1877), u64_val(0x29babe4598c311fb), // 5^132
+    u64_val(0xe16a1dc9d8545e94), u64_val(0xf4296dd6fef3d67a), // 5^133
+    u64_val(0x8ce2529e2734bb1d), u64_val(0x1899e4a65f58660c), // 5^134
+    u64_val(0xb01ae745b101e9e4), u64_val(0x5ec05dcff72e7f8f), // 5^135
+    u64_val(0xdc21a1171d42645d), u64_val(0x76707543f4fa1f73), // 5^136
+    u64_val(0x899504ae72497eba), u64_val(0x6a06494a791c53a8), // 5^137
+    u64_val(0xabfa45da0edbde69), u64_val(0x0487db9d17636892), // 5^138
+    u64_val(0xd6f8d7509292d603), u64_val(0x45a9d2845d3c42b6), // 5^139
+    u64_val(0x865b86925b9bc5c2), u64_val(0x0b8a2392ba45a9b2), // 5^140
+    u64_val(0xa7f26836f282b732), u64_val(0x8e6cac7768d7141e), // 5^141
+    u64_val(0xd1ef0244af2364ff), u64_val(0x3207d795430cd926), // 5^142
+    u64_val(0x8335616aed761f1f), u64_val(0x7f44e6bd49e807b8), // 5^143
+    u64_val(0xa402b9c5a8d3a6e7), u64_val(0x5f16206c9c6209a6), // 5^144
+    u64_val(0xcd036837130890a1), u64_val(0x36dba887c37a8c0f), // 5^145
+    u64_val(0x802221226be55a64), u64_val(0xc2494954da2c9789), // 5^146
+    u64_val(0xa02aa96b06deb0fd), u64_val(0xf2db9baa10b7bd6c), // 5^147
+    u64_val(0xc83553c5c8965d3d), u64_val(0x6f92829494e5acc7), // 5^148
+    u64_val(0xfa42a8b73abbf48c), u64_val(0xcb772339ba1f17f9), // 5^149
+    u64_val(0x9c69a97284b578d7), u64_val(0xff2a760414536efb), // 5^150
+    u64_val(0xc38413cf25e2d70d), u64_val(0xfef5138519684aba), // 5^151
+    u64_val(0xf46518c2ef5b8cd1), u64_val(0x7eb258665fc25d69), // 5^152
+    u64_val(0x98bf2f79d5993802), u64_val(0xef2f773ffbd97a61), // 5^153
+    u64_val(0xbeeefb584aff8603), u64_val(0xaafb550ffacfd8fa), // 5^154
+    u64_val(0xeeaaba2e5dbf6784), u64_val(0x95ba2a53f983cf38), // 5^155
+    u64_val(0x952ab45cfa97a0b2), u64_val(0xdd945a747bf26183), // 5^156
+    u64_val(0xba756174393d88df), u64_val(0x94f971119aeef9e4), // 5^157
+    u64_val(0xe912b9d1478ceb17), u64_val(0x7a37cd5601aab85d), // 5^158
+    u64_val(0x91abb422ccb812ee), u64_val(0xac62e055c10ab33a), // 5^159
+    u64_val(0xb616a12b7fe617aa), u64_val(0x577b986b314d6009), // 5^160
+    u64_val(0xe39c49765fdf9d94), u64_val(0xed5a7e85fda0b80b), // 5^161
+    u64_val(0x8e41ade9fbebc27d), u64_val(0x14588f13be847307), // 5^162
+    u64_val(0xb1d219647ae6b31c), u64_val(0x596eb2d8ae258fc8), // 5^163
+    u64_val(0xde469fbd99a05fe3), u64_val(0x6fca5f8ed9aef3bb), // 5^164
+    u64_val(0x8aec23d680043bee), u64_val(0x25de7bb9480d5854), // 5^165
+    u64_val(0xada72ccc20054ae9), u64_val(0xaf561aa79a10ae6a), // 5^166
+    u64_val(0xd910f7ff28069da4), u64_val(0x1b2ba1518094da04), // 5^167
+    u64_val(0x87aa9aff79042286), u64_val(0x90fb44d2f05d0842), // 5^168
+    u64_val(0xa99541bf57452b28), u64_val(0x353a1607ac744a53), // 5^169
+    u64_val(0xd3fa922f2d1675f2), u64_val(0x42889b8997915ce8), // 5^170
+    u64_val(0x847c9b5d7c2e09b7), u64_val(0x69956135febada11), // 5^171
+    u64_val(0xa59bc234db398c25), u64_val(0x43fab9837e699095), // 5^172
+    u64_val(0xcf02b2c21207ef2e), u64_val(0x94f967e45e03f4bb), // 5^173
+    u64_val(0x8161afb94b44f57d), u64_val(0x1d1be0eebac278f5), // 5^174
+    u64_val(0xa1ba1ba79e1632dc), u64_val(0x6462d92a69731732), // 5^175
+    u64_val(0xca28a291859bbf93), u64_val(0x7d7b8f7503cfdcfe), // 5^176
+    u64_val(0xfcb2cb35e702af78), u64_val(0x5cda735244c3d43e), // 5^177
+    u64_val(0x9defbf01b061adab), u64_val(0x3a0888136afa64a7), // 5^178
+    u64_val(0xc56baec21c7a1916), u64_val(0x088aaa1845b8fdd0), // 5^179
+    u64_val(0xf6c69a72a3989f5b), u64_val(0x8aad549e57273d45), // 5^180
+    u64_val(0x9a3c2087a63f6399), u64_val(0x36ac54e2f678864b), // 5^181
+    u64_val(0xc0cb28a98fcf3c7f), u64_val(0x84576a1bb416a7dd), // 5^182
+    u64_val(0xf0fdf2d3f3c30b9f), u64_val(0x656d44a2a11c51d5), // 5^183
+    u64_val(0x969eb7c47859e743), u64_val(0x9f644ae5a4b1b325), // 5^184
+    u64_val(0xbc4665b596706114), u64_val(0x873d5d9f0dde1fee), // 5^185
+    u64_val(0xeb57ff22fc0c7959), u64_val(0xa90cb506d155a7ea), // 5^186
+    u64_val(0x9316ff75dd87cbd8), u64_val(0x09a7f12442d588f2), // 5^187
+    u64_val(0xb7dcbf5354e9bece), u64_val(0x0c11ed6d538aeb2f), // 5^188
+    u64_val(0xe5d3ef282a242e81), u64_val(0x8f1668c8a86da5fa), // 5^189
+    u64_val(0x8fa475791a569d10), u64_val(0xf96e017d694487bc), // 5^190
+    u64_val(0xb38d92d760ec4455), u64_val(0x37c981dcc395a9ac), // 5^191
+    u64_val(0xe070f78d3927556a), u64_val(0x85bbe253f47b1417), // 5^192
+    u64_val(0x8c469ab843b89562), u64_val(0x93956d7478ccec8e), // 5^193
+    u64_val(0xaf58416654a6babb), u64_val(0x387ac8d1970027b2), // 5^194
+    u64_val(0xdb2e51bfe9d0696a), u64_val(0x06997b05fcc0319e), // 5^195
+    u64_val(0x88fcf317f22241e2), u64_val(0x441fece3bdf81f03), // 5^196
+    u64_val(0xab3c2fddeeaad25a), u64_val(0xd527e81cad7626c3), // 5^197
+    u64_val(0xd60b3bd56a5586f1), u64_val(0x8a71e223d8d3b074), // 5^198
+    u64_val(0x85c7056562757456), u64_val(0xf6872d5667844e49), // 5^199
+    u64_val(0xa738c6bebb12d16c), u64_val(0xb428f8ac016561db), // 5^200
+    u64_val(0xd106f86e69d785c7), u64_val(0xe13336d701beba52), // 5^201
+    u64_val(0x82a45b450226b39c), u64_val(0xecc0024661173473), // 5^202
+    u64_val(0xa34d721642b06084), u64_val(0x27f002d7f95d0190), // 5^203
+    u64_val(0xcc20ce9bd35c78a5), u64_val(0x31ec038df7b441f4), // 5^204
+    u64_val(0xff290242c83396ce), u64_val(0x7e67047175a15271), // 5^205
+    u64_val(0x9f79a169bd203e41), u64_val(0x0f0062c6e984d386), // 5^206
+    u64_val(0xc75809c42c684dd1), u64_val(0x52c07b78a3e60868), // 5^207
+    u64_val(0xf92e0c3537826145), u64_val(0xa7709a56ccdf8a82), // 5^208
+    u64_val(0x9bbcc7a142b17ccb), u64_val(0x88a66076400bb691), // 5^209
+    u64_val(0xc2abf989935ddbfe), u64_val(0x6acff893d00ea435), // 5^210
+    u64_val(0xf356f7ebf83552fe), u64_val(0x0583f6b8c4124d43), // 5^211
+    u64_val(0x98165af37b2153de), u64_val(0xc3727a337a8b704a), // 5^212
+    u64_val(0xbe1bf1b059e9a8d6), u64_val(0x744f18c0592e4c5c), // 5^213
+    u64_val(0xeda2ee1c7064130c), u64_val(0x1162def06f79df73), // 5^214
+    u64_val(0x9485d4d1c63e8be7), u64_val(0x8addcb5645ac2ba8), // 5^215
+    u64_val(0xb9a74a0637ce2ee1), u64_val(0x6d953e2bd7173692), // 5^216
+    u64_val(0xe8111c87c5c1ba99), u64_val(0xc8fa8db6ccdd0437), // 5^217
+    u64_val(0x910ab1d4db9914a0), u64_val(0x1d9c9892400a22a2), // 5^218
+    u64_val(0xb54d5e4a127f59c8), u64_val(0x2503beb6d00cab4b), // 5^219
+    u64_val(0xe2a0b5dc971f303a), u64_val(0x2e44ae64840fd61d), // 5^220
+    u64_val(0x8da471a9de737e24), u64_val(0x5ceaecfed289e5d2), // 5^221
+    u64_val(0xb10d8e1456105dad), u64_val(0x7425a83e872c5f47), // 5^222
+    u64_val(0xdd50f1996b947518), u64_val(0xd12f124e28f77719), // 5^223
+    u64_val(0x8a5296ffe33cc92f), u64_val(0x82bd6b70d99aaa6f), // 5^224
+    u64_val(0xace73cbfdc0bfb7b), u64_val(0x636cc64d1001550b), // 5^225
+    u64_val(0xd8210befd30efa5a), u64_val(0x3c47f7e05401aa4e), // 5^226
+    u64_val(0x8714a775e3e95c78), u64_val(0x65acfaec34810a71), // 5^227
+    u64_val(0xa8d9d1535ce3b396), u64_val(0x7f1839a741a14d0d), // 5^228
+    u64_val(0xd31045a8341ca07c), u64_val(0x1ede48111209a050), // 5^229
+    u64_val(0x83ea2b892091e44d), u64_val(0x934aed0aab460432), // 5^230
+    u64_val(0xa4e4b66b68b65d60), u64_val(0xf81da84d5617853f), // 5^231
+    u64_val(0xce1de40642e3f4b9), u64_val(0x36251260ab9d668e), // 5^232
+    u64_val(0x80d2ae83e9ce78f3), u64_val(0xc1d72b7c6b426019), // 5^233
+    u64_val(0xa1075a24e4421730), u64_val(0xb24cf65b8612f81f), // 5^234
+    u64_val(0xc94930ae1d529cfc), u64_val(0xdee033f26797b627), // 5^235
+    u64_val(0xfb9b7cd9a4a7443c), u64_val(0x169840ef017da3b1), // 5^236
+    u64_val(0x9d412e0806e88aa5), u64_val(0x8e1f289560ee864e), // 5^237
+    u64_val(0xc491798a08a2ad4e), u64_val(0xf1a6f2bab92a27e2), // 5^238
+    u64_val(0xf5b5d7ec8acb58a2), u64_val(0xae10af696774b1db), // 5^239
+    u64_val(0x9991a6f3d6bf1765), u64_val(0xacca6da1e0a8ef29), // 5^240
+    u64_val(0xbff610b0cc6edd3f), u64_val(0x17fd090a58d32af3), // 5^241
+    u64_val(0xeff394dcff8a948e), u64_val(0xddfc4b4cef07f5b0), // 5^242
+    u64_val(0x95f83d0a1fb69cd9), u64_val(0x4abdaf101564f98e), // 5^243
+    u64_val(0xbb764c4ca7a4440f), u64_val(0x9d6d1ad41abe37f1), // 5^244
+    u64_val(0xea53df5fd18d5513), u64_val(0x84c86189216dc5ed), // 5^245
+    u64_val(0x92746b9be2f8552c), u64_val(0x32fd3cf5b4e49bb4), // 5^246
+    u64_val(0xb7118682dbb66a77), u64_val(0x3fbc8c33221dc2a1), // 5^247
+    u64_val(0xe4d5e82392a40515), u64_val(0x0fabaf3feaa5334a), // 5^248
+    u64_val(0x8f05b1163ba6832d), u64_val(0x29cb4d87f2a7400e), // 5^249
+    u64_val(0xb2c71d5bca9023f8), u64_val(0x743e20e9ef511012), // 5^250
+    u64_val(0xdf78e4b2bd342cf6), u64_val(0x914da9246b255416), // 5^251
+    u64_val(0x8bab8eefb6409c1a), u64_val(0x1ad089b6c2f7548e), // 5^252
+    u64_val(0xae9672aba3d0c320), u64_val(0xa184ac2473b529b1), // 5^253
+    u64_val(0xda3c0f568cc4f3e8), u64_val(0xc9e5d72d90a2741e), // 5^254
+    u64_val(0x8865899617fb1871), u64_val(0x7e2fa67c7a658892), // 5^255
+    u64_val(0xaa7eebfb9df9de8d), u64_val(0xddbb901b98feeab7), // 5^256
+    u64_val(0xd51ea6fa85785631), u64_val(0x552a74227f3ea565), // 5^257
+    u64_val(0x8533285c936b35de), u64_val(0xd53a88958f87275f), // 5^258
+    u64_val(0xa67ff273b8460356), u64_val(0x8a892abaf368f137), // 5^259
+    u64_val(0xd01fef10a657842c), u64_val(0x2d2b7569b0432d85), // 5^260
+    u64_val(0x8213f56a67f6b29b), u64_val(0x9c3b29620e29fc73), // 5^261
+    u64_val(0xa298f2c501f45f42), u64_val(0x8349f3ba91b47b8f), // 5^262
+    u64_val(0xcb3f2f7642717713), u64_val(0x241c70a936219a73), // 5^263
+    u64_val(0xfe0efb53d30dd4d7), u64_val(0xed238cd383aa0110), // 5^264
+    u64_val(0x9ec95d1463e8a506), u64_val(0xf4363804324a40aa), // 5^265
+    u64_val(0xc67bb4597ce2ce48), u64_val(0xb143c6053edcd0d5), // 5^266
+    u64_val(0xf81aa16fdc1b81da), u64_val(0xdd94b7868e94050a), // 5^267
+    u64_val(0x9b10a4e5e9913128), u64_val(0xca7cf2b4191c8326), // 5^268
+    u64_val(0xc1d4ce1f63f57d72), u64_val(0xfd1c2f611f63a3f0), // 5^269
+    u64_val(0xf24a01a73cf2dccf), u64_val(0xbc633b39673c8cec), // 5^270
+    u64_val(0x976e41088617ca01), u64_val(0xd5be0503e085d813), // 5^271
+    u64_val(0xbd49d14aa79dbc82), u64_val(0x4b2d8644d8a74e18), // 5^272
+    u64_val(0xec9c459d51852ba2), u64_val(0xddf8e7d60ed1219e), // 5^273
+    u64_val(0x93e1ab8252f33b45), u64_val(0xcabb90e5c942b503), // 5^274
+    u64_val(0xb8da1662e7b00a17), u64_val(0x3d6a751f3b936243), // 5^275
+    u64_val(0xe7109bfba19c0c9d), u64_val(0x0cc512670a783ad4), // 5^276
+    u64_val(0x906a617d450187e2), u64_val(0x27fb2b80668b24c5), // 5^277
+    u64_val(0xb484f9dc9641e9da), u64_val(0xb1f9f660802dedf6), // 5^278
+    u64_val(0xe1a63853bbd26451), u64_val(0x5e7873f8a0396973), // 5^279
+    u64_val(0x8d07e33455637eb2), u64_val(0xdb0b487b6423e1e8), // 5^280
+    u64_val(0xb049dc016abc5e5f), u64_val(0x91ce1a9a3d2cda62), // 5^281
+    u64_val(0xdc5c5301c56b75f7), u64_val(0x7641a140cc7810fb), // 5^282
+    u64_val(0x89b9b3e11b6329ba), u64_val(0xa9e904c87fcb0a9d), // 5^283
+    u64_val(0xac2820d9623bf429), u64_val(0x546345fa9fbdcd44), // 5^284
+    u64_val(0xd732290fbacaf133), u64_val(0xa97c177947ad4095), // 5^285
+    u64_val(0x867f59a9d4bed6c0), u64_val(0x49ed8eabcccc485d), // 5^286
+    u64_val(0xa81f301449ee8c70), u64_val(0x5c68f256bfff5a74), // 5^287
+    u64_val(0xd226fc195c6a2f8c), u64_val(0x73832eec6fff3111), // 5^288
+    u64_val(0x83585d8fd9c25db7), u64_val(0xc831fd53c5ff7eab), // 5^289
+    u64_val(0xa42e74f3d032f525), u64_val(0xba3e7ca8b77f5e55), // 5^290
+    u64_val(0xcd3a1230c43fb26f), u64_val(0x28ce1bd2e55f35eb), // 5^291
+    u64_val(0x80444b5e7aa7cf85), u64_val(0x7980d163cf5b81b3), // 5^292
+    u64_val(0xa0555e361951c366), u64_val(0xd7e105bcc332621f), // 5^293
+    u64_val(0xc86ab5c39fa63440), u64_val(0x8dd9472bf3fefaa7), // 5^294
+    u64_val(0xfa856334878fc150), u64_val(0xb14f98f6f0feb951), // 5^295
+    u64_val(0x9c935e00d4b9d8d2), u64_val(0x6ed1bf9a569f33d3), // 5^296
+    u64_val(0xc3b8358109e84f07), u64_val(0x0a862f80ec4700c8), // 5^297
+    u64_val(0xf4a642e14c6262c8), u64_val(0xcd27bb612758c0fa), // 5^298
+    u64_val(0x98e7e9cccfbd7dbd), u64_val(0x8038d51cb897789c), // 5^299
+    u64_val(0xbf21e44003acdd2c), u64_val(0xe0470a63e6bd56c3), // 5^300
+    u64_val(0xeeea5d5004981478), u64_val(0x1858ccfce06cac74), // 5^301
+    u64_val(0x95527a5202df0ccb), u64_val(0x0f37801e0c43ebc8), // 5^302
+    u64_val(0xbaa718e68396cffd), u64_val(0xd30560258f54e6ba), // 5^303
+    u64_val(0xe950df20247c83fd), u64_val(0x47c6b82ef32a2069), // 5^304
+    u64_val(0x91d28b7416cdd27e), u64_val(0x4cdc331d57fa5441), // 5^305
+    u64_val(0xb6472e511c81471d), u64_val(0xe0133fe4adf8e952), // 5^306
+    u64_val(0xe3d8f9e563a198e5), u64_val(0x58180fddd97723a6), // 5^307
+    u64_val(0x8e679c2f5e44ff8f), u64_val(0x570f09eaa7ea7648), // 5^308
+};
+
+static const f64 str__exactPowerOfTen64[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+static const f32 str__exactPowerOfTen32[] = {
+    1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f,
+};
+
+INLINE u64 str__loadU64(const u8* p) {
+    u64 v;
+    mem_copy(&v, p, sizeof(v));
+    return v;
+}
+
+INLINE bx str__isEightDigits(u64 val) {
+    return !(((val + u64_val(0x4646464646464646)) | (val - u64_val(0x3030303030303030))) & u64_val(0x8080808080808080));
+}
+
+INLINE u64 str__parseEightDigits(u64 val) {
+    const u64 mask = u64_val(0x000000FF000000FF);
+    const u64 mul1 = u64_val(0x000F424000000064); // 100 + (1000000 << 32)
+    const u64 mul2 = u64_val(0x0000271000000001); // 1 + (10000 << 32)
+    val -= u64_val(0x3030303030303030);
+    val = (val * 10) + (val >> 8);
+    val = (((val & mask) * mul1) + (((val >> 16) & mask) * mul2)) >> 32;
+    return u32_cast(val);
+}
+
+INLINE bx str__isDigit(u8 c) {
+    return u8_cast(c - '0') < 10;
+}
+
+// accumulates decimal digits, overflow is set when the value doesn't fit into an u64
+LOCAL u64 str__parseU64Digits(const u8* p, u64 size, u64* outValue, bx* outOverflow) {
+    u64 idx = 0;
+    u64 value = 0;
+    bx overflow = false;
+    while (size - idx >= 8) {
+        u64 chunk = str__loadU64(p + idx);
+        if (!str__isEightDigits(chunk)) {
+            break;
+        }
+        u64 eight = str__parseEightDigits(chunk);
+        if (value > u64_val(184467440737)) {
+            overflow = true;
+        } else {
+            u64 shifted = value * 100000000;
+            value = shifted + eight;
+            overflow |= value < shifted;
+        }
+        idx += 8;
+    }
+    for (; idx < size && str__isDigit(p[idx]); idx++) {
+        u64 digit = p[idx] - '0';
+        if (value > u64_val(1844674407370955161) || (value == u64_val(1844674407370955161) && digit > 5)) {
+            overflow = true;
+        } else {
+            value = value * 10 + digit;
+        }
+    }
+    *outValue = value;
+    *outOverflow = overflow;
+    return idx;
+}
+
 f32  str_parseF32 (S8 str) {
    f32 val = 0.f;
    str_parseF32N(str, &val);
    return val;
 }
 
+f64  str_parseF64 (S8 str) {
+   f64 val = 0.0;
+   str_parseF64N(str, &val);
+   return val;
+}
+
+typedef struct str__Decimal {
+    u64 mantissa;          // first 19 significant digits
+    i64 exponent;          // power of ten applied to the mantissa
+    i64 explicitExponent;  // the exponent as written after 'e'
+    u64 size;              // consumed characters, 0 if the input is not a number
+    const u8* integer;
+    u64 integerCount;
+    const u8* fraction;
+    u64 fractionCount;
+    bx negative;
+    bx truncated;          // more than 19 significant digits, mantissa is rounded down
+    u8 special;            // 0 = finite, 1 = infinity, 2 = nan
+} str__Decimal;
+
+LOCAL bx str__matchNoCase(const u8* p, u64 size, const char* word) {
+    u64 idx = 0;
+    for (; word[idx]; idx++) {
+        if (idx >= size || (p[idx] | 0x20) != word[idx]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+LOCAL str__Decimal str__parseDecimal(S8 str) {
+    str__Decimal dec;
+    mem_structSetZero(&dec);
+    const u8* start = str.content;
+    const u8* end = str.content + str.size;
+    const u8* p = start;
+    if (p < end && (*p == '-' || *p == '+')) {
+        dec.negative = *p == '-';
+        p++;
+    }
+    if (p < end && !str__isDigit(*p) && *p != '.') {
+        u64 rest = u64_cast(end - p);
+        if (str__matchNoCase(p, rest, "infinity")) {
+            dec.special = 1;
+            dec.size = u64_cast(p - start) + 8;
+        } else if (str__matchNoCase(p, rest, "inf")) {
+            dec.special = 1;
+            dec.size = u64_cast(p - start) + 3;
+        } else if (str__matchNoCase(p, rest, "nan")) {
+            dec.special = 2;
+            dec.size = u64_cast(p - start) + 3;
+        }
+        return dec;
+    }
+
+    u64 mantissa = 0;
+    dec.integer = p;
+    for (; end - p >= 8 && str__isEightDigits(str__loadU64(p)); p += 8) {
+        mantissa = mantissa * 100000000 + str__parseEightDigits(str__loadU64(p));
+    }
+    for (; p < end && str__isDigit(*p); p++) {
+        mantissa = mantissa * 10 + u64_cast(*p - '0');
+    }
+    dec.integerCount = u64_cast(p - dec.integer);
+    dec.fraction = p;
+    if (p < end && *p == '.') {
+        p++;
+        dec.fraction = p;
+        for (; end - p >= 8 && str__isEightDigits(str__loadU64(p)); p += 8) {
+            mantissa = mantissa * 100000000 + str__parseEightDigits(str__loadU64(p));
+        }
+        for (; p < end && str__isDigit(*p); p++) {
+            mantissa = mantissa * 10 + u64_cast(*p - '0');
+        }
+        dec.fractionCount = u64_cast(p - dec.fraction);
+    }
+    if (dec.integerCount + dec.fractionCount == 0) {
+        return dec;
+    }
+
+    // an exponent without digits is not part of the number
+    if (p < end && (*p == 'e' || *p == 'E')) {
+        const u8* expStart = p;
+        p++;
+        bx negativeExp = false;
+        if (p < end && (*p == '-' || *p == '+')) {
+            negativeExp = *p == '-';
+            p++;
+        }
+        if (p < end && str__isDigit(*p)) {
+            i64 expValue = 0;
+            for (; p < end && str__isDigit(*p); p++) {
+                if (expValue < 0x10000000) {
+                    expValue = expValue * 10 + (*p - '0');
+                }
+            }
+            dec.explicitExponent = negativeExp ? -expValue : expValue;
+        } else {
+            p = expStart;
+        }
+    }
+    dec.size = u64_cast(p - start);
+    dec.mantissa = mantissa;
+    dec.exponent = dec.explicitExponent - i64_cast(dec.fractionCount);
+
+    if (dec.integerCount + dec.fractionCount > 19) {
+        // leading zeros don't count as significant digits
+        u64 significant = dec.integerCount + dec.fractionCount;
+        const u8* z = dec.integer;
+        for (; z < dec.integer + dec.integerCount && *z == '0'; z++) {
+            significant--;
+        }
+        if (z == dec.integer + dec.integerCount) {
+            for (z = dec.fraction; z < dec.fraction + dec.fractionCount && *z == '0'; z++) {
+                significant--;
+            }
+        }
+        if (significant > 19) {
+            dec.truncated = true;
+            const u64 minNineteenDigits = u64_val(1000000000000000000);
+            mantissa = 0;
+            const u8* q = dec.integer;
+            const u8* integerEnd = dec.integer + dec.integerCount;
+            for (; mantissa < minNineteenDigits && q < integerEnd; q++) {
+                mantissa = mantissa * 10 + u64_cast(*q - '0');
+            }
+            if (mantissa >= minNineteenDigits) {
+                dec.exponent = i64_cast(integerEnd - q) + dec.explicitExponent;
+            } else {
+                q = dec.fraction;
+                const u8* fractionEnd = dec.fraction + dec.fractionCount;
+                for (; mantissa < minNineteenDigits && q < fractionEnd; q++) {
+                    mantissa = mantissa * 10 + u64_cast(*q - '0');
+                }
+                dec.exponent = i64_cast(dec.fraction - q) + dec.explicitExponent;
+            }
+            dec.mantissa = mantissa;
+        }
+    }
+    return dec;
+}
+
+typedef struct str__FloatFormat {
+    i32 mantissaBits;
+    i32 minimumExponent;
+    i32 infinitePower;
+    i32 smallestPowerOfTen;
+    i32 largestPowerOfTen;
+    i32 minRoundToEven;
+    i32 maxRoundToEven;
+} str__FloatFormat;
+
+static const str__FloatFormat str__formatF64 = {52, -1023, 0x7FF, -342, 308, -4, 23};
+static const str__FloatFormat str__formatF32 = {23, -127, 0xFF, -65, 38, -17, 10};
+
+// Eisel-Lemire, returns false when the result can't be decided and the slow path has to be taken
+LOCAL bx str__eiselLemire(const str__FloatFormat* fmt, i64 q, u64 w, u64* outBits) {
+    if (w == 0 || q < fmt->smallestPowerOfTen) {
+        *outBits = 0;
+        return true;
+    }
+    if (q > fmt->largestPowerOfTen) {
+        *outBits = u64_cast(fmt->infinitePower) << fmt->mantissaBits;
+        return true;
+    }
+    i32 lz = i32_cast(u64_bitScanNonZero(w));
+    w <<= lz;
+
+    // the product only needs mantissaBits + 3 correct bits, the second word is only required when those could be off
+    u64 index = u64_cast(q - STR__POW5_MIN_EXPONENT) * 2;
+    u64 productHigh;
+    u64 productLow = str__mul128(w, str__powerOfFive128[index], &productHigh);
+    u64 precisionMask = u64_val(0xFFFFFFFFFFFFFFFF) >> (fmt->mantissaBits + 3);
+    if ((productHigh & precisionMask) == precisionMask) {
+        u64 secondHigh;
+        str__mul128(w, str__powerOfFive128[index + 1], &secondHigh);
+        productLow += secondHigh;
+        if (secondHigh > productLow) {
+            productHigh++;
+        }
+    }
+    if (productLow == u64_val(0xFFFFFFFFFFFFFFFF) && (q < -27 || q > 55)) {
+        return false;
+    }
+
+    i32 upperBit = i32_cast(productHigh >> 63);
+    i32 shift = upperBit + 64 - fmt->mantissaBits - 3;
+    u64 mantissa = productHigh >> shift;
+    i32 power2 = i32_cast((((152170 + 65536) * q) >> 16) + 63) + upperBit - lz - fmt->minimumExponent;
+
+    if (power2 <= 0) {
+        // subnormal
+        if (-power2 + 1 >= 64) {
+            *outBits = 0;
+            return true;
+        }
+        mantissa >>= -power2 + 1;
+        mantissa += mantissa & 1;
+        mantissa >>= 1;
+        power2 = mantissa < (u64_val(1) << fmt->mantissaBits) ? 0 : 1;
+        *outBits = (mantissa & ((u64_val(1) << fmt->mantissaBits) - 1)) | (u64_cast(power2) << fmt->mantissaBits);
+        return true;
+    }
+    // exactly halfway between two floats, round to even
+    if (productLow <= 1 && q >= fmt->minRoundToEven && q <= fmt->maxRoundToEven && (mantissa & 3) == 1) {
+        if ((mantissa << shift) == productHigh) {
+            mantissa &= ~u64_val(1);
+        }
+    }
+    mantissa += mantissa & 1;
+    mantissa >>= 1;
+    if (mantissa >= (u64_val(2) << fmt->mantissaBits)) {
+        mantissa = u64_val(1) << fmt->mantissaBits;
+        power2++;
+    }
+    mantissa &= ~(u64_val(1) << fmt->mantissaBits);
+    if (power2 >= fmt->infinitePower) {
+        power2 = fmt->infinitePower;
+        mantissa = 0;
+    }
+    *outBits = mantissa | (u64_cast(power2) << fmt->mantissaBits);
+    return true;
+}
+
+// writes the digits as "<digits>e<exponent>" (no decimal point, so the locale doesn't matter) for strtod/strtof
+LOCAL void str__decimalToCanonical(const str__Decimal* dec, char* buffer, u64 bufferSize) {
+    // enough digits to decide the rounding of any f64, everything after is folded into a sticky digit
+    const u64 maxDigits = 780;
+    ASSERT(bufferSize >= maxDigits + 32);
+    u64 count = 0;
+    i64 exponent = dec->explicitExponent - i64_cast(dec->fractionCount);
+    bx sticky = false;
+    const u8* parts[2] = {dec->integer, dec->fraction};
+    u64 partCounts[2] = {dec->integerCount, dec->fractionCount};
+    for (u32 part = 0; part < 2; part++) {
+        for (u64 idx = 0; idx < partCounts[part]; idx++) {
+            u8 c = parts[part][idx];
+            if (count == 0 && c == '0') {
+                continue;
+            }
+            if (count < maxDigits) {
+                buffer[count++] = c;
+            } else {
+                sticky |= c != '0';
+                exponent++;
+            }
+        }
+    }
+    if (sticky) {
+        buffer[count++] = '1';
+        exponent--;
+    }
+    if (count == 0) {
+        buffer[count++] = '0';
+    }
+    snprintf(buffer + count, bufferSize - count, "e%lld", (long long) exponent);
+}
+
+u64  str_parseF64N(S8 str, f64* f) {
+    str__Decimal dec = str__parseDecimal(str);
+    if (dec.size == 0) {
+        *f = 0;
+        return 0;
+    }
+    union { u64 bits; f64 value; } result;
+    if (dec.special) {
+        result.bits = dec.special == 1 ? u64_val(0x7FF0000000000000) : u64_val(0x7FF8000000000000);
+    } else if (!dec.truncated && dec.exponent >= -22 && dec.exponent <= 22 && dec.mantissa <= (u64_val(1) << 53)) {
+        // Clinger: both operands are exact, so the single rounding of the multiply/divide is correct
+        result.value = f64_cast(dec.mantissa);
+        if (dec.exponent < 0) {
+            result.value /= str__exactPowerOfTen64[-dec.exponent];
+        } else {
+            result.value *= str__exactPowerOfTen64[dec.exponent];
+        }
+    } else {
+        u64 bits = 0;
+        bx ok = str__eiselLemire(&str__formatF64, dec.exponent, dec.mantissa, &bits);
+        if (ok && dec.truncated) {
+            // the real value is between mantissa and mantissa + 1, both have to round to the same float
+            u64 upperBits = 0;
+            ok = str__eiselLemire(&str__formatF64, dec.exponent, dec.mantissa + 1, &upperBits) && upperBits == bits;
+        }
+        if (ok) {
+            result.bits = bits;
+        } else {
+            char buffer[1024];
+            str__decimalToCanonical(&dec, buffer, sizeof(buffer));
+            result.value = strtod(buffer, NULL);
+        }
+    }
+    if (dec.negative) {
+        result.bits |= u64_val(0x8000000000000000);
+    }
+    *f = result.value;
+    return dec.size;
+}
+
 u64  str_parseF32N(S8 str, f32* f) {
-   i64 left = 0;
-   u64 offset = str_parseS64N(str, &left);
-   if (offset == 0) {
-      *f = 0;
-      return 0;
-   }
-   *f = f32_cast(left);
-   if (str.size > (offset + 2) && str.content[offset + 1] == '.') {
-      S8 sub = str_subStr(str, offset + 1, str.size);
-      i64 right = 0;
-      u64 offsetRight = str_parseS64N(sub, &right);
-      if (offsetRight != 0 && right > 0) {
-         *f = (left > 0 ? 1.f : -1.f) * f32_cast(right) / f32_cast(offsetRight);
-         offset += offsetRight;
-      }
-   }
-   return offset;
+    str__Decimal dec = str__parseDecimal(str);
+    if (dec.size == 0) {
+        *f = 0;
+        return 0;
+    }
+    union { u32 bits; f32 value; } result;
+    if (dec.special) {
+        result.bits = dec.special == 1 ? 0x7F800000 : 0x7FC00000;
+    } else if (!dec.truncated && dec.exponent >= -10 && dec.exponent <= 10 && dec.mantissa <= (u64_val(1) << 24)) {
+        result.value = f32_cast(dec.mantissa);
+        if (dec.exponent < 0) {
+            result.value /= str__exactPowerOfTen32[-dec.exponent];
+        } else {
+            result.value *= str__exactPowerOfTen32[dec.exponent];
+        }
+    } else {
+        u64 bits = 0;
+        bx ok = str__eiselLemire(&str__formatF32, dec.exponent, dec.mantissa, &bits);
+        if (ok && dec.truncated) {
+            u64 upperBits = 0;
+            ok = str__eiselLemire(&str__formatF32, dec.exponent, dec.mantissa + 1, &upperBits) && upperBits == bits;
+        }
+        if (ok) {
+            result.bits = u32_cast(bits);
+        } else {
+            char buffer[1024];
+            str__decimalToCanonical(&dec, buffer, sizeof(buffer));
+            result.value = strtof(buffer, NULL);
+        }
+    }
+    if (dec.negative) {
+        result.bits |= 0x80000000;
+    }
+    *f = result.value;
+    return dec.size;
 }
 
 i64  str_parseS64 (S8 str) {
@@ -209,29 +1468,26 @@ i64  str_parseS64 (S8 str) {
 }
 
 u64  str_parseS64N(S8 str, i64* s) {
-   u64 out = 0;
-   u64 idx = 1;
-   if (str.size == 0) {
-      return 0;
-   }
-   i64 mult = str.content[0] == '-' ? -1 : 1;
-
-   for (; str.size > idx; idx++) {
-      char numChar = str.content[idx];
-      if (numChar < '0' || numChar > '9') {
-         *s = out * mult;
-         return idx;
-      }
-      out *= 10;
-      out += numChar - '0';
-      if (out >= i64_max) {
-         *s = mult * i64_max;
-         return idx;
-      }
-   }
-   *s = out * mult;
-   return idx;
-
+    u64 idx = 0;
+    bx negative = false;
+    if (idx < str.size && (str.content[idx] == '-' || str.content[idx] == '+')) {
+        negative = str.content[idx] == '-';
+        idx++;
+    }
+    u64 value = 0;
+    bx overflow = false;
+    u64 digits = str__parseU64Digits(str.content + idx, str.size - idx, &value, &overflow);
+    if (digits == 0) {
+        return 0;
+    }
+    // out of range values are clamped
+    const u64 limit = u64_val(0x7FFFFFFFFFFFFFFF);
+    if (negative) {
+        *s = (overflow || value > limit + 1) ? i64_cast(limit + 1) : i64_cast(~value + 1);
+    } else {
+        *s = (overflow || value > limit) ? i64_cast(limit) : i64_cast(value);
+    }
+    return idx + digits;
 }
 
 u32  str_parseU32 (S8 str) {
@@ -241,23 +1497,15 @@ u32  str_parseU32 (S8 str) {
 }
 
 u64 str_parseU32N(S8 str, u32* u) {
-   u64 out = 0;
-   u64 idx = 0;
-   for (; str.size > idx; idx++) {
-      char numChar = str.content[idx];
-      if (numChar < '0' || numChar > '9') {
-         *u = out;
-         return idx;
-      }
-      out *= 10;
-      out += numChar - '0';
-      if (out >= u32_max) {
-         *u = u32_max;
-         return idx;
-      }
-   }
-   *u = out;
-   return idx;
+    u64 value = 0;
+    bx overflow = false;
+    u64 digits = str__parseU64Digits(str.content, str.size, &value, &overflow);
+    if (digits == 0) {
+        return 0;
+    }
+    // out of range values are clamped
+    *u = (overflow || value > 0xFFFFFFFF) ? 0xFFFFFFFF : u32_cast(value);
+    return digits;
 }
 
 S8 str_copyNullTerminated(Arena* arena, S8 str) {
@@ -297,7 +1545,7 @@ u64 str_findFirst(S8 str, S8 findStr, u64 offset) {
       i = str.size;
       if (str.size >= findStr.size) {
          i = offset;
-         i8 c = findStr.content[0];
+         u8 c = findStr.content[0];
          u64 onePastLast = str.size - findStr.size + 1;
          for (; i < onePastLast; i++) {
             if (str.content[i] == c) {
@@ -309,7 +1557,7 @@ u64 str_findFirst(S8 str, S8 findStr, u64 offset) {
                }
             }
          }
-         if (i == onePastLast) {
+         if (i >= onePastLast) {
             i = str.size;
          }
       }
@@ -348,86 +1596,802 @@ u64 str_containsSubStringCount(S8 str, S8 findStr) {
 
 S8 str_replaceAll(Arena* arena, S8 str, S8 replaceStr, S8 replacement) {
    if (replaceStr.size == 0) return str;
-   u64 replaceable = str_containsSubStringCount(str, replaceStr);
-   if (replaceable == 0) return str;
-
-   u64 new_size = (str.size - replaceable * replaceStr.size) + (replaceable * replacement.size);
-   S8 ret = str_alloc(arena, new_size);
-
-   b8 replaced;
-   u64 o = 0;
-   for (u64 i = 0; i < str.size;) {
-      replaced = false;
-      if (str.content[i] == replaceStr.content[0]) {
-         if ((str.size - i) >= replaceStr.size) {
-               S8 sub = { .content = str.content + i, .size = replaceStr.size };
-               if (str_isEqual(sub, replaceStr)) {
-                  // replace this one
-                  memmove(ret.content + o, replacement.content, replacement.size);
-                  replaced = true;
-               }
-         }
-      }
-      
-      if (replaced) {
-         o += replacement.size;
-         i += replaceStr.size;
-         continue;
+   u64 idx = str_findFirst(str, replaceStr, 0);
+   if (idx == str.size) return str;
+
+   // recorded in one pass, a counting pass up front would have to agree with the replace pass on overlapping matches
+   S8 ret;
+   u64 copyStart = 0;
+   str_record(ret, arena) {
+      while (idx != str.size) {
+         u8* dst = (u8*) mem_arenaPush(arena, (idx - copyStart) + replacement.size);
+         mem_copy(dst, str.content + copyStart, idx - copyStart);
+         mem_copy(dst + (idx - copyStart), replacement.content, replacement.size);
+         copyStart = idx + replaceStr.size;
+         idx = str_findFirst(str, replaceStr, copyStart);
       }
-      
-      ret.content[o] = str.content[i];
-      o++; i++;
+      mem_copy(mem_arenaPush(arena, str.size - copyStart), str.content + copyStart, str.size - copyStart);
    }
-
    return ret;
 }
 
 ///////////////////////////////////////
-// UTF-8 functions
+// Multi pattern search
+
+// NOTE(pjako): Aho-Corasick with every failure link resolved into the transition table, so matching is one
+// table lookup per byte. Bytes are mapped to classes first (every byte used by a pattern gets its own class,
+// all other bytes share class 0), which keeps the table at stateCount * classCount entries.
+
+API str_Matcher* str_matcherInit(Arena* arena, S8* patterns, u32 patternCount) {
+    ASSERT(arena);
+    ASSERT(patterns || patternCount == 0);
+    str_Matcher* matcher = mem_arenaPushStructZero(arena, str_Matcher);
+    matcher->patternCount = patternCount;
+    matcher->patternSize = mem_arenaPushArray(arena, u32, (maxVal(patternCount, 1)));
+
+    u8 used[256];
+    mem_setZero(used, sizeof(used));
+    u32 usedCount = 0;
+    u32 maxStates = 1;
+    for (u32 idx = 0; idx < patternCount; idx++) {
+        matcher->patternSize[idx] = u32_cast(patterns[idx].size);
+        maxStates += u32_cast(patterns[idx].size);
+        for (u64 c = 0; c < patterns[idx].size; c++) {
+            usedCount += used[patterns[idx].content[c]] == 0;
+            used[patterns[idx].content[c]] = 1;
+        }
+    }
+    // class 0 is shared by all bytes no pattern uses, unless patterns use every byte value
+    u32 classCount = usedCount < 256 ? 1 : 0;
+    for (u32 byte = 0; byte < 256; byte++) {
+        if (used[byte]) {
+            matcher->byteClass[byte] = u8_cast(classCount);
+            classCount += 1;
+        }
+    }
+    matcher->classCount = classCount;
+
+    matcher->transitions = mem_arenaPushArrayZero(arena, u32, (u64_cast(maxStates) * classCount));
+    matcher->output = mem_arenaPushArrayZero(arena, u32, maxStates);
+    matcher->depth = mem_arenaPushArrayZero(arena, u32, maxStates);
+    u32* fail = mem_arenaPushArrayZero(arena, u32, maxStates);
+    u32* queue = mem_arenaPushArray(arena, u32, maxStates);
+
+    // trie, while building a transition to state 0 means there is no child
+    matcher->stateCount = 1;
+    for (u32 idx = 0; idx < patternCount; idx++) {
+        S8 pattern = patterns[idx];
+        if (pattern.size == 0) continue;
+        u32 state = 0;
+        for (u64 c = 0; c < pattern.size; c++) {
+            u32* next = &matcher->transitions[u64_cast(state) * classCount + matcher->byteClass[pattern.content[c]]];
+            if (*next == 0) {
+                *next = matcher->stateCount;
+                matcher->depth[matcher->stateCount] = matcher->depth[state] + 1;
+                matcher->stateCount += 1;
+            }
+            state = *next;
+        }
+        if (matcher->output[state] == 0) {
+            matcher->output[state] = idx + 1;
+        }
+    }
 
-u64 str_utf8Count(S8 str) {
-    u64 length = 0;
-    u64 idx = 0;
-    while (idx < str.size) {
-        if (0xf0 == (0xf8 & str.content[idx])) {
-            // 4-byte utf8 code point (began with 0b11110xxx)
-            idx += 4;
-        } else if (0xe0 == (0xf0 & str.content[idx])) {
-            // 3-byte utf8 code point (began with 0b1110xxxx)
-            idx += 3;
-        } else if (0xc0 == (0xe0 & str.content[idx])) {
-            // 2-byte utf8 code point (began with 0b110xxxxx)
-            idx += 2;
-        } else {
-            // 1-byte ascii (began with 0b0xxxxxxx)
-            idx += 1;
+    // breadth first, so the failure state of every state is complete before the state itself
+    u32 queueStart = 0;
+    u32 queueEnd = 0;
+    for (u32 cls = 0; cls < classCount; cls++) {
+        u32 child = matcher->transitions[cls];
+        if (child) {
+            queue[queueEnd++] = child;
+        }
+    }
+    while (queueStart < queueEnd) {
+        u32 state = queue[queueStart++];
+        if (matcher->output[state] == 0) {
+            // the longest pattern that is a proper suffix of this state
+            matcher->output[state] = matcher->output[fail[state]];
         }
+        u32* row = &matcher->transitions[u64_cast(state) * classCount];
+        u32* failRow = &matcher->transitions[u64_cast(fail[state]) * classCount];
+        for (u32 cls = 0; cls < classCount; cls++) {
+            if (row[cls]) {
+                fail[row[cls]] = failRow[cls];
+                queue[queueEnd++] = row[cls];
+            } else {
+                row[cls] = failRow[cls];
+            }
+        }
+    }
 
-        // it is always only one rune independent of its size
-        length++;
+    // prefilter for the root state: the first bytes directly when there are few of them, a nibble table otherwise
+    u32 firstBytes = 0;
+    for (u32 byte = 0; byte < 256; byte++) {
+        if (!used[byte] || matcher->transitions[matcher->byteClass[byte]] == 0) continue;
+        if (firstBytes < countOf(matcher->firstBytes)) {
+            matcher->firstBytes[firstBytes] = u8_cast(byte);
+        }
+        firstBytes += 1;
+        matcher->firstNibbleMask[byte & 0xF] |= u8_cast(1 << ((byte >> 4) & 0x7));
+    }
+    matcher->firstByteCount = firstBytes;
+    for (u32 idx = minVal(firstBytes, countOf(matcher->firstBytes)); idx < countOf(matcher->firstBytes) && firstBytes > 0; idx++) {
+        matcher->firstBytes[idx] = matcher->firstBytes[0];
     }
+    return matcher;
+}
 
-    if (idx > str.size) {
-        // rune size goes beyond content buffer so we go back on that one
-        length--;
+// index of the first byte at or after idx that can start a match (or a false positive), size if there is none
+LOCAL u64 str__matcherSkip(str_Matcher* matcher, const u8* content, u64 idx, u64 size) {
+#if SIMD_SSE2
+    if (matcher->firstByteCount <= countOf(matcher->firstBytes)) {
+        __m128i b0 = _mm_set1_epi8((char) matcher->firstBytes[0]);
+        __m128i b1 = _mm_set1_epi8((char) matcher->firstBytes[1]);
+        __m128i b2 = _mm_set1_epi8((char) matcher->firstBytes[2]);
+        __m128i b3 = _mm_set1_epi8((char) matcher->firstBytes[3]);
+        for (; idx + 16 <= size; idx += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*) (content + idx));
+            __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, b0), _mm_cmpeq_epi8(v, b1)), _mm_or_si128(_mm_cmpeq_epi8(v, b2), _mm_cmpeq_epi8(v, b3)));
+            u32 mask = (u32) _mm_movemask_epi8(hit);
+            if (mask) return idx + u32_bitScanReverseNonZero(mask);
+        }
     }
-    return length;
+#if SIMD_SSSE3
+    else {
+        // shufti: a byte can be a first byte if its low nibble entry has the bucket bit of its high nibble
+        __m128i lowTable = _mm_loadu_si128((const __m128i*) matcher->firstNibbleMask);
+        __m128i highTable = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, (char) 128, 1, 2, 4, 8, 16, 32, 64, (char) 128);
+        __m128i nibble = _mm_set1_epi8(0xF);
+        __m128i zero = _mm_setzero_si128();
+        for (; idx + 16 <= size; idx += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*) (content + idx));
+            __m128i low = _mm_shuffle_epi8(lowTable, _mm_and_si128(v, nibble));
+            __m128i high = _mm_shuffle_epi8(highTable, _mm_and_si128(_mm_srli_epi16(v, 4), nibble));
+            u32 mask = ~((u32) _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_and_si128(low, high), zero))) & 0xFFFF;
+            if (mask) return idx + u32_bitScanReverseNonZero(mask);
+        }
+    }
+#endif
+#elif SIMD_NEON
+    uint8x16_t lowTable = vld1q_u8(matcher->firstNibbleMask);
+    static const u8 str__highBuckets[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t highTable = vld1q_u8(str__highBuckets);
+    uint8x16_t nibble = vdupq_n_u8(0xF);
+    for (; idx + 16 <= size; idx += 16) {
+        uint8x16_t v = vld1q_u8(content + idx);
+        uint8x16_t low = vqtbl1q_u8(lowTable, vandq_u8(v, nibble));
+        uint8x16_t high = vqtbl1q_u8(highTable, vshrq_n_u8(v, 4));
+        if (vmaxvq_u8(vandq_u8(low, high)) != 0) break;
+    }
+#endif
+    const u32* root = matcher->transitions;
+    for (; idx < size && root[matcher->byteClass[content[idx]]] == 0; idx++);
+    return idx;
 }
 
-////////////////////////////
-// NOTE(pjako): hash
+API bx str_matcherFind(str_Matcher* matcher, S8 str, u64 offset, str_Match* outMatch) {
+    ASSERT(matcher);
+    if (matcher->firstByteCount == 0) {
+        return false;
+    }
+    const u32* transitions = matcher->transitions;
+    u32 classCount = matcher->classCount;
+    bx found = false;
+    u64 bestStart = 0;
+    u64 bestEnd = 0;
+    u32 bestPattern = 0;
+    u32 state = 0;
+    for (u64 idx = offset; idx < str.size; idx++) {
+        if (state == 0) {
+            if (found) break;
+            idx = str__matcherSkip(matcher, str.content, idx, str.size);
+            if (idx >= str.size) break;
+        }
+        state = transitions[u64_cast(state) * classCount + matcher->byteClass[str.content[idx]]];
+        u32 output = matcher->output[state];
+        if (output) {
+            // the longest pattern ending here is also the one that starts first
+            u64 start = idx + 1 - matcher->patternSize[output - 1];
+            if (!found || start <= bestStart) {
+                found = true;
+                bestStart = start;
+                bestEnd = idx + 1;
+                bestPattern = output - 1;
+            }
+        }
+        // every partial match still alive starts after the best match, none of them can win anymore
+        if (found && idx + 1 - matcher->depth[state] > bestStart) break;
+    }
+    if (found && outMatch) {
+        outMatch->offset = bestStart;
+        outMatch->size = bestEnd - bestStart;
+        outMatch->pattern = bestPattern;
+    }
+    return found;
+}
 
-API u32 str_hash32(S8 str) {
-    u32 hash = 5381;
-    i32 c;
-    for (u64 i = 0; i < str.size; i++) {
-        hash = ((hash << 5) + hash) + str.content[i]; /* hash * 33 + c */
+API S8 str_matcherReplace(Arena* arena, str_Matcher* matcher, S8 str, S8* replacements) {
+    ASSERT(replacements || matcher->patternCount == 0);
+    str_Match match;
+    if (!str_matcherFind(matcher, str, 0, &match)) {
+        return str;
     }
-    return hash;
+    S8 ret;
+    u64 copyStart = 0;
+    str_record(ret, arena) {
+        do {
+            S8 replacement = replacements[match.pattern];
+            u8* dst = (u8*) mem_arenaPush(arena, (match.offset - copyStart) + replacement.size);
+            mem_copy(dst, str.content + copyStart, match.offset - copyStart);
+            mem_copy(dst + (match.offset - copyStart), replacement.content, replacement.size);
+            copyStart = match.offset + match.size;
+        } while (str_matcherFind(matcher, str, copyStart, &match));
+        mem_copy(mem_arenaPush(arena, str.size - copyStart), str.content + copyStart, str.size - copyStart);
+    }
+    return ret;
 }
 
-API u64 str_hash64(S8 str) {
-    u32 hash1 = 5381;
+////////////////////////////
+// NOTE(pjako): glob, shift-and over the pattern elements. Bit i set means the element i is the next one to match,
+// bit elementCount means the pattern is complete. Every element matches one byte except '*'/'**' which loop.
+
+INLINE bx str__globIsSpecial(u8 c) {
+    return c == '*' || c == '?' || c == '[' || c == '\\';
+}
+
+// "**/" may only be skipped when it is entered, once it consumed a byte it has to end with its '/'
+INLINE u64 str__globClosure(const str_Glob* glob, u64 state, u64 skip2) {
+    for (;;) {
+        u64 next = state | ((state & glob->skip1) << 1) | ((state & skip2) << 2);
+        if (next == state) {
+            return state;
+        }
+        state = next;
+    }
+}
+
+LOCAL u64 str__globRun(const str_Glob* glob, u64 state, const u8* content, u64 size) {
+    for (u64 i = 0; i < size && state != 0; i++) {
+        u8 c = content[i];
+        u64 entered = str__globClosure(glob, (state & glob->accept[c]) << 1, glob->skip2);
+        state = entered | str__globClosure(glob, state & glob->loop[c], 0);
+    }
+    return state;
+}
+
+API str_Glob* str_globCompile(Arena* arena, S8 pattern) {
+    ASSERT(arena);
+    // the prefix ends after the last '/' that only has literal segments in front of it
+    u64 prefixSize = 0;
+    bx hasSeparator = false;
+    for (u64 i = 0; i < pattern.size; i++) {
+        if (str__globIsSpecial(pattern.content[i])) {
+            break;
+        }
+        if (pattern.content[i] == '/') {
+            prefixSize = i + 1;
+        }
+    }
+    for (u64 i = 0; i < pattern.size && !hasSeparator; i++) {
+        hasSeparator = pattern.content[i] == '/';
+    }
+
+    str_Glob* glob = mem_arenaPushStructZero(arena, str_Glob);
+    u32 element = 0;
+    for (u64 i = prefixSize; i < pattern.size; i++) {
+        if (element >= STR_GLOB_MAX_ELEMENTS) {
+            return NULL;
+        }
+        u64 bit = u64_val(1) << element;
+        u8 c = pattern.content[i];
+        if (c == '*') {
+            bx doubleStar = i + 1 < pattern.size && pattern.content[i + 1] == '*';
+            bx segmentStart = i == 0 || pattern.content[i - 1] == '/';
+            u64 end = doubleStar ? i + 2 : i + 1;
+            if (doubleStar && segmentStart && (end == pattern.size || pattern.content[end] == '/')) {
+                for (u32 b = 0; b < 256; b++) {
+                    glob->loop[b] |= bit;
+                }
+                // "**/" is followed by its '/' element, skipping both matches zero directories
+                glob->skip1 |= bit;
+                glob->skip2 |= end < pattern.size ? bit : 0;
+            } else {
+                // a '**' that is not a whole segment behaves like '*'
+                for (u32 b = 0; b < 256; b++) {
+                    glob->loop[b] |= b == '/' ? 0 : bit;
+                }
+                glob->skip1 |= bit;
+            }
+            // runs of stars collapse into one element
+            while (i + 1 < pattern.size && pattern.content[i + 1] == '*') i++;
+        } else if (c == '?') {
+            for (u32 b = 0; b < 256; b++) {
+                glob->accept[b] |= b == '/' ? 0 : bit;
+            }
+        } else if (c == '[') {
+            u64 cursor = i + 1;
+            bx negate = cursor < pattern.size && (pattern.content[cursor] == '!' || pattern.content[cursor] == '^');
+            cursor += negate ? 1 : 0;
+            u64 members[4] = {0, 0, 0, 0};
+            // a ']' right after the opening bracket is a member
+            u64 first = cursor;
+            for (; cursor < pattern.size && (cursor == first || pattern.content[cursor] != ']'); cursor++) {
+                u8 low = pattern.content[cursor];
+                if (low == '\\' && cursor + 1 < pattern.size) {
+                    low = pattern.content[++cursor];
+                }
+                u8 high = low;
+                if (cursor + 2 < pattern.size && pattern.content[cursor + 1] == '-' && pattern.content[cursor + 2] != ']') {
+                    cursor += 2;
+                    high = pattern.content[cursor];
+                    if (high == '\\' && cursor + 1 < pattern.size) {
+                        high = pattern.content[++cursor];
+                    }
+                }
+                for (u32 b = low; b <= high; b++) {
+                    members[b >> 6] |= u64_val(1) << (b & 63);
+                }
+            }
+            if (cursor >= pattern.size) {
+                return NULL;
+            }
+            for (u32 b = 0; b < 256; b++) {
+                bx member = ((members[b >> 6] >> (b & 63)) & 1) != 0;
+                if (member != negate && b != '/') {
+                    glob->accept[b] |= bit;
+                }
+            }
+            i = cursor;
+        } else {
+            if (c == '\\' && i + 1 < pattern.size) {
+                c = pattern.content[++i];
+            }
+            glob->accept[c] |= bit;
+        }
+        element++;
+    }
+    glob->elementCount = element;
+    glob->nameOnly = !hasSeparator;
+    glob->prefix = str_copy(arena, str_subStr(pattern, 0, prefixSize));
+    return glob;
+}
+
+API bx str_globMatch(const str_Glob* glob, S8 path) {
+    ASSERT(glob);
+    if (glob->nameOnly) {
+        i64 lastSlash = str_lastIndexOfChar(path, '/');
+        if (lastSlash >= 0) {
+            path = str_subStr(path, u64_cast(lastSlash) + 1, path.size - u64_cast(lastSlash) - 1);
+        }
+    }
+    if (!str_hasPrefix(path, glob->prefix)) {
+        return false;
+    }
+    u64 state = str__globRun(glob, str__globClosure(glob, 1, glob->skip2), path.content + glob->prefix.size, path.size - glob->prefix.size);
+    return ((state >> glob->elementCount) & 1) != 0;
+}
+
+API bx str_globCanMatchBelow(const str_Glob* glob, S8 directory) {
+    ASSERT(glob);
+    if (glob->nameOnly) {
+        return true;
+    }
+    // directories on the way to the prefix
+    if (directory.size < glob->prefix.size) {
+        return directory.size == 0 || (str_hasPrefix(glob->prefix, directory) && glob->prefix.content[directory.size] == '/');
+    }
+    if (!str_hasPrefix(directory, glob->prefix)) {
+        return false;
+    }
+    u64 state = str__globRun(glob, str__globClosure(glob, 1, glob->skip2), directory.content + glob->prefix.size, directory.size - glob->prefix.size);
+    state = str__globRun(glob, state, (const u8*) "/", 1);
+    return state != 0;
+}
+
+///////////////////////////////////////
+// Line, field and token iteration
+
+API str_Splitter str_splitter(S8 str, u8 delimiter) {
+    str_Splitter splitter;
+    mem_structSetZero(&splitter);
+    splitter.str = str;
+    splitter.delimiter = delimiter;
+    splitter.nextLine = 1;
+    return splitter;
+}
+
+// drops the '\r' of a "\r\n" line ending
+INLINE S8 str__trimCarriageReturn(S8 str) {
+    if (str.size > 0 && str.content[str.size - 1] == '\r') {
+        str.size -= 1;
+    }
+    return str;
+}
+
+API bx str_nextLine(str_Splitter* splitter) {
+    ASSERT(splitter);
+    S8 str = splitter->str;
+    if (splitter->offset >= str.size) {
+        splitter->piece = STR_NULL;
+        return false;
+    }
+    u64 end = str_findNextChar(str, splitter->offset, '\n');
+    splitter->piece = str__trimCarriageReturn(str_fromCharPtr(str.content + splitter->offset, end - splitter->offset));
+    splitter->line = splitter->nextLine;
+    splitter->nextLine += 1;
+    splitter->endOfLine = true;
+    splitter->offset = end + 1;
+    return true;
+}
+
+API bx str_nextField(str_Splitter* splitter) {
+    ASSERT(splitter);
+    S8 str = splitter->str;
+    // a delimiter at the very end is followed by one more (empty) field
+    bx trailingField = splitter->offset == str.size && str.size > 0 && str.content[str.size - 1] == splitter->delimiter && splitter->delimiter != '\n';
+    if (splitter->offset >= str.size && !trailingField) {
+        splitter->piece = STR_NULL;
+        return false;
+    }
+    u64 end = splitter->offset + str__findAny(str.content + splitter->offset, str.size - splitter->offset, splitter->delimiter, '\n', '\n');
+    splitter->line = splitter->nextLine;
+    splitter->endOfLine = end == str.size || str.content[end] == '\n';
+    splitter->piece = str_fromCharPtr(str.content + splitter->offset, end - splitter->offset);
+    if (splitter->endOfLine) {
+        splitter->piece = str__trimCarriageReturn(splitter->piece);
+        splitter->nextLine += 1;
+    }
+    splitter->offset = end + 1;
+    return true;
+}
+
+API bx str_nextToken(str_Splitter* splitter) {
+    ASSERT(splitter);
+    S8 str = splitter->str;
+    u64 start = splitter->offset + str__scanWhiteSpace(str.content + splitter->offset, str.size - splitter->offset, true);
+    // line breaks inside of the skipped whitespace
+    for (u64 idx = splitter->offset; (idx = str_findNextChar(str, idx, '\n')) < start; idx++) {
+        splitter->nextLine += 1;
+    }
+    if (start >= str.size) {
+        splitter->offset = str.size;
+        splitter->piece = STR_NULL;
+        return false;
+    }
+    u64 end = start + str__scanWhiteSpace(str.content + start, str.size - start, false);
+    splitter->line = splitter->nextLine;
+    splitter->piece = str_fromCharPtr(str.content + start, end - start);
+    // blanks between the token and the line break still leave it the last token of the line
+    u64 next = end;
+    while (next < str.size && (str.content[next] == ' ' || str.content[next] == '\t' || str.content[next] == '\v' || str.content[next] == '\f')) next++;
+    splitter->endOfLine = next == str.size || str.content[next] == '\n' || str.content[next] == '\r';
+    splitter->offset = end;
+    return true;
+}
+
+///////////////////////////////////////
+// UTF-8 functions
+
+#define STR__UTF8_IS_CONTINUATION(C) (((C) & 0xC0) == 0x80)
+
+// length of the leading run of ascii bytes, scans 32/16 bytes per step where available
+LOCAL u64 str__asciiPrefix(const u8* ptr, u64 size) {
+    u64 idx = 0;
+#if SIMD_AVX2
+    for (; idx + 32 <= size; idx += 32) {
+        u32 mask = (u32) _mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*) (ptr + idx)));
+        if (mask) return idx + u32_bitScanReverseNonZero(mask);
+    }
+#endif
+#if SIMD_SSE2
+    for (; idx + 16 <= size; idx += 16) {
+        u32 mask = (u32) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) (ptr + idx)));
+        if (mask) return idx + u32_bitScanReverseNonZero(mask);
+    }
+#elif SIMD_NEON
+    for (; idx + 16 <= size; idx += 16) {
+        if (vmaxvq_u8(vld1q_u8(ptr + idx)) >= 0x80) break;
+    }
+#endif
+    for (; idx + 8 <= size; idx += 8) {
+        u64 word;
+        mem_copy(&word, ptr + idx, sizeof(word));
+        u64 high = word & u64_val(0x8080808080808080);
+        // little endian: the lowest set bit belongs to the first non ascii byte
+        if (high) return idx + (u64_bitScanReverseNonZero(high) >> 3);
+    }
+    for (; idx < size && ptr[idx] < 0x80; idx++);
+    return idx;
+}
+
+// size of the sequence started by a lead byte, 0 for continuation or invalid bytes
+LOCAL u32 str__utf8SequenceSize(u8 c) {
+    if (c < 0x80) return 1;
+    if (c < 0xC0) return 0;
+    if (c < 0xE0) return 2;
+    if (c < 0xF0) return 3;
+    if (c < 0xF8) return 4;
+    return 0;
+}
+
+u64 str_utf8Count(S8 str) {
+    const u8* ptr = str.content;
+    u64 length = 0;
+    u64 idx = 0;
+    // every byte that is not a continuation byte (0b10xxxxxx) starts a code point
+#if SIMD_SSE2
+    const __m128i lastContinuation = _mm_set1_epi8((char) 0xBF);
+    for (; idx + 16 <= str.size; idx += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (ptr + idx));
+        length += u32_popCount((u32) _mm_movemask_epi8(_mm_cmpgt_epi8(v, lastContinuation)));
+    }
+#elif SIMD_NEON
+    const int8x16_t lastContinuation = vdupq_n_s8((i8) 0xBF);
+    for (; idx + 16 <= str.size; idx += 16) {
+        uint8x16_t isLead = vcgtq_s8(vreinterpretq_s8_u8(vld1q_u8(ptr + idx)), lastContinuation);
+        length += vaddvq_u8(vshrq_n_u8(isLead, 7));
+    }
+#endif
+    for (; idx + 8 <= str.size; idx += 8) {
+        u64 word;
+        mem_copy(&word, ptr + idx, sizeof(word));
+        u64 continuation = (word & u64_val(0x8080808080808080)) & ~((word << 1) & u64_val(0x8080808080808080));
+        length += 8 - u64_popCount(continuation);
+    }
+    for (; idx < str.size; idx++) {
+        length += !STR__UTF8_IS_CONTINUATION(ptr[idx]);
+    }
+
+    // a rune that goes beyond the content buffer is not counted
+    for (u64 back = 1; back <= minVal(4, str.size); back++) {
+        u8 c = ptr[str.size - back];
+        if (STR__UTF8_IS_CONTINUATION(c)) continue;
+        if (str__utf8SequenceSize(c) > back) {
+            length--;
+        }
+        break;
+    }
+    return length;
+}
+
+////////////////////////////
+// NOTE(pjako): hash
+// wyhash (final4) by Wang Yi, public domain. The 128 bit variant reuses the same core and derives
+// the high word from the un-folded block lanes, so its low word stays equal to the 64 bit hash.
+
+static const u64 str__hashSecret[4] = {
+    u64_val(0x2d358dccaa6c78a5), u64_val(0x8bb84b93962eacc9),
+    u64_val(0x4b33a62ed433d4a3), u64_val(0x4d5a2da51de1aa47),
+};
+
+INLINE void str__hashMum(u64* a, u64* b) {
+    *a = str__mul128(*a, *b, b);
+}
+
+INLINE u64 str__hashMix(u64 a, u64 b) {
+    str__hashMum(&a, &b);
+    return a ^ b;
+}
+
+// NOTE(pjako): little endian reads, matches all targets we build for
+INLINE u64 str__hashRead64(const u8* p) {
+    u64 v;
+    mem_copy(&v, p, sizeof(v));
+    return v;
+}
+
+INLINE u64 str__hashRead32(const u8* p) {
+    u32 v;
+    mem_copy(&v, p, sizeof(v));
+    return v;
+}
+
+INLINE void str__hashShort(const u8* p, u64 size, u64* a, u64* b) {
+    if (size >= 4) {
+        u64 offset = (size >> 3) << 2;
+        *a = (str__hashRead32(p) << 32) | str__hashRead32(p + offset);
+        *b = (str__hashRead32(p + size - 4) << 32) | str__hashRead32(p + size - 4 - offset);
+    } else if (size > 0) {
+        *a = (u64_cast(p[0]) << 16) | (u64_cast(p[size >> 1]) << 8) | p[size - 1];
+        *b = 0;
+    } else {
+        *a = *b = 0;
+    }
+}
+
+INLINE void str__hashBlock(const u8* p, u64* lanes) {
+    const u64* secret = str__hashSecret;
+    lanes[0] = str__hashMix(str__hashRead64(p)      ^ secret[1], str__hashRead64(p + 8)  ^ lanes[0]);
+    lanes[1] = str__hashMix(str__hashRead64(p + 16) ^ secret[2], str__hashRead64(p + 24) ^ lanes[1]);
+    lanes[2] = str__hashMix(str__hashRead64(p + 32) ^ secret[3], str__hashRead64(p + 40) ^ lanes[2]);
+}
+
+// p points at the remaining (< 48 byte) tail, the 16 bytes before p have to be readable
+INLINE void str__hashTail(const u8* p, u64 size, u64* seed, u64* a, u64* b) {
+    const u64* secret = str__hashSecret;
+    while (size > 16) {
+        *seed = str__hashMix(str__hashRead64(p) ^ secret[1], str__hashRead64(p + 8) ^ *seed);
+        size -= 16;
+        p += 16;
+    }
+    *a = str__hashRead64(p + size - 16);
+    *b = str__hashRead64(p + size - 8);
+}
+
+INLINE u64 str__hashFinal(u64 a, u64 b, u64 seed, u64 size) {
+    const u64* secret = str__hashSecret;
+    a ^= secret[1];
+    b ^= seed;
+    str__hashMum(&a, &b);
+    return str__hashMix(a ^ secret[0] ^ size, b ^ secret[1]);
+}
+
+INLINE u64 str__hashFinalHigh(u64 a, u64 b, u64 seed, u64 highSeed, u64 size) {
+    const u64* secret = str__hashSecret;
+    a ^= secret[3];
+    b ^= seed ^ highSeed;
+    str__hashMum(&a, &b);
+    return str__hashMix(a ^ secret[2] ^ size, b ^ secret[0]);
+}
+
+INLINE str_Hash128 str__hash(const u8* p, u64 size, u64 seed, bx withHigh) {
+    const u64* secret = str__hashSecret;
+    seed ^= str__hashMix(seed ^ secret[0], secret[1]);
+    u64 highSeed = secret[2];
+    u64 a, b;
+    if (size <= 16) {
+        str__hashShort(p, size, &a, &b);
+    } else {
+        u64 i = size;
+        if (i >= 48) {
+            u64 lanes[3] = {seed, seed, seed};
+            do {
+                str__hashBlock(p, lanes);
+                p += 48;
+                i -= 48;
+            } while (i >= 48);
+            if (withHigh) {
+                highSeed = str__hashMix(lanes[1] ^ secret[2], lanes[2] ^ secret[3]);
+            }
+            seed = lanes[0] ^ lanes[1] ^ lanes[2];
+        }
+        str__hashTail(p, i, &seed, &a, &b);
+    }
+    str_Hash128 result;
+    result.low = str__hashFinal(a, b, seed, size);
+    result.high = withHigh ? str__hashFinalHigh(a, b, seed, highSeed, size) : 0;
+    return result;
+}
+
+API u64 str_hash64Seed(S8 str, u64 seed) {
+    return str__hash(str.content, str.size, seed, false).low;
+}
+
+API u64 str_hash64(S8 str) {
+    return str__hash(str.content, str.size, 0, false).low;
+}
+
+API u32 str_hash32(S8 str) {
+    u64 hash = str__hash(str.content, str.size, 0, false).low;
+    return u32_cast(hash ^ (hash >> 32));
+}
+
+// same result as str_hash64/str_hash32 of the lower cased string, lowered in chunks on the stack
+API u64 str_hash64NoCase(S8 str) {
+    u8 chunk[256];
+    if (str.size <= sizeof(chunk)) {
+        str__flipAsciiCase(chunk, str.content, str.size, 'A');
+        return str__hash(chunk, str.size, 0, false).low;
+    }
+    str_HashStream stream = str_hashStreamInit(0);
+    for (u64 offset = 0; offset < str.size; offset += sizeof(chunk)) {
+        u64 size = minVal(str.size - offset, sizeof(chunk));
+        str__flipAsciiCase(chunk, str.content + offset, size, 'A');
+        str_hashStreamAppend(&stream, str_fromCharPtr(chunk, size));
+    }
+    return str_hashStreamFinish64(&stream);
+}
+
+API u32 str_hash32NoCase(S8 str) {
+    u64 hash = str_hash64NoCase(str);
+    return u32_cast(hash ^ (hash >> 32));
+}
+
+API str_Hash128 str_hash128(S8 str, u64 seed) {
+    return str__hash(str.content, str.size, seed, true);
+}
+
+API str_HashStream str_hashStreamInit(u64 seed) {
+    str_HashStream stream;
+    mem_structSetZero(&stream);
+    const u64* secret = str__hashSecret;
+    stream.seed = seed ^ str__hashMix(seed ^ secret[0], secret[1]);
+    stream.lanes[0] = stream.seed;
+    stream.lanes[1] = stream.seed;
+    stream.lanes[2] = stream.seed;
+    return stream;
+}
+
+API void str_hashStreamAppend(str_HashStream* stream, S8 str) {
+    ASSERT(stream);
+    const u8* p = str.content;
+    u64 size = str.size;
+    stream->size += size;
+    // NOTE(pjako): blocks are consumed as soon as 48 bytes are available, exactly like the one shot loop
+    if (stream->bufferSize > 0) {
+        u64 fill = sizeof(stream->buffer) - stream->bufferSize;
+        if (size < fill) {
+            mem_copy(stream->buffer + stream->bufferSize, p, size);
+            stream->bufferSize += u32_cast(size);
+            return;
+        }
+        mem_copy(stream->buffer + stream->bufferSize, p, fill);
+        str__hashBlock(stream->buffer, stream->lanes);
+        mem_copy(stream->lastBlockTail, stream->buffer + 32, 16);
+        stream->bufferSize = 0;
+        p += fill;
+        size -= fill;
+    }
+    if (size >= 48) {
+        do {
+            str__hashBlock(p, stream->lanes);
+            p += 48;
+            size -= 48;
+        } while (size >= 48);
+        mem_copy(stream->lastBlockTail, p - 16, 16);
+    }
+    if (size > 0) {
+        mem_copy(stream->buffer, p, size);
+        stream->bufferSize = u32_cast(size);
+    }
+}
+
+LOCAL str_Hash128 str__hashStreamFinish(str_HashStream* stream, bx withHigh) {
+    ASSERT(stream);
+    const u64* secret = str__hashSecret;
+    u64 size = stream->size;
+    u64 seed = stream->seed;
+    u64 highSeed = secret[2];
+    u64 a, b;
+    if (size <= 16) {
+        str__hashShort(stream->buffer, size, &a, &b);
+    } else {
+        if (size >= 48) {
+            if (withHigh) {
+                highSeed = str__hashMix(stream->lanes[1] ^ secret[2], stream->lanes[2] ^ secret[3]);
+            }
+            seed = stream->lanes[0] ^ stream->lanes[1] ^ stream->lanes[2];
+        }
+        // the tail may look back up to 16 bytes into the last consumed block
+        u8 tail[16 + 48];
+        mem_copy(tail, stream->lastBlockTail, 16);
+        mem_copy(tail + 16, stream->buffer, stream->bufferSize);
+        str__hashTail(tail + 16, stream->bufferSize, &seed, &a, &b);
+    }
+    str_Hash128 result;
+    result.low = str__hashFinal(a, b, seed, size);
+    result.high = withHigh ? str__hashFinalHigh(a, b, seed, highSeed, size) : 0;
+    return result;
+}
+
+API u64 str_hashStreamFinish64(str_HashStream* stream) {
+    return str__hashStreamFinish(stream, false).low;
+}
+
+API str_Hash128 str_hashStreamFinish128(str_HashStream* stream) {
+    return str__hashStreamFinish(stream, true);
+}
+
+API u32 str_hash32Djb2(S8 str) {
+    u32 hash = 5381;
+    for (u64 i = 0; i < str.size; i++) {
+        hash = ((hash << 5) + hash) + str.content[i]; /* hash * 33 + c */
+    }
+    return hash;
+}
+
+API u64 str_hash64Djb2(S8 str) {
+    u32 hash1 = 5381;
     u32 hash2 = 52711;
     u64 i = str.size;
     while (i--) {
@@ -439,6 +2403,131 @@ API u64 str_hash64(S8 str) {
     return (hash1 >> 0) * 4096 + (hash2 >> 0);
 }
 
+////////////////////////////
+// NOTE(pjako): perfect hash, hash and displace (CHD). Keys are spread over buckets by their hash, then the
+// buckets are placed largest first and each searches for the first seed that moves all of its keys to free slots.
+// Keep in sync with str_perfectHashT in base_str.hpp.
+
+// the search succeeds within a few hundred seeds for any sane key set, only identical hashes can exhaust it
+#define STR__PERFECT_HASH_MAX_SEED (1u << 24)
+
+INLINE u64 str__perfectHashKey(S8 key) {
+    u64 hash = STR__PERFECT_HASH_BASIS;
+    for (u64 i = 0; i < key.size; i++) {
+        hash = str__perfectHashStep(hash, key.content[i]);
+    }
+    return str__perfectHashMix(hash);
+}
+
+API bx str_perfectHashBuild(Arena* arena, S8* keys, u32 count, str_PerfectHash* out) {
+    ASSERT(arena && out);
+    ASSERT(keys || count == 0);
+    mem_structSetZero(out);
+    u32 bucketCount = str__perfectHashBucketCount(count);
+    S8*  slotKeys = mem_arenaPushArrayZero(arena, S8, count);
+    u32* indices = mem_arenaPushArrayZero(arena, u32, count);
+    u32* seeds = mem_arenaPushArrayZero(arena, u32, bucketCount);
+    bx result = true;
+    mem_scoped(scratch, arena) {
+        u64* hashes = mem_arenaPushArray(scratch.arena, u64, count);
+        u32* bucketStart = mem_arenaPushArrayZero(scratch.arena, u32, (bucketCount + 1));
+        u32* bucketKeys = mem_arenaPushArray(scratch.arena, u32, count);
+        u32* bucketFill = mem_arenaPushArrayZero(scratch.arena, u32, bucketCount);
+        u32* order = mem_arenaPushArray(scratch.arena, u32, bucketCount);
+        u32* sizeStart = mem_arenaPushArrayZero(scratch.arena, u32, (count + 2));
+        u32* candidate = mem_arenaPushArray(scratch.arena, u32, count);
+        bx* taken = mem_arenaPushArrayZero(scratch.arena, bx, count);
+
+        // keys grouped by bucket
+        for (u32 i = 0; i < count; i++) {
+            hashes[i] = str__perfectHashKey(keys[i]);
+            bucketStart[str__perfectHashBucket(hashes[i], bucketCount) + 1] += 1;
+        }
+        for (u32 b = 0; b < bucketCount; b++) {
+            bucketStart[b + 1] += bucketStart[b];
+        }
+        for (u32 i = 0; i < count; i++) {
+            u32 bucket = str__perfectHashBucket(hashes[i], bucketCount);
+            bucketKeys[bucketStart[bucket] + bucketFill[bucket]++] = i;
+        }
+
+        // buckets sorted by size, largest first
+        for (u32 b = 0; b < bucketCount; b++) {
+            sizeStart[count - (bucketStart[b + 1] - bucketStart[b]) + 1] += 1;
+        }
+        for (u32 s = 0; s <= count; s++) {
+            sizeStart[s + 1] += sizeStart[s];
+        }
+        for (u32 b = 0; b < bucketCount; b++) {
+            order[sizeStart[count - (bucketStart[b + 1] - bucketStart[b])]++] = b;
+        }
+
+        for (u32 o = 0; o < bucketCount && result; o++) {
+            u32 bucket = order[o];
+            u32 first = bucketStart[bucket];
+            u32 size = bucketStart[bucket + 1] - first;
+            if (size == 0) {
+                break;
+            }
+            // identical hashes can never be separated by a seed
+            for (u32 i = 0; i < size && result; i++) {
+                for (u32 j = i + 1; j < size; j++) {
+                    if (hashes[bucketKeys[first + i]] == hashes[bucketKeys[first + j]]) {
+                        result = false;
+                        break;
+                    }
+                }
+            }
+            u32 seed = 1;
+            for (; seed < STR__PERFECT_HASH_MAX_SEED && result; seed++) {
+                u32 placed = 0;
+                for (; placed < size; placed++) {
+                    u32 slot = str__perfectHashSlot(hashes[bucketKeys[first + placed]], seed, count);
+                    if (taken[slot]) {
+                        break;
+                    }
+                    taken[slot] = true;
+                    candidate[placed] = slot;
+                }
+                if (placed == size) {
+                    break;
+                }
+                for (u32 i = 0; i < placed; i++) {
+                    taken[candidate[i]] = false;
+                }
+            }
+            if (!result || seed >= STR__PERFECT_HASH_MAX_SEED) {
+                result = false;
+                break;
+            }
+            seeds[bucket] = seed;
+            for (u32 i = 0; i < size; i++) {
+                slotKeys[candidate[i]] = keys[bucketKeys[first + i]];
+                indices[candidate[i]] = bucketKeys[first + i];
+            }
+        }
+    }
+    if (!result) {
+        return false;
+    }
+    out->keys = slotKeys;
+    out->indices = indices;
+    out->seeds = seeds;
+    out->count = count;
+    out->bucketCount = bucketCount;
+    return true;
+}
+
+API u32 str_perfectHashFind(const str_PerfectHash* table, S8 key) {
+    ASSERT(table);
+    if (table->count == 0) {
+        return 0;
+    }
+    u64 hash = str__perfectHashKey(key);
+    u32 slot = str__perfectHashSlot(hash, table->seeds[str__perfectHashBucket(hash, table->bucketCount)], table->count);
+    return str_isEqual(table->keys[slot], key) ? table->indices[slot] : table->count;
+}
+
 S8 str_fromCharPtr(u8* charArr, u64 size) {
    S8 str;
    str.content = charArr;
@@ -457,192 +2546,1586 @@ S8 str_fromNullTerminatedCharPtr(char* charArr) {
    return str;
 }
 
-#if 0
-static str_Decode str_decodeUtf8(u8* str, u64 cap) {
-   str_Decode result = {'#', 1};
-   u16 x = str[0];
-   if (x < 0xD800 || 0xDFFF < x) {
-      result.codepoint = x;
-   } else if (cap >= 2) {
-      u16 y = str[1];
-      if (0xD800 <= x && x < 0xDC00 && 0xDC00 <= y && y < 0xE000) {
-         u16 xj = x - 0xD800;
-         u16 yj = y - 0xDc00;
-         u32 xy = (xj << 10) | yj;
-         result.codepoint = xy + 0x10000;
-         result.size = 2;
-      }
-   }
-   return result;
+// strict decode of one code point, returns the sequence size or 0 for invalid/truncated sequences
+LOCAL u32 str__decodeUtf8Strict(const u8* ptr, u64 cap, u32* codepoint) {
+    u8 c0 = ptr[0];
+    if (c0 < 0x80) {
+        *codepoint = c0;
+        return 1;
+    }
+    if (c0 < 0xC2) return 0; // continuation byte or overlong 2 byte sequence
+    if (c0 < 0xE0) {
+        if (cap < 2 || !STR__UTF8_IS_CONTINUATION(ptr[1])) return 0;
+        *codepoint = (u32_cast(c0 & 0x1F) << 6) | (ptr[1] & 0x3F);
+        return 2;
+    }
+    if (c0 < 0xF0) {
+        if (cap < 3 || !STR__UTF8_IS_CONTINUATION(ptr[1]) || !STR__UTF8_IS_CONTINUATION(ptr[2])) return 0;
+        if (c0 == 0xE0 && ptr[1] < 0xA0) return 0; // overlong
+        if (c0 == 0xED && ptr[1] >= 0xA0) return 0; // utf16 surrogate
+        *codepoint = (u32_cast(c0 & 0x0F) << 12) | (u32_cast(ptr[1] & 0x3F) << 6) | (ptr[2] & 0x3F);
+        return 3;
+    }
+    if (c0 < 0xF5) {
+        if (cap < 4 || !STR__UTF8_IS_CONTINUATION(ptr[1]) || !STR__UTF8_IS_CONTINUATION(ptr[2]) || !STR__UTF8_IS_CONTINUATION(ptr[3])) return 0;
+        if (c0 == 0xF0 && ptr[1] < 0x90) return 0; // overlong
+        if (c0 == 0xF4 && ptr[1] >= 0x90) return 0; // above U+10FFFF
+        *codepoint = (u32_cast(c0 & 0x07) << 18) | (u32_cast(ptr[1] & 0x3F) << 12) | (u32_cast(ptr[2] & 0x3F) << 6) | (ptr[3] & 0x3F);
+        return 4;
+    }
+    return 0;
 }
-#endif
 
 str_StringDecode str_decodeUtf8(u8* str, u64 cap) {
-   str_StringDecode result = {'#', 1};
-   u16 x = str[0];
-   if (x < 0xD800 || 0xDFFF < x){
-      result.codepoint = x;
-   } else if (cap >= 2){
-      u16 y = str[1];
-      if (0xD800 <= x && x < 0xDC00 &&
-         0xDC00 <= y && y < 0xE000){
-         u16 xj = x - 0xD800;
-         u16 yj = y - 0xDc00;
-         u32 xy = (xj << 10) | yj;
-         result.codepoint = xy + 0x10000;
-         result.size = 2;
-      }
-   }
-   return(result);
-}
-
-static u32 str_encodeUtf16(u16* dst, u32 codepoint) {
-   u32 size = 0;
-   if (codepoint < 0x10000) {
-      dst[0] = codepoint;
-      #if OS_WIN == 1
-      size = 1;
-      #else
-      size = 2;
-      #endif
-   } else {
-      u32 cpj = codepoint - 0x10000;
-      dst[0] = (cpj >> 10 ) + 0xD800;
-      dst[1] = (cpj & 0x3FF) + 0xDC00;
-      #if OS_WIN == 1
-      size = 2;
-      #else
-      size = 4;
-      #endif
-   }
-   return size;
+    str_StringDecode result = {'#', 1};
+    u32 codepoint = 0;
+    u32 size = cap > 0 ? str__decodeUtf8Strict(str, cap, &codepoint) : 0;
+    if (size != 0) {
+        result.codepoint = codepoint;
+        result.size = size;
+    }
+    return result;
 }
 
-str_StringDecode str_decodeUtf16(u16 *str, u32 cap) {
-    str_StringDecode result = {'#', 1};
-    u16 x = str[0];
-    if (x < 0xD800 || 0xDFFF < x){
-        result.codepoint = x;
-    } else if (cap >= 2) {
-        u16 y = str[1];
-        if (0xD800 <= x && x < 0xDC00 &&
-            0xDC00 <= y && y < 0xE000) {
-            u16 xj = x - 0xD800;
-            u16 yj = y - 0xDc00;
-            u32 xy = (xj << 10) | yj;
-            result.codepoint = xy + 0x10000;
-            result.size = 2;
-        }
-    }
-    return(result);
-}
-
-u32 str_encodeUtf8(u8 *dst, u32 codepoint){
-    u32 size = 0;
-    if (codepoint < (1 << 8)) {
-        dst[0] = codepoint;
-        size = 1;
-    } else if (codepoint < (1 << 11)) {
-        dst[0] = 0xC0 | (codepoint >> 6);
-        dst[1] = 0x80 | (codepoint & 0x3F);
-        size = 2;
-    } else if (codepoint < (1 << 16)) {
-        dst[0] = 0xE0 | (codepoint >> 12);
-        dst[1] = 0x80 | ((codepoint >> 6) & 0x3F);
-        dst[2] = 0x80 | (codepoint & 0x3F);
-        size = 3;
-    } else if (codepoint < (1 << 21)) {
-        dst[0] = 0xF0 | (codepoint >> 18);
-        dst[1] = 0x80 | ((codepoint >> 12) & 0x3F);
-        dst[2] = 0x80 | ((codepoint >> 6) & 0x3F);
-        dst[3] = 0x80 | (codepoint & 0x3F);
-        size = 4;
-    } else {
-        dst[0] = '#';
-        size = 1;
+LOCAL u64 str__utf8ValidateScalar(const u8* ptr, u64 size, u64 idx) {
+    while (idx < size) {
+        idx += str__asciiPrefix(ptr + idx, size - idx);
+        if (idx >= size) break;
+        u32 codepoint;
+        u32 seqSize = str__decodeUtf8Strict(ptr + idx, size - idx, &codepoint);
+        if (seqSize == 0) return idx;
+        idx += seqSize;
+    }
+    return size;
+}
+
+#if SIMD_SSSE3 || SIMD_NEON
+// the bytes before idx are known to be valid except for a possibly unfinished last sequence,
+// so the first non continuation byte of the last three is a code point boundary
+LOCAL u64 str__utf8BoundaryBefore(const u8* ptr, u64 idx) {
+    u64 start = idx >= 3 ? idx - 3 : 0;
+    while (start < idx && STR__UTF8_IS_CONTINUATION(ptr[start])) start++;
+    return start;
+}
+
+// Lookup table validation, see: John Keiser, Daniel Lemire "Validating UTF-8 In Less Than One Instruction Per Byte"
+#if SIMD_SSSE3
+typedef __m128i str__V16;
+#define str__v16Load(PTR)           _mm_loadu_si128((const __m128i*) (PTR))
+#define str__v16Set1(VAL)           _mm_set1_epi8((char) (VAL))
+#define str__v16And(A, B)           _mm_and_si128(A, B)
+#define str__v16Or(A, B)            _mm_or_si128(A, B)
+#define str__v16Xor(A, B)           _mm_xor_si128(A, B)
+#define str__v16Shr4(A)             _mm_and_si128(_mm_srli_epi16(A, 4), _mm_set1_epi8(0x0F))
+#define str__v16Lookup(TABLE, IDX)  _mm_shuffle_epi8(TABLE, IDX)
+#define str__v16SubSat(A, B)        _mm_subs_epu8(A, B)
+#define str__v16Prev(CUR, PREV, N)  _mm_alignr_epi8(CUR, PREV, 16 - (N))
+#define str__v16AnySet(A)           (_mm_movemask_epi8(_mm_cmpeq_epi8(A, _mm_setzero_si128())) != 0xFFFF)
+#define str__v16IsAscii(A)          (_mm_movemask_epi8(A) == 0)
+#else
+typedef uint8x16_t str__V16;
+#define str__v16Load(PTR)           vld1q_u8((const u8*) (PTR))
+#define str__v16Set1(VAL)           vdupq_n_u8((u8) (VAL))
+#define str__v16And(A, B)           vandq_u8(A, B)
+#define str__v16Or(A, B)            vorrq_u8(A, B)
+#define str__v16Xor(A, B)           veorq_u8(A, B)
+#define str__v16Shr4(A)             vshrq_n_u8(A, 4)
+#define str__v16Lookup(TABLE, IDX)  vqtbl1q_u8(TABLE, IDX)
+#define str__v16SubSat(A, B)        vqsubq_u8(A, B)
+#define str__v16Prev(CUR, PREV, N)  vextq_u8(PREV, CUR, 16 - (N))
+#define str__v16AnySet(A)           (vmaxvq_u8(A) != 0)
+#define str__v16IsAscii(A)          (vmaxvq_u8(A) < 0x80)
+#endif
+
+#define STR__UTF8_TOO_SHORT   (1 << 0)
+#define STR__UTF8_TOO_LONG    (1 << 1)
+#define STR__UTF8_OVERLONG_3  (1 << 2)
+#define STR__UTF8_TOO_LARGE   (1 << 3)
+#define STR__UTF8_SURROGATE   (1 << 4)
+#define STR__UTF8_OVERLONG_2  (1 << 5)
+#define STR__UTF8_TOO_LARGE_1000 (1 << 6)
+#define STR__UTF8_OVERLONG_4  (1 << 6)
+#define STR__UTF8_TWO_CONTS   (1 << 7)
+#define STR__UTF8_CARRY       (STR__UTF8_TOO_SHORT | STR__UTF8_TOO_LONG | STR__UTF8_TWO_CONTS)
+
+LOCAL u64 str__utf8ValidateSimd(const u8* ptr, u64 size) {
+    static const u8 byte1HighTable[16] = {
+        // 0_______ ________ <ascii in byte 1>
+        STR__UTF8_TOO_LONG, STR__UTF8_TOO_LONG, STR__UTF8_TOO_LONG, STR__UTF8_TOO_LONG,
+        STR__UTF8_TOO_LONG, STR__UTF8_TOO_LONG, STR__UTF8_TOO_LONG, STR__UTF8_TOO_LONG,
+        // 10______ ________ <continuation in byte 1>
+        STR__UTF8_TWO_CONTS, STR__UTF8_TWO_CONTS, STR__UTF8_TWO_CONTS, STR__UTF8_TWO_CONTS,
+        // 1100____ ________ <two byte lead in byte 1>
+        STR__UTF8_TOO_SHORT | STR__UTF8_OVERLONG_2,
+        // 1101____ ________ <two byte lead in byte 1>
+        STR__UTF8_TOO_SHORT,
+        // 1110____ ________ <three byte lead in byte 1>
+        STR__UTF8_TOO_SHORT | STR__UTF8_OVERLONG_3 | STR__UTF8_SURROGATE,
+        // 1111____ ________ <four+ byte lead in byte 1>
+        STR__UTF8_TOO_SHORT | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000 | STR__UTF8_OVERLONG_4
+    };
+    static const u8 byte1LowTable[16] = {
+        // ____0000 ________
+        STR__UTF8_CARRY | STR__UTF8_OVERLONG_3 | STR__UTF8_OVERLONG_2 | STR__UTF8_OVERLONG_4,
+        // ____0001 ________
+        STR__UTF8_CARRY | STR__UTF8_OVERLONG_2,
+        // ____001_ ________
+        STR__UTF8_CARRY,
+        STR__UTF8_CARRY,
+        // ____0100 ________
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE,
+        // ____0101 ________
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000,
+        // ____011_ ________
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000,
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000,
+        // ____1___ ________
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000,
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000,
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000,
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000,
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000,
+        // ____1101 ________
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000 | STR__UTF8_SURROGATE,
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000,
+        STR__UTF8_CARRY | STR__UTF8_TOO_LARGE | STR__UTF8_TOO_LARGE_1000
+    };
+    static const u8 byte2HighTable[16] = {
+        // ________ 0_______ <ascii in byte 2>
+        STR__UTF8_TOO_SHORT, STR__UTF8_TOO_SHORT, STR__UTF8_TOO_SHORT, STR__UTF8_TOO_SHORT,
+        STR__UTF8_TOO_SHORT, STR__UTF8_TOO_SHORT, STR__UTF8_TOO_SHORT, STR__UTF8_TOO_SHORT,
+        // ________ 1000____
+        STR__UTF8_TOO_LONG | STR__UTF8_OVERLONG_2 | STR__UTF8_TWO_CONTS | STR__UTF8_OVERLONG_3 | STR__UTF8_TOO_LARGE_1000 | STR__UTF8_OVERLONG_4,
+        // ________ 1001____
+        STR__UTF8_TOO_LONG | STR__UTF8_OVERLONG_2 | STR__UTF8_TWO_CONTS | STR__UTF8_OVERLONG_3 | STR__UTF8_TOO_LARGE,
+        // ________ 101_____
+        STR__UTF8_TOO_LONG | STR__UTF8_OVERLONG_2 | STR__UTF8_TWO_CONTS | STR__UTF8_SURROGATE | STR__UTF8_TOO_LARGE,
+        STR__UTF8_TOO_LONG | STR__UTF8_OVERLONG_2 | STR__UTF8_TWO_CONTS | STR__UTF8_SURROGATE | STR__UTF8_TOO_LARGE,
+        // ________ 11______
+        STR__UTF8_TOO_SHORT, STR__UTF8_TOO_SHORT, STR__UTF8_TOO_SHORT, STR__UTF8_TOO_SHORT
+    };
+    // the last three bytes of a block must not start a sequence that needs more bytes than are left
+    static const u8 incompleteMax[16] = {
+        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xF0 - 1, 0xE0 - 1, 0xC0 - 1
+    };
+
+    const str__V16 byte1High = str__v16Load(byte1HighTable);
+    const str__V16 byte1Low = str__v16Load(byte1LowTable);
+    const str__V16 byte2High = str__v16Load(byte2HighTable);
+    const str__V16 maxIncomplete = str__v16Load(incompleteMax);
+    const str__V16 lowNibble = str__v16Set1(0x0F);
+    const str__V16 highBit = str__v16Set1(0x80);
+    const str__V16 thirdByteMin = str__v16Set1(0xE0 - 0x80);
+    const str__V16 fourthByteMin = str__v16Set1(0xF0 - 0x80);
+
+    str__V16 prevInput = str__v16Set1(0);
+    str__V16 prevIncomplete = str__v16Set1(0);
+    u64 idx = 0;
+    for (; idx + 16 <= size; idx += 16) {
+        str__V16 input = str__v16Load(ptr + idx);
+        str__V16 error;
+        if (str__v16IsAscii(input)) {
+            // an ascii block may only follow a finished sequence
+            error = prevIncomplete;
+        } else {
+            str__V16 prev1 = str__v16Prev(input, prevInput, 1);
+            str__V16 special = str__v16And(str__v16And(
+                str__v16Lookup(byte1High, str__v16Shr4(prev1)),
+                str__v16Lookup(byte1Low, str__v16And(prev1, lowNibble))),
+                str__v16Lookup(byte2High, str__v16Shr4(input)));
+            str__V16 prev2 = str__v16Prev(input, prevInput, 2);
+            str__V16 prev3 = str__v16Prev(input, prevInput, 3);
+            str__V16 must23 = str__v16Or(str__v16SubSat(prev2, thirdByteMin), str__v16SubSat(prev3, fourthByteMin));
+            error = str__v16Xor(str__v16And(must23, highBit), special);
+            prevIncomplete = str__v16SubSat(input, maxIncomplete);
+        }
+        if (str__v16AnySet(error)) {
+            // rerun the scalar validator from the last boundary to find the exact error position
+            return str__utf8ValidateScalar(ptr, size, str__utf8BoundaryBefore(ptr, idx));
+        }
+        prevInput = input;
+    }
+    return str__utf8ValidateScalar(ptr, size, str__utf8BoundaryBefore(ptr, idx));
+}
+#endif // SIMD_SSSE3 || SIMD_NEON
+
+u64 str_utf8Validate(S8 str) {
+    // most text is ascii only, skip it before setting up the validator
+    u64 idx = str__asciiPrefix(str.content, str.size);
+    if (idx == str.size) return idx;
+#if SIMD_SSSE3 || SIMD_NEON
+    u64 start = str__utf8BoundaryBefore(str.content, idx);
+    return start + str__utf8ValidateSimd(str.content + start, str.size - start);
+#else
+    return str__utf8ValidateScalar(str.content, str.size, idx);
+#endif
+}
+
+bx str_utf8IsValid(S8 str) {
+    return str_utf8Validate(str) == str.size;
+}
+
+u64 str_utf16SizeFromUtf8(S8 str) {
+    u64 size = 0;
+    for (u64 idx = 0; idx < str.size;) {
+        u64 asciiCount = str__asciiPrefix(str.content + idx, str.size - idx);
+        size += asciiCount;
+        idx += asciiCount;
+        if (idx >= str.size) break;
+        u8 c = str.content[idx++];
+        // 4 byte sequences become a surrogate pair, continuation bytes add nothing
+        size += c >= 0xF0 ? 2 : !STR__UTF8_IS_CONTINUATION(c);
+    }
+    return size;
+}
+
+u64 str_utf8SizeFromUtf16(S16 str) {
+    u64 size = 0;
+    for (u64 idx = 0; idx < str.size; idx++) {
+        u16 c = str.content[idx];
+        // each half of a surrogate pair accounts for 2 of the 4 bytes
+        size += c < 0x80 ? 1 : (c < 0x800 || (c >= 0xD800 && c <= 0xDFFF)) ? 2 : 3;
+    }
+    return size;
+}
+
+str_Transcode str_utf8ToUtf16(S8 str, u16* out) {
+    const u8* ptr = str.content;
+    u16* dst = out;
+    u64 idx = 0;
+    while (idx < str.size) {
+#if SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        for (; idx + 16 <= str.size; idx += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*) (ptr + idx));
+            if (_mm_movemask_epi8(v)) break;
+            _mm_storeu_si128((__m128i*) dst, _mm_unpacklo_epi8(v, zero));
+            _mm_storeu_si128((__m128i*) (dst + 8), _mm_unpackhi_epi8(v, zero));
+            dst += 16;
+        }
+#elif SIMD_NEON
+        for (; idx + 16 <= str.size; idx += 16) {
+            uint8x16_t v = vld1q_u8(ptr + idx);
+            if (vmaxvq_u8(v) >= 0x80) break;
+            vst1q_u16(dst, vmovl_u8(vget_low_u8(v)));
+            vst1q_u16(dst + 8, vmovl_high_u8(v));
+            dst += 16;
+        }
+#endif
+        for (; idx < str.size && ptr[idx] < 0x80; idx++) {
+            *dst++ = ptr[idx];
+        }
+        if (idx >= str.size) break;
+
+        u32 codepoint;
+        u32 seqSize = str__decodeUtf8Strict(ptr + idx, str.size - idx, &codepoint);
+        if (seqSize == 0) {
+            str_Transcode result = {u64_cast(dst - out), idx};
+            return result;
+        }
+        if (codepoint < 0x10000) {
+            *dst++ = (u16) codepoint;
+        } else {
+            u32 cpj = codepoint - 0x10000;
+            *dst++ = (u16) ((cpj >> 10) + 0xD800);
+            *dst++ = (u16) ((cpj & 0x3FF) + 0xDC00);
+        }
+        idx += seqSize;
     }
-    return(size);
+    str_Transcode result = {u64_cast(dst - out), str.size};
+    return result;
+}
+
+str_Transcode str_utf8ToUtf32(S8 str, u32* out) {
+    const u8* ptr = str.content;
+    u32* dst = out;
+    u64 idx = 0;
+    while (idx < str.size) {
+#if SIMD_SSE2
+        const __m128i zero = _mm_setzero_si128();
+        for (; idx + 16 <= str.size; idx += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i*) (ptr + idx));
+            if (_mm_movemask_epi8(v)) break;
+            __m128i lo = _mm_unpacklo_epi8(v, zero);
+            __m128i hi = _mm_unpackhi_epi8(v, zero);
+            _mm_storeu_si128((__m128i*) dst, _mm_unpacklo_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*) (dst + 4), _mm_unpackhi_epi16(lo, zero));
+            _mm_storeu_si128((__m128i*) (dst + 8), _mm_unpacklo_epi16(hi, zero));
+            _mm_storeu_si128((__m128i*) (dst + 12), _mm_unpackhi_epi16(hi, zero));
+            dst += 16;
+        }
+#elif SIMD_NEON
+        for (; idx + 16 <= str.size; idx += 16) {
+            uint8x16_t v = vld1q_u8(ptr + idx);
+            if (vmaxvq_u8(v) >= 0x80) break;
+            uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+            uint16x8_t hi = vmovl_high_u8(v);
+            vst1q_u32(dst, vmovl_u16(vget_low_u16(lo)));
+            vst1q_u32(dst + 4, vmovl_high_u16(lo));
+            vst1q_u32(dst + 8, vmovl_u16(vget_low_u16(hi)));
+            vst1q_u32(dst + 12, vmovl_high_u16(hi));
+            dst += 16;
+        }
+#endif
+        for (; idx < str.size && ptr[idx] < 0x80; idx++) {
+            *dst++ = ptr[idx];
+        }
+        if (idx >= str.size) break;
+
+        u32 codepoint;
+        u32 seqSize = str__decodeUtf8Strict(ptr + idx, str.size - idx, &codepoint);
+        if (seqSize == 0) {
+            str_Transcode result = {u64_cast(dst - out), idx};
+            return result;
+        }
+        *dst++ = codepoint;
+        idx += seqSize;
+    }
+    str_Transcode result = {u64_cast(dst - out), str.size};
+    return result;
+}
+
+str_Transcode str_utf16ToUtf8(S16 str, u8* out) {
+    const u16* ptr = str.content;
+    u8* dst = out;
+    u64 idx = 0;
+    while (idx < str.size) {
+#if SIMD_SSE2
+        const __m128i nonAscii = _mm_set1_epi16((short) 0xFF80);
+        const __m128i zero = _mm_setzero_si128();
+        for (; idx + 8 <= str.size; idx += 8) {
+            __m128i v = _mm_loadu_si128((const __m128i*) (ptr + idx));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(v, nonAscii), zero)) != 0xFFFF) break;
+            _mm_storel_epi64((__m128i*) dst, _mm_packus_epi16(v, v));
+            dst += 8;
+        }
+#elif SIMD_NEON
+        for (; idx + 8 <= str.size; idx += 8) {
+            uint16x8_t v = vld1q_u16(ptr + idx);
+            if (vmaxvq_u16(v) >= 0x80) break;
+            vst1_u8(dst, vmovn_u16(v));
+            dst += 8;
+        }
+#endif
+        if (idx >= str.size) break;
+        u16 c = ptr[idx];
+        if (c < 0x80) {
+            *dst++ = (u8) c;
+            idx += 1;
+        } else if (c < 0x800) {
+            dst[0] = (u8) (0xC0 | (c >> 6));
+            dst[1] = (u8) (0x80 | (c & 0x3F));
+            dst += 2;
+            idx += 1;
+        } else if (c < 0xD800 || c > 0xDFFF) {
+            dst[0] = (u8) (0xE0 | (c >> 12));
+            dst[1] = (u8) (0x80 | ((c >> 6) & 0x3F));
+            dst[2] = (u8) (0x80 | (c & 0x3F));
+            dst += 3;
+            idx += 1;
+        } else if (c <= 0xDBFF && (idx + 1) < str.size && ptr[idx + 1] >= 0xDC00 && ptr[idx + 1] <= 0xDFFF) {
+            u32 codepoint = ((u32_cast(c - 0xD800) << 10) | u32_cast(ptr[idx + 1] - 0xDC00)) + 0x10000;
+            dst[0] = (u8) (0xF0 | (codepoint >> 18));
+            dst[1] = (u8) (0x80 | ((codepoint >> 12) & 0x3F));
+            dst[2] = (u8) (0x80 | ((codepoint >> 6) & 0x3F));
+            dst[3] = (u8) (0x80 | (codepoint & 0x3F));
+            dst += 4;
+            idx += 2;
+        } else {
+            // unpaired surrogate
+            str_Transcode result = {u64_cast(dst - out), idx};
+            return result;
+        }
+    }
+    str_Transcode result = {u64_cast(dst - out), str.size};
+    return result;
 }
 
 S8 str_fromS16(Arena* arena, S16 str) {
-   u8 *memory = mem_arenaPushArrayZero(arena, u8, str.size * 3 + 1);
-
-   u8  *dptr = memory;
-   u16 *ptr  = str.content;
-   u16 *opl  = str.content + str.size;
-   for (; ptr < opl;) {
-      str_StringDecode decode = str_decodeUtf16(ptr, (u64)(opl - ptr));
-      u16 enc_size = str_encodeUtf8(dptr, decode.codepoint);
-      ptr += decode.size;
-      dptr += enc_size;
-   }
+    u8* memory = mem_arenaPushArray(arena, u8, str.size * 3 + 1);
+    u64 size = 0;
+    for (S16 rest = str; rest.size > 0;) {
+        str_Transcode transcode = str_utf16ToUtf8(rest, memory + size);
+        size += transcode.size;
+        if (transcode.errorIndex >= rest.size) break;
+        memory[size++] = '#';
+        rest.content += transcode.errorIndex + 1;
+        rest.size -= transcode.errorIndex + 1;
+    }
+    memory[size] = '\0';
 
-   dptr[0] = 0;
-   //dptr[3] = 0;
+    S8 result = {memory, size};
+    return result;
+}
 
-   u64 allocCount = str.size * 3 + 1;
-   u64 stringCount = (u64)(dptr - memory);
-   u64 unusedCount = allocCount - stringCount - 1;
-   //mem_arenaPopAmount(arena, unusedCount * sizeof(*memory));
+S16 str_toS16(Arena* arena, S8 str) {
+    // every utf8 byte results in at most one utf16 code unit
+    u16* memory = mem_arenaPushArray(arena, u16, str.size + 1);
+    u64 size = 0;
+    for (S8 rest = str; rest.size > 0;) {
+        str_Transcode transcode = str_utf8ToUtf16(rest, memory + size);
+        size += transcode.size;
+        if (transcode.errorIndex >= rest.size) break;
+        memory[size++] = '#';
+        rest.content += transcode.errorIndex + 1;
+        rest.size -= transcode.errorIndex + 1;
+    }
+    memory[size] = 0;
 
-   S8 result = {memory, stringCount};
-   return(result);
+    S16 result = {memory, size};
+    return result;
 }
 
-S16 str_toS16(Arena *arena, S8 str) {
-   u64 allocSize = str.size * 4 + 2;
-   u16 *memory = mem_arenaPushArray(arena, u16, allocSize);
+S32 str_toS32(Arena* arena, S8 str) {
+    u32* memory = mem_arenaPushArray(arena, u32, str.size + 1);
+    u64 size = 0;
+    for (S8 rest = str; rest.size > 0;) {
+        str_Transcode transcode = str_utf8ToUtf32(rest, memory + size);
+        size += transcode.size;
+        if (transcode.errorIndex >= rest.size) break;
+        memory[size++] = '#';
+        rest.content += transcode.errorIndex + 1;
+        rest.size -= transcode.errorIndex + 1;
+    }
+    memory[size] = 0;
 
-   u16 *dptr = memory;
-   u8 *ptr = str.content;
-   u8 *opl = str.content + str.size;
-   u16* wstr = (u16*) memory;
+    S32 result = {memory, size};
+    return result;
+}
 
-   for (; ptr < opl;) {
-      str_StringDecode decode = str_decodeUtf8(ptr, (u64)(opl - ptr));
-      u32 encSize = str_encodeUtf16(dptr, decode.codepoint);
-      ptr  = ptr + decode.size;
-      dptr = &dptr[encSize];
-   }
+////////////////////////////
+// NOTE(pjako): number formatting
+// Integers are written two digits per step from a pair table directly to their final position.
+// Floats use Ryu (https://github.com/ulfjack/ryu, Apache 2.0/Boost) to find the shortest digits that
+// parse back to the same value, the layout follows the JavaScript Number.toString rules.
+
+static const char str__digitPairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static const u64 str__powersOfTen[20] = {
+    u64_val(1), u64_val(10), u64_val(100), u64_val(1000), u64_val(10000), u64_val(100000),
+    u64_val(1000000), u64_val(10000000), u64_val(100000000), u64_val(1000000000),
+    u64_val(10000000000), u64_val(100000000000), u64_val(1000000000000), u64_val(10000000000000),
+    u64_val(100000000000000), u64_val(1000000000000000), u64_val(10000000000000000),
+    u64_val(100000000000000000), u64_val(1000000000000000000), u64_val(10000000000000000000),
+};
 
-   *dptr = 0;
-   dptr += 1;
-   *dptr = 0;
+INLINE u32 str__decimalLength(u64 value) {
+    // log10 estimate from the bit length, corrected with one compare
+    u32 t = ((64 - u32_cast(u64_bitScanNonZero(value | 1))) * 1233) >> 12;
+    return t + (value >= str__powersOfTen[t]) + (value == 0);
+}
 
-   u64 stringCount = (u64)(dptr - memory);
-   u64 unusedCount = allocSize - stringCount - 1;
-   //mem_arenaPopAmount(arena, unusedCount);
+// writes exactly length digits, length has to be str__decimalLength(value) or more (zero padding)
+INLINE void str__writeDigits(u8* out, u32 length, u64 value) {
+    u8* p = out + length;
+    while (value >= 100) {
+        u64 idx = (value % 100) * 2;
+        value /= 100;
+        p -= 2;
+        p[0] = str__digitPairs[idx];
+        p[1] = str__digitPairs[idx + 1];
+    }
+    if (value >= 10) {
+        p -= 2;
+        p[0] = str__digitPairs[value * 2];
+        p[1] = str__digitPairs[value * 2 + 1];
+    } else {
+        *--p = u8_cast('0' + value);
+    }
+    while (p > out) {
+        *--p = '0';
+    }
+}
 
-   S16 result = {memory, stringCount};
-   return result;
+API u64 str_u64ToChars(u64 value, u8* out) {
+    u32 length = str__decimalLength(value);
+    str__writeDigits(out, length, value);
+    return length;
 }
 
-S32 str_toS32(Arena *arena, S8 str) {
-   u64 allocSize = str.size * 4 + 2;
-   u32 *memory = mem_arenaPushArray(arena, u32, allocSize);
+API u64 str_i64ToChars(i64 value, u8* out) {
+    if (value < 0) {
+        out[0] = '-';
+        return str_u64ToChars(~u64_cast(value) + 1, out + 1) + 1;
+    }
+    return str_u64ToChars(u64_cast(value), out);
+}
 
-   u32 *dptr = memory;
-   u8 *ptr = str.content;
-   u8 *opl = str.content + str.size;
-   u32* wstr = (u32*) memory;
+// Ryu tables: 5^i and 2^k/5^i with 125 significant bits, {low, high}
+#define STR__RYU_POW5_INV_BITCOUNT 125
+#define STR__RYU_POW5_BITCOUNT 125
+#define STR__RYU_FLOAT_POW5_INV_BITCOUNT (STR__RYU_POW5_INV_BITCOUNT - 64)
+#define STR__RYU_FLOAT_POW5_BITCOUNT (STR__RYU_POW5_BITCOUNT - 64)
+
+static const u64 str__ryuPow5InvSplit[342][2] = {
+    {u64_val(0x0000000000000001), u64_val(0x2000000000000000)},
+    {u64_val(0x999999999999999a), u64_val(0x1999999999999999)},
+    {u64_val(0x47ae147ae147ae15), u64_val(0x147ae147ae147ae1)},
+    {u64_val(0x6c8b4395810624de), u64_val(0x10624dd2f1a9fbe7)},
+    {u64_val(0x7a786c226809d496), u64_val(0x1a36e2eb1c432ca5)},
+    {u64_val(0x61f9f01b866e43ab), u64_val(0x14f8b588e368f084)},
+    {u64_val(0xb4c7f34938583622), u64_val(0x10c6f7a0b5ed8d36)},
+    {u64_val(0x87a6520ec08d236a), u64_val(0x1ad7f29abcaf4857)},
+    {u64_val(0x9fb841a566d74f88), u64_val(0x15798ee2308c39df)},
+    {u64_val(0xe62d01511f12a607), u64_val(0x112e0be826d694b2)},
+    {u64_val(0xd6ae6881cb5109a4), u64_val(0x1b7cdfd9d7bdbab7)},
+    {u64_val(0xdef1ed34a2a73aea), u64_val(0x15fd7fe17964955f)},
+    {u64_val(0x7f27f0f6e885c8bb), u64_val(0x119799812dea1119)},
+    {u64_val(0x650cb4be40d60df8), u64_val(0x1c25c268497681c2)},
+    {u64_val(0xea70909833de7193), u64_val(0x16849b86a12b9b01)},
+    {u64_val(0x21f3a6e0297ec143), u64_val(0x1203af9ee756159b)},
+    {u64_val(0x6985d7cd0f313537), u64_val(0x1cd2b297d889bc2b)},
+    {u64_val(0x2137dfd73f5a90f9), u64_val(0x170ef54646d49689)},
+    {u64_val(0xe75fe645cc4873fa), u64_val(0x12725dd1d243aba0)},
+    {u64_val(0xa5663d3c7a0d865d), u64_val(0x1d83c94fb6d2ac34)},
+    {u64_val(0x511e976394d79eb1), u64_val(0x179ca10c9242235d)},
+    {u64_val(0xda7edf82dd794bc1), u64_val(0x12e3b40a0e9b4f7d)},
+    {u64_val(0x2a6498d1625bac68), u64_val(0x1e392010175ee596)},
+    {u64_val(0xeeb6e0a781e2f053), u64_val(0x182db34012b25144)},
+    {u64_val(0x58924d52ce4f26a9), u64_val(0x1357c299a88ea76a)},
+    {u64_val(0x27507bb7b07ea441), u64_val(0x1ef2d0f5da7dd8aa)},
+    {u64_val(0x52a6c95fc0655034), u64_val(0x18c240c4aecb13bb)},
+    {u64_val(0x0eebd44c99eaa690), u64_val(0x13ce9a36f23c0fc9)},
+    {u64_val(0xb17953adc3110a80), u64_val(0x1fb0f6be50601941)},
+    {u64_val(0xc12ddc8b02740867), u64_val(0x195a5efea6b34767)},
+    {u64_val(0x3424b06f3529a052), u64_val(0x14484bfeebc29f86)},
+    {u64_val(0x901d59f290ee19db), u64_val(0x1039d66589687f9e)},
+    {u64_val(0x4cfbc31db4b0295f), u64_val(0x19f623d5a8a73297)},
+    {u64_val(0x3d9635b15d59bab2), u64_val(0x14c4e977ba1f5bac)},
+    {u64_val(0x97ab5e277de16228), u64_val(0x109d8792fb4c4956)},
+    {u64_val(0xf2abc9d8c9689d0d), u64_val(0x1a95a5b7f87a0ef0)},
+    {u64_val(0x5bbca17a3aba173e), u64_val(0x154484932d2e725a)},
+    {u64_val(0xafca1ac82efb45cb), u64_val(0x11039d428a8b8eae)},
+    {u64_val(0xb2dcf7a6b1920945), u64_val(0x1b38fb9daa78e44a)},
+    {u64_val(0xf57d92ebc141a104), u64_val(0x15c72fb1552d836e)},
+    {u64_val(0xc46475896767b403), u64_val(0x116c262777579c58)},
+    {u64_val(0x6d6d88dbd8a5ecd2), u64_val(0x1be03d0bf225c6f4)},
+    {u64_val(0x8abe071646eb23db), u64_val(0x164cfda3281e38c3)},
+    {u64_val(0x6efe6c11d255b649), u64_val(0x11d7314f534b609c)},
+    {u64_val(0xb197134fb6ef8a0e), u64_val(0x1c8b821885456760)},
+    {u64_val(0x27ac0f72f8bfa1a5), u64_val(0x16d601ad376ab91a)},
+    {u64_val(0xb95672c260994e1e), u64_val(0x1244ce242c5560e1)},
+    {u64_val(0xf5571e03cdc21695), u64_val(0x1d3ae36d13bbce35)},
+    {u64_val(0x2aac18030b01abab), u64_val(0x17624f8a762fd82b)},
+    {u64_val(0xbbbce0026f348956), u64_val(0x12b50c6ec4f31355)},
+    {u64_val(0x92c7ccd0b1eda889), u64_val(0x1dee7a4ad4b81eef)},
+    {u64_val(0xdbd30a408e57ba07), u64_val(0x17f1fb6f10934bf2)},
+    {u64_val(0x7ca8d50071dfc806), u64_val(0x1327fc58da0f6ff5)},
+    {u64_val(0xfaa7bb33e9660cd6), u64_val(0x1ea6608e29b24cbb)},
+    {u64_val(0x9552fc298784d711), u64_val(0x18851a0b548ea3c9)},
+    {u64_val(0xaaa8c9bad2d0ac0e), u64_val(0x139dae6f76d88307)},
+    {u64_val(0xdddadc5e1e1aace3), u64_val(0x1f62b0b257c0d1a5)},
+    {u64_val(0x7e48b04b4b488a4f), u64_val(0x191bc08eac9a4151)},
+    {u64_val(0xcb6d59d5d5d3a1d9), u64_val(0x141633a556e1cdda)},
+    {u64_val(0x3c577b1177dc817b), u64_val(0x1011c2eaabe7d7e2)},
+    {u64_val(0xc6f25e825960cf2a), u64_val(0x19b604aaaca62636)},
+    {u64_val(0x6bf518684780a5bb), u64_val(0x14919d5556eb51c5)},
+    {u64_val(0x232a79ed06008496), u64_val(0x10747ddddf22a7d1)},
+    {u64_val(0xd1dd8fe1a3340756), u64_val(0x1a53fc9631d10c81)},
+    {u64_val(0xa7e4731ae8f66c45), u64_val(0x150ffd44f4a73d34)},
+    {u64_val(0x531d28e253f8569e), u64_val(0x10d9976a5d52975d)},
+    {u64_val(0xeb61db03b98d5762), u64_val(0x1af5bf109550f22e)},
+    {u64_val(0xbc4e48cfc7a445e8), u64_val(0x159165a6ddda5b58)},
+    {u64_val(0x6371d3d96c836b20), u64_val(0x11411e1f17e1e2ad)},
+    {u64_val(0x9f1c8628ad9f11cd), u64_val(0x1b9b6364f3030448)},
+    {u64_val(0xe5b06b53be18db0b), u64_val(0x1615e91d8f359d06)},
+    {u64_val(0xeaf3890fcb4715a2), u64_val(0x11ab20e472914a6b)},
+    {u64_val(0x44b8db4c7871bc37), u64_val(0x1c45016d841baa46)},
+    {u64_val(0x03c715d6c6c1635f), u64_val(0x169d9abe03495505)},
+    {u64_val(0x3638de456bcde919), u64_val(0x1217aefe69077737)},
+    {u64_val(0x56c163a2461641c1), u64_val(0x1cf2b1970e725858)},
+    {u64_val(0xdf011c81d1ab67ce), u64_val(0x17288e1271f51379)},
+    {u64_val(0x7f3416ce4155eca5), u64_val(0x1286d80ec190dc61)},
+    {u64_val(0x6520247d3556476e), u64_val(0x1da48ce468e7c702)},
+    {u64_val(0xea801d30f7783925), u64_val(0x17b6d71d20b96c01)},
+    {u64_val(0xbb99b0f3f92cfa84), u64_val(0x12f8ac174d612334)},
+    {u64_val(0x5f5c4e532847f739), u64_val(0x1e5aacf215683854)},
+    {u64_val(0x7f7d0b75b9d32c2e), u64_val(0x18488a5b44536043)},
+    {u64_val(0x9930d5f7c7dc2358), u64_val(0x136d3b7c36a919cf)},
+    {u64_val(0x8eb4898c72f9d226), u64_val(0x1f152bf9f10e8fb2)},
+    {u64_val(0x722a07a38f2e41b8), u64_val(0x18ddbcc7f40ba628)},
+    {u64_val(0xc1bb394fa5be9afa), u64_val(0x13e497065cd61e86)},
+    {u64_val(0x9c5ec2190930f7f6), u64_val(0x1fd424d6faf030d7)},
+    {u64_val(0x49e56814075a5ff8), u64_val(0x197683df2f268d79)},
+    {u64_val(0x6e51201005e1e660), u64_val(0x145ecfe5bf520ac7)},
+    {u64_val(0xf1da800cd181851a), u64_val(0x104bd984990e6f05)},
+    {u64_val(0x4fc400148268d4f5), u64_val(0x1a12f5a0f4e3e4d6)},
+    {u64_val(0xd96999aa01ed772b), u64_val(0x14dbf7b3f71cb711)},
+    {u64_val(0xadee1488018ac5bc), u64_val(0x10aff95cc5b09274)},
+    {u64_val(0x497ceda668de092c), u64_val(0x1ab328946f80ea54)},
+    {u64_val(0x3aca57b853e4d424), u64_val(0x155c2076bf9a5510)},
+    {u64_val(0x623b7960431d7683), u64_val(0x1116805effaeaa73)},
+    {u64_val(0x9d2bf566d1c8bd9e), u64_val(0x1b5733cb32b110b8)},
+    {u64_val(0x7dbcc452416d647f), u64_val(0x15df5ca28ef40d60)},
+    {u64_val(0xcafd69db678ab6cc), u64_val(0x117f7d4ed8c33de6)},
+    {u64_val(0xab2f0fc572778adf), u64_val(0x1bff2ee48e052fd7)},
+    {u64_val(0x88f273045b92d580), u64_val(0x1665bf1d3e6a8cac)},
+    {u64_val(0xd3f528d049424466), u64_val(0x11eaff4a98553d56)},
+    {u64_val(0xb988414d4203a0a3), u64_val(0x1cab3210f3bb9557)},
+    {u64_val(0x6139cdd76802e6e9), u64_val(0x16ef5b40c2fc7779)},
+    {u64_val(0xe761717920025254), u64_val(0x125915cd68c9f92d)},
+    {u64_val(0xa568b58e999d5086), u64_val(0x1d5b561574765b7c)},
+    {u64_val(0x5120913ee14aa6d2), u64_val(0x177c44ddf6c515fd)},
+    {u64_val(0xa74d40ff1aa21f0e), u64_val(0x12c9d0b1923744ca)},
+    {u64_val(0x0baece64f769cb4a), u64_val(0x1e0fb44f50586e11)},
+    {u64_val(0x3c8bd850c5ee3c3b), u64_val(0x180c903f7379f1a7)},
+    {u64_val(0xca0979da37f1c9c9), u64_val(0x133d4032c2c7f485)},
+    {u64_val(0xa9a8c2f6bfe942db), u64_val(0x1ec866b79e0cba6f)},
+    {u64_val(0x2153cf2bccba9be3), u64_val(0x18a0522c7e709526)},
+    {u64_val(0x1aa9728970954982), u64_val(0x13b374f06526ddb8)},
+    {u64_val(0xf775840f1a88759d), u64_val(0x1f8587e7083e2f8c)},
+    {u64_val(0x5f9136727ba05e17), u64_val(0x19379fec0698260a)},
+    {u64_val(0x1940f85b9619e4df), u64_val(0x142c7ff0054684d5)},
+    {u64_val(0xe100c6afab47ea4c), u64_val(0x1023998cd1053710)},
+    {u64_val(0xce67a44c453fdd47), u64_val(0x19d28f47b4d524e7)},
+    {u64_val(0xd852e9d69dccb106), u64_val(0x14a8729fc3ddb71f)},
+    {u64_val(0x79dbee454b0a2738), u64_val(0x1086c219697e2c19)},
+    {u64_val(0x295fe3a211a9d859), u64_val(0x1a71368f0f30468f)},
+    {u64_val(0xbab31c81a7bb137a), u64_val(0x15275ed8d8f36ba5)},
+    {u64_val(0x6228e39aec95a92f), u64_val(0x10ec4be0ad8f8951)},
+    {u64_val(0x9d0e38f7e0ef7517), u64_val(0x1b13ac9aaf4c0ee8)},
+    {u64_val(0xb0d82d931a592a79), u64_val(0x15a956e225d67253)},
+    {u64_val(0x8d79be0f4847552e), u64_val(0x11544581b7dec1dc)},
+    {u64_val(0x158f967eda0bbb7c), u64_val(0x1bba08cf8c979c94)},
+    {u64_val(0x77a611ff14d62f97), u64_val(0x162e6d72d6dfb076)},
+    {u64_val(0xf951a7ff43de8c79), u64_val(0x11bebdf578b2f391)},
+    {u64_val(0xc21c3ffed2fdad8e), u64_val(0x1c6463225ab7ec1c)},
+    {u64_val(0x01b0333242648ad8), u64_val(0x16b6b5b5155ff017)},
+    {u64_val(0x0159c28e9b83a246), u64_val(0x122bc490dde659ac)},
+    {u64_val(0xcef604175f3903a3), u64_val(0x1d12d41afca3c2ac)},
+    {u64_val(0x725e69ac4c2d9c83), u64_val(0x17424348ca1c9bbd)},
+    {u64_val(0xf5185489d68ae39c), u64_val(0x129b69070816e2fd)},
+    {u64_val(0xee8d540fbdab05c6), u64_val(0x1dc574d80cf16b2f)},
+    {u64_val(0xbed77672fe226b05), u64_val(0x17d12a4670c1228c)},
+    {u64_val(0xff12c528cb4ebc04), u64_val(0x130dbb6b8d674ed6)},
+    {u64_val(0xcb513b74787df9a0), u64_val(0x1e7c5f127bd87e24)},
+    {u64_val(0x090dc929f9fe614d), u64_val(0x18637f41fcad31b7)},
+    {u64_val(0xa0d7d42194cb810a), u64_val(0x1382cc34ca2427c5)},
+    {u64_val(0x67bfb9cf5478ce77), u64_val(0x1f37ad21436d0c6f)},
+    {u64_val(0x1fcc94a5dd2d71f9), u64_val(0x18f9574dcf8a7059)},
+    {u64_val(0x7fd6dd517dbdf4c7), u64_val(0x13faac3e3fa1f37a)},
+    {u64_val(0xffbe2ee8c92fee0b), u64_val(0x1ff779fd329cb8c3)},
+    {u64_val(0x6631bf20a0f324d6), u64_val(0x1992c7fdc216fa36)},
+    {u64_val(0xb827cc1a1a5c1d78), u64_val(0x14756ccb01abfb5e)},
+    {u64_val(0x935309ae7b7ce460), u64_val(0x105df0a267bcc918)},
+    {u64_val(0x1eeb42b0c594a099), u64_val(0x1a2fe76a3f9474f4)},
+    {u64_val(0xe58902270476e6e1), u64_val(0x14f31f8832dd2a5c)},
+    {u64_val(0xb7a0ce859d2bebe7), u64_val(0x10c27fa028b0eeb0)},
+    {u64_val(0x59014a6f61dfdfd8), u64_val(0x1ad0cc33744e4ab4)},
+    {u64_val(0xe0cdd525e7e64cad), u64_val(0x1573d68f903ea229)},
+    {u64_val(0x4d7177518651d6f1), u64_val(0x11297872d9cbb4ee)},
+    {u64_val(0x7be8bee8d6e957e8), u64_val(0x1b758d848fac54b0)},
+    {u64_val(0xfcba3253df211320), u64_val(0x15f7a46a0c89dd59)},
+    {u64_val(0x63c8284318e74280), u64_val(0x1192e9ee706e4aae)},
+    {u64_val(0x060d0d3827d86a66), u64_val(0x1c1e43171a4a1117)},
+    {u64_val(0x6b3da42cecad21eb), u64_val(0x167e9c127b6e7412)},
+    {u64_val(0x88fe1cf0bd574e56), u64_val(0x11fee341fc585cdb)},
+    {u64_val(0x419694b462254a23), u64_val(0x1ccb0536608d615f)},
+    {u64_val(0x67abaa29e81dd4e9), u64_val(0x1708d0f84d3de77f)},
+    {u64_val(0xb95621bb2017dd87), u64_val(0x126d73f9d764b932)},
+    {u64_val(0xc223692b668c95a5), u64_val(0x1d7becc2f23ac1ea)},
+    {u64_val(0xce82ba891ed6de1d), u64_val(0x179657025b6234bb)},
+    {u64_val(0xa53562074bdf1818), u64_val(0x12deac01e2b4f6fc)},
+    {u64_val(0x3b889cd87964f359), u64_val(0x1e3113363787f194)},
+    {u64_val(0xfc6d4a46c783f5e1), u64_val(0x18274291c6065adc)},
+    {u64_val(0x30576e9f06032b1a), u64_val(0x13529ba7d19eaf17)},
+    {u64_val(0x1a257dcb3cd1de90), u64_val(0x1eea92a61c311825)},
+    {u64_val(0x481dfe3c30a7e540), u64_val(0x18bba884e35a79b7)},
+    {u64_val(0xd34b31c9c0865100), u64_val(0x13c9539d82aec7c5)},
+    {u64_val(0x5211e942cda3b4cd), u64_val(0x1fa885c8d117a609)},
+    {u64_val(0x74db21023e1c90a4), u64_val(0x19539e3a40dfb807)},
+    {u64_val(0xf715b401cb4a0d50), u64_val(0x1442e4fb67196005)},
+    {u64_val(0xf8de299b09080aa7), u64_val(0x103583fc527ab337)},
+    {u64_val(0x8e304291a80cddd7), u64_val(0x19ef3993b72ab859)},
+    {u64_val(0x3e8d020e200a4b13), u64_val(0x14bf6142f8eef9e1)},
+    {u64_val(0x653d9b3e80083c0f), u64_val(0x10991a9bfa58c7e7)},
+    {u64_val(0x6ec8f864000d2ce4), u64_val(0x1a8e90f9908e0ca5)},
+    {u64_val(0x8bd3f9e999a423ea), u64_val(0x153eda614071a3b7)},
+    {u64_val(0x3ca994bae1501cbb), u64_val(0x10ff151a99f482f9)},
+    {u64_val(0xc775bac49bb3612b), u64_val(0x1b31bb5dc320d18e)},
+    {u64_val(0xd2c4956a16291a89), u64_val(0x15c162b168e70e0b)},
+    {u64_val(0xdbd0778811ba7ba1), u64_val(0x11678227871f3e6f)},
+    {u64_val(0x2c80bf401c5d929b), u64_val(0x1bd8d03f3e9863e6)},
+    {u64_val(0xbd33cc3349e47549), u64_val(0x16470cff6546b651)},
+    {u64_val(0xca8fd68f6e505dd4), u64_val(0x11d270cc51055ea7)},
+    {u64_val(0x4419574be3b3c953), u64_val(0x1c83e7ad4e6efdd9)},
+    {u64_val(0x0347790982f63aa9), u64_val(0x16cfec8aa52597e1)},
+    {u64_val(0xcf6c60d468c4fbba), u64_val(0x123ff06eea847980)},
+    {u64_val(0xe57a34870e07f92a), u64_val(0x1d331a4b10d3f59a)},
+    {u64_val(0x512e906c0b399422), u64_val(0x175c1508da432ae2)},
+    {u64_val(0xda8ba6bcd5c7a9b5), u64_val(0x12b010d3e1cf5581)},
+    {u64_val(0x90df712e22d90f87), u64_val(0x1de6815302e5559c)},
+    {u64_val(0xda4c5a8b4f140c6c), u64_val(0x17eb9aa8cf1dde16)},
+    {u64_val(0xaea37ba2a5a9a38a), u64_val(0x1322e220a5b17e78)},
+    {u64_val(0x7dd25f6aa2a905a9), u64_val(0x1e9e369aa2b59727)},
+    {u64_val(0x97db7f888220d154), u64_val(0x187e92154ef7ac1f)},
+    {u64_val(0x797c6606ce80a777), u64_val(0x139874ddd8c6234c)},
+    {u64_val(0x8f2d700ae4010bf1), u64_val(0x1f5a549627a36bad)},
+    {u64_val(0x0c2459a25000d65a), u64_val(0x191510781fb5efbe)},
+    {u64_val(0x701d1481d99a4515), u64_val(0x1410d9f9b2f7f2fe)},
+    {u64_val(0xc017439b147b6a77), u64_val(0x100d7b2e28c65bfe)},
+    {u64_val(0xccf205c4ed9243f2), u64_val(0x19af2b7d0e0a2cca)},
+    {u64_val(0x0a5b37d0be0e9cc2), u64_val(0x148c22ca71a1bd6f)},
+    {u64_val(0x0848f973cb3ee3ce), u64_val(0x10701bd527b4978c)},
+    {u64_val(0xda0e5bec78649fb0), u64_val(0x1a4cf9550c5425ac)},
+    {u64_val(0x7b3eaff060507fc0), u64_val(0x150a6110d6a9b7bd)},
+    {u64_val(0x95cbbff380406633), u64_val(0x10d51a73deee2c97)},
+    {u64_val(0xefac665266cd7052), u64_val(0x1aee90b964b04758)},
+    {u64_val(0x2623850eb8a459db), u64_val(0x158ba6fab6f36c47)},
+    {u64_val(0x1e82d0d893b6ae49), u64_val(0x113c85955f29236c)},
+    {u64_val(0xfd9e1af41f8ab075), u64_val(0x1b9408eefea838ac)},
+    {u64_val(0x97b1af29b2d559f7), u64_val(0x16100725988693bd)},
+    {u64_val(0xac8e25baf5777b2c), u64_val(0x11a66c1e139edc97)},
+    {u64_val(0x7a7d092b2258c513), u64_val(0x1c3d79c9b8fe2dbf)},
+    {u64_val(0x61fda0ef4ead6a76), u64_val(0x169794a160cb57cc)},
+    {u64_val(0xe7fe1a590bbdeec5), u64_val(0x1212dd4de7091309)},
+    {u64_val(0xa6635d5b45fcb13a), u64_val(0x1ceafbafd80e84dc)},
+    {u64_val(0x851c4aaf6b308dc8), u64_val(0x172262f3133ed0b0)},
+    {u64_val(0xd0e36ef2bc26d7d4), u64_val(0x1281e8c275cbda26)},
+    {u64_val(0xb49f17eac6a48c86), u64_val(0x1d9ca79d894629d7)},
+    {u64_val(0x2a18dfef0550706b), u64_val(0x17b08617a104ee46)},
+    {u64_val(0x54e0b3259dd9f389), u64_val(0x12f39e794d9d8b6b)},
+    {u64_val(0x87cdeb6f62f65274), u64_val(0x1e5297287c2f4578)},
+    {u64_val(0xd30b22bf825ea85d), u64_val(0x18421286c9bf6ac6)},
+    {u64_val(0x0f3c1bcc684bb9e4), u64_val(0x13680ed23aff889f)},
+    {u64_val(0x18602c7a4079296d), u64_val(0x1f0ce4839198da98)},
+    {u64_val(0x46b356c833942124), u64_val(0x18d71d360e13e213)},
+    {u64_val(0x388f78a029434db6), u64_val(0x13df4a91a4dcb4dc)},
+    {u64_val(0x5a7f2766a86baf8a), u64_val(0x1fcbaa82a1612160)},
+    {u64_val(0x153285ebb9efbfa2), u64_val(0x196fbb9bb44db44d)},
+    {u64_val(0xaa8ed189618c994e), u64_val(0x145962e2f6a4903d)},
+    {u64_val(0xeed8a7a11ad6e10c), u64_val(0x1047824f2bb6d9ca)},
+    {u64_val(0x7e27729b5e249b45), u64_val(0x1a0c03b1df8af611)},
+    {u64_val(0xfe85f549181d4904), u64_val(0x14d6695b193bf80d)},
+    {u64_val(0xcb9e5dd4134aa0d0), u64_val(0x10ab877c142ff9a4)},
+    {u64_val(0xdf63c9535211014d), u64_val(0x1aac0bf9b9e65c3a)},
+    {u64_val(0x191ca10f74da6771), u64_val(0x15566ffafb1eb02f)},
+    {u64_val(0xadb080d92a4852c1), u64_val(0x1111f32f2f4bc025)},
+    {u64_val(0x15e7348eaa0d5134), u64_val(0x1b4feb7eb212cd09)},
+    {u64_val(0xab1f5d3eee710dc4), u64_val(0x15d98932280f0a6d)},
+    {u64_val(0xbc1917658b8da49d), u64_val(0x117ad428200c0857)},
+    {u64_val(0x2cf4f23c127c3a94), u64_val(0x1bf7b9d9cce00d59)},
+    {u64_val(0xf0c3f4fcdb969543), u64_val(0x165fc7e170b33de0)},
+    {u64_val(0x5a365d9716121103), u64_val(0x11e6398126f5cb1a)},
+    {u64_val(0x9056fc24f01ce804), u64_val(0x1ca38f350b22de90)},
+    {u64_val(0xd9df301d8ce3ecd0), u64_val(0x16e93f5da2824ba6)},
+    {u64_val(0xe17f59b13d8323da), u64_val(0x125432b14ecea2eb)},
+    {u64_val(0x68cbc2b52f38395c), u64_val(0x1d53844ee47dd179)},
+    {u64_val(0x53d6355dbf602de3), u64_val(0x177603725064a794)},
+    {u64_val(0xa9782ab165e68b1c), u64_val(0x12c4cf8ea6b6ec76)},
+    {u64_val(0x0f26aab56fd744fa), u64_val(0x1e07b27dd78b13f1)},
+    {u64_val(0x3f52222abfdf6a62), u64_val(0x18062864ac6f4327)},
+    {u64_val(0x65db4e88997f884e), u64_val(0x1338205089f29c1f)},
+    {u64_val(0x6fc54a7428cc0d4a), u64_val(0x1ec033b40fea9365)},
+    {u64_val(0x596aa1f68709a43b), u64_val(0x1899c2f673220f84)},
+    {u64_val(0xadeee7f86c07b696), u64_val(0x13ae3591f5b4d936)},
+    {u64_val(0x497e3ff3e00c5756), u64_val(0x1f7d228322baf524)},
+    {u64_val(0xd464fff64cd6ac45), u64_val(0x1930e868e89590e9)},
+    {u64_val(0x4383fff83d7889d1), u64_val(0x14272053ed4473ee)},
+    {u64_val(0xcf9cccc69793a174), u64_val(0x101f4d0ff1038ff1)},
+    {u64_val(0x7f6147a425b90252), u64_val(0x19cbae7fe805b31c)},
+    {u64_val(0xcc4dd2e9b7c7350f), u64_val(0x14a2f1ffecd15c16)},
+    {u64_val(0x3d0b0f215fd290d9), u64_val(0x10825b3323dab012)},
+    {u64_val(0x61ab4b689950e7c1), u64_val(0x1a6a2b85062ab350)},
+    {u64_val(0x4e22a2ba1440b967), u64_val(0x1521bc6a6b555c40)},
+    {u64_val(0x0b4ee894dd009453), u64_val(0x10e7c9eebc4449cd)},
+    {u64_val(0x1217da87c800ed51), u64_val(0x1b0c764ac6d3a948)},
+    {u64_val(0xdb46486ca000bdda), u64_val(0x15a391d56bdc876c)},
+    {u64_val(0x490506bd4ccd64af), u64_val(0x114fa7ddefe39f8a)},
+    {u64_val(0xa8080ac87ae23ab1), u64_val(0x1bb2a62fe638ff43)},
+    {u64_val(0x5339a239fbe82ef4), u64_val(0x162884f31e93ff69)},
+    {u64_val(0x75c7b4fb2fecf25d), u64_val(0x11ba03f5b20fff87)},
+    {u64_val(0x22d92191e647ea2e), u64_val(0x1c5cd322b67fff3f)},
+    {u64_val(0xb57a8141850654f2), u64_val(0x16b0a8e891ffff65)},
+    {u64_val(0xc4620101373843f5), u64_val(0x1226ed86db3332b7)},
+    {u64_val(0x3a366801f1f39fee), u64_val(0x1d0b15a491eb8459)},
+    {u64_val(0xfb5eb99b27f6198b), u64_val(0x173c115074bc69e0)},
+    {u64_val(0x2f7efae2865e7ad6), u64_val(0x129674405d6387e7)},
+    {u64_val(0xe597f7d0d6fd9156), u64_val(0x1dbd86cd6238d971)},
+    {u64_val(0x8479930d78cadaab), u64_val(0x17cad23de82d7ac1)},
+    {u64_val(0xd06142712d6f1556), u64_val(0x1308a831868ac89a)},
+    {u64_val(0x4d686a4eaf182222), u64_val(0x1e74404f3daada91)},
+    {u64_val(0xa453883ef279b4e8), u64_val(0x185d003f6488aeda)},
+    {u64_val(0xe9dc6cff28615d87), u64_val(0x137d99cc506d58ae)},
+    {u64_val(0xa960ae650d6895a4), u64_val(0x1f2f5c7a1a488de4)},
+    {u64_val(0xbab3beb73ded4483), u64_val(0x18f2b061aea07183)},
+    {u64_val(0x2ef6322c318a9d36), u64_val(0x13f559e7bee6c136)},
+    {u64_val(0xe4bd1d13827761f0), u64_val(0x1feef63f97d79b89)},
+    {u64_val(0x83ca7da9352c4e5a), u64_val(0x198bf832dfdfafa1)},
+    {u64_val(0x9ca1fe20f756a515), u64_val(0x146ff9c24cb2f2e7)},
+    {u64_val(0x4a1b31b3f9121daa), u64_val(0x1059949b708f28b9)},
+    {u64_val(0x435eb5ecc1b695dd), u64_val(0x1a28edc580e50df5)},
+    {u64_val(0x35e55e57015ede4a), u64_val(0x14ed8b04671da4c4)},
+    {u64_val(0xc4b77eac0118b1d5), u64_val(0x10be08d0527e1d69)},
+    {u64_val(0xa12597799b5ab622), u64_val(0x1ac9a7b3b7302f0f)},
+    {u64_val(0x4db7ac6149155e81), u64_val(0x156e1fc2f8f358d9)},
+    {u64_val(0xd7c6238107444b9b), u64_val(0x1124e63593f5e0ad)},
+    {u64_val(0x593d059b3ed3ac2b), u64_val(0x1b6e3d2286563449)},
+    {u64_val(0xe0fd9e15cbdc89bc), u64_val(0x15f1ca820511c36d)},
+    {u64_val(0xb3fe18116fe3a163), u64_val(0x118e3b9b37416924)},
+    {u64_val(0x866359b57fd29bd1), u64_val(0x1c16c5c525357507)},
+    {u64_val(0xd1e91491330ee30e), u64_val(0x16789e3750f790d2)},
+    {u64_val(0x74ba76da8f3f1c0b), u64_val(0x11fa182c40c60d75)},
+    {u64_val(0xedf72490e531c678), u64_val(0x1cc359e067a348bb)},
+    {u64_val(0x8b2c1d40b75b052d), u64_val(0x1702ae4d1fb5d3c9)},
+    {u64_val(0x6f567dcd5f7c0424), u64_val(0x12688b70e62b0fd4)},
+    {u64_val(0x7ef0c94898c66d06), u64_val(0x1d74124e3d11b2ed)},
+    {u64_val(0x98c0a106e09ebd9f), u64_val(0x17900ea4fda7c257)},
+    {u64_val(0x470080d24d4bcae6), u64_val(0x12d9a550caec9b79)},
+    {u64_val(0xd800ce1d487944a2), u64_val(0x1e29088144adc58e)},
+    {u64_val(0x1333d8176d2dd082), u64_val(0x1820d39a9d57d13f)},
+    {u64_val(0xa8f646792424a6ce), u64_val(0x134d76154aaca765)},
+    {u64_val(0x74bd3d8ea03aa47d), u64_val(0x1ee25688777aa56f)},
+    {u64_val(0x5d64313ee6955064), u64_val(0x18b51206c5fbb78c)},
+    {u64_val(0x4ab68dcbebaaa6b7), u64_val(0x13c40e6bd1962c70)},
+    {u64_val(0x1124161312aaa457), u64_val(0x1fa01712e8f0471a)},
+    {u64_val(0xda8344dc0eeee9df), u64_val(0x194cdf4253f36c14)},
+    {u64_val(0xe2029d7cd8bf2180), u64_val(0x143d7f6843292343)},
+    {u64_val(0x4e687dfd7a328133), u64_val(0x103132b9cf541c36)},
+    {u64_val(0x4a40c9959050ceb8), u64_val(0x19e851294bb9c6bd)},
+    {u64_val(0x0833d477a6a70bc6), u64_val(0x14b9da876fc7d231)},
+    {u64_val(0xa02976c61eec096b), u64_val(0x1094aed2bfd30e8d)},
+    {u64_val(0x004257a364acdbdf), u64_val(0x1a877e1dffb81749)},
+    {u64_val(0xcd01dfb5ea23e319), u64_val(0x153931b1996012a0)},
+    {u64_val(0x70ce4c91881cb5ae), u64_val(0x10fa8e27ade6754d)},
+    {u64_val(0x1ae3adb5a69455e2), u64_val(0x1b2a7d0c4970bbaf)},
+    {u64_val(0x7be957c4854377e8), u64_val(0x15bb973d078d62f2)},
+    {u64_val(0xc987796a0435f987), u64_val(0x1162df64060ab58e)},
+    {u64_val(0x75a58f1006bcc271), u64_val(0x1bd1656cd67788e4)},
+    {u64_val(0xf7b7a5a66bca3527), u64_val(0x16411df0ab92d3e9)},
+    {u64_val(0x5fc61e1ebca1c41f), u64_val(0x11cdb18d560f0fee)},
+    {u64_val(0xffa363646102d365), u64_val(0x1c7c4f4889b1b316)},
+    {u64_val(0x32e91c504d9bdc51), u64_val(0x16c9d906d48e28df)},
+    {u64_val(0x8f20e37371497d0e), u64_val(0x123b140576d820b2)},
+    {u64_val(0x7e9b0585820f2e7c), u64_val(0x1d2b533bf159cdea)},
+    {u64_val(0xcbaf379e01a5beca), u64_val(0x1755dc2ff447d7ee)},
+    {u64_val(0x0958f94b348498a1), u64_val(0x12ab168cc36cacbf)},
+};
 
-   for (; ptr < opl;) {
-      str_StringDecode decode = str_decodeUtf8(ptr, (u64)(opl - ptr));
-      ptr  = ptr + decode.size;
-      *dptr = decode.codepoint;
-      dptr = dptr + 1;
-   }
+static const u64 str__ryuPow5Split[326][2] = {
+    {u64_val(0x0000000000000000), u64_val(0x1000000000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x1400000000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x1900000000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x1f40000000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x1388000000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x186a000000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x1e84800000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x1312d00000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x17d7840000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x1dcd650000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x12a05f2000000000)},
+    {u64_val(0x0000000000000000), u64_val(0x174876e800000000)},
+    {u64_val(0x0000000000000000), u64_val(0x1d1a94a200000000)},
+    {u64_val(0x0000000000000000), u64_val(0x12309ce540000000)},
+    {u64_val(0x0000000000000000), u64_val(0x16bcc41e90000000)},
+    {u64_val(0x0000000000000000), u64_val(0x1c6bf52634000000)},
+    {u64_val(0x0000000000000000), u64_val(0x11c37937e0800000)},
+    {u64_val(0x0000000000000000), u64_val(0x16345785d8a00000)},
+    {u64_val(0x0000000000000000), u64_val(0x1bc16d674ec80000)},
+    {u64_val(0x0000000000000000), u64_val(0x1158e460913d0000)},
+    {u64_val(0x0000000000000000), u64_val(0x15af1d78b58c4000)},
+    {u64_val(0x0000000000000000), u64_val(0x1b1ae4d6e2ef5000)},
+    {u64_val(0x0000000000000000), u64_val(0x10f0cf064dd59200)},
+    {u64_val(0x0000000000000000), u64_val(0x152d02c7e14af680)},
+    {u64_val(0x0000000000000000), u64_val(0x1a784379d99db420)},
+    {u64_val(0x0000000000000000), u64_val(0x108b2a2c28029094)},
+    {u64_val(0x0000000000000000), u64_val(0x14adf4b7320334b9)},
+    {u64_val(0x4000000000000000), u64_val(0x19d971e4fe8401e7)},
+    {u64_val(0x8800000000000000), u64_val(0x1027e72f1f128130)},
+    {u64_val(0xaa00000000000000), u64_val(0x1431e0fae6d7217c)},
+    {u64_val(0xd480000000000000), u64_val(0x193e5939a08ce9db)},
+    {u64_val(0xc9a0000000000000), u64_val(0x1f8def8808b02452)},
+    {u64_val(0xbe04000000000000), u64_val(0x13b8b5b5056e16b3)},
+    {u64_val(0xad85000000000000), u64_val(0x18a6e32246c99c60)},
+    {u64_val(0xd8e6400000000000), u64_val(0x1ed09bead87c0378)},
+    {u64_val(0x878fe80000000000), u64_val(0x13426172c74d822b)},
+    {u64_val(0x6973e20000000000), u64_val(0x1812f9cf7920e2b6)},
+    {u64_val(0x03d0da8000000000), u64_val(0x1e17b84357691b64)},
+    {u64_val(0x8262889000000000), u64_val(0x12ced32a16a1b11e)},
+    {u64_val(0x22fb2ab400000000), u64_val(0x178287f49c4a1d66)},
+    {u64_val(0xabb9f56100000000), u64_val(0x1d6329f1c35ca4bf)},
+    {u64_val(0xcb54395ca0000000), u64_val(0x125dfa371a19e6f7)},
+    {u64_val(0xbe2947b3c8000000), u64_val(0x16f578c4e0a060b5)},
+    {u64_val(0x2db399a0ba000000), u64_val(0x1cb2d6f618c878e3)},
+    {u64_val(0xfc90400474400000), u64_val(0x11efc659cf7d4b8d)},
+    {u64_val(0x7bb4500591500000), u64_val(0x166bb7f0435c9e71)},
+    {u64_val(0xdaa16406f5a40000), u64_val(0x1c06a5ec5433c60d)},
+    {u64_val(0xa8a4de8459868000), u64_val(0x118427b3b4a05bc8)},
+    {u64_val(0xd2ce16256fe82000), u64_val(0x15e531a0a1c872ba)},
+    {u64_val(0x87819baecbe22800), u64_val(0x1b5e7e08ca3a8f69)},
+    {u64_val(0xf4b1014d3f6d5900), u64_val(0x111b0ec57e6499a1)},
+    {u64_val(0x71dd41a08f48af40), u64_val(0x1561d276ddfdc00a)},
+    {u64_val(0x0e549208b31adb10), u64_val(0x1aba4714957d300d)},
+    {u64_val(0x28f4db456ff0c8ea), u64_val(0x10b46c6cdd6e3e08)},
+    {u64_val(0x33321216cbecfb24), u64_val(0x14e1878814c9cd8a)},
+    {u64_val(0xbffe969c7ee839ed), u64_val(0x1a19e96a19fc40ec)},
+    {u64_val(0xf7ff1e21cf512434), u64_val(0x105031e2503da893)},
+    {u64_val(0xf5fee5aa43256d41), u64_val(0x14643e5ae44d12b8)},
+    {u64_val(0x337e9f14d3eec892), u64_val(0x197d4df19d605767)},
+    {u64_val(0x005e46da08ea7ab6), u64_val(0x1fdca16e04b86d41)},
+    {u64_val(0xa03aec4845928cb2), u64_val(0x13e9e4e4c2f34448)},
+    {u64_val(0xc849a75a56f72fde), u64_val(0x18e45e1df3b0155a)},
+    {u64_val(0x7a5c1130ecb4fbd6), u64_val(0x1f1d75a5709c1ab1)},
+    {u64_val(0xec798abe93f11d65), u64_val(0x13726987666190ae)},
+    {u64_val(0xa797ed6e38ed64bf), u64_val(0x184f03e93ff9f4da)},
+    {u64_val(0x517de8c9c728bdef), u64_val(0x1e62c4e38ff87211)},
+    {u64_val(0xd2eeb17e1c7976b5), u64_val(0x12fdbb0e39fb474a)},
+    {u64_val(0x87aa5ddda397d462), u64_val(0x17bd29d1c87a191d)},
+    {u64_val(0xe994f5550c7dc97b), u64_val(0x1dac74463a989f64)},
+    {u64_val(0x11fd195527ce9ded), u64_val(0x128bc8abe49f639f)},
+    {u64_val(0xd67c5faa71c24568), u64_val(0x172ebad6ddc73c86)},
+    {u64_val(0x8c1b77950e32d6c2), u64_val(0x1cfa698c95390ba8)},
+    {u64_val(0x57912abd28dfc639), u64_val(0x121c81f7dd43a749)},
+    {u64_val(0xad75756c7317b7c8), u64_val(0x16a3a275d494911b)},
+    {u64_val(0x98d2d2c78fdda5ba), u64_val(0x1c4c8b1349b9b562)},
+    {u64_val(0x9f83c3bcb9ea8794), u64_val(0x11afd6ec0e14115d)},
+    {u64_val(0x0764b4abe8652979), u64_val(0x161bcca7119915b5)},
+    {u64_val(0x493de1d6e27e73d7), u64_val(0x1ba2bfd0d5ff5b22)},
+    {u64_val(0x6dc6ad264d8f0866), u64_val(0x1145b7e285bf98f5)},
+    {u64_val(0xc938586fe0f2ca80), u64_val(0x159725db272f7f32)},
+    {u64_val(0x7b866e8bd92f7d20), u64_val(0x1afcef51f0fb5eff)},
+    {u64_val(0xad34051767bdae34), u64_val(0x10de1593369d1b5f)},
+    {u64_val(0x9881065d41ad19c1), u64_val(0x15159af804446237)},
+    {u64_val(0x7ea147f492186032), u64_val(0x1a5b01b605557ac5)},
+    {u64_val(0x6f24ccf8db4f3c1f), u64_val(0x1078e111c3556cbb)},
+    {u64_val(0x4aee003712230b27), u64_val(0x14971956342ac7ea)},
+    {u64_val(0xdda98044d6abcdf0), u64_val(0x19bcdfabc13579e4)},
+    {u64_val(0x0a89f02b062b60b6), u64_val(0x10160bcb58c16c2f)},
+    {u64_val(0xcd2c6c35c7b638e4), u64_val(0x141b8ebe2ef1c73a)},
+    {u64_val(0x8077874339a3c71d), u64_val(0x1922726dbaae3909)},
+    {u64_val(0xe0956914080cb8e4), u64_val(0x1f6b0f092959c74b)},
+    {u64_val(0x6c5d61ac8507f38e), u64_val(0x13a2e965b9d81c8f)},
+    {u64_val(0x4774ba17a649f072), u64_val(0x188ba3bf284e23b3)},
+    {u64_val(0x1951e89d8fdc6c8f), u64_val(0x1eae8caef261aca0)},
+    {u64_val(0x0fd3316279e9c3d9), u64_val(0x132d17ed577d0be4)},
+    {u64_val(0x13c7fdbb186434cf), u64_val(0x17f85de8ad5c4edd)},
+    {u64_val(0x58b9fd29de7d4203), u64_val(0x1df67562d8b36294)},
+    {u64_val(0xb7743e3a2b0e4942), u64_val(0x12ba095dc7701d9c)},
+    {u64_val(0xe5514dc8b5d1db92), u64_val(0x17688bb5394c2503)},
+    {u64_val(0xdea5a13ae3465277), u64_val(0x1d42aea2879f2e44)},
+    {u64_val(0x0b2784c4ce0bf38a), u64_val(0x1249ad2594c37ceb)},
+    {u64_val(0xcdf165f6018ef06d), u64_val(0x16dc186ef9f45c25)},
+    {u64_val(0x416dbf7381f2ac88), u64_val(0x1c931e8ab871732f)},
+    {u64_val(0x88e497a83137abd5), u64_val(0x11dbf316b346e7fd)},
+    {u64_val(0xeb1dbd923d8596ca), u64_val(0x1652efdc6018a1fc)},
+    {u64_val(0x25e52cf6cce6fc7d), u64_val(0x1be7abd3781eca7c)},
+    {u64_val(0x97af3c1a40105dce), u64_val(0x1170cb642b133e8d)},
+    {u64_val(0xfd9b0b20d0147542), u64_val(0x15ccfe3d35d80e30)},
+    {u64_val(0x3d01cde904199292), u64_val(0x1b403dcc834e11bd)},
+    {u64_val(0x462120b1a28ffb9b), u64_val(0x1108269fd210cb16)},
+    {u64_val(0xd7a968de0b33fa82), u64_val(0x154a3047c694fddb)},
+    {u64_val(0xcd93c3158e00f923), u64_val(0x1a9cbc59b83a3d52)},
+    {u64_val(0xc07c59ed78c09bb6), u64_val(0x10a1f5b813246653)},
+    {u64_val(0xb09b7068d6f0c2a3), u64_val(0x14ca732617ed7fe8)},
+    {u64_val(0xdcc24c830cacf34c), u64_val(0x19fd0fef9de8dfe2)},
+    {u64_val(0xc9f96fd1e7ec180f), u64_val(0x103e29f5c2b18bed)},
+    {u64_val(0x3c77cbc661e71e13), u64_val(0x144db473335deee9)},
+    {u64_val(0x8b95beb7fa60e598), u64_val(0x1961219000356aa3)},
+    {u64_val(0x6e7b2e65f8f91efe), u64_val(0x1fb969f40042c54c)},
+    {u64_val(0xc50cfcffbb9bb35f), u64_val(0x13d3e2388029bb4f)},
+    {u64_val(0xb6503c3faa82a037), u64_val(0x18c8dac6a0342a23)},
+    {u64_val(0xa3e44b4f95234844), u64_val(0x1efb1178484134ac)},
+    {u64_val(0xe66eaf11bd360d2b), u64_val(0x135ceaeb2d28c0eb)},
+    {u64_val(0xe00a5ad62c839075), u64_val(0x183425a5f872f126)},
+    {u64_val(0x980cf18bb7a47493), u64_val(0x1e412f0f768fad70)},
+    {u64_val(0x5f0816f752c6c8dc), u64_val(0x12e8bd69aa19cc66)},
+    {u64_val(0xf6ca1cb527787b13), u64_val(0x17a2ecc414a03f7f)},
+    {u64_val(0xf47ca3e2715699d7), u64_val(0x1d8ba7f519c84f5f)},
+    {u64_val(0xf8cde66d86d62026), u64_val(0x127748f9301d319b)},
+    {u64_val(0xf7016008e88ba830), u64_val(0x17151b377c247e02)},
+    {u64_val(0xb4c1b80b22ae923c), u64_val(0x1cda62055b2d9d83)},
+    {u64_val(0x50f91306f5ad1b65), u64_val(0x12087d4358fc8272)},
+    {u64_val(0xe53757c8b318623f), u64_val(0x168a9c942f3ba30e)},
+    {u64_val(0x9e852dbadfde7acf), u64_val(0x1c2d43b93b0a8bd2)},
+    {u64_val(0xa3133c94cbeb0cc1), u64_val(0x119c4a53c4e69763)},
+    {u64_val(0x8bd80bb9fee5cff1), u64_val(0x16035ce8b6203d3c)},
+    {u64_val(0xaece0ea87e9f43ee), u64_val(0x1b843422e3a84c8b)},
+    {u64_val(0x4d40c9294f238a75), u64_val(0x1132a095ce492fd7)},
+    {u64_val(0x2090fb73a2ec6d12), u64_val(0x157f48bb41db7bcd)},
+    {u64_val(0x68b53a508ba78856), u64_val(0x1adf1aea12525ac0)},
+    {u64_val(0x417144725748b536), u64_val(0x10cb70d24b7378b8)},
+    {u64_val(0x51cd958eed1ae283), u64_val(0x14fe4d06de5056e6)},
+    {u64_val(0xe640faf2a8619b24), u64_val(0x1a3de04895e46c9f)},
+    {u64_val(0xefe89cd7a93d00f7), u64_val(0x1066ac2d5daec3e3)},
+    {u64_val(0xebe2c40d938c4134), u64_val(0x14805738b51a74dc)},
+    {u64_val(0x26db7510f86f5181), u64_val(0x19a06d06e2611214)},
+    {u64_val(0x9849292a9b4592f1), u64_val(0x100444244d7cab4c)},
+    {u64_val(0xbe5b73754216f7ad), u64_val(0x1405552d60dbd61f)},
+    {u64_val(0xadf25052929cb598), u64_val(0x1906aa78b912cba7)},
+    {u64_val(0x996ee4673743e2ff), u64_val(0x1f485516e7577e91)},
+    {u64_val(0xffe54ec0828a6ddf), u64_val(0x138d352e5096af1a)},
+    {u64_val(0xbfdea270a32d0957), u64_val(0x18708279e4bc5ae1)},
+    {u64_val(0x2fd64b0ccbf84bad), u64_val(0x1e8ca3185deb719a)},
+    {u64_val(0x5de5eee7ff7b2f4c), u64_val(0x1317e5ef3ab32700)},
+    {u64_val(0x755f6aa1ff59fb1f), u64_val(0x17dddf6b095ff0c0)},
+    {u64_val(0x92b7454a7f3079e7), u64_val(0x1dd55745cbb7ecf0)},
+    {u64_val(0x5bb28b4e8f7e4c30), u64_val(0x12a5568b9f52f416)},
+    {u64_val(0xf29f2e22335ddf3c), u64_val(0x174eac2e8727b11b)},
+    {u64_val(0xef46f9aac035570b), u64_val(0x1d22573a28f19d62)},
+    {u64_val(0xd58c5c0ab8215667), u64_val(0x123576845997025d)},
+    {u64_val(0x4aef730d6629ac01), u64_val(0x16c2d4256ffcc2f5)},
+    {u64_val(0x9dab4fd0bfb41701), u64_val(0x1c73892ecbfbf3b2)},
+    {u64_val(0xa28b11e277d08e60), u64_val(0x11c835bd3f7d784f)},
+    {u64_val(0x8b2dd65b15c4b1f9), u64_val(0x163a432c8f5cd663)},
+    {u64_val(0x6df94bf1db35de77), u64_val(0x1bc8d3f7b3340bfc)},
+    {u64_val(0xc4bbcf772901ab0a), u64_val(0x115d847ad000877d)},
+    {u64_val(0x35eac354f34215cd), u64_val(0x15b4e5998400a95d)},
+    {u64_val(0x8365742a30129b40), u64_val(0x1b221effe500d3b4)},
+    {u64_val(0xd21f689a5e0ba108), u64_val(0x10f5535fef208450)},
+    {u64_val(0x06a742c0f58e894a), u64_val(0x1532a837eae8a565)},
+    {u64_val(0x4851137132f22b9d), u64_val(0x1a7f5245e5a2cebe)},
+    {u64_val(0xed32ac26bfd75b42), u64_val(0x108f936baf85c136)},
+    {u64_val(0xa87f57306fcd3212), u64_val(0x14b378469b673184)},
+    {u64_val(0xd29f2cfc8bc07e97), u64_val(0x19e056584240fde5)},
+    {u64_val(0xa3a37c1dd7584f1e), u64_val(0x102c35f729689eaf)},
+    {u64_val(0x8c8c5b254d2e62e6), u64_val(0x14374374f3c2c65b)},
+    {u64_val(0x6faf71eea079fb9f), u64_val(0x1945145230b377f2)},
+    {u64_val(0x0b9b4e6a48987a87), u64_val(0x1f965966bce055ef)},
+    {u64_val(0x674111026d5f4c94), u64_val(0x13bdf7e0360c35b5)},
+    {u64_val(0xc111554308b71fba), u64_val(0x18ad75d8438f4322)},
+    {u64_val(0x7155aa93cae4e7a8), u64_val(0x1ed8d34e547313eb)},
+    {u64_val(0x26d58a9c5ecf10c9), u64_val(0x13478410f4c7ec73)},
+    {u64_val(0xf08aed437682d4fb), u64_val(0x1819651531f9e78f)},
+    {u64_val(0xecada89454238a3a), u64_val(0x1e1fbe5a7e786173)},
+    {u64_val(0x73ec895cb4963664), u64_val(0x12d3d6f88f0b3ce8)},
+    {u64_val(0x90e7abb3e1bbc3fd), u64_val(0x1788ccb6b2ce0c22)},
+    {u64_val(0x352196a0da2ab4fd), u64_val(0x1d6affe45f818f2b)},
+    {u64_val(0x0134fe24885ab11e), u64_val(0x1262dfeebbb0f97b)},
+    {u64_val(0xc1823dadaa715d65), u64_val(0x16fb97ea6a9d37d9)},
+    {u64_val(0x31e2cd19150db4bf), u64_val(0x1cba7de5054485d0)},
+    {u64_val(0x1f2dc02fad2890f7), u64_val(0x11f48eaf234ad3a2)},
+    {u64_val(0xa6f9303b9872b535), u64_val(0x1671b25aec1d888a)},
+    {u64_val(0x50b77c4a7e8f6282), u64_val(0x1c0e1ef1a724eaad)},
+    {u64_val(0x5272adae8f199d91), u64_val(0x1188d357087712ac)},
+    {u64_val(0x670f591a32e004f6), u64_val(0x15eb082cca94d757)},
+    {u64_val(0x40d32f60bf980633), u64_val(0x1b65ca37fd3a0d2d)},
+    {u64_val(0x4883fd9c77bf03e0), u64_val(0x111f9e62fe44483c)},
+    {u64_val(0x5aa4fd0395aec4d8), u64_val(0x156785fbbdd55a4b)},
+    {u64_val(0x314e3c447b1a760e), u64_val(0x1ac1677aad4ab0de)},
+    {u64_val(0xded0e5aaccf089c9), u64_val(0x10b8e0acac4eae8a)},
+    {u64_val(0x96851f15802cac3b), u64_val(0x14e718d7d7625a2d)},
+    {u64_val(0xfc2666dae037d74a), u64_val(0x1a20df0dcd3af0b8)},
+    {u64_val(0x9d980048cc22e68e), u64_val(0x10548b68a044d673)},
+    {u64_val(0x84fe005aff2ba032), u64_val(0x1469ae42c8560c10)},
+    {u64_val(0xa63d8071bef6883e), u64_val(0x198419d37a6b8f14)},
+    {u64_val(0xcfcce08e2eb42a4e), u64_val(0x1fe52048590672d9)},
+    {u64_val(0x21e00c58dd309a70), u64_val(0x13ef342d37a407c8)},
+    {u64_val(0x2a580f6f147cc10d), u64_val(0x18eb0138858d09ba)},
+    {u64_val(0xb4ee134ad99bf150), u64_val(0x1f25c186a6f04c28)},
+    {u64_val(0x7114cc0ec80176d2), u64_val(0x137798f428562f99)},
+    {u64_val(0xcd59ff127a01d486), u64_val(0x18557f31326bbb7f)},
+    {u64_val(0xc0b07ed7188249a8), u64_val(0x1e6adefd7f06aa5f)},
+    {u64_val(0xd86e4f466f516e09), u64_val(0x1302cb5e6f642a7b)},
+    {u64_val(0xce89e3180b25c98b), u64_val(0x17c37e360b3d351a)},
+    {u64_val(0x822c5bde0def3bee), u64_val(0x1db45dc38e0c8261)},
+    {u64_val(0xf15bb96ac8b58575), u64_val(0x1290ba9a38c7d17c)},
+    {u64_val(0x2db2a7c57ae2e6d2), u64_val(0x1734e940c6f9c5dc)},
+    {u64_val(0x391f51b6d99ba086), u64_val(0x1d022390f8b83753)},
+    {u64_val(0x03b3931248014454), u64_val(0x1221563a9b732294)},
+    {u64_val(0x04a077d6da019569), u64_val(0x16a9abc9424feb39)},
+    {u64_val(0x45c895cc9081fac3), u64_val(0x1c5416bb92e3e607)},
+    {u64_val(0x8b9d5d9fda513cba), u64_val(0x11b48e353bce6fc4)},
+    {u64_val(0xae84b507d0e58be8), u64_val(0x1621b1c28ac20bb5)},
+    {u64_val(0x1a25e249c51eeee3), u64_val(0x1baa1e332d728ea3)},
+    {u64_val(0xf057ad6e1b33554d), u64_val(0x114a52dffc679925)},
+    {u64_val(0x6c6d98c9a2002aa1), u64_val(0x159ce797fb817f6f)},
+    {u64_val(0x4788fefc0a803549), u64_val(0x1b04217dfa61df4b)},
+    {u64_val(0x0cb59f5d8690214e), u64_val(0x10e294eebc7d2b8f)},
+    {u64_val(0xcfe30734e83429a1), u64_val(0x151b3a2a6b9c7672)},
+    {u64_val(0x83dbc9022241340a), u64_val(0x1a6208b50683940f)},
+    {u64_val(0xb2695da15568c086), u64_val(0x107d457124123c89)},
+    {u64_val(0x1f03b509aac2f0a7), u64_val(0x149c96cd6d16cbac)},
+    {u64_val(0x26c4a24c1573acd1), u64_val(0x19c3bc80c85c7e97)},
+    {u64_val(0x783ae56f8d684c03), u64_val(0x101a55d07d39cf1e)},
+    {u64_val(0x16499ecb70c25f03), u64_val(0x1420eb449c8842e6)},
+    {u64_val(0x9bdc067e4cf2f6c4), u64_val(0x19292615c3aa539f)},
+    {u64_val(0x82d3081de02fb476), u64_val(0x1f736f9b3494e887)},
+    {u64_val(0xb1c3e512ac1dd0c9), u64_val(0x13a825c100dd1154)},
+    {u64_val(0xde34de57572544fc), u64_val(0x18922f31411455a9)},
+    {u64_val(0x55c215ed2cee963b), u64_val(0x1eb6bafd91596b14)},
+    {u64_val(0xb5994db43c151de5), u64_val(0x133234de7ad7e2ec)},
+    {u64_val(0xe2ffa1214b1a655e), u64_val(0x17fec216198ddba7)},
+    {u64_val(0xdbbf89699de0feb6), u64_val(0x1dfe729b9ff15291)},
+    {u64_val(0x2957b5e202ac9f31), u64_val(0x12bf07a143f6d39b)},
+    {u64_val(0xf3ada35a8357c6fe), u64_val(0x176ec98994f48881)},
+    {u64_val(0x70990c31242db8bd), u64_val(0x1d4a7bebfa31aaa2)},
+    {u64_val(0x865fa79eb69c9376), u64_val(0x124e8d737c5f0aa5)},
+    {u64_val(0xe7f791866443b854), u64_val(0x16e230d05b76cd4e)},
+    {u64_val(0xa1f575e7fd54a669), u64_val(0x1c9abd04725480a2)},
+    {u64_val(0xa53969b0fe54e801), u64_val(0x11e0b622c774d065)},
+    {u64_val(0x0e87c41d3dea2202), u64_val(0x1658e3ab7952047f)},
+    {u64_val(0xd229b5248d64aa82), u64_val(0x1bef1c9657a6859e)},
+    {u64_val(0x435a1136d85eea91), u64_val(0x117571ddf6c81383)},
+    {u64_val(0x143095848e76a536), u64_val(0x15d2ce55747a1864)},
+    {u64_val(0x193cbae5b2144e83), u64_val(0x1b4781ead1989e7d)},
+    {u64_val(0x2fc5f4cf8f4cb112), u64_val(0x110cb132c2ff630e)},
+    {u64_val(0xbbb77203731fdd56), u64_val(0x154fdd7f73bf3bd1)},
+    {u64_val(0x2aa54e844fe7d4ac), u64_val(0x1aa3d4df50af0ac6)},
+    {u64_val(0xdaa75112b1f0e4eb), u64_val(0x10a6650b926d66bb)},
+    {u64_val(0xd15125575e6d1e26), u64_val(0x14cffe4e7708c06a)},
+    {u64_val(0x85a56ead360865b0), u64_val(0x1a03fde214caf085)},
+    {u64_val(0x7387652c41c53f8e), u64_val(0x10427ead4cfed653)},
+    {u64_val(0x50693e7752368f71), u64_val(0x14531e58a03e8be8)},
+    {u64_val(0x64838e1526c4334e), u64_val(0x1967e5eec84e2ee2)},
+    {u64_val(0xfda4719a70754022), u64_val(0x1fc1df6a7a61ba9a)},
+    {u64_val(0xde86c70086494815), u64_val(0x13d92ba28c7d14a0)},
+    {u64_val(0x162878c0a7db9a1a), u64_val(0x18cf768b2f9c59c9)},
+    {u64_val(0x5bb296f0d1d280a1), u64_val(0x1f03542dfb83703b)},
+    {u64_val(0x194f9e5683239064), u64_val(0x1362149cbd322625)},
+    {u64_val(0x5fa385ec23ec747e), u64_val(0x183a99c3ec7eafae)},
+    {u64_val(0xf78c67672ce7919d), u64_val(0x1e494034e79e5b99)},
+    {u64_val(0x3ab7c0a07c10bb02), u64_val(0x12edc82110c2f940)},
+    {u64_val(0x4965b0c89b14e9c3), u64_val(0x17a93a2954f3b790)},
+    {u64_val(0x5bbf1cfac1da2433), u64_val(0x1d9388b3aa30a574)},
+    {u64_val(0xb957721cb92856a0), u64_val(0x127c35704a5e6768)},
+    {u64_val(0xe7ad4ea3e7726c48), u64_val(0x171b42cc5cf60142)},
+    {u64_val(0xa198a24ce14f075a), u64_val(0x1ce2137f74338193)},
+    {u64_val(0x44ff65700cd16498), u64_val(0x120d4c2fa8a030fc)},
+    {u64_val(0x563f3ecc1005bdbe), u64_val(0x16909f3b92c83d3b)},
+    {u64_val(0x2bcf0e7f14072d2e), u64_val(0x1c34c70a777a4c8a)},
+    {u64_val(0x5b61690f6c847c3d), u64_val(0x11a0fc668aac6fd6)},
+    {u64_val(0xf239c35347a59b4c), u64_val(0x16093b802d578bcb)},
+    {u64_val(0xeec83428198f021f), u64_val(0x1b8b8a6038ad6ebe)},
+    {u64_val(0x553d20990ff96153), u64_val(0x1137367c236c6537)},
+    {u64_val(0x2a8c68bf53f7b9a8), u64_val(0x1585041b2c477e85)},
+    {u64_val(0x752f82ef28f5a812), u64_val(0x1ae64521f7595e26)},
+    {u64_val(0x093db1d57999890b), u64_val(0x10cfeb353a97dad8)},
+    {u64_val(0x0b8d1e4ad7ffeb4e), u64_val(0x1503e602893dd18e)},
+    {u64_val(0x8e7065dd8dffe622), u64_val(0x1a44df832b8d45f1)},
+    {u64_val(0xf9063faa78bfefd5), u64_val(0x106b0bb1fb384bb6)},
+    {u64_val(0xb747cf9516efebca), u64_val(0x1485ce9e7a065ea4)},
+    {u64_val(0xe519c37a5cabe6bd), u64_val(0x19a742461887f64d)},
+    {u64_val(0xaf301a2c79eb7036), u64_val(0x1008896bcf54f9f0)},
+    {u64_val(0xdafc20b798664c43), u64_val(0x140aabc6c32a386c)},
+    {u64_val(0x11bb28e57e7fdf54), u64_val(0x190d56b873f4c688)},
+    {u64_val(0x1629f31ede1fd72a), u64_val(0x1f50ac6690f1f82a)},
+    {u64_val(0x4dda37f34ad3e67a), u64_val(0x13926bc01a973b1a)},
+    {u64_val(0xe150c5f01d88e019), u64_val(0x187706b0213d09e0)},
+    {u64_val(0x19a4f76c24eb181f), u64_val(0x1e94c85c298c4c59)},
+    {u64_val(0xb0071aa39712ef13), u64_val(0x131cfd3999f7afb7)},
+    {u64_val(0x9c08e14c7cd7aad8), u64_val(0x17e43c8800759ba5)},
+    {u64_val(0x030b199f9c0d958e), u64_val(0x1ddd4baa0093028f)},
+    {u64_val(0x61e6f003c1887d79), u64_val(0x12aa4f4a405be199)},
+    {u64_val(0xba60ac04b1ea9cd7), u64_val(0x1754e31cd072d9ff)},
+    {u64_val(0xa8f8d705de65440d), u64_val(0x1d2a1be4048f907f)},
+    {u64_val(0xc99b8663aaff4a88), u64_val(0x123a516e82d9ba4f)},
+    {u64_val(0xbc0267fc95bf1d2a), u64_val(0x16c8e5ca239028e3)},
+    {u64_val(0xab0301fbbb2ee474), u64_val(0x1c7b1f3cac74331c)},
+    {u64_val(0xeae1e13d54fd4ec9), u64_val(0x11ccf385ebc89ff1)},
+    {u64_val(0x659a598caa3ca27b), u64_val(0x1640306766bac7ee)},
+    {u64_val(0xff00efefd4cbcb1a), u64_val(0x1bd03c81406979e9)},
+    {u64_val(0x3f6095f5e4ff5ef0), u64_val(0x116225d0c841ec32)},
+    {u64_val(0xcf38bb735e3f36ac), u64_val(0x15baaf44fa52673e)},
+    {u64_val(0x8306ea5035cf0457), u64_val(0x1b295b1638e7010e)},
+    {u64_val(0x11e4527221a162b6), u64_val(0x10f9d8ede39060a9)},
+    {u64_val(0x565d670eaa09bb64), u64_val(0x15384f295c7478d3)},
+    {u64_val(0x2bf4c0d2548c2a3d), u64_val(0x1a8662f3b3919708)},
+    {u64_val(0x1b78f88374d79a66), u64_val(0x1093fdd8503afe65)},
+    {u64_val(0x625736a4520d8100), u64_val(0x14b8fd4e6449bdfe)},
+    {u64_val(0xfaed044d6690e140), u64_val(0x19e73ca1fd5c2d7d)},
+    {u64_val(0xbcd422b0601a8cc8), u64_val(0x103085e53e599c6e)},
+    {u64_val(0x6c092b5c78212ffa), u64_val(0x143ca75e8df0038a)},
+    {u64_val(0x070b763396297bf8), u64_val(0x194bd136316c046d)},
+    {u64_val(0x48ce53c07bb3daf6), u64_val(0x1f9ec583bdc70588)},
+    {u64_val(0x2d80f4584d5068da), u64_val(0x13c33b72569c6375)},
+    {u64_val(0x78e1316e60a48310), u64_val(0x18b40a4eec437c52)},
+};
 
-   *dptr = 0;
-   dptr += 1;
-   *dptr = 0;
+INLINE i32 str__ryuPow5Bits(i32 e) {
+    return i32_cast(((u32_cast(e) * 1217359) >> 19) + 1);
+}
 
-   u64 stringCount = (u64)(dptr - memory);
-   u64 unusedCount = allocSize - stringCount - 1;
-   //mem_arenaPopAmount(arena, unusedCount);
+INLINE u32 str__ryuLog10Pow2(i32 e) {
+    return (u32_cast(e) * 78913) >> 18;
+}
 
-   S32 result = {memory, stringCount};
-   return result;
+INLINE u32 str__ryuLog10Pow5(i32 e) {
+    return (u32_cast(e) * 732923) >> 20;
+}
+
+INLINE u32 str__ryuPow5Factor(u64 value) {
+    u32 count = 0;
+    while (value % 5 == 0) {
+        value /= 5;
+        count++;
+    }
+    return count;
+}
+
+INLINE bx str__ryuMultipleOfPow5(u64 value, u32 p) {
+    return str__ryuPow5Factor(value) >= p;
+}
+
+INLINE bx str__ryuMultipleOfPow2(u64 value, u32 p) {
+    return (value & ((u64_val(1) << p) - 1)) == 0;
+}
+
+INLINE u64 str__ryuMulShift64(u64 m, const u64* mul, i32 j) {
+    u64 high1;
+    u64 low1 = str__mul128(m, mul[1], &high1);
+    u64 high0;
+    str__mul128(m, mul[0], &high0);
+    u64 sum = high0 + low1;
+    if (sum < high0) {
+        high1++;
+    }
+    u32 dist = u32_cast(j - 64);
+    return (high1 << (64 - dist)) | (sum >> dist);
+}
+
+INLINE u32 str__ryuMulShift32(u32 m, u64 factor, i32 shift) {
+    u64 bits0 = u64_cast(m) * u32_cast(factor);
+    u64 bits1 = u64_cast(m) * u32_cast(factor >> 32);
+    u64 sum = (bits0 >> 32) + bits1;
+    return u32_cast(sum >> (shift - 32));
+}
+
+typedef struct str__FloatDecimal {
+    u64 mantissa;
+    i32 exponent;
+} str__FloatDecimal;
+
+LOCAL str__FloatDecimal str__ryuF64(u64 ieeeMantissa, u32 ieeeExponent) {
+    i32 e2;
+    u64 m2;
+    if (ieeeExponent == 0) {
+        e2 = 1 - 1023 - 52 - 2;
+        m2 = ieeeMantissa;
+    } else {
+        e2 = i32_cast(ieeeExponent) - 1023 - 52 - 2;
+        m2 = (u64_val(1) << 52) | ieeeMantissa;
+    }
+    bx acceptBounds = (m2 & 1) == 0;
+
+    // interval of valid representations [mm, mp] around mv, scaled by 4
+    u64 mv = 4 * m2;
+    u32 mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+
+    u64 vr, vp, vm;
+    i32 e10;
+    bx vmIsTrailingZeros = false;
+    bx vrIsTrailingZeros = false;
+    if (e2 >= 0) {
+        u32 q = str__ryuLog10Pow2(e2) - (e2 > 3);
+        e10 = i32_cast(q);
+        i32 k = STR__RYU_POW5_INV_BITCOUNT + str__ryuPow5Bits(i32_cast(q)) - 1;
+        i32 i = -e2 + i32_cast(q) + k;
+        vr = str__ryuMulShift64(4 * m2, str__ryuPow5InvSplit[q], i);
+        vp = str__ryuMulShift64(4 * m2 + 2, str__ryuPow5InvSplit[q], i);
+        vm = str__ryuMulShift64(4 * m2 - 1 - mmShift, str__ryuPow5InvSplit[q], i);
+        if (q <= 21) {
+            // only one of mp, mv and mm can be a multiple of 5
+            if (mv % 5 == 0) {
+                vrIsTrailingZeros = str__ryuMultipleOfPow5(mv, q);
+            } else if (acceptBounds) {
+                vmIsTrailingZeros = str__ryuMultipleOfPow5(mv - 1 - mmShift, q);
+            } else {
+                vp -= str__ryuMultipleOfPow5(mv + 2, q);
+            }
+        }
+    } else {
+        u32 q = str__ryuLog10Pow5(-e2) - (-e2 > 1);
+        e10 = i32_cast(q) + e2;
+        i32 i = -e2 - i32_cast(q);
+        i32 k = str__ryuPow5Bits(i) - STR__RYU_POW5_BITCOUNT;
+        i32 j = i32_cast(q) - k;
+        vr = str__ryuMulShift64(4 * m2, str__ryuPow5Split[i], j);
+        vp = str__ryuMulShift64(4 * m2 + 2, str__ryuPow5Split[i], j);
+        vm = str__ryuMulShift64(4 * m2 - 1 - mmShift, str__ryuPow5Split[i], j);
+        if (q <= 1) {
+            // mv = 4 * m2 always has at least two trailing zero bits
+            vrIsTrailingZeros = true;
+            if (acceptBounds) {
+                vmIsTrailingZeros = mmShift == 1;
+            } else {
+                vp--;
+            }
+        } else if (q < 63) {
+            vrIsTrailingZeros = str__ryuMultipleOfPow2(mv, q);
+        }
+    }
+
+    // remove digits as long as the interval still contains a shorter representation
+    i32 removed = 0;
+    u8 lastRemovedDigit = 0;
+    u64 output;
+    if (vmIsTrailingZeros || vrIsTrailingZeros) {
+        while (vp / 10 > vm / 10) {
+            vmIsTrailingZeros &= vm % 10 == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = u8_cast(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vmIsTrailingZeros) {
+            while (vm % 10 == 0) {
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = u8_cast(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+            // exactly halfway, round to even
+            lastRemovedDigit = 4;
+        }
+        output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+    } else {
+        bx roundUp = false;
+        if (vp / 100 > vm / 100) {
+            u64 vrMod100 = vr % 100;
+            roundUp = vrMod100 >= 50;
+            vr /= 100;
+            vp /= 100;
+            vm /= 100;
+            removed += 2;
+        }
+        while (vp / 10 > vm / 10) {
+            roundUp = vr % 10 >= 5;
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || roundUp);
+    }
+    str__FloatDecimal result = {output, e10 + removed};
+    return result;
+}
+
+INLINE u32 str__ryuMulPow5InvDivPow2(u32 m, u32 q, i32 j) {
+    // the table stores [2^x / 5^y] + 1 for the full 128 bits, the upper word needs the + 1 again
+    return str__ryuMulShift32(m, str__ryuPow5InvSplit[q][1] + 1, j);
+}
+
+INLINE u32 str__ryuMulPow5DivPow2(u32 m, u32 i, i32 j) {
+    return str__ryuMulShift32(m, str__ryuPow5Split[i][1], j);
+}
+
+LOCAL str__FloatDecimal str__ryuF32(u32 ieeeMantissa, u32 ieeeExponent) {
+    i32 e2;
+    u32 m2;
+    if (ieeeExponent == 0) {
+        e2 = 1 - 127 - 23 - 2;
+        m2 = ieeeMantissa;
+    } else {
+        e2 = i32_cast(ieeeExponent) - 127 - 23 - 2;
+        m2 = (1u << 23) | ieeeMantissa;
+    }
+    bx acceptBounds = (m2 & 1) == 0;
+
+    u32 mv = 4 * m2;
+    u32 mp = 4 * m2 + 2;
+    u32 mmShift = ieeeMantissa != 0 || ieeeExponent <= 1;
+    u32 mm = 4 * m2 - 1 - mmShift;
+
+    u32 vr, vp, vm;
+    i32 e10;
+    bx vmIsTrailingZeros = false;
+    bx vrIsTrailingZeros = false;
+    u8 lastRemovedDigit = 0;
+    if (e2 >= 0) {
+        u32 q = str__ryuLog10Pow2(e2);
+        e10 = i32_cast(q);
+        i32 k = STR__RYU_FLOAT_POW5_INV_BITCOUNT + str__ryuPow5Bits(i32_cast(q)) - 1;
+        i32 i = -e2 + i32_cast(q) + k;
+        vr = str__ryuMulPow5InvDivPow2(mv, q, i);
+        vp = str__ryuMulPow5InvDivPow2(mp, q, i);
+        vm = str__ryuMulPow5InvDivPow2(mm, q, i);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+            // one removed digit is needed even if the loop below doesn't run
+            i32 l = STR__RYU_FLOAT_POW5_INV_BITCOUNT + str__ryuPow5Bits(i32_cast(q - 1)) - 1;
+            lastRemovedDigit = u8_cast(str__ryuMulPow5InvDivPow2(mv, q - 1, -e2 + i32_cast(q) - 1 + l) % 10);
+        }
+        if (q <= 9) {
+            if (mv % 5 == 0) {
+                vrIsTrailingZeros = str__ryuMultipleOfPow5(mv, q);
+            } else if (acceptBounds) {
+                vmIsTrailingZeros = str__ryuMultipleOfPow5(mm, q);
+            } else {
+                vp -= str__ryuMultipleOfPow5(mp, q);
+            }
+        }
+    } else {
+        u32 q = str__ryuLog10Pow5(-e2);
+        e10 = i32_cast(q) + e2;
+        i32 i = -e2 - i32_cast(q);
+        i32 k = str__ryuPow5Bits(i) - STR__RYU_FLOAT_POW5_BITCOUNT;
+        i32 j = i32_cast(q) - k;
+        vr = str__ryuMulPow5DivPow2(mv, u32_cast(i), j);
+        vp = str__ryuMulPow5DivPow2(mp, u32_cast(i), j);
+        vm = str__ryuMulPow5DivPow2(mm, u32_cast(i), j);
+        if (q != 0 && (vp - 1) / 10 <= vm / 10) {
+            j = i32_cast(q) - 1 - (str__ryuPow5Bits(i + 1) - STR__RYU_FLOAT_POW5_BITCOUNT);
+            lastRemovedDigit = u8_cast(str__ryuMulPow5DivPow2(mv, u32_cast(i + 1), j) % 10);
+        }
+        if (q <= 1) {
+            vrIsTrailingZeros = true;
+            if (acceptBounds) {
+                vmIsTrailingZeros = mmShift == 1;
+            } else {
+                vp--;
+            }
+        } else if (q < 31) {
+            vrIsTrailingZeros = str__ryuMultipleOfPow2(mv, q - 1);
+        }
+    }
+
+    i32 removed = 0;
+    u32 output;
+    if (vmIsTrailingZeros || vrIsTrailingZeros) {
+        while (vp / 10 > vm / 10) {
+            vmIsTrailingZeros &= vm % 10 == 0;
+            vrIsTrailingZeros &= lastRemovedDigit == 0;
+            lastRemovedDigit = u8_cast(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        if (vmIsTrailingZeros) {
+            while (vm % 10 == 0) {
+                vrIsTrailingZeros &= lastRemovedDigit == 0;
+                lastRemovedDigit = u8_cast(vr % 10);
+                vr /= 10;
+                vp /= 10;
+                vm /= 10;
+                removed++;
+            }
+        }
+        if (vrIsTrailingZeros && lastRemovedDigit == 5 && vr % 2 == 0) {
+            lastRemovedDigit = 4;
+        }
+        output = vr + ((vr == vm && (!acceptBounds || !vmIsTrailingZeros)) || lastRemovedDigit >= 5);
+    } else {
+        while (vp / 10 > vm / 10) {
+            lastRemovedDigit = u8_cast(vr % 10);
+            vr /= 10;
+            vp /= 10;
+            vm /= 10;
+            removed++;
+        }
+        output = vr + (vr == vm || lastRemovedDigit >= 5);
+    }
+    str__FloatDecimal result = {output, e10 + removed};
+    return result;
+}
+
+// lays out mantissa * 10^exponent: fixed notation for 1e-7 < |v| < 1e21, scientific otherwise
+LOCAL u64 str__writeFloatDecimal(u8* out, bx negative, str__FloatDecimal dec) {
+    u8* p = out;
+    if (negative) {
+        *p++ = '-';
+    }
+    u32 length = str__decimalLength(dec.mantissa);
+    i32 pointPos = i32_cast(length) + dec.exponent;
+    if (dec.exponent >= 0 && pointPos <= 21) {
+        // integer, pad with zeros
+        str__writeDigits(p, length, dec.mantissa);
+        p += length;
+        for (i32 i = 0; i < dec.exponent; i++) {
+            *p++ = '0';
+        }
+    } else if (pointPos > 0 && pointPos <= 21) {
+        u64 scale = str__powersOfTen[length - u32_cast(pointPos)];
+        str__writeDigits(p, u32_cast(pointPos), dec.mantissa / scale);
+        p += pointPos;
+        *p++ = '.';
+        str__writeDigits(p, length - u32_cast(pointPos), dec.mantissa % scale);
+        p += length - u32_cast(pointPos);
+    } else if (pointPos <= 0 && pointPos > -6) {
+        *p++ = '0';
+        *p++ = '.';
+        for (i32 i = pointPos; i < 0; i++) {
+            *p++ = '0';
+        }
+        str__writeDigits(p, length, dec.mantissa);
+        p += length;
+    } else {
+        // d.ddde+x
+        u64 scale = str__powersOfTen[length - 1];
+        *p++ = u8_cast('0' + dec.mantissa / scale);
+        if (length > 1) {
+            *p++ = '.';
+            str__writeDigits(p, length - 1, dec.mantissa % scale);
+            p += length - 1;
+        }
+        i32 exp = pointPos - 1;
+        *p++ = 'e';
+        *p++ = exp < 0 ? '-' : '+';
+        exp = exp < 0 ? -exp : exp;
+        u32 expLength = str__decimalLength(u64_cast(exp));
+        str__writeDigits(p, expLength, u64_cast(exp));
+        p += expLength;
+    }
+    return u64_cast(p - out);
+}
+
+LOCAL u64 str__writeFloatSpecial(u8* out, bx negative, bx isNan) {
+    S8 text = isNan ? s8("nan") : (negative ? s8("-inf") : s8("inf"));
+    mem_copy(out, text.content, text.size);
+    return text.size;
+}
+
+API u64 str_f64ToChars(f64 value, u8* out) {
+    u64 bits;
+    mem_copy(&bits, &value, sizeof(bits));
+    bx negative = (bits >> 63) != 0;
+    u64 ieeeMantissa = bits & ((u64_val(1) << 52) - 1);
+    u32 ieeeExponent = u32_cast((bits >> 52) & 0x7FF);
+    if (ieeeExponent == 0x7FF) {
+        return str__writeFloatSpecial(out, negative, ieeeMantissa != 0);
+    }
+    if (ieeeExponent == 0 && ieeeMantissa == 0) {
+        u8* p = out;
+        if (negative) {
+            *p++ = '-';
+        }
+        *p++ = '0';
+        return u64_cast(p - out);
+    }
+    // small integers don't need the full algorithm
+    if (ieeeExponent >= 1023 && ieeeExponent <= 1023 + 52) {
+        u64 m2 = (u64_val(1) << 52) | ieeeMantissa;
+        u32 shift = 1023 + 52 - ieeeExponent;
+        if ((m2 & ((u64_val(1) << shift) - 1)) == 0) {
+            str__FloatDecimal dec = {m2 >> shift, 0};
+            // strip trailing zeros so large round numbers take the scientific notation
+            while (dec.mantissa % 10 == 0) {
+                dec.mantissa /= 10;
+                dec.exponent++;
+            }
+            return str__writeFloatDecimal(out, negative, dec);
+        }
+    }
+    return str__writeFloatDecimal(out, negative, str__ryuF64(ieeeMantissa, ieeeExponent));
+}
+
+API u64 str_f32ToChars(f32 value, u8* out) {
+    u32 bits;
+    mem_copy(&bits, &value, sizeof(bits));
+    bx negative = (bits >> 31) != 0;
+    u32 ieeeMantissa = bits & ((1u << 23) - 1);
+    u32 ieeeExponent = (bits >> 23) & 0xFF;
+    if (ieeeExponent == 0xFF) {
+        return str__writeFloatSpecial(out, negative, ieeeMantissa != 0);
+    }
+    if (ieeeExponent == 0 && ieeeMantissa == 0) {
+        u8* p = out;
+        if (negative) {
+            *p++ = '-';
+        }
+        *p++ = '0';
+        return u64_cast(p - out);
+    }
+    return str__writeFloatDecimal(out, negative, str__ryuF32(ieeeMantissa, ieeeExponent));
 }
 
 ////////////////////////////
@@ -656,80 +4139,30 @@ LOCAL void str_recordCustom(Arena* arena, str_CustomVal* customVal, S8 format) {
    customVal->buildStrFn(arena, format, customVal->usrPtr);
 }
 
-LOCAL i32 str__f32ToCharArr(char const** start, u32 *len, char* out, i32* decimal_pos, f64 value, i32 frac_digits);
-
-LOCAL void str_recordf32_cast(Arena* arena, f32 floatVal) {
-   u32 fracDigits = 10;
-   const char* startChar = NULL;
-   char str[512];
-   u32 length = 0;
-   i32 decPos = 0;
-   i32 start = str__f32ToCharArr(&startChar, &length, str, &decPos, floatVal, fracDigits);
-   if (decPos == 0) {
-      mem_copy(mem_arenaPush(arena, 2), "0.", 2);
-   }
-   if (decPos < length) {
-      mem_copy(mem_arenaPush(arena, decPos), startChar, decPos);
-      mem_copy(mem_arenaPush(arena, 1),  ".", 1);
-      mem_copy(mem_arenaPush(arena, length - decPos), &startChar[decPos], length - decPos);
-   } else {
-      mem_copy(mem_arenaPush(arena, length), &startChar[0], length);
-   }
-}
-
+LOCAL void str_recordF32(Arena* arena, f32 floatVal) {
+   u8 buffer[STR_FLOAT_MAX_CHARS];
+   u64 length = str_f32ToChars(floatVal, buffer);
+   mem_copy(mem_arenaPush(arena, length), buffer, length);
+}
+
 LOCAL void str_recordF64(Arena* arena, f64 floatVal) {
-   u32 fracDigits = 15;
-   const char* startChar = NULL;
-   char str[512];
-   u32 length = 0;
-   i32 decPos = 0;
-   i32 start = str__f32ToCharArr(&startChar, &length, &str[0], &decPos, floatVal, fracDigits);
-   if (decPos == 0) {
-      mem_copy(mem_arenaPush(arena, length), "0.", 2);
-   }
-   mem_copy(mem_arenaPush(arena, decPos), startChar, decPos);
-   mem_copy(mem_arenaPush(arena, 1),  ".", 1);
-   mem_copy(mem_arenaPush(arena, length - decPos), &startChar[decPos], length - decPos);
+   u8 buffer[STR_FLOAT_MAX_CHARS];
+   u64 length = str_f64ToChars(floatVal, buffer);
+   mem_copy(mem_arenaPush(arena, length), buffer, length);
 }
-// TODO: consider fast coversation alternative: https://github.com/fmtlib/format-benchmark/blob/master/src/u2985907.h
+
 LOCAL void str_recordU64(Arena* arena, u64 value, bx isNegativ, S8 format) {
+   u32 length = str__decimalLength(value);
+   u8* ptr = (u8*) mem_arenaPush(arena, length + (isNegativ ? 1 : 0));
    if (isNegativ) {
-      u8* ptr = mem_arenaPush(arena, 1);
-      ptr[0] = '-';
-   }
-   if (value == 0) {
-      u8* ptr = mem_arenaPush(arena, 1);
-      ptr[0] = '0';
-      return;
-   }
-   u8 intStr[21];
-   uint32_t pos = 20;
-   for (uint64_t tmpVal = value; tmpVal > 0;tmpVal /= 10) {
-      uint64_t digit = tmpVal - ((tmpVal / 10) * 10);
-      intStr[pos--] = '0' + digit;
+      *ptr++ = '-';
    }
-   pos += 1;
-   u32 length = 21 - pos;
-   mem_copy(mem_arenaPush(arena, length), intStr + pos, length);
+   str__writeDigits(ptr, length, value);
 }
 
-LOCAL i32 str__ufast_utoa10(u32 value, char* str);
-
-LOCAL void str_recordU32(Arena* arena, u32 value, bx isNegativ, S8 format) {
-   if (isNegativ) {
-      u8* ptr = mem_arenaPush(arena, 1);
-      ptr[0] = '-';
-   }
-   if (value == 0) {
-      u8* ptr = mem_arenaPush(arena, 1);
-      ptr[0] = '0';
-      return;
-   }
-   
-   int popBy = 10 - str__ufast_utoa10(value, (char*) mem_arenaPush(arena, 10));
-   if (popBy > 0) {
-      mem_arenaPopTo(arena, arena->pos - popBy);
-   }
+LOCAL void str_recordI64(Arena* arena, i64 value, S8 format) {
+   // negate in unsigned space, i64 min has no positive counterpart
+   str_recordU64(arena, value < 0 ? ~u64_cast(value) + 1 : u64_cast(value), value < 0, format);
 }
 
 LOCAL void str_recordChar(Arena* arena, char value) {
@@ -750,12 +4183,12 @@ API S8 str_joinVargs(Arena* arena, u32 argCount, va_list inValist) {
             case str_argType_custom:   str_recordCustom(arena, &arg.customVal, (S8) {0, 0}); break;
             case str_argType_char:     str_recordChar(arena, arg.charVal); break;
             case str_argType_str:      str_recordStr(arena, arg.strVal); break;
-            case str_argType_f32:      str_recordf32_cast(arena, arg.f32Val); break;
+            case str_argType_f32:      str_recordF32(arena, arg.f32Val); break;
             case str_argType_f64:      str_recordF64(arena, arg.f64Val); break;
-            case str_argType_u32:      str_recordU32(arena, arg.u32Val, false, (S8){0, 0}); break;
+            case str_argType_u32:      str_recordU64(arena, arg.u32Val, false, (S8){0, 0}); break;
             case str_argType_u64:      str_recordU64(arena, arg.u64Val, false, (S8){0, 0}); break;
-            case str_argType_i32:      str_recordU32(arena, absVal(arg.i32Val), arg.i32Val >= 0 ? false : true, (S8){0, 0}); break;
-            case str_argType_i64:      str_recordU64(arena, absVal(arg.i64Val), arg.i64Val >= 0 ? false : true, (S8){0, 0}); break;
+            case str_argType_i32:      str_recordI64(arena, arg.i32Val, (S8){0, 0}); break;
+            case str_argType_i64:      str_recordI64(arena, arg.i64Val, (S8){0, 0}); break;
          }
       }
    }
@@ -775,394 +4208,436 @@ S8 str_fmtRaw(Arena* arena, S8 fmt, u32 argCount, ...) {
    return str_fmtVargs(arena, fmt, argCount, valist);
 }
 
-bx str__insertValue(Arena* arena, u32 insertCount, S8 valueFormat, u32 argCount, va_list inValist) {
-   va_list valist;
-   va_copy(valist, inValist);
-   i32 insertIndex = -1;
-   i32 fmtIdx = 0;
-   if (valueFormat.size == 0 || valueFormat.content[0] == ':') {
-      insertIndex = insertCount;
-   } else if (valueFormat.size >= 1 && str_isNumberChar(valueFormat.content[0])) {
-      u32 number = 0;
-      u64 offset = str_parseU32N(valueFormat, &number);
-      if (offset != 0) {
-         insertIndex = number;
-         fmtIdx = offset;
-      }
+////////////////////////////
+// NOTE(pjako): format programs
+
+// ops kept on the stack by str_fmtVargs, longer templates compile into arena scratch (see str__fmtScratchPush)
+#define STR__FMT_LOCAL_OPS 64
+// arguments read from the va_list into a local array, more spill into arena scratch
+#define STR__FMT_LOCAL_ARGS 16
+// key table of str_fmtProgramArgs, enough for 32 arguments at half load
+#define STR__FMT_LOCAL_KEY_SLOTS 64
+
+// The caller may be recording into arena (str_record, builders, the log), so scratch can not be pushed and popped
+// around the output. It is pushed in front of the output instead and the finished output is moved down over it.
+INLINE void* str__fmtScratchPush(Arena* arena, u64 size) {
+   // aligned by hand, pushes are not aligned while the arena records
+   u8* mem = (u8*) mem_arenaPush(arena, size + 15);
+   return (void*) alignUp(mem, 16);
+}
+
+LOCAL S8 str__fmtScratchEnd(Arena* arena, u64 scratchPos, S8 result) {
+   u8* start = ((u8*) arena) + scratchPos;
+   if (result.size > 0) {
+      mem_move(start, result.content, result.size);
    }
-   str_KeyValue arg;
-   if (insertIndex != -1) {
-      // Find value at index
-      if (insertIndex >= argCount) {
-         ASSERT(!"Index out of arguments bounds.");
-         va_end(valist);
-         return false;
-      }
-      for (u32 idx = 0; idx < argCount; idx++) {
-         arg = va_arg(valist, str_KeyValue);
-         if (idx == insertIndex) {
-            break;
-         }
-      }
+   u64 pos = scratchPos + result.size;
+   mem_arenaPopTo(arena, arena->unsafeRecord ? pos : alignUp(pos, arena->alignment));
+   result.content = start;
+   return result;
+}
+
+INLINE bx str__fmtPushOp(str_FmtProgram* program, u32 opCapacity, str_fmtOpKind kind, u32 offset, u32 size) {
+   if (size == 0 && kind == str_fmtOpKind_literal) {
+      return true;
+   }
+   if (program->opCount >= opCapacity) {
+      return false;
+   }
+   str_FmtOp* op = &program->ops[program->opCount++];
+   mem_structSetZero(op);
+   op->kind = u8_cast(kind);
+   op->offset = offset;
+   op->size = size;
+   return true;
+}
+
+// FNV-1a, keys are short
+INLINE u32 str__fmtKeyHash(S8 key) {
+   u32 hash = 2166136261u;
+   for (u64 idx = 0; idx < key.size; idx++) {
+      hash = (hash ^ key.content[idx]) * 16777619u;
+   }
+   return hash;
+}
+
+// parses the placeholder content between the braces into op
+LOCAL void str__fmtParseSlot(str_FmtProgram* program, str_FmtOp* op, u32 position) {
+   S8 slot = str_subStr(program->fmt, op->offset + 1, op->size - 2);
+   u32 specStart = 0;
+   op->kind = str_fmtOpKind_arg;
+   if (slot.size == 0 || slot.content[0] == ':') {
+      op->argIndex = u8_cast(position);
+   } else if (str_isNumberChar(slot.content[0])) {
+      u32 number = 0;
+      u64 consumed = str_parseU32N(slot, &number);
+      ASSERT(number < 256 && "Argument index out of range.");
+      op->argIndex = u8_cast(number);
+      specStart = u32_cast(consumed);
    } else {
-      // figure out S8 key and search for it
       u32 count = 0;
-      for (; valueFormat.content[count] != ':' && valueFormat.content[count] != '}'; count++);
-      S8 key;
-      if (count > 1) {
-         key.content = valueFormat.content;
-         key.size = count;
-         fmtIdx = count;
-      } else {
-         ASSERT(!"Key argument invalid.");
-         va_end(valist);
-         return false;
-      }
-      bx keyFound = false;
+      for (; count < slot.size && slot.content[count] != ':'; count++);
+      op->kind = str_fmtOpKind_key;
+      op->keySize = u16_cast(count);
+      op->keyHash = str__fmtKeyHash(str_fromCharPtr(slot.content, count));
+      op->argIndex = 0;
+      program->keyCount += 1;
+      specStart = count;
+   }
+   ASSERT(position < 256 && "Too many placeholders.");
+   if (op->kind == str_fmtOpKind_arg) {
+      program->argCount = maxVal(program->argCount, u32_cast(op->argIndex) + 1);
+   }
+   if (specStart < slot.size && slot.content[specStart] == ':') {
+      ASSERT(op->size < 0x10000 && "Placeholder too long.");
+      op->specOffset = u16_cast(specStart + 2);
+      op->specSize = u16_cast(slot.size - (specStart + 1));
+   }
+}
 
-      for (u32 idx = 0; idx < argCount; idx++) {
-         arg = va_arg(valist, str_KeyValue);
-         if (str_isEqual(arg.key, key)) {
-            keyFound = true;
+API bx str_fmtCompileInto(str_FmtProgram* program, str_FmtOp* ops, u32 opCapacity, S8 fmt) {
+   ASSERT(program);
+   mem_structSetZero(program);
+   program->fmt = fmt;
+   program->ops = ops;
+   program->valid = true;
+
+   u32 position = 0;
+   u32 textStart = 0;
+   for (u32 idx = 0; idx < fmt.size; idx++) {
+      u8 c = fmt.content[idx];
+      if (c == '{') {
+         if (idx + 1 >= fmt.size) {
+            ASSERT(!"Encountered single '{' at the end of the string!");
+            program->valid = false;
+            return true;
+         }
+         if (fmt.content[idx + 1] == '{') {
+            // "{{" => "{", keep the first brace in the literal
+            if (!str__fmtPushOp(program, opCapacity, str_fmtOpKind_literal, textStart, idx + 1 - textStart)) return false;
+            idx += 1;
+            textStart = idx + 1;
+            continue;
+         }
+         u32 end = idx + 1;
+         for (; end < fmt.size && !(fmt.content[end] == '}' && fmt.content[end - 1] != '\\'); end++);
+         if (end >= fmt.size) {
+            // unterminated placeholder, emitted as text
             break;
          }
-      }
-
-      if (!keyFound) {
-         ASSERT(!"Key was not found in arguments");
-         va_end(valist);
-         return false;
+         if (!str__fmtPushOp(program, opCapacity, str_fmtOpKind_literal, textStart, idx - textStart)) return false;
+         if (!str__fmtPushOp(program, opCapacity, str_fmtOpKind_arg, idx, end + 1 - idx)) return false;
+         str__fmtParseSlot(program, &program->ops[program->opCount - 1], position);
+         position += 1;
+         idx = end;
+         textStart = end + 1;
+      } else if (c == '}') {
+         if (idx + 1 >= fmt.size || fmt.content[idx + 1] != '}') {
+            ASSERT(!"Encountered single '}' ");
+            program->valid = false;
+            return true;
+         }
+         // "}}" => "}"
+         if (!str__fmtPushOp(program, opCapacity, str_fmtOpKind_literal, textStart, idx + 1 - textStart)) return false;
+         idx += 1;
+         textStart = idx + 1;
       }
    }
-   va_end(valist);
-
-   S8 format;
-   format.content = NULL;
-   format.size = 0;
+   return str__fmtPushOp(program, opCapacity, str_fmtOpKind_literal, textStart, fmt.size - textStart);
+}
 
-   if (valueFormat.content[fmtIdx] == ':') {
-      u8 * f = valueFormat.content + (fmtIdx + 1);
-      u32 size = valueFormat.size - (fmtIdx + 1);
-      u32 count = 0;
-      for (; f[count] != '}' && count < size; count++);
-      if (count > 0) {
-         format.content = f;
-         format.size = count;
-      }
-   }
+API str_FmtProgram str_fmtCompile(Arena* arena, S8 fmt) {
+   // a template never needs more ops than it has characters plus the trailing literal
+   u32 capacity = fmt.size + 1;
+   str_FmtProgram program;
+   str_FmtOp* ops = mem_arenaPushArray(arena, str_FmtOp, capacity);
+   str_fmtCompileInto(&program, ops, capacity, fmt);
+   mem_arenaPopAmount(arena, (capacity - program.opCount) * sizeof(str_FmtOp));
+   return program;
+}
 
-   switch (arg.value.type) {
-      case str_argType_custom:   str_recordCustom(arena, &arg.value.customVal, format); break;
-      case str_argType_char:     str_recordChar(arena, arg.value.charVal); break;
-      case str_argType_str:      str_recordStr(arena, arg.value.strVal); break;
-      case str_argType_f32:      str_recordf32_cast(arena, arg.value.f32Val); break;
-      case str_argType_f64:      str_recordF64(arena, arg.value.f64Val); break;
-      case str_argType_u32:      str_recordU32(arena, arg.value.u32Val, false, format); break;
-      case str_argType_u64:      str_recordU64(arena, arg.value.u64Val, false, format); break;
-      case str_argType_i32:      str_recordU32(arena, absVal(arg.value.i32Val), arg.value.i32Val >= 0 ? false : true, format); break;
-      case str_argType_i64:      str_recordU64(arena, absVal(arg.value.i64Val), arg.value.i64Val >= 0 ? false : true, format); break;
+INLINE void str__recordValue(Arena* arena, const str_Value* value, S8 format) {
+   switch (value->type) {
+      case str_argType_custom:   str_recordCustom(arena, (str_CustomVal*) &value->customVal, format); break;
+      case str_argType_char:     str_recordChar(arena, value->charVal); break;
+      case str_argType_str:      str_recordStr(arena, value->strVal); break;
+      case str_argType_f32:      str_recordF32(arena, value->f32Val); break;
+      case str_argType_f64:      str_recordF64(arena, value->f64Val); break;
+      case str_argType_u32:      str_recordU64(arena, value->u32Val, false, format); break;
+      case str_argType_u64:      str_recordU64(arena, value->u64Val, false, format); break;
+      case str_argType_i32:      str_recordI64(arena, value->i32Val, format); break;
+      case str_argType_i64:      str_recordI64(arena, value->i64Val, format); break;
    }
-
-   return true;
 }
 
-S8 str_fmtVargs(Arena* arena, S8 fmt, u32 argCount, va_list list) {
+API S8 str_fmtProgramArgs(Arena* arena, const str_FmtProgram* program, u32 argCount, const str_KeyValue* args) {
+   ASSERT(program);
+   if (!program->valid) {
+      return str_lit("");
+   }
+   ASSERT(program->argCount <= argCount && "Index out of arguments bounds.");
+   // the argument keys go into an open addressing table once per call, every named placeholder is one lookup.
+   // Slots hold the argument index + 1, the table is at most half full so a probe always ends on an empty slot.
+   u32 localSlots[STR__FMT_LOCAL_KEY_SLOTS];
+   u32* slots = NULL;
+   u32 slotMask = 0;
+   u64 scratchPos = arena->pos;
+   if (program->keyCount > 0 && argCount > 0) {
+      u32 slotCount = 8;
+      while (slotCount < argCount * 2) {
+         slotCount *= 2;
+      }
+      slots = slotCount <= countOf(localSlots) ? localSlots : (u32*) str__fmtScratchPush(arena, sizeof(u32) * slotCount);
+      mem_setZero(slots, sizeof(u32) * slotCount);
+      slotMask = slotCount - 1;
+      for (u32 idx = 0; idx < argCount; idx++) {
+         if (args[idx].key.size == 0) {
+            continue;
+         }
+         u32 slot = str__fmtKeyHash(args[idx].key) & slotMask;
+         while (slots[slot] != 0 && !str_isEqual(args[slots[slot] - 1].key, args[idx].key)) {
+            slot = (slot + 1) & slotMask;
+         }
+         // the first argument with a key wins
+         if (slots[slot] == 0) {
+            slots[slot] = idx + 1;
+         }
+      }
+   }
    S8 strOut;
    u32 storedAligmnet = arena->alignment;
    arena->alignment = 1;
    str_record(strOut, arena) {
-      char lastChar = 0;
-      char currentChar = 0;
-      i32 insertCount = 0;
-      i32 insertStartIdx = -1;
-      i32 textStartIdx = 0;
-
-      for (i32 idx = 0; idx < fmt.size; (lastChar = fmt.content[idx], idx++)) {
-         currentChar = fmt.content[idx];
-         if (insertStartIdx != -1) {
-            if (currentChar == '}' && lastChar != '\\') {
-               S8 fmtStr;
-               fmtStr.content = fmt.content + insertStartIdx + 1;
-               fmtStr.size = idx - (insertStartIdx + 1);
-               if (str__insertValue(arena, insertCount, fmtStr, argCount, list)) {
-                  textStartIdx = idx + 1;
-               } else {
-                  textStartIdx = insertStartIdx;
-               }
-               insertStartIdx = -1;
-               insertCount += 1;
-            }
-         } else if (currentChar == '{') {
-            if (!(idx < fmt.size)) {
-               ASSERT(!"Encountered single '{' at the end of the string!");
-               arena->alignment = storedAligmnet;
-               return str_lit("");
-            }
-            char nextChar = fmt.content[idx + 1];
-            if (nextChar == '{') {
-               idx += 1;
+      u8* fmt = program->fmt.content;
+      for (u32 opIdx = 0; opIdx < program->opCount; opIdx++) {
+         const str_FmtOp* op = &program->ops[opIdx];
+         const str_KeyValue* arg = NULL;
+         if (op->kind == str_fmtOpKind_arg) {
+            if (op->argIndex < argCount) {
+               arg = &args[op->argIndex];
             }
-            i32 textSize = idx - textStartIdx;
-            if (textSize > 0) {
-               // copy text from template
-               u8* mem = (u8*) mem_arenaPush(arena, textSize * sizeof(u8));
-               mem_copy(mem, (fmt.content + textStartIdx), textSize * sizeof(u8));
-            }
-            if (nextChar != '{') {
-               insertStartIdx = idx;
-            }
-            textStartIdx = idx + 1;
-         } else if (currentChar == '}') {
-            if (!(idx < fmt.size)) {
-               ASSERT(!"Encountered single '}' at the end of the string!");
-               arena->alignment = storedAligmnet;
-               return str_lit("");
-            }
-            char nextChar = fmt.content[idx + 1];
-            if (nextChar == '}') {
-               idx += 1;
-            } else {
-               ASSERT(!"Encountered single '}' ");
-               arena->alignment = storedAligmnet;
-               return str_lit("");
-            }
-            i32 textSize = idx - textStartIdx;
-            if (textSize > 0) {
-               // copy text from template
-               u8* mem = (u8*) mem_arenaPush(arena, textSize * sizeof(u8));
-               mem_copy(mem, (fmt.content + textStartIdx), textSize * sizeof(u8));
+         } else if (op->kind == str_fmtOpKind_key && slots) {
+            S8 key = str_fromCharPtr(fmt + op->offset + 1, op->keySize);
+            for (u32 slot = op->keyHash & slotMask; slots[slot] != 0; slot = (slot + 1) & slotMask) {
+               if (str_isEqual(args[slots[slot] - 1].key, key)) {
+                  arg = &args[slots[slot] - 1];
+                  break;
+               }
             }
-            textStartIdx = idx + 1;
          }
-      }
-      // copy over the remaining text
-      u32 size =  fmt.size - textStartIdx;
-      if (size > 0) {
-         // copy text from template
-         u8* mem = (u8*) mem_arenaPush(arena, size * sizeof(u8));
-         mem_copy(mem, (fmt.content + textStartIdx), size * sizeof(u8));
+         ASSERT((arg || op->kind != str_fmtOpKind_key) && "Key was not found in arguments");
+         if (arg) {
+            S8 format = op->specSize ? str_fromCharPtr(fmt + op->offset + op->specOffset, op->specSize) : (S8) {0, 0};
+            str__recordValue(arena, &arg->value, format);
+         } else {
+            // literals and unresolved placeholders are copied from the template
+            u8* mem = (u8*) mem_arenaPush(arena, op->size);
+            mem_copy(mem, fmt + op->offset, op->size);
+         }
       }
    }
-
    arena->alignment = storedAligmnet;
-   return strOut;
+   return slots && slots != localSlots ? str__fmtScratchEnd(arena, scratchPos, strOut) : strOut;
+}
+
+API S8 str_fmtProgramVargs(Arena* arena, const str_FmtProgram* program, u32 argCount, va_list inValist) {
+   str_KeyValue localArgs[STR__FMT_LOCAL_ARGS];
+   str_KeyValue* args = localArgs;
+   u64 scratchPos = arena->pos;
+   if (argCount > countOf(localArgs)) {
+      args = (str_KeyValue*) str__fmtScratchPush(arena, sizeof(str_KeyValue) * argCount);
+   }
+   va_list valist;
+   va_copy(valist, inValist);
+   for (u32 idx = 0; idx < argCount; idx++) {
+      args[idx] = va_arg(valist, str_KeyValue);
+   }
+   va_end(valist);
+   S8 result = str_fmtProgramArgs(arena, program, argCount, args);
+   return args == localArgs ? result : str__fmtScratchEnd(arena, scratchPos, result);
+}
+
+API S8 str_fmtProgramRaw(Arena* arena, const str_FmtProgram* program, u32 argCount, ...) {
+   va_list valist;
+   va_start(valist, argCount);
+   S8 result = str_fmtProgramVargs(arena, program, argCount, valist);
+   va_end(valist);
+   return result;
+}
+
+S8 str_fmtVargs(Arena* arena, S8 fmt, u32 argCount, va_list list) {
+   str_FmtOp localOps[STR__FMT_LOCAL_OPS];
+   str_FmtProgram program;
+   if (str_fmtCompileInto(&program, localOps, countOf(localOps), fmt)) {
+      return str_fmtProgramVargs(arena, &program, argCount, list);
+   }
+   // a template never needs more ops than it has characters plus the trailing literal
+   u64 scratchPos = arena->pos;
+   u32 capacity = u32_cast(fmt.size) + 1;
+   str_FmtOp* ops = (str_FmtOp*) str__fmtScratchPush(arena, sizeof(str_FmtOp) * capacity);
+   str_fmtCompileInto(&program, ops, capacity, fmt);
+   return str__fmtScratchEnd(arena, scratchPos, str_fmtProgramVargs(arena, &program, argCount, list));
 }
 
 
+////////////////////////////
+// NOTE(pjako): builder
+
 str_Builder str_builderInit(Arena* arena, u64 blockDefaultSize) {
    str_Builder builder = {
       .arena = arena,
-      .blockDefaultSize = blockDefaultSize ? blockDefaultSize : MEGABYTE(1),
+      .blockDefaultSize = blockDefaultSize ? blockDefaultSize : KILOBYTE(64),
    };
 
    return builder;
 }
 
-S8 str_builderFinish(Arena* targetArena) {
-   
+LOCAL u64 str__builderArenaPos(Arena* arena, u8* ptr) {
+   return u64_cast(ptr) - u64_cast(arena);
 }
 
-void str_builderJoinRaw(str_Builder* builder, u32 argCount, ...) {
-   ASSERT(builder && "Builder is NULL");
-   u32 storedAlignment = builder->arena->alignment;
-   str__BuilderBlock* builderBlock = NULL;
-   if (builder->lastBlock != NULL && builder->arena->commitPos == builder->arenaLastOffset) {
+// true if nothing was pushed to the arena since the last append, the last block can then grow in place
+INLINE bx str__builderIsTail(str_Builder* builder) {
+   return builder->lastBlock && builder->arena->pos == builder->arenaLastOffset;
+}
+
+// the header goes in front of the content so that the block stays at the end of the arena and can grow in place
+LOCAL void str__builderLinkBlock(str_Builder* builder, str__BuilderBlock* block, u8* content, u64 size, u64 capacity) {
+   block->next = NULL;
+   block->str.content = content;
+   block->str.size = size;
+   block->capacity = capacity;
+   if (builder->lastBlock) {
+      builder->lastBlock->next = block;
    } else {
-      builderBlock = (str__BuilderBlock*) mem_arenaPush(builder->arena, sizeOf(*builder->lastBlock));
-      if (builder->firstBlock == NULL) {
-         builder->firstBlock = builderBlock;
-         builder->lastBlock = builderBlock;
-      } else {
-         builder->lastBlock->next = builderBlock;
-         builderBlock->prev = builder->lastBlock;
-         builder->lastBlock = builderBlock;
-      }
+      builder->firstBlock = block;
    }
-
-   va_list valist;
-   va_start(valist, argCount);
-   str_joinVargs(builder->arena, argCount, valist);
-   builder->arenaLastOffset = builder->arena->commitPos;
-   builder->arena->alignment = storedAlignment;
+   builder->lastBlock = block;
+   builder->blockCount += 1;
 }
-void str_builderFmtRaw(str_Builder* builder, S8 fmt, u32 argCount, ...) {
+
+API void str_builderAppend(str_Builder* builder, S8 str) {
    ASSERT(builder && "Builder is NULL");
-   u32 storedAlignment = builder->arena->alignment;
-   str__BuilderBlock* builderBlock = NULL;
-   if (builder->lastBlock != NULL && builder->arena->commitPos == builder->arenaLastOffset) {
-   } else {
-      builderBlock = (str__BuilderBlock*) mem_arenaPush(builder->arena, sizeOf(*builder->lastBlock));
-      if (builder->firstBlock == NULL) {
-         builder->firstBlock = builderBlock;
-         builder->lastBlock = builderBlock;
-      } else {
-         builder->lastBlock->next = builderBlock;
-         builderBlock->prev = builder->lastBlock;
-         builder->lastBlock = builderBlock;
+   if (str.size == 0) {
+      return;
+   }
+   builder->totalStringSize += str.size;
+   str__BuilderBlock* block = builder->lastBlock;
+   if (block) {
+      u64 free = block->capacity - block->str.size;
+      u64 size = minVal(free, str.size);
+      mem_copy(block->str.content + block->str.size, str.content, size);
+      block->str.size += size;
+      str = str_from(str, size);
+      if (str.size == 0) {
+         return;
       }
    }
+   if (str__builderIsTail(builder)) {
+      // the block is full and still at the end of the arena, just extend it
+      mem_arenaPopTo(builder->arena, str__builderArenaPos(builder->arena, block->str.content + block->capacity));
+      mem_arenaStartUnsafeRecord(builder->arena);
+      mem_copy(mem_arenaPush(builder->arena, str.size), str.content, str.size);
+      mem_arenaStopUnsafeRecord(builder->arena);
+      block->str.size += str.size;
+      block->capacity += str.size;
+   } else {
+      u64 capacity = maxVal(builder->blockDefaultSize, str.size);
+      str__BuilderBlock* newBlock = mem_arenaPushStruct(builder->arena, str__BuilderBlock);
+      u8* content = (u8*) mem_arenaPush(builder->arena, capacity);
+      mem_copy(content, str.content, str.size);
+      str__builderLinkBlock(builder, newBlock, content, str.size, capacity);
+   }
+   builder->arenaLastOffset = builder->arena->pos;
+}
 
+// formatted appends are recorded at the end of the arena behind a speculative block header,
+// then either moved into the free space of the last block or kept in place as a new block
+#define str__builderRecord(BUILDER, RECORD) do { \
+   Arena* recordArena = (BUILDER)->arena; \
+   str__BuilderBlock* block = (BUILDER)->lastBlock; \
+   bx grow = str__builderIsTail(BUILDER) && block->str.size == block->capacity; \
+   str__BuilderBlock* newBlock = NULL; \
+   if (grow) { \
+      mem_arenaPopTo(recordArena, str__builderArenaPos(recordArena, block->str.content + block->capacity)); \
+   } else { \
+      newBlock = mem_arenaPushStruct(recordArena, str__BuilderBlock); \
+   } \
+   S8 recorded; \
+   str_record(recorded, recordArena) { \
+      RECORD; \
+   } \
+   (BUILDER)->totalStringSize += recorded.size; \
+   if (grow) { \
+      block->str.size += recorded.size; \
+      block->capacity += recorded.size; \
+   } else if (block && recorded.size <= block->capacity - block->str.size) { \
+      mem_copy(block->str.content + block->str.size, recorded.content, recorded.size); \
+      block->str.size += recorded.size; \
+      mem_arenaPopTo(recordArena, str__builderArenaPos(recordArena, (u8*) newBlock)); \
+   } else { \
+      str__builderLinkBlock(BUILDER, newBlock, recorded.content, recorded.size, recorded.size); \
+   } \
+   (BUILDER)->arenaLastOffset = recordArena->pos; \
+} while (0)
+
+API void str_builderJoinVargs(str_Builder* builder, u32 argCount, va_list list) {
+   ASSERT(builder && "Builder is NULL");
+   str__builderRecord(builder, str_joinVargs(recordArena, argCount, list));
+}
+
+API void str_builderFmtVargs(str_Builder* builder, S8 fmt, u32 argCount, va_list list) {
+   ASSERT(builder && "Builder is NULL");
+   str__builderRecord(builder, str_fmtVargs(recordArena, fmt, argCount, list));
+}
+
+void str_builderJoinRaw(str_Builder* builder, u32 argCount, ...) {
    va_list valist;
    va_start(valist, argCount);
-   str_fmtVargs(builder->arena, fmt, argCount, valist);
-   builder->arenaLastOffset = builder->arena->commitPos;
-   builder->arena->alignment = storedAlignment;
+   str_builderJoinVargs(builder, argCount, valist);
+   va_end(valist);
 }
 
+void str_builderFmtRaw(str_Builder* builder, S8 fmt, u32 argCount, ...) {
+   va_list valist;
+   va_start(valist, argCount);
+   str_builderFmtVargs(builder, fmt, argCount, valist);
+   va_end(valist);
+}
 
-/////////////////
-// Parse u32 to str
-
-i32 str__ufast_utoa10(u32 value, char* str) {
-   #define JOIN(N)                                                      \
-   N "0", N "1", N "2", N "3", N "4", N "5", N "6", N "7", N "8", N "9" \
-
-   #define JOIN2(N)                                                     \
-   JOIN(N "0"), JOIN(N "1"), JOIN(N "2"), JOIN(N "3"), JOIN(N "4"),     \
-   JOIN(N "5"), JOIN(N "6"), JOIN(N "7"), JOIN(N "8"), JOIN(N "9")      \
-
-   #define JOIN3(N)                                                      \
-   JOIN2(N "0"), JOIN2(N "1"), JOIN2(N "2"), JOIN2(N "3"), JOIN2(N "4"), \
-   JOIN2(N "5"), JOIN2(N "6"), JOIN2(N "7"), JOIN2(N "8"), JOIN2(N "9")  \
-
-   #define JOIN4                                               \
-   JOIN3("0"), JOIN3("1"), JOIN3("2"), JOIN3("3"), JOIN3("4"), \
-   JOIN3("5"), JOIN3("6"), JOIN3("7"), JOIN3("8"), JOIN3("9")  \
-
-   #define JOIN5(N)                                                \
-   JOIN(N), JOIN(N "1"), JOIN(N "2"), JOIN(N "3"), JOIN(N "4"),    \
-   JOIN(N "5"), JOIN(N "6"), JOIN(N "7"), JOIN(N "8"), JOIN(N "9") \
-
-   #define JOIN6                                              \
-   JOIN5(""), JOIN2("1"), JOIN2("2"), JOIN2("3"), JOIN2("4"), \
-   JOIN2("5"), JOIN2("6"), JOIN2("7"), JOIN2("8"), JOIN2("9") \
-
-   #define F(N)  ((N) >= 100 ? 3 : (N) >= 10 ? 2 : 1)
-
-   #define F10(N)                                   \
-   F(N), F(N + 1), F(N + 2), F(N + 3), F(N + 4),    \
-   F(N + 5), F(N + 6), F(N + 7), F(N + 8), F(N + 9) \
-
-   #define F100(N)                                    \
-   F10(N), F10(N + 10), F10(N + 20), F10(N + 30),     \
-   F10(N + 40), F10(N + 50), F10(N + 60), F10(N + 70),\
-   F10(N + 80), F10(N + 90)                           \
-
-   static const short offsets[] = {
-                                    F100(  0), F100(100), F100(200), F100(300), F100(400),
-                                    F100(500), F100(600), F100(700), F100(800), F100(900)
-                                    };
-
-   static const char table1[][4] = { JOIN ("") };
-   static const char table2[][4] = { JOIN2("") };
-   static const char table3[][4] = { JOIN3("") };
-   static const char table4[][8] = { JOIN4 };
-   static const char table5[][4] = { JOIN6 };
-
-   #undef JOIN
-   #undef JOIN2
-   #undef JOIN3
-   #undef JOIN4
-   #undef F
-   #undef F10
-   #undef F100
-
-   char *wstr;
-   #if (_WIN64 || __x86_64__ || __ppc64__)
-      uint64_t remains[2];
-   #else
-      uint32_t remains[2];
-   #endif
-   unsigned int v2;
-
-   if (value >= 100000000)
-   {
-      #if (_WIN64 || __x86_64__ || __ppc64__)
-         remains[0] = (((uint64_t)value * (uint64_t)3518437209) >> 45);
-         remains[1] = (((uint64_t)value * (uint64_t)2882303762) >> 58);
-      #else
-         remains[0] = value / 10000;
-         remains[1] = value / 100000000;
-      #endif
-      v2 = remains[1];
-      remains[1] = remains[0] - remains[1] * 10000;
-      remains[0] = value - remains[0] * 10000;
-      if (v2 >= 10)
-      {
-         memcpy(str,table5[v2],2);
-         str += 2;
-         memcpy(str,table4[remains[1]],4);
-         str += 4;
-         memcpy(str,table4[remains[0]],4);
-         return 10;
-      }
-      else
-      {
-         *(char *) str = v2 + '0';
-         str += 1;
-         memcpy(str,table4[remains[1]],4);
-         str += 4;
-         memcpy(str,table4[remains[0]],4);
-         return 9;
-      }
+API S8 str_builderFinish(str_Builder* builder, Arena* targetArena) {
+   ASSERT(builder && "Builder is NULL");
+   if (builder->blockCount == 0) {
+      return STR_EMPTY;
    }
-   else if (value >= 10000)
-   {
-      #if (_WIN64 || __x86_64__ || __ppc64__)
-         v2 = (((uint64_t)value * (uint64_t)3518437209 ) >> 45);
-      #else
-         v2 = value / 10000;
-      #endif
-      remains[0] = value - v2 * 10000;
-      if (v2 >= 1000)
-      {
-         memcpy(str,table4[v2],4);
-         str += 4;
-         memcpy(str,table4[remains[0]],4);
-         return 8;
-      }
-      else
-      {
-         wstr = str;
-         memcpy(wstr,table5[v2],4);
-         wstr += offsets[v2];
-         memcpy(wstr,table4[remains[0]],4);
-         wstr += 4;
-         return (wstr - str);
-      }
+   if (builder->blockCount == 1 && targetArena == builder->arena) {
+      return builder->firstBlock->str;
    }
-   else
-   {
-      if (value >= 1000)
-      {
-         memcpy(str,table4[value],4);
-         return 4;
-      }
-      else if (value >= 100)
-      {
-         memcpy(str,table3[value],3);
-         return 3;
-      }
-      else if (value >= 10)
-      {
-         memcpy(str,table2[value],2);
-         return 2;
-      }
-      else
-      {
-         *(char *) str = *(char *) table1[value];
-         return 1;
-      }
+   S8 result = str_alloc(targetArena, builder->totalStringSize);
+   u64 offset = 0;
+   for (str__BuilderBlock* block = builder->firstBlock; block; block = block->next) {
+      mem_copy(result.content + offset, block->str.content, block->str.size);
+      offset += block->str.size;
    }
+   ASSERT(offset == builder->totalStringSize);
+   return result;
 }
 
-LOCAL i32 str__ufast_itoa10(i32 value, char* str) {
-  if (value < 0) { *(str++) = '-'; 
-    return str__ufast_utoa10(-value, str) + 1; 
-  }
-  else return str__ufast_utoa10(value, str);
+API S8* str_builderSpans(str_Builder* builder, Arena* arena, u32* spanCount) {
+   ASSERT(builder && "Builder is NULL");
+   ASSERT(spanCount);
+   S8* spans = mem_arenaPushArray(arena, S8, maxVal(builder->blockCount, 1));
+   u32 count = 0;
+   for (str__BuilderBlock* block = builder->firstBlock; block; block = block->next) {
+      if (block->str.size > 0) {
+         spans[count++] = block->str;
+      }
+   }
+   *spanCount = count;
+   return spans;
 }
 
+
 /////////////////
 // Parse float in str
 // this could be an alternative: https://github.com/charlesnicholson/nanoprintf/blob/bb60443d4821b86482e3c70329fc10280f1e6aa4/nanoprintf.h#L602
@@ -1573,3 +5048,459 @@ S8 str_u32ToHex(Arena* arena, u32 value) {
 
    return str_join(arena, s8("0x"), raw);
 }
+
+///////////////////////////////////////
+// Binary to text
+
+static const u8 str__hexDigits[] = "0123456789ABCDEF";
+static const u8 str__base64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+// char -> 6 bit value, 0xFF for chars outside of the alphabet
+static const u8 str__base64DecodeLut[128] = {
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+    0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+    0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+    0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+INLINE u32 str__hexValue(u8 c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    c |= 0x20;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return 0xFF;
+}
+
+INLINE u32 str__base64Value(u8 c) {
+    return c < 128 ? str__base64DecodeLut[c] : 0xFF;
+}
+
+// 8 upper case hex digits of value, most significant first: every nibble is moved to its own byte and turned into a digit
+INLINE void str__hex8(u32 value, u8* out) {
+    u64 n = (value >> 16) | (u64_cast(value & 0xFFFF) << 32);
+    n = ((n >> 8) & u64_val(0x000000FF000000FF)) | ((n & u64_val(0x000000FF000000FF)) << 16);
+    n = ((n >> 4) & u64_val(0x000F000F000F000F)) | ((n & u64_val(0x000F000F000F000F)) << 8);
+    n += u64_val(0x3030303030303030) + (((n + u64_val(0x0606060606060606)) >> 4) & u64_val(0x0101010101010101)) * 7;
+    mem_copy(out, &n, 8);
+}
+
+#if SIMD_SSE2
+// nibble values of 16 hex digits, clears lanes of valid to 0 for anything that is not a hex digit
+INLINE __m128i str__hexNibblesSse2(__m128i c, __m128i* valid) {
+    __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    __m128i letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    __m128i isDigit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    __m128i isLetter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    *valid = _mm_and_si128(*valid, _mm_or_si128(isDigit, isLetter));
+    return _mm_or_si128(_mm_and_si128(isDigit, digit), _mm_and_si128(isLetter, _mm_add_epi8(letter, _mm_set1_epi8(10))));
+}
+
+// two nibbles per 16 bit lane (first one in the low byte) to one byte per lane
+INLINE __m128i str__hexPairsSse2(__m128i nibbles) {
+    return _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0xFF)), 4), _mm_srli_epi16(nibbles, 8));
+}
+#elif SIMD_NEON
+INLINE uint8x16_t str__hexNibblesNeon(uint8x16_t c, uint8x16_t* valid) {
+    uint8x16_t digit = vsubq_u8(c, vdupq_n_u8('0'));
+    uint8x16_t letter = vsubq_u8(vorrq_u8(c, vdupq_n_u8(0x20)), vdupq_n_u8('a'));
+    uint8x16_t isDigit = vcleq_u8(digit, vdupq_n_u8(9));
+    uint8x16_t isLetter = vcleq_u8(letter, vdupq_n_u8(5));
+    *valid = vandq_u8(*valid, vorrq_u8(isDigit, isLetter));
+    return vorrq_u8(vandq_u8(isDigit, digit), vandq_u8(isLetter, vaddq_u8(letter, vdupq_n_u8(10))));
+}
+#endif
+
+API u64 str_hexEncodeInto(u8* out, S8 data) {
+    u64 idx = 0;
+#if SIMD_SSE2
+    __m128i nibble = _mm_set1_epi8(0xF);
+    __m128i nine = _mm_set1_epi8(9);
+    __m128i zeroChar = _mm_set1_epi8('0');
+    __m128i letterOffset = _mm_set1_epi8('A' - '0' - 10);
+    for (; idx + 16 <= data.size; idx += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*) (data.content + idx));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+        __m128i low = _mm_and_si128(v, nibble);
+        __m128i first = _mm_unpacklo_epi8(high, low);
+        __m128i second = _mm_unpackhi_epi8(high, low);
+        first = _mm_add_epi8(_mm_add_epi8(first, zeroChar), _mm_and_si128(_mm_cmpgt_epi8(first, nine), letterOffset));
+        second = _mm_add_epi8(_mm_add_epi8(second, zeroChar), _mm_and_si128(_mm_cmpgt_epi8(second, nine), letterOffset));
+        _mm_storeu_si128((__m128i*) (out + idx * 2), first);
+        _mm_storeu_si128((__m128i*) (out + idx * 2 + 16), second);
+    }
+#elif SIMD_NEON
+    uint8x16_t table = vld1q_u8(str__hexDigits);
+    for (; idx + 16 <= data.size; idx += 16) {
+        uint8x16_t v = vld1q_u8(data.content + idx);
+        uint8x16x2_t pair;
+        pair.val[0] = vqtbl1q_u8(table, vshrq_n_u8(v, 4));
+        pair.val[1] = vqtbl1q_u8(table, vandq_u8(v, vdupq_n_u8(0xF)));
+        vst2q_u8(out + idx * 2, pair);
+    }
+#endif
+    for (; idx < data.size; idx++) {
+        out[idx * 2] = str__hexDigits[data.content[idx] >> 4];
+        out[idx * 2 + 1] = str__hexDigits[data.content[idx] & 0xF];
+    }
+    return data.size * 2;
+}
+
+API S8 str_hexEncode(Arena* arena, S8 data) {
+    S8 result = str_alloc(arena, data.size * 2);
+    str_hexEncodeInto(result.content, data);
+    return result;
+}
+
+API bx str_hexDecode(Arena* arena, S8 hex, S8* outData) {
+    ASSERT(outData);
+    *outData = STR_NULL;
+    if (hex.size & 1) {
+        return false;
+    }
+    S8 result = str_alloc(arena, hex.size / 2);
+    u64 idx = 0;
+#if SIMD_SSE2
+    for (; idx + 32 <= hex.size; idx += 32) {
+        __m128i valid = _mm_set1_epi8(-1);
+        __m128i first = str__hexNibblesSse2(_mm_loadu_si128((const __m128i*) (hex.content + idx)), &valid);
+        __m128i second = str__hexNibblesSse2(_mm_loadu_si128((const __m128i*) (hex.content + idx + 16)), &valid);
+        if (_mm_movemask_epi8(valid) != 0xFFFF) break;
+        _mm_storeu_si128((__m128i*) (result.content + idx / 2), _mm_packus_epi16(str__hexPairsSse2(first), str__hexPairsSse2(second)));
+    }
+#elif SIMD_NEON
+    for (; idx + 32 <= hex.size; idx += 32) {
+        uint8x16_t valid = vdupq_n_u8(0xFF);
+        uint8x16x2_t chars = vld2q_u8(hex.content + idx);
+        uint8x16_t high = str__hexNibblesNeon(chars.val[0], &valid);
+        uint8x16_t low = str__hexNibblesNeon(chars.val[1], &valid);
+        if (vminvq_u8(valid) != 0xFF) break;
+        vst1q_u8(result.content + idx / 2, vorrq_u8(vshlq_n_u8(high, 4), low));
+    }
+#endif
+    // tail and the block with the invalid digit
+    for (; idx < hex.size; idx += 2) {
+        u32 high = str__hexValue(hex.content[idx]);
+        u32 low = str__hexValue(hex.content[idx + 1]);
+        if ((high | low) > 0xF) {
+            return false;
+        }
+        result.content[idx / 2] = u8_cast((high << 4) | low);
+    }
+    *outData = result;
+    return true;
+}
+
+API u64 str_base64EncodeInto(u8* out, S8 data) {
+    const u8* src = data.content;
+    const u8* end = data.content + data.size;
+    u8* dst = out;
+#if SIMD_SSSE3
+    // 12 bytes to 16 chars per step (Mula/Lemire): spread the 6 bit groups to bytes with two multiplies, then one table lookup
+    __m128i shuffle = _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10);
+    __m128i shiftLut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+    for (; end - src >= 16; src += 12, dst += 16) {
+        __m128i in = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) src), shuffle);
+        __m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+        __m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+        __m128i indices = _mm_or_si128(t0, t1);
+        __m128i lut = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        lut = _mm_or_si128(lut, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), indices), _mm_set1_epi8(13)));
+        _mm_storeu_si128((__m128i*) dst, _mm_add_epi8(indices, _mm_shuffle_epi8(shiftLut, lut)));
+    }
+#elif SIMD_NEON
+    uint8x16x4_t alphabet = vld1q_u8_x4(str__base64Alphabet);
+    uint8x16_t mask = vdupq_n_u8(0x3F);
+    for (; end - src >= 48; src += 48, dst += 64) {
+        uint8x16x3_t in = vld3q_u8(src);
+        uint8x16x4_t out;
+        out.val[0] = vqtbl4q_u8(alphabet, vshrq_n_u8(in.val[0], 2));
+        out.val[1] = vqtbl4q_u8(alphabet, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), mask));
+        out.val[2] = vqtbl4q_u8(alphabet, vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), mask));
+        out.val[3] = vqtbl4q_u8(alphabet, vandq_u8(in.val[2], mask));
+        vst4q_u8(dst, out);
+    }
+#endif
+    for (; end - src >= 3; src += 3, dst += 4) {
+        u32 triple = (u32_cast(src[0]) << 16) | (u32_cast(src[1]) << 8) | src[2];
+        dst[0] = str__base64Alphabet[(triple >> 18) & 0x3F];
+        dst[1] = str__base64Alphabet[(triple >> 12) & 0x3F];
+        dst[2] = str__base64Alphabet[(triple >> 6) & 0x3F];
+        dst[3] = str__base64Alphabet[triple & 0x3F];
+    }
+    if (end - src > 0) {
+        u32 triple = (u32_cast(src[0]) << 16) | (end - src > 1 ? u32_cast(src[1]) << 8 : 0);
+        dst[0] = str__base64Alphabet[(triple >> 18) & 0x3F];
+        dst[1] = str__base64Alphabet[(triple >> 12) & 0x3F];
+        dst[2] = end - src > 1 ? str__base64Alphabet[(triple >> 6) & 0x3F] : '=';
+        dst[3] = '=';
+        dst += 4;
+    }
+    return u64_cast(dst - out);
+}
+
+API S8 str_base64Encode(Arena* arena, S8 data) {
+    S8 result = str_alloc(arena, STR_BASE64_ENCODED_SIZE(data.size));
+    str_base64EncodeInto(result.content, data);
+    return result;
+}
+
+API bx str_base64Decode(Arena* arena, S8 text, S8* outData) {
+    ASSERT(outData);
+    *outData = STR_NULL;
+    if (text.size & 3) {
+        return false;
+    }
+    u64 padding = 0;
+    if (text.size > 0 && text.content[text.size - 1] == '=') padding++;
+    if (text.size > 1 && text.content[text.size - 2] == '=') padding++;
+    S8 result = str_alloc(arena, text.size / 4 * 3 - padding);
+    const u8* src = text.content;
+    const u8* end = text.content + text.size;
+    u8* dst = result.content;
+#if SIMD_SSSE3
+    // 16 chars to 12 bytes per step (Mula/Lemire): classify by nibbles, translate with a roll table, merge with two multiply-adds.
+    // The store writes 16 bytes, the remaining 8 chars leave at least 4 bytes of room behind the 12 decoded ones
+    __m128i lutLow = _mm_setr_epi8(0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    __m128i lutHigh = _mm_setr_epi8(0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    __m128i pack = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    __m128i nibble = _mm_set1_epi8(0xF);
+    for (; end - src >= 24; src += 16, dst += 12) {
+        __m128i in = _mm_loadu_si128((const __m128i*) src);
+        __m128i high = _mm_and_si128(_mm_srli_epi32(in, 4), nibble);
+        __m128i invalid = _mm_and_si128(_mm_shuffle_epi8(lutLow, _mm_and_si128(in, nibble)), _mm_shuffle_epi8(lutHigh, high));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, _mm_setzero_si128())) != 0xFFFF) break;
+        __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(_mm_cmpeq_epi8(in, _mm_set1_epi8('/')), high));
+        __m128i values = _mm_add_epi8(in, roll);
+        __m128i merged = _mm_madd_epi16(_mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140)), _mm_set1_epi32(0x00011000));
+        _mm_storeu_si128((__m128i*) dst, _mm_shuffle_epi8(merged, pack));
+    }
+#elif SIMD_NEON
+    uint8x16x4_t lutLow = vld1q_u8_x4(str__base64DecodeLut);
+    uint8x16x4_t lutHigh = vld1q_u8_x4(str__base64DecodeLut + 64);
+    for (; end - src > 64; src += 64, dst += 48) {
+        uint8x16x4_t in = vld4q_u8(src);
+        uint8x16x4_t values;
+        uint8x16_t bad = vdupq_n_u8(0);
+        for (u32 lane = 0; lane < 4; lane++) {
+            // chars >= 128 index past both tables and read 0, they are caught by the compare
+            uint8x16_t c = in.val[lane];
+            values.val[lane] = vorrq_u8(vqtbl4q_u8(lutLow, c), vqtbl4q_u8(lutHigh, vsubq_u8(c, vdupq_n_u8(64))));
+            bad = vorrq_u8(bad, vorrq_u8(values.val[lane], vcgeq_u8(c, vdupq_n_u8(128))));
+        }
+        if (vmaxvq_u8(bad) > 63) break;
+        uint8x16x3_t out;
+        out.val[0] = vorrq_u8(vshlq_n_u8(values.val[0], 2), vshrq_n_u8(values.val[1], 4));
+        out.val[1] = vorrq_u8(vshlq_n_u8(values.val[1], 4), vshrq_n_u8(values.val[2], 2));
+        out.val[2] = vorrq_u8(vshlq_n_u8(values.val[2], 6), values.val[3]);
+        vst3q_u8(dst, out);
+    }
+#endif
+    // tail, padding and the block with the invalid char
+    for (; src < end; src += 4) {
+        bx last = end - src == 4;
+        u32 a = str__base64Value(src[0]);
+        u32 b = str__base64Value(src[1]);
+        u32 c = last && padding >= 2 ? 0 : str__base64Value(src[2]);
+        u32 d = last && padding >= 1 ? 0 : str__base64Value(src[3]);
+        if ((a | b | c | d) > 63) {
+            return false;
+        }
+        u32 triple = (a << 18) | (b << 12) | (c << 6) | d;
+        u64 count = last ? 3 - padding : 3;
+        dst[0] = u8_cast(triple >> 16);
+        if (count > 1) dst[1] = u8_cast(triple >> 8);
+        if (count > 2) dst[2] = u8_cast(triple);
+        dst += count;
+    }
+    *outData = result;
+    return true;
+}
+
+API S8 str_cArrayLiteral(Arena* arena, S8 data, u32 elementSize, u32 elementsPerLine, S8 indent) {
+    ASSERT(elementSize == 1 || elementSize == 2 || elementSize == 4 || elementSize == 8);
+    ASSERT(data.size % elementSize == 0);
+    ASSERT(elementsPerLine > 0);
+    u64 elementCount = data.size / elementSize;
+    if (elementCount == 0) {
+        return STR_NULL;
+    }
+    // every element is "0x" + 2 digits per byte, separated by ", " or ",\n" + indent
+    u64 lineCount = (elementCount + elementsPerLine - 1) / elementsPerLine;
+    u64 size = elementCount * (2 + elementSize * 2) + (elementCount - lineCount) * 2 + (lineCount - 1) * 2 + lineCount * indent.size;
+    S8 result = str_alloc(arena, size);
+
+    u8* dst = result.content;
+    const u8* src = data.content;
+    for (u64 line = 0; line < lineCount; line++) {
+        mem_copy(dst, indent.content, indent.size);
+        dst += indent.size;
+        u64 count = minVal(elementsPerLine, elementCount - line * elementsPerLine);
+        for (u64 idx = 0; idx < count; idx++, src += elementSize) {
+            dst[0] = '0';
+            dst[1] = 'x';
+            dst += 2;
+            // little endian elements, most significant byte first
+            switch (elementSize) {
+                case 1: {
+                    dst[0] = str__hexDigits[src[0] >> 4];
+                    dst[1] = str__hexDigits[src[0] & 0xF];
+                } break;
+                case 2: {
+                    u16 value;
+                    u8 digits[8];
+                    mem_copy(&value, src, 2);
+                    str__hex8(value, digits);
+                    mem_copy(dst, digits + 4, 4);
+                } break;
+                case 4: {
+                    u32 value;
+                    mem_copy(&value, src, 4);
+                    str__hex8(value, dst);
+                } break;
+                default: {
+                    u32 value[2];
+                    mem_copy(value, src, 8);
+                    str__hex8(value[1], dst);
+                    str__hex8(value[0], dst + 8);
+                } break;
+            }
+            dst += elementSize * 2;
+            if (idx + 1 < count) {
+                dst[0] = ',';
+                dst[1] = ' ';
+                dst += 2;
+            }
+        }
+        if (line + 1 < lineCount) {
+            dst[0] = ',';
+            dst[1] = '\n';
+            dst += 2;
+        }
+    }
+    ASSERT(u64_cast(dst - result.content) == size);
+    return result;
+}
+
+////////////////////////////
+// NOTE(pjako): escaping
+
+// index of the first byte that is '"', '\\', a control char, a or b, size if there is none
+LOCAL u64 str__findEscape(const u8* ptr, u64 size, u8 a, u8 b) {
+    u64 idx = 0;
+#if SIMD_AVX2
+    __m256i quote = _mm256_set1_epi8('"');
+    __m256i backslash = _mm256_set1_epi8('\\');
+    __m256i va = _mm256_set1_epi8((char) a);
+    __m256i vb = _mm256_set1_epi8((char) b);
+    __m256i control = _mm256_set1_epi8(0x1F);
+    for (; idx + 32 <= size; idx += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*) (ptr + idx));
+        __m256i hit = _mm256_or_si256(_mm256_cmpeq_epi8(v, quote), _mm256_cmpeq_epi8(v, backslash));
+        hit = _mm256_or_si256(hit, _mm256_or_si256(_mm256_cmpeq_epi8(v, va), _mm256_cmpeq_epi8(v, vb)));
+        hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(_mm256_min_epu8(v, control), v));
+        u32 mask = (u32) _mm256_movemask_epi8(hit);
+        if (mask) return idx + u32_bitScanReverseNonZero(mask);
+    }
+#elif SIMD_SSE2
+    __m128i quote = _mm_set1_epi8('"');
+    __m128i backslash = _mm_set1_epi8('\\');
+    __m128i va = _mm_set1_epi8((char) a);
+    __m128i vb = _mm_set1_epi8((char) b);
+    __m128i control = _mm_set1_epi8(0x1F);
+    for (; idx + 32 <= size; idx += 32) {
+        __m128i v0 = _mm_loadu_si128((const __m128i*) (ptr + idx));
+        __m128i v1 = _mm_loadu_si128((const __m128i*) (ptr + idx + 16));
+        __m128i hit0 = _mm_or_si128(_mm_cmpeq_epi8(v0, quote), _mm_cmpeq_epi8(v0, backslash));
+        __m128i hit1 = _mm_or_si128(_mm_cmpeq_epi8(v1, quote), _mm_cmpeq_epi8(v1, backslash));
+        hit0 = _mm_or_si128(hit0, _mm_or_si128(_mm_cmpeq_epi8(v0, va), _mm_cmpeq_epi8(v0, vb)));
+        hit1 = _mm_or_si128(hit1, _mm_or_si128(_mm_cmpeq_epi8(v1, va), _mm_cmpeq_epi8(v1, vb)));
+        // unsigned v <= 0x1F, a signed compare would flag every utf-8 byte
+        hit0 = _mm_or_si128(hit0, _mm_cmpeq_epi8(_mm_min_epu8(v0, control), v0));
+        hit1 = _mm_or_si128(hit1, _mm_cmpeq_epi8(_mm_min_epu8(v1, control), v1));
+        u32 mask = (u32) _mm_movemask_epi8(hit0) | ((u32) _mm_movemask_epi8(hit1) << 16);
+        if (mask) return idx + u32_bitScanReverseNonZero(mask);
+    }
+#elif SIMD_NEON
+    uint8x16_t quote = vdupq_n_u8('"');
+    uint8x16_t backslash = vdupq_n_u8('\\');
+    uint8x16_t va = vdupq_n_u8(a);
+    uint8x16_t vb = vdupq_n_u8(b);
+    uint8x16_t control = vdupq_n_u8(0x1F);
+    for (; idx + 32 <= size; idx += 32) {
+        uint8x16_t v0 = vld1q_u8(ptr + idx);
+        uint8x16_t v1 = vld1q_u8(ptr + idx + 16);
+        uint8x16_t hit0 = vorrq_u8(vorrq_u8(vceqq_u8(v0, quote), vceqq_u8(v0, backslash)), vorrq_u8(vceqq_u8(v0, va), vceqq_u8(v0, vb)));
+        uint8x16_t hit1 = vorrq_u8(vorrq_u8(vceqq_u8(v1, quote), vceqq_u8(v1, backslash)), vorrq_u8(vceqq_u8(v1, va), vceqq_u8(v1, vb)));
+        hit0 = vorrq_u8(hit0, vcleq_u8(v0, control));
+        hit1 = vorrq_u8(hit1, vcleq_u8(v1, control));
+        if (vmaxvq_u8(vorrq_u8(hit0, hit1))) break;
+    }
+#endif
+    for (; idx < size; idx++) {
+        u8 c = ptr[idx];
+        if (c == '"' || c == '\\' || c <= 0x1F || c == a || c == b) break;
+    }
+    return idx;
+}
+
+LOCAL void str__recordJsonEscaped(Arena* arena, S8 str) {
+    u64 offset = 0;
+    while (offset < str.size) {
+        u64 run = str__findEscape(str.content + offset, str.size - offset, '"', '"');
+        if (run > 0) {
+            str_recordStr(arena, str_fromCharPtr(str.content + offset, run));
+            offset += run;
+        }
+        if (offset == str.size) {
+            break;
+        }
+        u8 c = str.content[offset++];
+        u8 shortForm = 0;
+        switch (c) {
+            case '"':  shortForm = '"'; break;
+            case '\\': shortForm = '\\'; break;
+            case '\n': shortForm = 'n'; break;
+            case '\r': shortForm = 'r'; break;
+            case '\t': shortForm = 't'; break;
+            case '\b': shortForm = 'b'; break;
+            case '\f': shortForm = 'f'; break;
+            default: break;
+        }
+        if (shortForm) {
+            u8* out = (u8*) mem_arenaPush(arena, 2);
+            out[0] = '\\';
+            out[1] = shortForm;
+        } else {
+            u8* out = (u8*) mem_arenaPush(arena, 6);
+            mem_copy(out, "\\u00", 4);
+            out[4] = str__hexDigits[c >> 4];
+            out[5] = str__hexDigits[c & 0xF];
+        }
+    }
+}
+
+API S8 str_escapeJson(Arena* arena, S8 str) {
+    S8 result;
+    str_record(result, arena) {
+        str__recordJsonEscaped(arena, str);
+    }
+    return result;
+}
+
+API S8 str_escapeLogfmt(Arena* arena, S8 str) {
+    S8 result;
+    str_record(result, arena) {
+        if (str.size > 0 && str__findEscape(str.content, str.size, ' ', '=') == str.size) {
+            str_recordStr(arena, str);
+        } else {
+            str_recordChar(arena, '"');
+            str__recordJsonEscaped(arena, str);
+            str_recordChar(arena, '"');
+        }
+    }
+    return result;
+}
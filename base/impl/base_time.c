@@ -3,6 +3,12 @@
 #include "base/base_math.h"
 #include "base/base_time.h"
 
+#if ARCH_X64 && COMPILER_MSVC
+#include <intrin.h>
+#elif ARCH_X64
+#include <x86intrin.h>
+#endif
+
 #if OS_WIN
 
 #else
@@ -115,13 +121,25 @@ u64 tm_currentCount(void) {
 #elif OS_APPLE
     counter = mach_absolute_time();
 #else
-    struct timeval now;
-    gettimeofday(&now, 0);
-    counter = now.tv_sec * i64_cast(1000000) + now.tv_usec;
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    counter = now.tv_sec*INT64_C(1000000000) + now.tv_nsec;
 #endif
     return counter;
 }
 
+u64 tm_cycleCount(void) {
+#if ARCH_X64
+    return __rdtsc();
+#elif ARCH_ARM64 && (COMPILER_GCC || COMPILER_CLANG)
+    u64 counter;
+    __asm__ volatile("mrs %0, cntvct_el0" : "=r"(counter));
+    return counter;
+#else
+    return tm_currentCount();
+#endif
+}
+
 tm_FrequencyInfo tm_getPerformanceFrequency(void) {
     tm_FrequencyInfo freq;
     freq.frequency = i64_val(1000000000);
@@ -144,7 +162,8 @@ tm_FrequencyInfo tm_getPerformanceFrequency(void) {
     return freq;
 }
 
-INLINE i32 tm__i64Muldiv(i64 value, i64 numer, i64 denom) {
+// value * numer / denom without overflowing the product for large counts
+INLINE i64 tm__i64Muldiv(i64 value, i64 numer, i64 denom) {
     i64 q = value / denom;
     i64 r = value % denom;
     return q * numer + r * numer / denom;
@@ -155,12 +174,13 @@ u64 tm_countToNanoseconds( tm_FrequencyInfo info, i64 count) {
 #if OS_WIN
     now = (u64) tm__i64Muldiv(count, 1000000000, info.frequency);
 #elif OS_APPLE
-    now = u64_cast(((count * i64_cast(info.numer))) / i64_cast(info.denom));
+    now = u64_cast(tm__i64Muldiv(count, i64_cast(info.numer), i64_cast(info.denom)));
 #elif OS_EMSCRIPTEN
     f64 js_now = count;
     now = u64_cast(count * info.frequency) / 1000;
 #else
-    now = count * info.frequency;
+    // counts are already in nanoseconds
+    now = u64_cast(count);
 #endif
     return now;
 }
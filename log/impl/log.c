@@ -1,71 +1,2050 @@
+#if defined(__linux__) && !defined(_POSIX_C_SOURCE)
+// fileno and fsync for the file sinks are hidden in strict c11 mode
+#define _POSIX_C_SOURCE 200809L
+#endif
 #include "base/base.h"
 #include "base/base_types.h"
 #include "base/base_mem.h"
 #include "base/base_str.h"
+#include "base/base_atomic.h"
+#include "base/base_time.h"
 #include "os/os.h"
 #include "log/log.h"
 
 #include <stdio.h>
 #include <time.h>
 
+#if OS_WIN
+#include <windows.h>
+#include <io.h>
+#define log__fileSync(FILE) _commit(_fileno(FILE))
+#else
+#include <pthread.h>
+#include <unistd.h>
+#define log__fileSync(FILE) fsync(fileno(FILE))
+#endif
+
 #ifndef PROJECT_ROOT
 #define PROJECT_ROOT ""
 #endif
 #define STRLOG_NO_COLOR
-void log__writeTimestamp(Arena* arena, log_Severity severity, S8 fileName, u64 line) {
-    log_Severity sev = clampVal(severity, log_severity_trace, log_severity_fatal);
-    S8 log__severityLevelStrings[] = {
-        str_lit("TRACE"), str_lit("DEBUG"), str_lit("INFO "), str_lit("WARN "), str_lit("ERROR"), str_lit("FATAL")
-    };
 
-    S8 log__severityLevelColors[] = {
-        str_lit("\x1b[94m"), str_lit("\x1b[36m"), str_lit("\x1b[32m"), str_lit("\x1b[33m"), str_lit("\x1b[31m"), str_lit("\x1b[35m")
+////////////////////////////
+// NOTE(pjako): sinks
+
+#define LOG__SINK_RING_DEFAULT_SIZE KILOBYTE(64)
+#define LOG__SINK_MMAP_DEFAULT_SIZE MEGABYTE(4)
+#define LOG__MMAP_MAGIC "LMAP"
+#define LOG__MMAP_VERSION 1
+#define LOG__SINK_SYNC_DEFAULT_MS 1000
+#define LOG__SINK_ROTATE_DEFAULT_COUNT 4
+#define LOG__SINK_FILE_BUFFER_SIZE KILOBYTE(64)
+#define LOG__PATH_MAX 4096
+
+// a finished text line
+typedef struct log__Line {
+    S8 text;             // timestamp prefix, message and line break
+    S8 fileName;
+    u32 line;
+    u32 messageOffset;   // size of the timestamp prefix
+    log_Severity severity;
+    bx terminated;       // text is followed by '\0' and can go to os_log as is
+} log__Line;
+
+// start of an mmap sink file, the ring follows it
+typedef struct log__MmapHeader {
+    u8 magic[4];
+    u32 version;
+    u64 capacity;        // ring bytes after the header
+    a64 written;         // bytes written in total, stored after the bytes themselves
+    u8 reserved[40];
+} log__MmapHeader;
+
+typedef struct log__Sink {
+    log_SinkType type;
+    bx active;
+    log_Severity minSeverity;
+    // file
+    FILE* file;
+    char* path;
+    u64 fileSize;
+    u64 openedNs;
+    u64 syncedNs;
+    u64 rotateSize;
+    u64 rotateIntervalNs;
+    u32 rotateCount;
+    u64 syncIntervalNs;
+    u64 lostLines;       // lines while the file could not be reopened after a rotation
+    bx dirty;
+    // ring, mmap
+    u8* ring;
+    u64 ringCapacity;
+    u64 ringWritten;     // bytes written in total
+    os_FileMap map;
+    log__MmapHeader* mmapHeader;
+    // callback
+    log_callbackFn* callback;
+    void* user;
+} log__Sink;
+
+typedef struct log__Sinks {
+    a32 state;           // 0 = not initialized, 1 = initializing, 2 = ready
+    os_Mutex lock;
+    Arena* arena;        // paths and rings, guarded by lock
+    i32 callbackSink;    // sink of log_setCallback
+    log__Sink sinks[LOG_SINK_MAX];
+} log__Sinks;
+
+static log__Sinks log__sinks;
+// set while the thread runs a callback sink and holds the sinks lock, lines it logs are written on the spot
+static THREAD_LOCAL bx log__inCallback;
+
+LOCAL u64 log__unixNs(void) {
+    struct timespec spec;
+    timespec_get(&spec, TIME_UTC);
+    return u64_cast(spec.tv_sec) * 1000000000 + u64_cast(spec.tv_nsec);
+}
+
+LOCAL void log__sinksInit(void) {
+    if (a32_loadAcquire(&log__sinks.state) == 2) {
+        return;
+    }
+    if (a32_compareAndSwap(&log__sinks.state, 0, 1) == 0) {
+        BaseMemory baseMem = os_getBaseMemory();
+        log__sinks.arena = mem_makeArena(&baseMem, GIGABYTE(1));
+        os_mutexInit(&log__sinks.lock);
+        log__sinks.callbackSink = -1;
+        log__sinks.sinks[0].type = log_sinkType_console;
+        log__sinks.sinks[0].minSeverity = log_severity_trace;
+        log__sinks.sinks[0].active = true;
+        a32_storeRelease(&log__sinks.state, 2);
+    }
+    while (a32_loadAcquire(&log__sinks.state) != 2) {
+        os_yield();
+    }
+}
+
+// the message without timestamp prefix and line break
+LOCAL S8 log__lineMessage(log__Line* line) {
+    S8 message = str_from(line->text, line->messageOffset);
+    while (message.size > 0 && (message.content[message.size - 1] == '\n' || message.content[message.size - 1] == '\r')) {
+        message.size--;
+    }
+    return message;
+}
+
+LOCAL bx log__sinkOpen(log__Sink* sink, u64 now) {
+    sink->file = fopen(sink->path, "ab");
+    if (!sink->file) {
+        return false;
+    }
+    setvbuf(sink->file, NULL, _IOFBF, LOG__SINK_FILE_BUFFER_SIZE);
+    fseek(sink->file, 0, SEEK_END);
+    sink->fileSize = u64_cast(maxVal(ftell(sink->file), 0));
+    sink->openedNs = now;
+    sink->syncedNs = now;
+    return true;
+}
+
+LOCAL void log__sinkSync(log__Sink* sink, u64 now) {
+    fflush(sink->file);
+    log__fileSync(sink->file);
+    sink->syncedNs = now;
+    sink->dirty = false;
+}
+
+// only renames, compressing or deleting the old files is left to whoever collects them
+LOCAL void log__sinkRotate(log__Sink* sink, u64 now) {
+    log__sinkSync(sink, now);
+    fclose(sink->file);
+    sink->file = NULL;
+    char from[LOG__PATH_MAX + 16];
+    char to[LOG__PATH_MAX + 16];
+    for (u32 idx = sink->rotateCount; idx > 0; idx--) {
+        if (idx == 1) {
+            snprintf(from, sizeof(from), "%s", sink->path);
+        } else {
+            snprintf(from, sizeof(from), "%s.%u", sink->path, idx - 1);
+        }
+        snprintf(to, sizeof(to), "%s.%u", sink->path, idx);
+#if OS_WIN
+        // rename does not replace existing files on windows
+        remove(to);
+#endif
+        rename(from, to);
+    }
+    if (!log__sinkOpen(sink, now)) {
+        fprintf(stderr, "log: could not reopen %s after rotating, retrying on the next write\n", sink->path);
+    }
+}
+
+// retried on every write after a failed rotation, the first line in the file tells how many lines are missing
+LOCAL bx log__sinkReopen(log__Sink* sink, u64 now) {
+    if (!log__sinkOpen(sink, now)) {
+        return false;
+    }
+    if (sink->lostLines > 0) {
+        char note[96];
+        i32 size = snprintf(note, sizeof(note), "log: file could not be reopened, lost %llu lines\r\n", (unsigned long long) sink->lostLines);
+        u64 noteSize = u64_cast(clampVal(0, i32_cast(sizeof(note)) - 1, size));
+        fwrite(note, noteSize, 1, sink->file);
+        sink->fileSize += noteSize;
+        sink->dirty = true;
+        sink->lostLines = 0;
+    }
+    return true;
+}
+
+LOCAL void log__sinkWrite(log__Sink* sink, log__Line* lines, u32 count, u64 now) {
+    switch (sink->type) {
+        case log_sinkType_console: {
+            if (count == 1 && lines[0].terminated) {
+                // os_log also reaches the debugger output on windows, it needs the terminator
+                if (lines[0].severity >= sink->minSeverity) {
+                    os_log(str_fromCharPtr(lines[0].text.content, lines[0].text.size + 1));
+                }
+                break;
+            }
+            S8 spans[256];
+            u32 spanCount = 0;
+            for (u32 idx = 0; idx < count; idx++) {
+                if (lines[idx].severity < sink->minSeverity) {
+                    continue;
+                }
+                spans[spanCount++] = lines[idx].text;
+                if (spanCount == countOf(spans)) {
+                    os_logSpans(spans, spanCount);
+                    spanCount = 0;
+                }
+            }
+            if (spanCount > 0) {
+                os_logSpans(spans, spanCount);
+            }
+        } break;
+        case log_sinkType_stderr: {
+            for (u32 idx = 0; idx < count; idx++) {
+                if (lines[idx].severity >= sink->minSeverity) {
+                    fwrite(lines[idx].text.content, lines[idx].text.size, 1, stderr);
+                }
+            }
+        } break;
+        case log_sinkType_file: {
+            bx fileOpen = sink->file || log__sinkReopen(sink, now);
+            for (u32 idx = 0; idx < count; idx++) {
+                log__Line* line = lines + idx;
+                if (line->severity < sink->minSeverity) {
+                    continue;
+                }
+                if (!fileOpen) {
+                    sink->lostLines++;
+                    continue;
+                }
+                bx full = sink->rotateSize > 0 && sink->fileSize > 0 && sink->fileSize + line->text.size > sink->rotateSize;
+                bx old = sink->rotateIntervalNs > 0 && now - sink->openedNs >= sink->rotateIntervalNs;
+                if (full || old) {
+                    log__sinkRotate(sink, now);
+                    if (!sink->file) {
+                        fileOpen = false;
+                        sink->lostLines++;
+                        continue;
+                    }
+                }
+                fwrite(line->text.content, line->text.size, 1, sink->file);
+                sink->fileSize += line->text.size;
+                sink->dirty = true;
+            }
+        } break;
+        case log_sinkType_ring:
+        case log_sinkType_mmap: {
+            for (u32 idx = 0; idx < count; idx++) {
+                S8 text = lines[idx].text;
+                if (lines[idx].severity < sink->minSeverity) {
+                    continue;
+                }
+                if (text.size > sink->ringCapacity) {
+                    text = str_from(text, text.size - sink->ringCapacity);
+                }
+                u64 pos = sink->ringWritten % sink->ringCapacity;
+                u64 first = minVal(text.size, sink->ringCapacity - pos);
+                mem_copy(sink->ring + pos, text.content, first);
+                mem_copy(sink->ring, text.content + first, text.size - first);
+                sink->ringWritten += text.size;
+            }
+            if (sink->mmapHeader) {
+                a64_storeRelease(&sink->mmapHeader->written, sink->ringWritten);
+            }
+        } break;
+        case log_sinkType_callback: {
+            for (u32 idx = 0; idx < count; idx++) {
+                log__Line* line = lines + idx;
+                if (line->severity >= sink->minSeverity) {
+                    log__inCallback = true;
+                    sink->callback(line->severity, line->fileName, line->line, log__lineMessage(line), sink->user);
+                    log__inCallback = false;
+                }
+            }
+        } break;
+    }
+}
+
+// sinks lock has to be held
+LOCAL void log__sinksSync(u64 now, bx force) {
+    for (u32 idx = 0; idx < LOG_SINK_MAX; idx++) {
+        log__Sink* sink = log__sinks.sinks + idx;
+        if (sink->active && sink->file && sink->dirty && (force || now - sink->syncedNs >= sink->syncIntervalNs)) {
+            log__sinkSync(sink, now);
+        }
+        if (sink->active && sink->mmapHeader && force) {
+            os_fileMapSync(&sink->map);
+        }
+    }
+}
+
+LOCAL void log__sinksWrite(log__Line* lines, u32 count) {
+    log__sinksInit();
+    u64 now = log__unixNs();
+    os_mutexScoped(&log__sinks.lock) {
+        for (u32 idx = 0; idx < LOG_SINK_MAX; idx++) {
+            if (log__sinks.sinks[idx].active) {
+                log__sinkWrite(log__sinks.sinks + idx, lines, count, now);
+            }
+        }
+        log__sinksSync(now, false);
+    }
+}
+
+// a line logged by a callback sink: the lock is already held and a full ring would wait for the writer that runs the callback,
+// the callback sinks are skipped so a callback can not recurse
+LOCAL void log__sinksWriteFromCallback(log__Line* line) {
+    u64 now = log__unixNs();
+    for (u32 idx = 0; idx < LOG_SINK_MAX; idx++) {
+        log__Sink* sink = log__sinks.sinks + idx;
+        if (sink->active && sink->type != log_sinkType_callback) {
+            log__sinkWrite(sink, line, 1, now);
+        }
+    }
+}
+
+// flushes file sinks that waited for longer than their interval, force flushes all of them
+LOCAL void log__sinksTick(bx force) {
+    log__sinksInit();
+    u64 now = log__unixNs();
+    os_mutexScoped(&log__sinks.lock) {
+        log__sinksSync(now, force);
+    }
+}
+
+// maps the file and continues its ring if it was written with the same size, starts a new one otherwise
+LOCAL bx log__sinkMapOpen(log__Sink* sink, log_SinkDesc* desc) {
+    u64 capacity = desc->ringSize ? desc->ringSize : LOG__SINK_MMAP_DEFAULT_SIZE;
+    if (!os_fileMapOpen(&sink->map, desc->fileName, sizeof(log__MmapHeader) + capacity)) {
+        return false;
+    }
+    log__MmapHeader* header = (log__MmapHeader*) sink->map.content;
+    if (!str_isEqual(str_fromCharPtr(header->magic, sizeof(header->magic)), s8(LOG__MMAP_MAGIC)) || header->version != LOG__MMAP_VERSION || header->capacity != capacity) {
+        mem_setZero(header, sizeof(log__MmapHeader));
+        mem_copy(header->magic, LOG__MMAP_MAGIC, sizeof(header->magic));
+        header->version = LOG__MMAP_VERSION;
+        header->capacity = capacity;
+    }
+    sink->mmapHeader = header;
+    sink->ring = sink->map.content + sizeof(log__MmapHeader);
+    sink->ringCapacity = capacity;
+    sink->ringWritten = header->written;
+    return true;
+}
+
+// sinks lock has to be held
+LOCAL i32 log__sinkAddLocked(log_SinkDesc* desc, u64 now) {
+    i32 result = -1;
+    for (i32 idx = 0; idx < LOG_SINK_MAX && result == -1; idx++) {
+        if (!log__sinks.sinks[idx].active) {
+            result = idx;
+        }
+    }
+    if (result != -1) {
+        log__Sink* sink = log__sinks.sinks + result;
+        mem_structSetZero(sink);
+        sink->type = desc->type;
+        sink->minSeverity = desc->minSeverity;
+        if (desc->type == log_sinkType_file) {
+            u64 pathSize = minVal(desc->fileName.size, LOG__PATH_MAX - 1);
+            sink->path = (char*) mem_arenaPush(log__sinks.arena, pathSize + 1);
+            mem_copy(sink->path, desc->fileName.content, pathSize);
+            sink->path[pathSize] = '\0';
+            sink->rotateSize = desc->rotateSize;
+            sink->rotateIntervalNs = u64_cast(desc->rotateIntervalSec) * 1000000000;
+            sink->rotateCount = desc->rotateCount ? desc->rotateCount : LOG__SINK_ROTATE_DEFAULT_COUNT;
+            sink->syncIntervalNs = u64_cast(desc->syncIntervalMs ? desc->syncIntervalMs : LOG__SINK_SYNC_DEFAULT_MS) * 1000000;
+            if (!log__sinkOpen(sink, now)) {
+                result = -1;
+            }
+        } else if (desc->type == log_sinkType_ring) {
+            sink->ringCapacity = desc->ringSize ? desc->ringSize : LOG__SINK_RING_DEFAULT_SIZE;
+            sink->ring = (u8*) mem_arenaPush(log__sinks.arena, sink->ringCapacity);
+        } else if (desc->type == log_sinkType_mmap) {
+            if (!log__sinkMapOpen(sink, desc)) {
+                result = -1;
+            }
+        } else if (desc->type == log_sinkType_callback) {
+            sink->callback = desc->callback;
+            sink->user = desc->user;
+        }
+        sink->active = result != -1;
+    }
+    return result;
+}
+
+// sinks lock has to be held
+LOCAL void log__sinkRemoveLocked(i32 sink, u64 now) {
+    log__Sink* entry = log__sinks.sinks + sink;
+    if (entry->active && entry->file) {
+        log__sinkSync(entry, now);
+        fclose(entry->file);
+        entry->file = NULL;
+    }
+    if (entry->active && entry->mmapHeader) {
+        os_fileMapClose(&entry->map);
+        entry->mmapHeader = NULL;
+        entry->ring = NULL;
+    }
+    // path and ring memory stay in the arena
+    entry->active = false;
+}
+
+API i32 log_sinkAdd(log_SinkDesc* desc) {
+    ASSERT(desc);
+    ASSERT((desc->type != log_sinkType_file && desc->type != log_sinkType_mmap) || desc->fileName.size > 0);
+    ASSERT(desc->type != log_sinkType_callback || desc->callback);
+    log__sinksInit();
+    u64 now = log__unixNs();
+    i32 result = -1;
+    os_mutexScoped(&log__sinks.lock) {
+        result = log__sinkAddLocked(desc, now);
+    }
+    return result;
+}
+
+API void log_sinkRemove(i32 sink) {
+    ASSERT(sink >= 0 && sink < LOG_SINK_MAX);
+    log__sinksInit();
+    u64 now = log__unixNs();
+    os_mutexScoped(&log__sinks.lock) {
+        log__sinkRemoveLocked(sink, now);
+    }
+}
+
+API void log_sinkSetSeverity(i32 sink, log_Severity minSeverity) {
+    ASSERT(sink >= 0 && sink < LOG_SINK_MAX);
+    log__sinksInit();
+    os_mutexScoped(&log__sinks.lock) {
+        log__sinks.sinks[sink].minSeverity = minSeverity;
+    }
+}
+
+// the ring content oldest first, starting at the first complete line
+LOCAL S8 log__ringCopy(Arena* arena, u8* ring, u64 capacity, u64 written) {
+    u64 size = minVal(written, capacity);
+    u64 pos = (written - size) % capacity;
+    u64 first = minVal(size, capacity - pos);
+    S8 result = str_alloc(arena, size);
+    mem_copy(result.content, ring + pos, first);
+    mem_copy(result.content + first, ring, size - first);
+    if (written > capacity) {
+        // the oldest line was partly overwritten
+        i64 lineEnd = str_findChar(result, '\n');
+        result = lineEnd >= 0 ? str_from(result, u64_cast(lineEnd) + 1) : STR_NULL;
+    }
+    return result;
+}
+
+API S8 log_sinkRingRead(Arena* arena, i32 sink) {
+    ASSERT(sink >= 0 && sink < LOG_SINK_MAX);
+    log__sinksInit();
+    S8 result = STR_NULL;
+    os_mutexScoped(&log__sinks.lock) {
+        log__Sink* entry = log__sinks.sinks + sink;
+        if (entry->active && entry->ring && (entry->type == log_sinkType_ring || entry->type == log_sinkType_mmap)) {
+            result = log__ringCopy(arena, entry->ring, entry->ringCapacity, entry->ringWritten);
+        }
+    }
+    return result;
+}
+
+API S8 log_mmapDecode(Arena* arena, S8 data) {
+    log__MmapHeader header;
+    if (data.size < sizeof(header)) {
+        return STR_NULL;
+    }
+    mem_copy(&header, data.content, sizeof(header));
+    if (!str_isEqual(str_fromCharPtr(header.magic, sizeof(header.magic)), s8(LOG__MMAP_MAGIC)) || header.version != LOG__MMAP_VERSION ||
+        header.capacity == 0 || header.capacity > data.size - sizeof(header)) {
+        return STR_NULL;
+    }
+    return log__ringCopy(arena, data.content + sizeof(header), header.capacity, header.written);
+}
+
+API void log_setCallback(log_callbackFn* callback, void* user) {
+    log__sinksInit();
+    u64 now = log__unixNs();
+    // concurrent calls must not remove the same sink twice or leak one
+    os_mutexScoped(&log__sinks.lock) {
+        if (log__sinks.callbackSink >= 0) {
+            log__sinkRemoveLocked(log__sinks.callbackSink, now);
+            log__sinks.callbackSink = -1;
+        }
+        if (callback) {
+            log_SinkDesc desc;
+            mem_structSetZero(&desc);
+            desc.type = log_sinkType_callback;
+            desc.callback = callback;
+            desc.user = user;
+            log__sinks.callbackSink = log__sinkAddLocked(&desc, now);
+        }
+    }
+}
+
+////////////////////////////
+// NOTE(pjako): async output, one single producer ring per thread. A record is its size (u32) followed by the
+// log__RecordHeader and the line, padded to 8 bytes. A record never wraps around, the space at the end of the ring
+// is skipped with a wrap marker.
+// The ring of an exited thread goes to a free list and the next new thread continues writing into it, the writer
+// keeps draining it in the meantime.
+
+#define LOG__RING_WRAP 0xFFFFFFFFu
+#define LOG__RING_BINARY 0x80000000u // size flag, the record goes into the .blog file
+#define LOG__RING_DEFAULT_SIZE MEGABYTE(1)
+#define LOG__FLUSH_DEFAULT_MS 10
+
+typedef struct log__Ring {
+    struct log__Ring* next;
+    struct log__Ring* nextFree; // guarded by log__async.lock
+    u8* data;
+    u64 capacity;
+    a32 owned;                  // a thread writes into the ring, cleared when the thread exits
+    ALIGN_DECL(64, a64 head); // written by the owning thread
+    u64 reserveHead;          // head after the reserved record
+    u64 reserveUsed;          // fill level after the reserved record
+    ALIGN_DECL(64, a64 tail); // written by the writer
+    a64 dropped;
+    u64 droppedReported;
+} log__Ring;
+
+// everything of a log__Line but the text, the file name is a literal and outlives the record
+typedef struct log__RecordHeader {
+    const u8* fileName;
+    u32 fileNameSize;
+    u32 line;
+    u32 messageOffset;
+    u32 severity;
+} log__RecordHeader;
+
+typedef struct log__Async {
+    a32 running;
+    a32 stopping;
+    log_AsyncPolicy policy;
+    u64 ringSize;
+    u32 flushIntervalMs;
+    os_Mutex lock;
+    Arena* arena;       // rings and binary sites, guarded by lock
+    log__Ring* rings;   // new rings are prepended under lock, next pointers never change afterwards
+    log__Ring* freeRings; // rings of exited threads, guarded by lock
+#if OS_WIN
+    DWORD threadExitKey;
+#else
+    pthread_key_t threadExitKey;
+#endif
+    bx threadExitHook;
+    os_Semaphore wake;
+    os_Thread writer;
+} log__Async;
+
+static log__Async log__async;
+static THREAD_LOCAL log__Ring* log__threadRing;
+
+LOCAL void log__binaryWriteRecord(u8* record, u32 size);
+LOCAL str_FmtProgram* log__sitePrepare(log_FmtSite* site, S8 template);
+LOCAL void log__rateFlush(void);
+
+LOCAL log__Ring* log__ringsHead(void) {
+    log__Ring* rings;
+    os_mutexScoped(&log__async.lock) {
+        rings = log__async.rings;
+    }
+    return rings;
+}
+
+LOCAL void log__ringRelease(log__Ring* ring) {
+    os_mutexScoped(&log__async.lock) {
+        a32_storeRelease(&ring->owned, 0);
+        ring->nextFree = log__async.freeRings;
+        log__async.freeRings = ring;
+    }
+}
+
+// runs when a thread that owns a ring exits
+#if OS_WIN
+LOCAL void NTAPI log__threadExit(void* ring) {
+#else
+LOCAL void log__threadExit(void* ring) {
+#endif
+    if (ring) {
+        log__threadRing = NULL;
+        log__ringRelease((log__Ring*) ring);
+    }
+}
+
+LOCAL void log__threadExitHookInit(void) {
+#if OS_WIN
+    log__async.threadExitKey = FlsAlloc(log__threadExit);
+    log__async.threadExitHook = log__async.threadExitKey != FLS_OUT_OF_INDEXES;
+#else
+    log__async.threadExitHook = pthread_key_create(&log__async.threadExitKey, log__threadExit) == 0;
+#endif
+}
+
+LOCAL void log__threadExitHookSet(log__Ring* ring) {
+    if (!log__async.threadExitHook) {
+        return;
+    }
+#if OS_WIN
+    FlsSetValue(log__async.threadExitKey, ring);
+#else
+    pthread_setspecific(log__async.threadExitKey, ring);
+#endif
+}
+
+// NULL if there is no memory left for another ring, the line has to be written synchronously
+LOCAL log__Ring* log__ringGet(void) {
+    log__Ring* ring = log__threadRing;
+    if (ring) {
+        return ring;
+    }
+    os_mutexScoped(&log__async.lock) {
+        // a ring of an earlier log_asyncStart can have a different size
+        log__Ring** link = &log__async.freeRings;
+        while (*link && (*link)->capacity != log__async.ringSize) {
+            link = &(*link)->nextFree;
+        }
+        ring = *link;
+        if (ring) {
+            *link = ring->nextFree;
+            ring->nextFree = NULL;
+        } else {
+            u64 pos = log__async.arena->pos;
+            ring = (log__Ring*) mem_arenaPush(log__async.arena, sizeof(log__Ring));
+            u8* data = ring ? (u8*) mem_arenaPush(log__async.arena, log__async.ringSize) : NULL;
+            if (data) {
+                mem_structSetZero(ring);
+                ring->capacity = log__async.ringSize;
+                ring->data = data;
+                ring->next = log__async.rings;
+                log__async.rings = ring;
+            } else {
+                mem_arenaPopTo(log__async.arena, pos);
+                ring = NULL;
+            }
+        }
+        if (ring) {
+            ASSERT(!ring->owned);
+            a32_storeRelease(&ring->owned, 1);
+        }
+    }
+    if (ring) {
+        log__threadRing = ring;
+        log__threadExitHookSet(ring);
+    }
+    return ring;
+}
+
+// larger records would stall the thread until the ring is almost empty
+INLINE bx log__ringFits(log__Ring* ring, u64 size) {
+    return alignUp(sizeof(u32) + size, 8) <= ring->capacity / 4;
+}
+
+// returns the memory of the record, NULL if the ring is full and the line is dropped
+LOCAL u8* log__ringReserve(log__Ring* ring, u64 size, u32 flags) {
+    u64 need = alignUp(sizeof(u32) + size, 8);
+    u64 head = ring->head;
+    u64 pos = head & (ring->capacity - 1);
+    u64 pad = pos + need > ring->capacity ? ring->capacity - pos : 0;
+    u64 used;
+    for (;;) {
+        used = head - a64_loadAcquire(&ring->tail);
+        if (used + pad + need <= ring->capacity) {
+            break;
+        }
+        if (log__async.policy == log_asyncPolicy_drop) {
+            a64_storeRelease(&ring->dropped, ring->dropped + 1);
+            return NULL;
+        }
+        os_semaphorePost(&log__async.wake, 1);
+        os_yield();
+    }
+    if (pad > 0) {
+        *(u32*) (ring->data + pos) = LOG__RING_WRAP;
+        pos = 0;
+    }
+    *(u32*) (ring->data + pos) = u32_cast(size) | flags;
+    ring->reserveHead = head + pad + need;
+    ring->reserveUsed = used + pad + need;
+    return ring->data + pos + sizeof(u32);
+}
+
+LOCAL void log__ringCommit(log__Ring* ring, log_Severity severity) {
+    u64 added = ring->reserveHead - ring->head;
+    a64_storeRelease(&ring->head, ring->reserveHead);
+    // the writer wakes up on its own every flush interval, only errors and a filling ring wake it early
+    u64 half = ring->capacity / 2;
+    if (severity >= log_severity_error || (ring->reserveUsed - added < half && ring->reserveUsed >= half)) {
+        os_semaphorePost(&log__async.wake, 1);
+    }
+}
+
+LOCAL void log__ringDrain(log__Ring* ring) {
+    log__Line lines[256];
+    u64 mask = ring->capacity - 1;
+    u64 tail = ring->tail;
+    u64 head = a64_loadAcquire(&ring->head);
+    while (tail < head) {
+        u32 count = 0;
+        u64 end = tail;
+        while (end < head && count < countOf(lines)) {
+            u64 pos = end & mask;
+            u32 size = *(u32*) (ring->data + pos);
+            if (size == LOG__RING_WRAP) {
+                end += ring->capacity - pos;
+                continue;
+            }
+            u8* record = ring->data + pos + sizeof(u32);
+            if (size & LOG__RING_BINARY) {
+                size &= ~LOG__RING_BINARY;
+                log__binaryWriteRecord(record, size);
+            } else {
+                log__RecordHeader header;
+                mem_copy(&header, record, sizeof(header));
+                log__Line* line = lines + count++;
+                line->text = str_fromCharPtr(record + sizeof(header), size - sizeof(header));
+                line->fileName = str_fromCharPtr((u8*) header.fileName, header.fileNameSize);
+                line->line = header.line;
+                line->messageOffset = header.messageOffset;
+                line->severity = (log_Severity) header.severity;
+                line->terminated = false;
+            }
+            end += alignUp(sizeof(u32) + size, 8);
+        }
+        if (count > 0) {
+            log__sinksWrite(lines, count);
+        }
+        a64_storeRelease(&ring->tail, end);
+        tail = end;
+    }
+    u64 dropped = a64_loadAcquire(&ring->dropped);
+    if (dropped != ring->droppedReported) {
+        u8 buffer[64];
+        S8 prefix = str_lit("log: ring full, dropped ");
+        S8 suffix = str_lit(" lines\r\n");
+        mem_copy(buffer, prefix.content, prefix.size);
+        u64 size = prefix.size + str_u64ToChars(dropped - ring->droppedReported, buffer + prefix.size);
+        mem_copy(buffer + size, suffix.content, suffix.size);
+        log__Line line;
+        mem_structSetZero(&line);
+        line.text = str_fromCharPtr(buffer, size + suffix.size);
+        line.severity = log_severity_warning;
+        log__sinksWrite(&line, 1);
+        ring->droppedReported = dropped;
+    }
+}
+
+// false if the line has to be written synchronously
+LOCAL bx log__asyncPush(log__Line* line) {
+    log__Ring* ring = log__ringGet();
+    if (!ring) {
+        return false;
+    }
+    u64 size = sizeof(log__RecordHeader) + line->text.size;
+    if (!log__ringFits(ring, size)) {
+        // keeps the order of the thread, a line this large is rare
+        log_flush();
+        return false;
+    }
+    u8* record = log__ringReserve(ring, size, 0);
+    if (record) {
+        log__RecordHeader header;
+        header.fileName = line->fileName.content;
+        header.fileNameSize = u32_cast(line->fileName.size);
+        header.line = line->line;
+        header.messageOffset = line->messageOffset;
+        header.severity = line->severity;
+        mem_copy(record, &header, sizeof(header));
+        mem_copy(record + sizeof(header), line->text.content, line->text.size);
+        log__ringCommit(ring, line->severity);
+    }
+    return true;
+}
+
+////////////////////////////
+// NOTE(pjako): binary output
+// The file starts with LOG__BINARY_MAGIC and the version, followed by records: u32 size, u8 kind and the payload.
+//  clock:      u64 cycles, u64 unix time in ns, sampled together so the decoder can map cycles to time
+//  descriptor: u32 id, u32 line, u8 severity, u32 size + file name, u32 size + template
+//  message:    u32 id, u64 cycles, u8 argCount, arguments
+// An argument is its str_argType (high bit set if a key follows as u16 size + bytes) and the value:
+// strings are u32 size + bytes, everything else the raw bytes of the str_Value member.
+
+#define LOG__BINARY_MAGIC "BLOG"
+#define LOG__BINARY_VERSION 1
+#define LOG__BINARY_KEYED 0x80
+
+typedef enum log__binaryKind {
+    log__binaryKind_clock      = 1,
+    log__binaryKind_descriptor = 2,
+    log__binaryKind_message    = 3,
+} log__binaryKind;
+
+typedef struct log__BinarySite {
+    S8 fileName;
+    S8 template;
+    u32 line;
+    u8 severity;
+} log__BinarySite;
+
+typedef struct log__Binary {
+    a32 running;
+    os_Mutex lock;           // file and sitesWritten, held by the writer while it drains
+    FILE* file;
+    u32 sitesWritten;        // descriptors in the current file
+    u32 clockCount;          // clock records in the current file
+    u64 clockLastNs;
+    log__BinarySite* sites;  // index is id - 1, guarded by log__async.lock
+    u32 siteCount;
+    u32 siteCapacity;
+} log__Binary;
+
+static log__Binary log__binary;
+
+// bytes of the str_Value member for every str_argType, strings are handled separately
+static const u8 log__binaryValueSizes[] = {
+    0, // custom, written as string
+    0, // str
+    sizeof(char),
+    sizeof(f32),
+    sizeof(f64),
+    sizeof(u32),
+    sizeof(u64),
+    sizeof(i32),
+    sizeof(i64),
+};
+
+INLINE u8* log__put(u8* at, const void* value, u64 size) {
+    mem_copy(at, value, size);
+    return at + size;
+}
+
+// binary lock has to be held
+LOCAL void log__binaryWriteClock(bx force) {
+    u64 ns = log__unixNs();
+    // the rate needs two samples, the second one is taken soon after the start
+    u64 interval = log__binary.clockCount < 2 ? 10000000 : 1000000000;
+    if (!force && ns - log__binary.clockLastNs < interval) {
+        return;
+    }
+    u8 record[sizeof(u32) + 1 + 2 * sizeof(u64)];
+    u32 size = sizeof(record) - sizeof(u32);
+    u8 kind = log__binaryKind_clock;
+    u64 cycles = tm_cycleCount();
+    u8* at = log__put(record, &size, sizeof(size));
+    at = log__put(at, &kind, 1);
+    at = log__put(at, &cycles, sizeof(cycles));
+    log__put(at, &ns, sizeof(ns));
+    fwrite(record, sizeof(record), 1, log__binary.file);
+    log__binary.clockCount++;
+    log__binary.clockLastNs = ns;
+}
+
+// binary lock has to be held
+LOCAL void log__binaryWriteDescriptors(void) {
+    os_mutexScoped(&log__async.lock) {
+        for (; log__binary.sitesWritten < log__binary.siteCount; log__binary.sitesWritten++) {
+            log__BinarySite* site = log__binary.sites + log__binary.sitesWritten;
+            u32 id = log__binary.sitesWritten + 1;
+            u32 fileSize = u32_cast(site->fileName.size);
+            u32 templateSize = u32_cast(site->template.size);
+            u32 size = 1 + 2 * sizeof(u32) + 1 + sizeof(u32) + fileSize + sizeof(u32) + templateSize;
+            u8 header[sizeof(u32) + 1 + 2 * sizeof(u32) + 1];
+            u8 kind = log__binaryKind_descriptor;
+            u8* at = log__put(header, &size, sizeof(size));
+            at = log__put(at, &kind, 1);
+            at = log__put(at, &id, sizeof(id));
+            at = log__put(at, &site->line, sizeof(site->line));
+            log__put(at, &site->severity, 1);
+            fwrite(header, sizeof(header), 1, log__binary.file);
+            fwrite(&fileSize, sizeof(fileSize), 1, log__binary.file);
+            fwrite(site->fileName.content, fileSize, 1, log__binary.file);
+            fwrite(&templateSize, sizeof(templateSize), 1, log__binary.file);
+            fwrite(site->template.content, templateSize, 1, log__binary.file);
+        }
+    }
+}
+
+// called by the writer with the binary lock held
+LOCAL void log__binaryWriteRecord(u8* record, u32 size) {
+    if (!log__binary.file) {
+        return;
+    }
+    u32 id;
+    mem_copy(&id, record + 1, sizeof(id));
+    if (id > log__binary.sitesWritten) {
+        // the site was registered before the record was pushed, so it is visible here
+        log__binaryWriteDescriptors();
+    }
+    fwrite(&size, sizeof(size), 1, log__binary.file);
+    fwrite(record, size, 1, log__binary.file);
+}
+
+LOCAL u32 log__binaryRegister(log_FmtSite* site, log_Severity severity, S8 fileName, u64 line, S8 template) {
+    u32 id = a32_loadAcquire(&site->binaryId);
+    if (id != 0) {
+        return id;
+    }
+    os_mutexScoped(&log__async.lock) {
+        id = site->binaryId;
+        if (id == 0) {
+            if (log__binary.siteCount == log__binary.siteCapacity) {
+                // the old array stays in the arena, sites are registered once per call site
+                u32 capacity = maxVal(64, log__binary.siteCapacity * 2);
+                log__BinarySite* sites = mem_arenaPushArray(log__async.arena, log__BinarySite, capacity);
+                if (log__binary.siteCount > 0) {
+                    mem_copy(sites, log__binary.sites, sizeof(log__BinarySite) * log__binary.siteCount);
+                }
+                log__binary.sites = sites;
+                log__binary.siteCapacity = capacity;
+            }
+            S8 projectRootPath = str_lit(PROJECT_ROOT "/");
+            log__BinarySite* entry = log__binary.sites + log__binary.siteCount;
+            entry->fileName = str_subStr(fileName, projectRootPath.size, fileName.size - projectRootPath.size);
+            entry->template = template;
+            entry->line = u32_cast(line);
+            entry->severity = u8_cast(severity);
+            id = ++log__binary.siteCount;
+            a32_storeRelease(&site->binaryId, id);
+        }
+    }
+    return id;
+}
+
+// false if the message has to be written as text
+LOCAL bx log__binaryPush(Arena* mem, log_Severity severity, log_FmtSite* site, S8 fileName, u64 line, S8 template, u32 argCount, va_list list) {
+    u64 cycles = tm_cycleCount();
+    // only literal templates have a stable descriptor
+    if (argCount > 255 || !log__sitePrepare(site, template)) {
+        return false;
+    }
+    u32 id = log__binaryRegister(site, severity, fileName, line, template);
+    bx result = true;
+    mem_scoped(scratch, mem) {
+        str_KeyValue* args = mem_arenaPushArray(scratch.arena, str_KeyValue, (argCount + 1));
+        u64 size = 1 + sizeof(u32) + sizeof(u64) + 1;
+        for (u32 idx = 0; idx < argCount; idx++) {
+            str_KeyValue arg = va_arg(list, str_KeyValue);
+            if (arg.value.type == str_argType_custom) {
+                // the user pointer is gone by the time the record is decoded, its text is stored instead
+                S8 text;
+                str_record(text, scratch.arena) {
+                    arg.value.customVal.buildStrFn(scratch.arena, STR_NULL, arg.value.customVal.usrPtr);
+                }
+                arg.value.type = str_argType_str;
+                arg.value.strVal = text;
+            }
+            args[idx] = arg;
+            size += 1 + (arg.key.size > 0 ? sizeof(u16) + arg.key.size : 0);
+            size += arg.value.type == str_argType_str ? sizeof(u32) + arg.value.strVal.size : log__binaryValueSizes[arg.value.type];
+        }
+        log__Ring* ring = log__ringGet();
+        result = ring && log__ringFits(ring, size);
+        u8* at = result ? log__ringReserve(ring, size, LOG__RING_BINARY) : NULL;
+        if (at) {
+            u8 kind = log__binaryKind_message;
+            u8 count = u8_cast(argCount);
+            at = log__put(at, &kind, 1);
+            at = log__put(at, &id, sizeof(id));
+            at = log__put(at, &cycles, sizeof(cycles));
+            at = log__put(at, &count, 1);
+            for (u32 idx = 0; idx < argCount; idx++) {
+                str_KeyValue* arg = args + idx;
+                u8 type = u8_cast(arg->value.type);
+                if (arg->key.size > 0) {
+                    u16 keySize = u16_cast(minVal(arg->key.size, 0xFFFF));
+                    type |= LOG__BINARY_KEYED;
+                    at = log__put(at, &type, 1);
+                    at = log__put(at, &keySize, sizeof(keySize));
+                    at = log__put(at, arg->key.content, keySize);
+                } else {
+                    at = log__put(at, &type, 1);
+                }
+                if (arg->value.type == str_argType_str) {
+                    u32 strSize = u32_cast(arg->value.strVal.size);
+                    at = log__put(at, &strSize, sizeof(strSize));
+                    at = log__put(at, arg->value.strVal.content, strSize);
+                } else {
+                    // all union members start at the same address
+                    at = log__put(at, &arg->value.u64Val, log__binaryValueSizes[arg->value.type]);
+                }
+            }
+            log__ringCommit(ring, severity);
+        }
+    }
+    return result;
+}
+
+LOCAL void log__drainAll(void) {
+    os_mutexScoped(&log__binary.lock) {
+        for (log__Ring* ring = log__ringsHead(); ring; ring = ring->next) {
+            log__ringDrain(ring);
+        }
+        if (log__binary.file) {
+            log__binaryWriteClock(false);
+            fflush(log__binary.file);
+        }
+    }
+    log__sinksTick(false);
+}
+
+LOCAL i32 log__writerRun(os_Thread* thread, void* userData) {
+    unusedVars(thread, userData);
+    while (!a32_loadAcquire(&log__async.stopping)) {
+        os_semaphoreWait(&log__async.wake, i32_cast(log__async.flushIntervalMs));
+        log__drainAll();
+    }
+    log__drainAll();
+    return 0;
+}
+
+// logStr ends with a line break and a null terminator
+LOCAL void log__output(log_Severity severity, S8 fileName, u64 line, S8 logStr, u64 prefixSize) {
+    log__Line entry;
+    entry.text = str_fromCharPtr(logStr.content, logStr.size - 1);
+    entry.fileName = fileName;
+    entry.line = u32_cast(line);
+    entry.messageOffset = u32_cast(prefixSize);
+    entry.severity = severity;
+    entry.terminated = true;
+    if (log__inCallback) {
+        log__sinksWriteFromCallback(&entry);
+        return;
+    }
+    if (a32_loadAcquire(&log__async.running) && log__asyncPush(&entry)) {
+        return;
+    }
+    log__sinksWrite(&entry, 1);
+}
+
+API bx log_asyncStart(log_AsyncDesc* desc) {
+    ASSERT(desc);
+    if (a32_loadAcquire(&log__async.running)) {
+        return true;
+    }
+    if (!log__async.arena) {
+        BaseMemory baseMem = os_getBaseMemory();
+        log__async.arena = mem_makeArena(&baseMem, GIGABYTE(4));
+        os_mutexInit(&log__async.lock);
+        os_mutexInit(&log__binary.lock);
+        os_semaphoreInit(&log__async.wake);
+        log__threadExitHookInit();
+    }
+    u64 ringSize = KILOBYTE(4);
+    while (ringSize < (desc->ringSize ? desc->ringSize : LOG__RING_DEFAULT_SIZE)) {
+        ringSize *= 2;
+    }
+    log__async.ringSize = ringSize;
+    log__async.flushIntervalMs = desc->flushIntervalMs ? desc->flushIntervalMs : LOG__FLUSH_DEFAULT_MS;
+    log__async.policy = desc->policy;
+    a32_storeRelease(&log__async.stopping, 0);
+    // the writer runs the sink callbacks, they get the default stack size
+    if (!os_threadCreate(&log__async.writer, log__writerRun, NULL, 0, str_lit("log writer"))) {
+        return false;
+    }
+    a32_storeRelease(&log__async.running, 1);
+    return true;
+}
+
+API void log_asyncStop(void) {
+    if (!a32_loadAcquire(&log__async.running)) {
+        return;
+    }
+    log_binaryStop();
+    a32_storeRelease(&log__async.running, 0);
+    a32_storeRelease(&log__async.stopping, 1);
+    os_semaphorePost(&log__async.wake, 1);
+    os_threadShutdown(&log__async.writer);
+    // lines pushed while the writer was shutting down
+    log__drainAll();
+}
+
+API void log_flush(void) {
+    // the summaries go through the rings as well, they have to be pushed before waiting for them
+    log__rateFlush();
+    if (a32_loadAcquire(&log__async.running)) {
+        for (log__Ring* ring = log__ringsHead(); ring; ring = ring->next) {
+            u64 head = a64_loadAcquire(&ring->head);
+            while (a64_loadAcquire(&ring->tail) < head && a32_loadAcquire(&log__async.running)) {
+                os_semaphorePost(&log__async.wake, 1);
+                os_sleep(1);
+            }
+        }
+    }
+    fflush(stdout);
+    log__sinksTick(true);
+}
+
+API bx log_binaryStart(S8 fileName) {
+    if (a32_loadAcquire(&log__binary.running)) {
+        return true;
+    }
+    if (!a32_loadAcquire(&log__async.running)) {
+        log_AsyncDesc desc;
+        mem_structSetZero(&desc);
+        if (!log_asyncStart(&desc)) {
+            return false;
+        }
+    }
+    char path[4096];
+    if (fileName.size >= sizeof(path)) {
+        return false;
+    }
+    mem_copy(path, fileName.content, fileName.size);
+    path[fileName.size] = '\0';
+    FILE* file = fopen(path, "wb");
+    if (!file) {
+        return false;
+    }
+    os_mutexScoped(&log__binary.lock) {
+        u32 version = LOG__BINARY_VERSION;
+        fwrite(LOG__BINARY_MAGIC, 4, 1, file);
+        fwrite(&version, sizeof(version), 1, file);
+        log__binary.file = file;
+        log__binary.sitesWritten = 0;
+        log__binary.clockCount = 0;
+        log__binaryWriteClock(true);
+    }
+    a32_storeRelease(&log__binary.running, 1);
+    return true;
+}
+
+API void log_binaryStop(void) {
+    if (!a32_loadAcquire(&log__binary.running)) {
+        return;
+    }
+    a32_storeRelease(&log__binary.running, 0);
+    log_flush();
+    os_mutexScoped(&log__binary.lock) {
+        log__binaryWriteClock(true);
+        fclose(log__binary.file);
+        log__binary.file = NULL;
+    }
+}
+
+////////////////////////////
+// NOTE(pjako): runtime levels
+// Call sites register on their first call. A configuration change recomputes the level of every registered
+// site under the lock and stores it atomically, the call sites themselves only ever load it.
+
+typedef struct log__LevelRule {
+    S8 module;          // module rules
+    str_Glob* fileGlob; // file rules, NULL for module rules
+    log_Severity minSeverity;
+} log__LevelRule;
+
+typedef struct log__Levels {
+    a32 state;          // 0 = not initialized, 1 = initializing, 2 = ready
+    os_Mutex lock;
+    Arena* arena;       // rules, module names and globs, guarded by lock
+    log_Site* sites;    // every call site that logged at least once
+    log__LevelRule* rules;
+    u32 ruleCount;
+    u32 ruleCapacity;
+    log_Severity defaultSeverity;
+} log__Levels;
+
+static log__Levels log__levels;
+
+LOCAL void log__levelsInit(void) {
+    if (a32_loadAcquire(&log__levels.state) == 2) {
+        return;
+    }
+    if (a32_compareAndSwap(&log__levels.state, 0, 1) == 0) {
+        BaseMemory baseMem = os_getBaseMemory();
+        log__levels.arena = mem_makeArena(&baseMem, MEGABYTE(64));
+        os_mutexInit(&log__levels.lock);
+        log__levels.defaultSeverity = log_severity_trace;
+        a32_storeRelease(&log__levels.state, 2);
+    }
+    while (a32_loadAcquire(&log__levels.state) != 2) {
+        os_yield();
+    }
+}
+
+// caller holds log__levels.lock
+LOCAL log_Severity log__levelsResolve(log_Site* site) {
+    S8 projectRootPath = str_lit(PROJECT_ROOT "/");
+    S8 relativeFileName = str_subStr(site->fileName, projectRootPath.size, site->fileName.size - projectRootPath.size);
+    log__LevelRule* fileRule = NULL;
+    for (u32 idx = log__levels.ruleCount; idx-- > 0;) {
+        log__LevelRule* rule = log__levels.rules + idx;
+        if (!rule->fileGlob) {
+            if (str_isEqual(rule->module, site->module)) {
+                return rule->minSeverity;
+            }
+        } else if (!fileRule && str_globMatch(rule->fileGlob, relativeFileName)) {
+            fileRule = rule;
+        }
+    }
+    return fileRule ? fileRule->minSeverity : log__levels.defaultSeverity;
+}
+
+// caller holds log__levels.lock
+LOCAL void log__levelsApply(void) {
+    for (log_Site* site = log__levels.sites; site; site = site->next) {
+        a32_storeRelease(&site->level, u32_cast(log__levelsResolve(site)) + 1);
+    }
+}
+
+// caller holds log__levels.lock
+LOCAL void log__levelsAddRule(S8 module, str_Glob* fileGlob, log_Severity minSeverity) {
+    if (log__levels.ruleCount == log__levels.ruleCapacity) {
+        u32 capacity = maxVal(16, log__levels.ruleCapacity * 2);
+        log__LevelRule* rules = mem_arenaPushArray(log__levels.arena, log__LevelRule, capacity);
+        if (log__levels.ruleCount > 0) {
+            mem_copy(rules, log__levels.rules, sizeof(log__LevelRule) * log__levels.ruleCount);
+        }
+        log__levels.rules = rules;
+        log__levels.ruleCapacity = capacity;
+    }
+    log__LevelRule* rule = log__levels.rules + log__levels.ruleCount++;
+    rule->module = fileGlob ? STR_NULL : str_copy(log__levels.arena, module);
+    rule->fileGlob = fileGlob;
+    rule->minSeverity = minSeverity;
+}
+
+// registers the site on its first call, true if severity passes its level
+LOCAL bx log__sitePass(log_Site* site, log_Severity severity, S8 fileName, u64 line) {
+    if (a32_loadAcquire(&site->level) == 0) {
+        log__levelsInit();
+        os_mutexScoped(&log__levels.lock) {
+            if (site->level == 0) {
+                site->fileName = fileName;
+                site->line = u32_cast(line);
+                site->next = log__levels.sites;
+                log__levels.sites = site;
+                a32_storeRelease(&site->level, u32_cast(log__levelsResolve(site)) + 1);
+            }
+        }
+    }
+    return log__sitePasses(*site, severity);
+}
+
+API void log_setDefaultLevel(log_Severity minSeverity) {
+    log__levelsInit();
+    os_mutexScoped(&log__levels.lock) {
+        log__levels.defaultSeverity = minSeverity;
+        log__levelsApply();
+    }
+}
+
+API void log_setModuleLevel(S8 module, log_Severity minSeverity) {
+    log__levelsInit();
+    os_mutexScoped(&log__levels.lock) {
+        log__levelsAddRule(module, NULL, minSeverity);
+        log__levelsApply();
+    }
+}
+
+API bx log_setFileLevel(S8 fileGlob, log_Severity minSeverity) {
+    log__levelsInit();
+    bx result = false;
+    os_mutexScoped(&log__levels.lock) {
+        str_Glob* glob = str_globCompile(log__levels.arena, str_copy(log__levels.arena, fileGlob));
+        if (glob) {
+            log__levelsAddRule(STR_NULL, glob, minSeverity);
+            log__levelsApply();
+            result = true;
+        }
+    }
+    return result;
+}
+
+API void log_clearLevels(void) {
+    log__levelsInit();
+    os_mutexScoped(&log__levels.lock) {
+        mem_arenaPopTo(log__levels.arena, 0);
+        log__levels.rules = NULL;
+        log__levels.ruleCount = 0;
+        log__levels.ruleCapacity = 0;
+        log__levels.defaultSeverity = log_severity_trace;
+        log__levelsApply();
+    }
+}
+
+LOCAL S8 log__trim(S8 str) {
+    while (str.size > 0 && (str.content[0] == ' ' || str.content[0] == '\t')) {
+        str.content++;
+        str.size--;
+    }
+    while (str.size > 0 && (str.content[str.size - 1] == ' ' || str.content[str.size - 1] == '\t')) {
+        str.size--;
+    }
+    return str;
+}
+
+LOCAL bx log__parseSeverity(S8 str, log_Severity* out) {
+    static const S8 names[] = {
+        {(u8*) "trace", 5}, {(u8*) "debug", 5}, {(u8*) "info", 4}, {(u8*) "warn", 4}, {(u8*) "error", 5}, {(u8*) "fatal", 5}, {(u8*) "off", 3}
     };
-    S8 severityStr = log__severityLevelStrings[sev];
-    S8 severityColor = log__severityLevelColors[sev];
-    time_t t = time(NULL);
-    struct tm *time = localtime(&t);
-    char timeBuffer[64];
-    i32 size = strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%d %H:%M:%S", time);
-    timeBuffer[size] = '\0';
-    S8 timeStr;
-    timeStr.size = size;
-    timeStr.content = (u8*) &timeBuffer[0];
+    for (u32 idx = 0; idx < countOf(names); idx++) {
+        if (str_isEqualNoCase(str, names[idx])) {
+            *out = (log_Severity) idx;
+            return true;
+        }
+    }
+    if (str_isEqualNoCase(str, s8("warning"))) {
+        *out = log_severity_warning;
+        return true;
+    }
+    return false;
+}
+
+// splits "name=severity", name is empty for a bare severity
+LOCAL bx log__parseRule(S8 entry, S8* name, log_Severity* severity) {
+    i64 equals = str_findChar(entry, '=');
+    *name = equals < 0 ? STR_NULL : log__trim(str_subStr(entry, 0, u64_cast(equals)));
+    S8 severityStr = equals < 0 ? entry : log__trim(str_from(entry, u64_cast(equals) + 1));
+    return (equals < 0 || name->size > 0) && log__parseSeverity(severityStr, severity);
+}
+
+LOCAL bx log__isFilePattern(S8 name) {
+    return str_findChar(name, '/') >= 0 || str_findChar(name, '*') >= 0 || str_findChar(name, '.') >= 0;
+}
+
+API bx log_setLevels(S8 spec) {
+    log__levelsInit();
+    bx result = true;
+    os_mutexScoped(&log__levels.lock) {
+        // validate everything first so that a typo does not leave half of the spec applied
+        str_forEachField(spec, ',', it) {
+            S8 entry = log__trim(it.piece);
+            S8 name;
+            log_Severity severity;
+            if (entry.size > 0 && !log__parseRule(entry, &name, &severity)) {
+                result = false;
+            }
+        }
+        u32 ruleCount = log__levels.ruleCount;
+        log_Severity defaultSeverity = log__levels.defaultSeverity;
+        str_forEachField(spec, ',', it) {
+            S8 entry = log__trim(it.piece);
+            S8 name;
+            log_Severity severity;
+            if (!result || entry.size == 0 || !log__parseRule(entry, &name, &severity)) {
+                continue;
+            }
+            if (name.size == 0) {
+                log__levels.defaultSeverity = severity;
+            } else if (log__isFilePattern(name)) {
+                str_Glob* glob = str_globCompile(log__levels.arena, str_copy(log__levels.arena, name));
+                if (!glob) {
+                    result = false;
+                    continue;
+                }
+                log__levelsAddRule(STR_NULL, glob, severity);
+            } else {
+                log__levelsAddRule(name, NULL, severity);
+            }
+        }
+        if (!result) {
+            // a glob that did not compile, drop the rules of this spec again
+            log__levels.ruleCount = ruleCount;
+            log__levels.defaultSeverity = defaultSeverity;
+        }
+        log__levelsApply();
+    }
+    return result;
+}
+
+////////////////////////////
+// NOTE(pjako): log clock
+// The date part of the prefix is formatted once per second and thread, the sub-second digits come from
+// tm_currentCount relative to the wall clock sample taken at the start of the second.
+
+static const S8 log__severityStrings[] = {
+    {(u8*) "TRACE", 5}, {(u8*) "DEBUG", 5}, {(u8*) "INFO ", 5}, {(u8*) "WARN ", 5}, {(u8*) "ERROR", 5}, {(u8*) "FATAL", 5}
+};
+
+static const S8 log__severityColors[] = {
+    {(u8*) "\x1b[94m", 5}, {(u8*) "\x1b[36m", 5}, {(u8*) "\x1b[32m", 5}, {(u8*) "\x1b[33m", 5}, {(u8*) "\x1b[31m", 5}, {(u8*) "\x1b[35m", 5}
+};
+
+typedef struct log__Clock {
+    tm_FrequencyInfo frequency;
+    u64 anchorCount;     // tm_currentCount at anchorNs
+    u64 anchorNs;        // unix time in ns, 0 = not sampled yet
+    u64 second;          // second of date
+    u8 date[32];         // "YYYY-MM-DD HH:MM:SS"
+    u32 dateSize;
+} log__Clock;
+
+static THREAD_LOCAL log__Clock log__clock;
+static a32 log__timePrecision = log_timePrecision_milli;
+
+LOCAL void log__localTime(u64 second, struct tm* out) {
+    time_t t = (time_t) second;
+#if OS_WIN
+    localtime_s(out, &t);
+#else
+    localtime_r(&t, out);
+#endif
+}
+
+// writes the local time with the configured sub-second digits, returns the size
+LOCAL u64 log__clockFormat(u8* out) {
+    log__Clock* clock = &log__clock;
+    u64 ns = 0;
+    // the frequency is only known once the clock was anchored, converting before divides by 0 on some platforms
+    if (clock->anchorNs != 0) {
+        u64 count = tm_currentCount();
+        ns = clock->anchorNs + tm_countToNanoseconds(clock->frequency, i64_cast(count - clock->anchorCount));
+    }
+    if (clock->anchorNs == 0 || ns / 1000000000 != clock->second) {
+        // a new second samples the wall clock again, this also keeps the drift between both clocks small
+        clock->frequency = tm_getPerformanceFrequency();
+        clock->anchorNs = log__unixNs();
+        clock->anchorCount = tm_currentCount();
+        ns = clock->anchorNs;
+        clock->second = ns / 1000000000;
+        struct tm local;
+        log__localTime(clock->second, &local);
+        clock->dateSize = u32_cast(strftime((char*) clock->date, sizeof(clock->date), "%Y-%m-%d %H:%M:%S", &local));
+    }
+    mem_copy(out, clock->date, clock->dateSize);
+    u64 size = clock->dateSize;
+    u32 precision = log__timePrecision;
+    if (precision != log_timePrecision_second) {
+        u32 digits = precision == log_timePrecision_milli ? 3 : 6;
+        u32 fraction = u32_cast((ns % 1000000000) / (precision == log_timePrecision_milli ? 1000000 : 1000));
+        out[size++] = '.';
+        for (u32 idx = digits; idx > 0; idx--) {
+            out[size + idx - 1] = (u8) ('0' + fraction % 10);
+            fraction /= 10;
+        }
+        size += digits;
+    }
+    return size;
+}
+
+API void log_setTimePrecision(log_TimePrecision precision) {
+    a32_storeRelease(&log__timePrecision, precision);
+}
+
+S8 log__writeTimestamp(Arena* arena, log_Severity severity, S8 fileName, u64 line) {
+    log_Severity sev = clampVal(log_severity_trace, log_severity_fatal, severity);
+    S8 severityStr = log__severityStrings[sev];
+    u8 timeBuffer[64];
+    S8 timeStr = str_fromCharPtr(timeBuffer, log__clockFormat(timeBuffer));
     S8 log__projectRootPath = str_lit(PROJECT_ROOT "/");
     S8 relativeFilePath = str_subStr(fileName, log__projectRootPath.size, fileName.size - log__projectRootPath.size);
     #ifndef STRLOG_NO_COLOR
+    S8 severityColor = log__severityColors[sev];
     S8 COL0 = str_lit("\x1b[0m\x1b[90m");
     S8 COL1 = str_lit("\x1b[0m");
-    str_join(arena, timeStr, s8(" "), severityColor, severityStr, s8(" "), COL0, relativeFilePath, s8(":"), line, s8(":"), COL1, s8(" "));
+    return str_join(arena, timeStr, s8(" "), severityColor, severityStr, s8(" "), COL0, relativeFilePath, s8(":"), line, s8(":"), COL1, s8(" "));
     #else
-    str_join(arena, timeStr, s8(" "), severityStr, s8(" "), relativeFilePath, s8(":"), line, s8(": "));
+    return str_join(arena, timeStr, s8(" "), severityStr, s8(" "), relativeFilePath, s8(":"), line, s8(": "));
     #endif
 }
 
-void log__msg(Arena* mem, log_Severity severity, S8 fileName, u64 line, u32 argCount, ...) {
+////////////////////////////
+// NOTE(pjako): structured output
+// The message is formatted as usual, everything around it is written field by field into the record.
+
+static a32 log__encoding = log_encoding_text;
+
+static const S8 log__levelNames[] = {
+    {(u8*) "trace", 5}, {(u8*) "debug", 5}, {(u8*) "info", 4}, {(u8*) "warn", 4}, {(u8*) "error", 5}, {(u8*) "fatal", 5}
+};
+
+API void log_setEncoding(log_Encoding encoding) {
+    a32_storeRelease(&log__encoding, encoding);
+}
+
+INLINE void log__append(Arena* arena, S8 str) {
+    mem_copy(mem_arenaPush(arena, str.size), str.content, str.size);
+}
+
+// keyed arguments become fields, custom values are turned into text first since they write into the arena themselves
+LOCAL u32 log__collectFields(Arena* arena, str_KeyValue* args, u32 argCount, str_KeyValue* fields) {
+    u32 fieldCount = 0;
+    for (u32 idx = 0; idx < argCount; idx++) {
+        str_KeyValue field = args[idx];
+        if (field.key.size == 0) {
+            continue;
+        }
+        if (field.value.type == str_argType_custom) {
+            S8 text;
+            str_record(text, arena) {
+                field.value.customVal.buildStrFn(arena, STR_NULL, field.value.customVal.usrPtr);
+            }
+            field.value.type = str_argType_str;
+            field.value.strVal = text;
+        }
+        fields[fieldCount++] = field;
+    }
+    return fieldCount;
+}
+
+LOCAL void log__recordValue(Arena* arena, log_Encoding encoding, str_Value* value) {
+    u8 buffer[STR_FLOAT_MAX_CHARS];
+    S8 text = STR_NULL;
+    switch (value->type) {
+        case str_argType_str:
+        case str_argType_char: {
+            S8 str = value->type == str_argType_str ? value->strVal : str_fromCharPtr((u8*) &value->charVal, 1);
+            if (encoding == log_encoding_json) {
+                log__append(arena, s8("\""));
+                str_escapeJson(arena, str);
+                log__append(arena, s8("\""));
+            } else {
+                str_escapeLogfmt(arena, str);
+            }
+            return;
+        }
+        case str_argType_f32:
+        case str_argType_f64: {
+            f64 number = value->type == str_argType_f32 ? value->f32Val : value->f64Val;
+            // nan and infinity are no json numbers
+            if (number - number != 0) {
+                text = encoding == log_encoding_json ? s8("null") : s8("NaN");
+            } else {
+                text = str_fromCharPtr(buffer, value->type == str_argType_f32 ? str_f32ToChars(value->f32Val, buffer) : str_f64ToChars(number, buffer));
+            }
+        } break;
+        case str_argType_u32: text = str_fromCharPtr(buffer, str_u64ToChars(value->u32Val, buffer)); break;
+        case str_argType_u64: text = str_fromCharPtr(buffer, str_u64ToChars(value->u64Val, buffer)); break;
+        case str_argType_i32: text = str_fromCharPtr(buffer, str_i64ToChars(value->i32Val, buffer)); break;
+        case str_argType_i64: text = str_fromCharPtr(buffer, str_i64ToChars(value->i64Val, buffer)); break;
+        default: text = encoding == log_encoding_json ? s8("null") : s8("\"\""); break;
+    }
+    log__append(arena, text);
+}
+
+// the record with a line break and a null terminator, repeatOffset skips the time field for the repeat check
+LOCAL S8 log__encodeRecord(Arena* arena, log_Encoding encoding, log_Severity severity, log_Site* site, S8 fileName, u64 line,
+                           S8 message, str_KeyValue* fields, u32 fieldCount, u64* repeatOffset) {
+    u8 timeBuffer[64];
+    u64 timeSize = log__clockFormat(timeBuffer);
+    // ISO 8601
+    timeBuffer[10] = 'T';
+    S8 timeStr = str_fromCharPtr(timeBuffer, timeSize);
+    S8 projectRootPath = str_lit(PROJECT_ROOT "/");
+    S8 relativeFilePath = str_subStr(fileName, projectRootPath.size, fileName.size - projectRootPath.size);
+    S8 level = log__levelNames[clampVal(log_severity_trace, log_severity_fatal, severity)];
+    bx json = encoding == log_encoding_json;
+    u8 lineBuffer[24];
+    S8 lineStr = str_fromCharPtr(lineBuffer, str_u64ToChars(line, lineBuffer));
+    S8 record;
+    str_record(record, arena) {
+        log__append(arena, json ? s8("{\"time\":\"") : s8("time="));
+        log__append(arena, timeStr);
+        log__append(arena, json ? s8("\",\"level\":\"") : s8(" level="));
+        // the repeat check skips the time
+        *repeatOffset = (json ? 9 : 5) + timeStr.size + (json ? 1 : 0);
+        log__append(arena, level);
+        if (json) {
+            log__append(arena, s8("\",\"file\":\""));
+            str_escapeJson(arena, relativeFilePath);
+            log__append(arena, s8("\",\"line\":"));
+            log__append(arena, lineStr);
+            if (site->module.size > 0) {
+                log__append(arena, s8(",\"module\":\""));
+                str_escapeJson(arena, site->module);
+                log__append(arena, s8("\""));
+            }
+            log__append(arena, s8(",\"msg\":\""));
+            str_escapeJson(arena, message);
+            log__append(arena, s8("\""));
+        } else {
+            log__append(arena, s8(" file="));
+            str_escapeLogfmt(arena, relativeFilePath);
+            log__append(arena, s8(" line="));
+            log__append(arena, lineStr);
+            if (site->module.size > 0) {
+                log__append(arena, s8(" module="));
+                str_escapeLogfmt(arena, site->module);
+            }
+            log__append(arena, s8(" msg="));
+            str_escapeLogfmt(arena, message);
+        }
+        for (u32 idx = 0; idx < fieldCount; idx++) {
+            if (json) {
+                log__append(arena, s8(",\""));
+                str_escapeJson(arena, fields[idx].key);
+                log__append(arena, s8("\":"));
+            } else {
+                log__append(arena, s8(" "));
+                str_escapeLogfmt(arena, fields[idx].key);
+                log__append(arena, s8("="));
+            }
+            log__recordValue(arena, encoding, &fields[idx].value);
+        }
+        log__append(arena, json ? s8("}\n\0") : s8("\n\0"));
+    }
+    return record;
+}
+
+////////////////////////////
+// NOTE(pjako): rate limiting
+
+typedef struct log__RateLimit {
+    tm_FrequencyInfo frequency; // set before the limits are published
+    a64 intervalNs;     // time the bucket needs to refill one message, 0 = no limit
+    a64 capacityNs;     // burst * intervalNs
+    a64 repeatWindowNs; // 0 = no collapsing
+} log__RateLimit;
+
+static log__RateLimit log__rateLimit;
+
+// monotonic, a wall clock that is set back would drop every message until it caught up again
+LOCAL u64 log__rateNow(void) {
+    return tm_countToNanoseconds(log__rateLimit.frequency, i64_cast(tm_currentCount()));
+}
+
+// takes the whole count, zero if another thread took it first
+LOCAL u32 log__takeCount(a32* count) {
+    u32 value = a32_loadAcquire(count);
+    while (value != 0) {
+        u32 previous = a32_compareAndSwap(count, value, 0);
+        if (previous == value) {
+            break;
+        }
+        value = previous;
+    }
+    return value;
+}
+
+LOCAL void log__writeCount(Arena* mem, log_Site* site, log_Severity severity, S8 before, u32 count, S8 after) {
+    mem_scoped(scratch, mem) {
+        S8 logStr;
+        u64 prefixSize = 0;
+        str_record(logStr, scratch.arena) {
+            prefixSize = log__writeTimestamp(scratch.arena, severity, site->fileName, site->line).size;
+            str_join(scratch.arena, before, count, after, s8("\r\n"), STR_TERMINATOR);
+        }
+        log__output(severity, site->fileName, site->line, logStr, prefixSize);
+    }
+}
+
+LOCAL void log__writeDropped(Arena* mem, log_Site* site, log_Severity severity, u32 dropped) {
+    log__writeCount(mem, site, severity, s8(""), dropped, s8(" messages dropped by the rate limit"));
+}
+
+LOCAL void log__writeRepeats(Arena* mem, log_Site* site, log_Severity severity, u32 repeats) {
+    log__writeCount(mem, site, severity, s8("previous message repeated "), repeats, s8(" times"));
+}
+
+// The bucket is stored as the time it is full again: every message moves that time one interval ahead and
+// a message passes while it stays within burst intervals of now. One compare and swap updates the whole bucket.
+LOCAL bx log__rateTake(Arena* mem, log_Site* site, log_Severity severity) {
+    u64 intervalNs = a64_loadAcquire(&log__rateLimit.intervalNs);
+    if (intervalNs == 0) {
+        return true;
+    }
+    u64 capacityNs = a64_loadAcquire(&log__rateLimit.capacityNs);
+    u64 now = log__rateNow();
+    for (;;) {
+        u64 fullNs = a64_loadAcquire(&site->bucketFullNs);
+        u64 start = maxVal(fullNs, now);
+        if (start + intervalNs - now > capacityNs) {
+            a32_add(&site->dropped, 1);
+            a32_storeRelease(&site->lastSeverity, severity);
+            return false;
+        }
+        if (a64_compareAndSwap(&site->bucketFullNs, fullNs, start + intervalNs) == fullNs) {
+            break;
+        }
+    }
+    u32 dropped = a32_loadAcquire(&site->dropped) != 0 ? log__takeCount(&site->dropped) : 0;
+    if (dropped > 0) {
+        log__writeDropped(mem, site, severity, dropped);
+    }
+    return true;
+}
+
+// true if message repeats the last one of the site and is only counted, the counts are exact
+// while the window is only approximate when several threads log from the same site
+LOCAL bx log__repeatCollapse(Arena* mem, log_Site* site, log_Severity severity, S8 message) {
+    u64 windowNs = a64_loadAcquire(&log__rateLimit.repeatWindowNs);
+    if (windowNs == 0) {
+        return false;
+    }
+    u64 hash = str_hash64(message);
+    u64 now = log__rateNow();
+    if (a64_loadAcquire(&site->lastHash) == hash) {
+        if (a32_add(&site->repeats, 1) == 0) {
+            a64_storeRelease(&site->repeatStartNs, now);
+        } else if (now - a64_loadAcquire(&site->repeatStartNs) > windowNs) {
+            u32 repeats = log__takeCount(&site->repeats);
+            if (repeats > 0) {
+                log__writeRepeats(mem, site, severity, repeats);
+            }
+        }
+        a32_storeRelease(&site->lastSeverity, severity);
+        return true;
+    }
+    u32 repeats = log__takeCount(&site->repeats);
+    if (repeats > 0) {
+        log__writeRepeats(mem, site, (log_Severity) a32_loadAcquire(&site->lastSeverity), repeats);
+    }
+    a64_storeRelease(&site->lastHash, hash);
+    a32_storeRelease(&site->lastSeverity, severity);
+    return false;
+}
+
+// writes the repeat and drop counts of sites that went quiet
+LOCAL void log__rateFlush(void) {
+    if (a32_loadAcquire(&log__levels.state) != 2) {
+        return;
+    }
+    os_mutexScoped(&log__levels.lock) {
+        for (log_Site* site = log__levels.sites; site; site = site->next) {
+            if (a32_loadAcquire(&site->repeats) == 0 && a32_loadAcquire(&site->dropped) == 0) {
+                continue;
+            }
+            log_Severity severity = (log_Severity) a32_loadAcquire(&site->lastSeverity);
+            u32 repeats = log__takeCount(&site->repeats);
+            if (repeats > 0) {
+                log__writeRepeats(log__levels.arena, site, severity, repeats);
+            }
+            u32 dropped = log__takeCount(&site->dropped);
+            if (dropped > 0) {
+                log__writeDropped(log__levels.arena, site, severity, dropped);
+            }
+        }
+    }
+}
+
+API void log_setRateLimit(log_RateLimitDesc* desc) {
+    log__rateLimit.frequency = tm_getPerformanceFrequency();
+    u64 intervalNs = 0;
+    u64 capacityNs = 0;
+    u64 repeatWindowNs = 0;
+    if (desc) {
+        intervalNs = desc->perSecond > 0 ? maxVal(u64_val(1000000000) / desc->perSecond, 1) : 0;
+        capacityNs = intervalNs * (desc->burst > 0 ? desc->burst : desc->perSecond);
+        repeatWindowNs = u64_cast(desc->repeatWindowMs) * 1000000;
+    }
+    a64_storeRelease(&log__rateLimit.capacityNs, capacityNs);
+    a64_storeRelease(&log__rateLimit.repeatWindowNs, repeatWindowNs);
+    a64_storeRelease(&log__rateLimit.intervalNs, intervalNs);
+}
+
+void log__msg(Arena* mem, log_Severity severity, log_Site* site, S8 fileName, u64 line, u32 argCount, ...) {
+    if (!log__sitePass(site, severity, fileName, line) || !log__rateTake(mem, site, severity)) {
+        return;
+    }
     va_list valist;
     va_start(valist, argCount);
+    log_Encoding encoding = (log_Encoding) a32_loadAcquire(&log__encoding);
     mem_scoped(scratch, mem) {
         S8 logStr;
-        str_record(logStr, scratch.arena) {
-            log__writeTimestamp(scratch.arena, severity, fileName, line);
-            str_joinVargs(scratch.arena, argCount, valist);
-            str_join(scratch.arena, s8("\r\n"), STR_TERMINATOR);
+        u64 prefixSize = 0;
+        u64 repeatOffset = 0;
+        if (encoding == log_encoding_text) {
+            str_record(logStr, scratch.arena) {
+                prefixSize = log__writeTimestamp(scratch.arena, severity, fileName, line).size;
+                str_joinVargs(scratch.arena, argCount, valist);
+                str_join(scratch.arena, s8("\r\n"), STR_TERMINATOR);
+            }
+            repeatOffset = prefixSize;
+        } else {
+            S8 message = str_joinVargs(scratch.arena, argCount, valist);
+            logStr = log__encodeRecord(scratch.arena, encoding, severity, site, fileName, line, message, NULL, 0, &repeatOffset);
+        }
+        if (!log__repeatCollapse(scratch.arena, site, severity, str_from(logStr, repeatOffset))) {
+            log__output(severity, fileName, line, logStr, prefixSize);
         }
-        os_log(logStr);
     }
+    va_end(valist);
 }
 
-void log__msgFmt(Arena* mem, log_Severity severity, S8 fileName, u64 line, S8 template, u32 argCount, ...) {
+LOCAL str_FmtProgram* log__sitePrepare(log_FmtSite* site, S8 template) {
+    u32 state = a32_loadAcquire(&site->state);
+    if (state == 0 && a32_compareAndSwap(&site->state, 0, 1) == 0) {
+        bx fits = str_fmtCompileInto(&site->program, site->ops, countOf(site->ops), template);
+        a32_compareAndSwap(&site->state, 1, fits ? 2 : 3);
+        state = fits ? 2 : 3;
+    }
+    // the template of a call site is expected to be a literal, anything else takes the uncached path
+    if (state != 2 || site->program.fmt.content != template.content || site->program.fmt.size != template.size) {
+        return NULL;
+    }
+    return &site->program;
+}
+
+void log__msgFmt(Arena* mem, log_Severity severity, log_FmtSite* site, S8 fileName, u64 line, S8 template, u32 argCount, ...) {
+    if (!log__sitePass(&site->site, severity, fileName, line) || !log__rateTake(mem, &site->site, severity)) {
+        return;
+    }
     va_list valist;
     va_start(valist, argCount);
+    if (a32_loadAcquire(&log__binary.running) && !log__inCallback) {
+        va_list binaryList;
+        va_copy(binaryList, valist);
+        bx written = log__binaryPush(mem, severity, site, fileName, line, template, argCount, binaryList);
+        va_end(binaryList);
+        if (written) {
+            va_end(valist);
+            return;
+        }
+    }
+    str_FmtProgram* program = log__sitePrepare(site, template);
+    log_Encoding encoding = (log_Encoding) a32_loadAcquire(&log__encoding);
     mem_scoped(scratch, mem) {
         S8 logStr;
-        str_record(logStr, scratch.arena) {
-            log__writeTimestamp(scratch.arena, severity, fileName, line);
-            str_fmtVargs(scratch.arena, template, argCount, valist);
-            str_join(scratch.arena, s8("\r\n"), STR_TERMINATOR);
+        u64 prefixSize = 0;
+        u64 repeatOffset = 0;
+        if (encoding == log_encoding_text) {
+            str_record(logStr, scratch.arena) {
+                prefixSize = log__writeTimestamp(scratch.arena, severity, fileName, line).size;
+                if (program) {
+                    str_fmtProgramVargs(scratch.arena, program, argCount, valist);
+                } else {
+                    str_fmtVargs(scratch.arena, template, argCount, valist);
+                }
+                str_join(scratch.arena, s8("\r\n"), STR_TERMINATOR);
+            }
+            repeatOffset = prefixSize;
+        } else {
+            // arrays first, text pushes leave the arena unaligned
+            str_KeyValue* args = mem_arenaPushArray(scratch.arena, str_KeyValue, (argCount + 1));
+            str_KeyValue* fields = mem_arenaPushArray(scratch.arena, str_KeyValue, (argCount + 1));
+            str_FmtProgram compiled;
+            if (!program) {
+                compiled = str_fmtCompile(scratch.arena, template);
+                program = &compiled;
+            }
+            for (u32 idx = 0; idx < argCount; idx++) {
+                args[idx] = va_arg(valist, str_KeyValue);
+            }
+            S8 message = str_fmtProgramArgs(scratch.arena, program, argCount, args);
+            u32 fieldCount = log__collectFields(scratch.arena, args, argCount, fields);
+            logStr = log__encodeRecord(scratch.arena, encoding, severity, &site->site, fileName, line, message, fields, fieldCount, &repeatOffset);
+        }
+        if (!log__repeatCollapse(scratch.arena, &site->site, severity, str_from(logStr, repeatOffset))) {
+            log__output(severity, fileName, line, logStr, prefixSize);
         }
-        os_log(logStr);
     }
-}
\ No newline at end of file
+    va_end(valist);
+}
+
+////////////////////////////
+// NOTE(pjako): binary decoding
+
+typedef struct log__BinaryReader {
+    u8* at;
+    u8* end;
+    bx valid;
+} log__BinaryReader;
+
+LOCAL void log__read(log__BinaryReader* reader, void* out, u64 size) {
+    if (!reader->valid || u64_cast(reader->end - reader->at) < size) {
+        reader->valid = false;
+        mem_setZero(out, size);
+        return;
+    }
+    mem_copy(out, reader->at, size);
+    reader->at += size;
+}
+
+LOCAL S8 log__readStr(log__BinaryReader* reader, u64 size) {
+    if (!reader->valid || u64_cast(reader->end - reader->at) < size) {
+        reader->valid = false;
+        return STR_NULL;
+    }
+    S8 str = str_fromCharPtr(reader->at, size);
+    reader->at += size;
+    return str;
+}
+
+// splits off the next record, false at the end or at a truncated record
+LOCAL bx log__readRecord(log__BinaryReader* reader, log__BinaryReader* record, u8* kind) {
+    u32 size = 0;
+    log__read(reader, &size, sizeof(size));
+    record->at = reader->at;
+    record->valid = size > 0;
+    log__readStr(reader, size);
+    record->end = reader->at;
+    log__read(record, kind, 1);
+    return reader->valid && record->valid;
+}
+
+typedef struct log__DecodeSite {
+    S8 fileName;
+    u32 line;
+    u8 severity;
+    str_FmtProgram program;
+} log__DecodeSite;
+
+// the arguments come from the file, they have to cover every placeholder of the template
+LOCAL bx log__decodeArgsMatch(const str_FmtProgram* program, u32 argCount, const str_KeyValue* args) {
+    if (program->argCount > argCount) {
+        return false;
+    }
+    for (u32 opIdx = 0; opIdx < program->opCount; opIdx++) {
+        const str_FmtOp* op = program->ops + opIdx;
+        if (op->kind != str_fmtOpKind_key) {
+            continue;
+        }
+        S8 key = str_fromCharPtr(program->fmt.content + op->offset + 1, op->keySize);
+        bx found = false;
+        for (u32 idx = 0; idx < argCount && !found; idx++) {
+            found = str_isEqual(args[idx].key, key);
+        }
+        if (!found) {
+            return false;
+        }
+    }
+    return true;
+}
+
+API bx log_binaryDecode(Arena* tmpArena, S8 data, str_Builder* out) {
+    ASSERT(out);
+    log__BinaryReader file;
+    file.at = data.content;
+    file.end = data.content + data.size;
+    file.valid = true;
+    S8 magic = log__readStr(&file, 4);
+    u32 version = 0;
+    log__read(&file, &version, sizeof(version));
+    if (!file.valid || !str_isEqual(magic, s8(LOG__BINARY_MAGIC)) || version != LOG__BINARY_VERSION) {
+        return false;
+    }
+    log__BinaryReader start = file;
+    log__BinaryReader record;
+    u8 kind;
+
+    // first pass: the clock samples for the cycle rate and the number of descriptors, ids are assigned from 1 without
+    // gaps so a valid id is never above it
+    u64 firstCycles = 0, firstNs = 0, lastCycles = 0, lastNs = 0;
+    u32 clockCount = 0;
+    u32 siteCount = 0;
+    while (log__readRecord(&file, &record, &kind)) {
+        if (kind == log__binaryKind_clock) {
+            log__read(&record, &lastCycles, sizeof(lastCycles));
+            log__read(&record, &lastNs, sizeof(lastNs));
+            if (clockCount++ == 0) {
+                firstCycles = lastCycles;
+                firstNs = lastNs;
+            }
+        } else if (kind == log__binaryKind_descriptor) {
+            siteCount++;
+        }
+    }
+    // without a second sample the counter is assumed to count nanoseconds
+    f64 nsPerCycle = 1.0;
+    if (clockCount > 1 && lastCycles > firstCycles) {
+        nsPerCycle = f64_cast(lastNs - firstNs) / f64_cast(lastCycles - firstCycles);
+    }
+
+    bx result = true;
+    mem_scoped(scratch, tmpArena) {
+        log__DecodeSite* sites = mem_arenaPushArray(scratch.arena, log__DecodeSite, (u64_cast(siteCount) + 1));
+        if (sites) {
+            mem_setZero(sites, sizeof(log__DecodeSite) * (u64_cast(siteCount) + 1));
+        }
+        result = sites != NULL;
+        i64 cachedSecond = -1;
+        char dateBuffer[32];
+        dateBuffer[0] = '\0';
+        file = start;
+        while (sites && log__readRecord(&file, &record, &kind)) {
+            if (kind == log__binaryKind_descriptor) {
+                u32 id = 0, size = 0;
+                log__DecodeSite site;
+                mem_structSetZero(&site);
+                log__read(&record, &id, sizeof(id));
+                log__read(&record, &site.line, sizeof(site.line));
+                log__read(&record, &site.severity, 1);
+                log__read(&record, &size, sizeof(size));
+                site.fileName = log__readStr(&record, size);
+                log__read(&record, &size, sizeof(size));
+                S8 template = log__readStr(&record, size);
+                if (record.valid && id > 0 && id <= siteCount) {
+                    site.program = str_fmtCompile(scratch.arena, template);
+                    sites[id] = site;
+                }
+                continue;
+            }
+            if (kind != log__binaryKind_message) {
+                continue;
+            }
+            u32 id = 0;
+            u64 cycles = 0;
+            u8 argCount = 0;
+            log__read(&record, &id, sizeof(id));
+            log__read(&record, &cycles, sizeof(cycles));
+            log__read(&record, &argCount, 1);
+            if (!record.valid || id == 0 || id > siteCount || !sites[id].program.fmt.content) {
+                continue;
+            }
+            log__DecodeSite* site = sites + id;
+            mem_scoped(recordScratch, scratch.arena) {
+                str_KeyValue* args = mem_arenaPushArray(recordScratch.arena, str_KeyValue, (argCount + 1));
+                if (args) {
+                    mem_setZero(args, sizeof(str_KeyValue) * (argCount + 1));
+                } else {
+                    record.valid = false;
+                }
+                for (u32 idx = 0; idx < argCount && record.valid; idx++) {
+                    u8 type = 0;
+                    log__read(&record, &type, 1);
+                    if (type & LOG__BINARY_KEYED) {
+                        u16 keySize = 0;
+                        log__read(&record, &keySize, sizeof(keySize));
+                        args[idx].key = log__readStr(&record, keySize);
+                        type &= ~LOG__BINARY_KEYED;
+                    }
+                    if (type == str_argType_str) {
+                        u32 strSize = 0;
+                        log__read(&record, &strSize, sizeof(strSize));
+                        args[idx].value.strVal = log__readStr(&record, strSize);
+                    } else if (type > str_argType_str && type < countOf(log__binaryValueSizes)) {
+                        log__read(&record, &args[idx].value.u64Val, log__binaryValueSizes[type]);
+                    } else {
+                        record.valid = false;
+                    }
+                    args[idx].value.type = (str_argType) type;
+                }
+                if (record.valid) {
+                    i64 ns = i64_cast(firstNs) + i64_cast(f64_cast(i64_cast(cycles - firstCycles)) * nsPerCycle);
+                    i64 second = ns / 1000000000;
+                    if (second != cachedSecond) {
+                        struct tm local;
+                        log__localTime(u64_cast(second), &local);
+                        strftime(dateBuffer, sizeof(dateBuffer), "%Y-%m-%d %H:%M:%S", &local);
+                        cachedSecond = second;
+                    }
+                    S8 severityStr = log__severityStrings[minVal(site->severity, log_severity_fatal)];
+                    char prefix[128];
+                    i32 prefixSize = snprintf(prefix, sizeof(prefix), "%s.%06u %.*s ", dateBuffer, u32_cast((ns % 1000000000) / 1000), i32_cast(severityStr.size), severityStr.content);
+                    str_builderAppend(out, str_fromCharPtr((u8*) prefix, u64_cast(clampVal(0, i32_cast(sizeof(prefix)) - 1, prefixSize))));
+                    str_builderJoin(out, site->fileName, s8(":"), site->line, s8(": "));
+                    if (site->program.valid && log__decodeArgsMatch(&site->program, argCount, args)) {
+                        str_builderAppend(out, str_fmtProgramArgs(recordScratch.arena, &site->program, argCount, args));
+                    } else {
+                        str_builderAppend(out, site->program.fmt);
+                    }
+                    str_builderAppend(out, s8("\n"));
+                }
+            }
+        }
+    }
+    return result;
+}
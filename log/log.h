@@ -12,6 +12,7 @@ typedef enum log_Severity {
     log_severity_warning = 3,
     log_severity_error   = 4,
     log_severity_fatal   = 5,
+    log_severity_off     = 6, // only as a minimum severity, lets nothing through
 } log_Severity;
 
 #ifndef LOG_SEVERITY_MIN
@@ -42,7 +43,7 @@ typedef enum log_Severity {
 #endif
 
 #if LOG_SEVERITY_MIN <= log_severity_warning
-#define log_warnFmt(ARENA, EMPLATE, ...) log_msgFmt(ARENA, log_severity_warning, TEMPLATE, __VA_ARGS__)
+#define log_warnFmt(ARENA, TEMPLATE, ...) log_msgFmt(ARENA, log_severity_warning, TEMPLATE, __VA_ARGS__)
 #define log_warn(ARENA, ...) log_msg(ARENA, log_severity_warning, __VA_ARGS__)
 #else
 #define log_warnFmt(...) 
@@ -65,14 +66,194 @@ typedef enum log_Severity {
 #define log_fatal(...) 
 #endif
 
-#define log_msg(ARENA, SEVERITY, ...) STR_ARG_OVER_UNDER_FLOW_CHECKER(log__msg, STR_AT_LEAST_TWO_ARGS, __VA_ARGS__)(ARENA, SEVERITY, str_lit(__FILE__), __LINE__, STR_ARR_MACRO_CHOOSER(__VA_ARGS__)(str_Value, str__convertToValue, __VA_ARGS__))
-#define log_msgFmt(ARENA, severity, TEMPLATE, ...) STR_ARG_OVER_UNDER_FLOW_CHECKER(log__msgFmt, STR_AT_LEAST_TWO_ARGS, __VA_ARGS__)(ARENA, severity, str_lit(__FILE__), __LINE__, str__convertToKey(TEMPLATE), STR_ARR_MACRO_CHOOSER(__VA_ARGS__)(str_KeyValue, str__convertToKeyValue, __VA_ARGS__))
+// Runtime filtering: every call site has a static log_Site that caches the lowest severity it lets through.
+// The check is a single load before any argument is evaluated, a filtered call costs nothing else.
+// Sites resolve their level on the first call and again whenever the configuration below changes.
+// Define LOG_MODULE before including log.h to tag all call sites of a file with a module name.
+#ifndef LOG_MODULE
+#define LOG_MODULE ""
+#endif
+
+typedef struct log_Site {
+    a32 level; // lowest passing severity + 1, 0 = not resolved yet (the first call resolves it)
+    S8 module;
+    S8 fileName;
+    u32 line;
+    struct log_Site* next;
+    // rate limiting, see log_setRateLimit
+    a64 bucketFullNs;  // time at which the token bucket of the site is full again
+    a32 dropped;       // messages the bucket dropped since the last one that passed
+    a32 repeats;       // identical messages collapsed since the last written one
+    a32 lastSeverity;
+    a64 lastHash;      // hash of the last written message
+    a64 repeatStartNs; // time of the first collapsed message of the current run
+} log_Site;
+
+#define LOG__SITE_INIT {0, {(u8*) LOG_MODULE, sizeof(LOG_MODULE) - 1}}
+#define log__sitePasses(SITE, SEVERITY) (u32_cast(SEVERITY) + 1 >= (SITE).level)
+
+#define log_msg(ARENA, SEVERITY, ...) do { \
+    static log_Site log__site = LOG__SITE_INIT; \
+    if (log__sitePasses(log__site, SEVERITY)) { \
+        STR_ARG_OVER_UNDER_FLOW_CHECKER(log__msg, STR_AT_LEAST_TWO_ARGS, __VA_ARGS__)(ARENA, SEVERITY, &log__site, str_lit(__FILE__), __LINE__, STR_ARR_MACRO_CHOOSER(__VA_ARGS__)(str_Value, str__convertToValue, __VA_ARGS__)); \
+    } \
+} while (0)
+#define log_msgFmt(ARENA, SEVERITY, TEMPLATE, ...) do { \
+    static log_FmtSite log__fmtSite = {LOG__SITE_INIT}; \
+    if (log__sitePasses(log__fmtSite.site, SEVERITY)) { \
+        STR_ARG_OVER_UNDER_FLOW_CHECKER(log__msgFmt, STR_AT_LEAST_TWO_ARGS, __VA_ARGS__)(ARENA, SEVERITY, &log__fmtSite, str_lit(__FILE__), __LINE__, str__convertToKey(TEMPLATE), STR_ARR_MACRO_CHOOSER(__VA_ARGS__)(str_KeyValue, str__convertToKeyValue, __VA_ARGS__)); \
+    } \
+} while (0)
+
+#ifndef LOG_FMT_SITE_OPS
+#define LOG_FMT_SITE_OPS 24
+#endif
+
+// every log_msgFmt call site compiles its template once into this static
+typedef struct log_FmtSite {
+    log_Site site;
+    a32 state; // 0 = not compiled, 1 = compiling, 2 = ready, 3 = template does not fit, always use str_fmt
+    a32 binaryId; // descriptor id in binary logs, 0 = not registered yet
+    str_FmtProgram program;
+    str_FmtOp ops[LOG_FMT_SITE_OPS];
+} log_FmtSite;
+
+API void log__msg(Arena* tmpArena, log_Severity severity, log_Site* site, S8 fileName, u64 line, u32 argCount, ...);
+API void log__msgFmt(Arena* tmpArena, log_Severity severity, log_FmtSite* site, S8 fileName, u64 line, S8 strTemplate, u32 argCount, ...);
+
+// Rules are matched against every call site, a module rule wins over a file rule and later rules win
+// over earlier ones of the same kind. Sites without a matching rule use the default level (trace).
+// Levels only lower what LOG_SEVERITY_MIN compiled in, they can not bring back removed call sites.
+API void log_setDefaultLevel(log_Severity minSeverity);
+API void log_setModuleLevel(S8 module, log_Severity minSeverity);
+// fileGlob is matched against the path relative to PROJECT_ROOT, e.g. "rx/impl/*.c" or "os/**", see str_globCompile
+API bx   log_setFileLevel(S8 fileGlob, log_Severity minSeverity);
+// removes all rules and resets the default level
+API void log_clearLevels(void);
+// comma separated rules, a name with '/', '*' or '.' is a file glob: "info,rx=trace,os/impl/*.c=debug"
+// severities: trace, debug, info, warn, error, fatal, off. Returns false (and applies nothing) on a parse error
+API bx   log_setLevels(S8 spec);
+
+// Rate limiting: every call site has its own token bucket that refills at perSecond messages and holds up to
+// burst of them, a site that logs in a loop can not drown the output or stall the thread on it. Identical messages
+// of one site within repeatWindowMs are collapsed into one "previous message repeated N times" line, written when the
+// site logs something else, when the window is over or on log_flush. Both are checked without locks on the state
+// in the call site's static. The bucket is checked before the message is formatted, repeats after.
+typedef struct log_RateLimitDesc {
+    u32 perSecond;      // messages per second and call site, 0 = no limit
+    u32 burst;          // messages a quiet site can write at once, 0 = perSecond
+    u32 repeatWindowMs; // 0 = identical messages are not collapsed
+} log_RateLimitDesc;
+
+// NULL turns both off
+API void log_setRateLimit(log_RateLimitDesc* desc);
+
+typedef enum log_TimePrecision {
+    log_timePrecision_second, // 2024-01-31 12:00:00
+    log_timePrecision_milli,  // 2024-01-31 12:00:00.123 (default)
+    log_timePrecision_micro,  // 2024-01-31 12:00:00.123456
+} log_TimePrecision;
+
+// sub-second digits of the timestamp in front of every line
+API void log_setTimePrecision(log_TimePrecision precision);
+
+// Structured output: arguments of the Fmt macros passed as str_kv(key, value) become fields of the record next to
+// time, level, file, line, module and the formatted message. Fields are encoded straight from the argument values
+// into the record, numbers stay numbers. The text encoding keeps the plain line and only uses the values in the message.
+typedef enum log_Encoding {
+    log_encoding_text,   // 2024-01-31 12:00:00.123 INFO  app/main.c:12: done (default)
+    log_encoding_json,   // {"time":"2024-01-31T12:00:00.123","level":"info","file":"app/main.c","line":12,"msg":"done","ms":3}
+    log_encoding_logfmt, // time=2024-01-31T12:00:00.123 level=info file=app/main.c line=12 msg=done ms=3
+} log_Encoding;
 
-API void log__msg(Arena* tmpArena, log_Severity severity, S8 fileName, u64 line, u32 argCount, ...);
-API void log__msgFmt(Arena* tmpArena, log_Severity severity, S8 fileName, u64 line, S8 strTemplate, u32 argCount, ...);
+// every sink gets the encoded records, callback sinks the whole record without the line break
+API void log_setEncoding(log_Encoding encoding);
 
-// API S8 log_pull(void);
+// Asynchronous output: every thread appends finished lines to its own ring and a writer thread
+// drains all rings in large gather writes, so the calling thread never waits on the output.
+// Lines of one thread stay in order, lines of different threads are only ordered by their timestamps.
+// Rings are allocated on the first message of a thread and stay alive until the process exits.
+
+typedef enum log_AsyncPolicy {
+    log_asyncPolicy_drop,  // a full ring drops the line, the writer reports how many were lost
+    log_asyncPolicy_block, // a full ring makes the thread wait for the writer
+} log_AsyncPolicy;
+
+typedef struct log_AsyncDesc {
+    u32 ringSize;        // bytes per thread, rounded up to a power of two, 0 = 1MB
+    u32 flushIntervalMs; // longest time a line waits in a ring, 0 = 10ms
+    log_AsyncPolicy policy;
+} log_AsyncDesc;
+
+// no other thread may log while the writer starts or stops
+API bx   log_asyncStart(log_AsyncDesc* desc);
+// writes what is left and joins the writer, messages are written synchronously again afterwards
+API void log_asyncStop(void);
+// writes pending repeat summaries, returns once every line logged before the call is written and the file sinks are flushed
+API void log_flush(void);
+
+// Binary output: instead of formatting the line a log_msgFmt call site writes its descriptor id,
+// a tm_cycleCount timestamp and the raw argument bytes. The descriptor (file, line, severity, template) is
+// registered on the first call and written once per file. Records go through the async rings into a .blog file
+// that log_binaryDecode (or the blog tool) expands into text. log_msg is not affected and keeps writing text.
+// The file is written in the byte order of the machine, decode it on one with the same order.
+
+// starts the async writer with default settings if it is not running already
+API bx   log_binaryStart(S8 fileName);
+API void log_binaryStop(void);
+// appends the text of a .blog file, a truncated last record (crash) is skipped. tmpArena can not be the builder arena
+API bx   log_binaryDecode(Arena* tmpArena, S8 data, str_Builder* out);
+
+// Sinks: every text line goes to all sinks whose severity it reaches. Sink 0 is the console (os_log)
+// and exists from the start. With async output the sinks run on the writer thread, otherwise on the
+// logging thread under a lock. Binary records (log_binaryStart) do not reach the sinks.
+
+#ifndef LOG_SINK_MAX
+#define LOG_SINK_MAX 8
+#endif
+
+// str is the formatted message without the timestamp prefix and the line break.
+// Callbacks run with the sinks locked. Lines they log are written right away to the other sinks, callbacks do not see them.
+// They must not call log_flush or the sink functions.
 typedef void (log_callbackFn) (log_Severity severity, S8 fileName, u64 line, S8 str, void* user);
+
+typedef enum log_SinkType {
+    log_sinkType_console,  // os_log
+    log_sinkType_stderr,
+    log_sinkType_file,
+    log_sinkType_ring,     // keeps the latest lines in memory, see log_sinkRingRead
+    log_sinkType_callback,
+    log_sinkType_mmap,     // ring in a memory mapped file that survives a crash of the process, see log_mmapDecode
+} log_SinkType;
+
+typedef struct log_SinkDesc {
+    log_SinkType type;
+    log_Severity minSeverity;
+    // file: the current file is renamed to fileName.1 (fileName.1 to fileName.2 ...) and a new one opened
+    S8 fileName;
+    u64 rotateSize;        // bytes, 0 = no size limit
+    u32 rotateIntervalSec; // 0 = no time limit
+    u32 rotateCount;       // rotated files kept, 0 = 4
+    u32 syncIntervalMs;    // writes are buffered, flushed and fsynced at this interval, 0 = 1000ms
+    // ring, mmap (uses fileName too)
+    u32 ringSize;          // 0 = 64KB for rings, 4MB for mmap
+    // callback
+    log_callbackFn* callback;
+    void* user;
+} log_SinkDesc;
+
+// returns the sink index, -1 if all LOG_SINK_MAX sinks are in use or the file can not be opened
+API i32  log_sinkAdd(log_SinkDesc* desc);
+API void log_sinkRemove(i32 sink);
+API void log_sinkSetSeverity(i32 sink, log_Severity minSeverity);
+// copy of the lines in a ring or mmap sink, oldest first
+API S8   log_sinkRingRead(Arena* arena, i32 sink);
+// The mmap sink writes lines with plain stores into the mapped file, the header keeps the total written size.
+// An existing file of the same size is continued, so a restarted process does not overwrite what the crashed one wrote.
+// lines of an mmap sink file (read after a crash), oldest first, STR_NULL if data is not one
+API S8   log_mmapDecode(Arena* arena, S8 data);
+
+// a callback sink for all severities, replaces the one of the last call, NULL removes it
 API void log_setCallback(log_callbackFn* callback, void* user);
 
 #ifdef __cplusplus
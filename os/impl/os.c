@@ -4,8 +4,103 @@
 #include "base/base_math.h"
 #include "base/base_str.h"
 #include "base/base_time.h"
+#include "base/base_atomic.h"
 #include "os/os.h"
 
+/////////////////////////
+// File Helper, the same on every platform
+
+// the separator automaton is built by the first os_fixFilepath call and shared by all threads afterwards
+static struct {
+    a32 state; // 0 = not built, 1 = building, 2 = ready
+    str_Matcher* matcher;
+    ALIGN_DECL(16, u8 memory[sizeof(Arena) + KILOBYTE(2)]);
+} os__pathMatcher;
+
+LOCAL str_Matcher* os__pathMatcherGet(void) {
+    if (a32_loadAcquire(&os__pathMatcher.state) == 2) {
+        return os__pathMatcher.matcher;
+    }
+    if (a32_compareAndSwap(&os__pathMatcher.state, 0, 1) == 0) {
+        S8 separators[] = {s8("\\"), s8("/."), s8("\\."), s8("/.."), s8("\\..")};
+        Arena* matcherArena = mem_makeArenaPreAllocated(os__pathMatcher.memory, sizeof(os__pathMatcher.memory));
+        os__pathMatcher.matcher = str_matcherInit(matcherArena, separators, countOf(separators));
+        a32_storeRelease(&os__pathMatcher.state, 2);
+    }
+    while (a32_loadAcquire(&os__pathMatcher.state) != 2) {
+        os_yield();
+    }
+    return os__pathMatcher.matcher;
+}
+
+S8 os_fixFilepath(Arena* arena, S8 path) {
+    str_Matcher* matcher = os__pathMatcherGet();
+
+    // the fixed path is never longer than the input
+    S8 result = str_alloc(arena, path.size);
+    u64 size = 0;
+    u64 copyStart = 0;
+    str_Match match;
+    while (str_matcherFind(matcher, path, copyStart, &match)) {
+        mem_copy(result.content + size, path.content + copyStart, match.offset - copyStart);
+        size += match.offset - copyStart;
+        copyStart = match.offset + match.size;
+        u64 end = match.offset + match.size;
+        bx segmentEnds = end == path.size || path.content[end] == '/' || path.content[end] == '\\';
+        if (match.size == 1 || !segmentEnds) {
+            // plain separator (or a name like ".hidden"), the separator is normalized and the rest copied as is
+            result.content[size++] = '/';
+            mem_copy(result.content + size, path.content + match.offset + 1, match.size - 1);
+            size += match.size - 1;
+            continue;
+        }
+        if (match.size == 2) {
+            // "/." followed by a separator or the end, the separator after it starts the next segment
+            if (size == 0 && end == path.size) {
+                result.content[size++] = '/';
+            }
+            continue;
+        }
+        // "/.." removes the previous segment unless there is none or it is a ".." itself
+        u64 segmentStart = size;
+        while (segmentStart > 0 && result.content[segmentStart - 1] != '/') segmentStart--;
+        S8 segment = str_fromCharPtr(result.content + segmentStart, size - segmentStart);
+        if (size == 0) {
+            // the separator is the root of an absolute path, there is nothing above it
+            if (end == path.size) {
+                result.content[size++] = '/';
+            }
+            continue;
+        }
+        if (str_isEqual(segment, s8("."))) {
+            // "./.." is the parent of the current directory
+            mem_copy(result.content + segmentStart, "..", 2);
+            size = segmentStart + 2;
+            continue;
+        }
+        if (segment.size == 0 || str_isEqual(segment, s8(".."))) {
+            mem_copy(result.content + size, "/..", 3);
+            size += 3;
+            continue;
+        }
+        if (segmentStart == 0 && end < path.size) {
+            // relative path lost its first segment, don't turn it into an absolute one
+            copyStart += 1;
+        }
+        if (segmentStart == 0 && end == path.size) {
+            // relative path lost its only segment
+            result.content[0] = '.';
+            size = 1;
+            continue;
+        }
+        // an absolute path keeps its root
+        size = segmentStart == 1 && end == path.size ? 1 : (segmentStart > 0 ? segmentStart - 1 : 0);
+    }
+    mem_copy(result.content + size, path.content + copyStart, path.size - copyStart);
+    result.size = size + path.size - copyStart;
+    return result;
+}
+
 #if OS_APPLE || OS_ANDROID || OS_UNIX || OS_LINUX
 #include <sys/mman.h>
 #include <unistd.h>
@@ -17,7 +112,15 @@
 #include <stdio.h>
 #include <limits.h>
 #include <sys/stat.h>
+#include <sys/uio.h>
 #include <dlfcn.h>
+#include <dirent.h>
+#include <fcntl.h>
+
+#if OS_LINUX || OS_ANDROID
+#include <sys/syscall.h>
+#include <sys/inotify.h>
+#endif
 
 #if OS_APPLE
 #include <sys/types.h>
@@ -190,7 +293,7 @@ DateTime os_timeUniversalFromLocal(DateTime* date_time) {
 u64 os_timeMicrosecondsNow(void) {
 	struct timespec ts;
     clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
-	u64 us = ((u64)ts.tv_sec * 1000000) + ((u64)ts.tv_nsec / 1000000);
+	u64 us = ((u64)ts.tv_sec * 1000000) + ((u64)ts.tv_nsec / 1000);
     return us;
 }
 
@@ -237,6 +340,97 @@ bx os_fileWrite(S8 fileName, S8 data) {
     return result;
 }
 
+LOCAL bx os__writeSpans(i32 fileHandle, S8* spans, u32 spanCount) {
+    bx result = true;
+    struct iovec vecs[64];
+    u32 spanIdx = 0;
+    u64 spanOffset = 0;
+    while (spanIdx < spanCount) {
+        u32 vecCount = 0;
+        for (u32 idx = spanIdx; idx < spanCount && vecCount < countOf(vecs); idx++) {
+            u64 offset = idx == spanIdx ? spanOffset : 0;
+            vecs[vecCount].iov_base = spans[idx].content + offset;
+            vecs[vecCount].iov_len = spans[idx].size - offset;
+            vecCount++;
+        }
+        ssize_t written = writev(fileHandle, vecs, vecCount);
+        if (written < 0) {
+            result = false;
+            break;
+        }
+        // skip over what was written, writev may stop in the middle of a span
+        u64 remaining = u64_cast(written);
+        while (spanIdx < spanCount && remaining >= spans[spanIdx].size - spanOffset) {
+            remaining -= spans[spanIdx].size - spanOffset;
+            spanOffset = 0;
+            spanIdx++;
+        }
+        spanOffset += remaining;
+    }
+    return result;
+}
+
+bx os_fileWriteSpans(S8 fileName, S8* spans, u32 spanCount) {
+    u8 path[255 + 4096 + 1];
+    ASSERT(sizeof(path) > (fileName.size + 1));
+    ASSERT(fileName.content);
+    ASSERT(fileName.size > 0);
+    mem_copy(path, fileName.content, fileName.size);
+    path[fileName.size] = '\0';
+    i32 fileHandle = open((const char*) path, O_WRONLY | O_CREAT | O_TRUNC, S_IRUSR + S_IWUSR + S_IRGRP + S_IROTH);
+    if (fileHandle == -1) {
+        return false;
+    }
+    bx result = os__writeSpans(fileHandle, spans, spanCount);
+    close(fileHandle);
+    return result;
+}
+
+bx os_fileMapOpen(os_FileMap* map, S8 fileName, u64 size) {
+    ASSERT(map);
+    ASSERT(size > 0);
+    map->content = NULL;
+    map->size = 0;
+    u8 path[255 + 4096 + 1];
+    ASSERT(sizeof(path) > (fileName.size + 1));
+    ASSERT(fileName.content);
+    ASSERT(fileName.size > 0);
+    mem_copy(path, fileName.content, fileName.size);
+    path[fileName.size] = '\0';
+    i32 fileHandle = open((const char*) path, O_RDWR | O_CREAT, S_IRUSR + S_IWUSR + S_IRGRP + S_IROTH);
+    if (fileHandle == -1) {
+        return false;
+    }
+    void* content = MAP_FAILED;
+    if (ftruncate(fileHandle, (off_t) size) == 0) {
+        content = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileHandle, 0);
+    }
+    // the mapping keeps the file alive
+    close(fileHandle);
+    if (content == MAP_FAILED) {
+        return false;
+    }
+    map->content = (u8*) content;
+    map->size = size;
+    return true;
+}
+
+void os_fileMapSync(os_FileMap* map) {
+    ASSERT(map);
+    if (map->content) {
+        msync(map->content, map->size, MS_SYNC);
+    }
+}
+
+void os_fileMapClose(os_FileMap* map) {
+    ASSERT(map);
+    if (map->content) {
+        munmap(map->content, map->size);
+    }
+    map->content = NULL;
+    map->size = 0;
+}
+
 bx os_fileDelete(S8 fileName) {
     u8 path[255 + 4096 + 1];
     ASSERT(sizeof(path) > (fileName.size + 1));
@@ -283,6 +477,858 @@ bx os_dirDelete(S8 dirname) {
 	return o == -1 ? false : true;
 }
 
+/////////////////////////
+// Directory listing
+
+// NOTE(pjako): directories are a shared work queue, every walker lists one directory at a time into its own arenas
+// and queues the subdirectories it finds. On Linux the entries come straight from getdents64 in large batches.
+
+#define OS__PATH_WALK_BUFFER_SIZE KILOBYTE(64)
+
+#if OS_LINUX || OS_ANDROID
+// layout of the records getdents64 writes, glibc only declares dirent64 with _LARGEFILE64_SOURCE
+typedef struct os__LinuxDirent64 {
+    u64 ino;
+    i64 offset;
+    u16 recordSize;
+    u8 type;
+    char name[];
+} os__LinuxDirent64;
+#endif
+
+typedef struct os__PathWalk {
+    const str_Glob* glob;
+    flags32 flags;
+    i32 rootFd;
+    u32 threadCount;
+    os_Mutex lock;
+    os_Semaphore workAvailable;
+    // guarded by lock
+    Arena* queueArena;
+    S8* queue;
+    u32 queueCount;
+    u32 queueCapacity;
+    u32 pending; // queued directories and directories being listed
+} os__PathWalk;
+
+typedef struct os__PathWalker {
+    os_Thread thread;
+    os__PathWalk* walk;
+    Arena* strings;
+    Arena* list;    // only S8 entries, so they end up as one contiguous array
+    S8* entries;
+    u64 count;
+    u8* buffer;
+    bx started;     // helper thread is running, the calling thread is walker 0
+} os__PathWalker;
+
+// the terminator is not part of the size, so paths can be passed to the os and used as regular strings
+LOCAL S8 os__pathCopy(Arena* arena, const u8* content, u64 size) {
+    S8 path = str_alloc(arena, size + 1);
+    mem_copy(path.content, content, size);
+    path.content[size] = '\0';
+    path.size = size;
+    return path;
+}
+
+LOCAL void os__pathWalkQueue(os__PathWalk* walk, S8 directory) {
+    os_mutexScoped(&walk->lock) {
+        if (walk->queueCount == walk->queueCapacity) {
+            u32 capacity = maxVal(walk->queueCapacity * 2, 64);
+            S8* queue = mem_arenaPushArray(walk->queueArena, S8, capacity);
+            if (walk->queueCount > 0) {
+                mem_copy(queue, walk->queue, sizeof(S8) * walk->queueCount);
+            }
+            walk->queue = queue;
+            walk->queueCapacity = capacity;
+        }
+        walk->queue[walk->queueCount++] = directory;
+        walk->pending++;
+    }
+    os_semaphorePost(&walk->workAvailable, 1);
+}
+
+// path is directory + '/' + name in buffer, null terminated
+LOCAL void os__pathWalkEntry(os__PathWalker* walker, u8* path, u64 pathSize, bx isDirectory) {
+    os__PathWalk* walk = walker->walk;
+    S8 entry = str_fromCharPtr(path, pathSize);
+    bx queue = isDirectory && (walk->flags & os_pathListFlag_recursive) && (!walk->glob || str_globCanMatchBelow(walk->glob, entry));
+    bx list = (!isDirectory || (walk->flags & os_pathListFlag_directories)) && (!walk->glob || str_globMatch(walk->glob, entry));
+    if (!queue && !list) {
+        return;
+    }
+    S8 stored = os__pathCopy(walker->strings, path, pathSize);
+    if (list) {
+        S8* slot = mem_arenaPushStruct(walker->list, S8);
+        ASSERT(!walker->entries || slot == walker->entries + walker->count);
+        walker->entries = walker->entries ? walker->entries : slot;
+        walker->entries[walker->count++] = stored;
+    }
+    if (queue) {
+        os__pathWalkQueue(walk, stored);
+    }
+}
+
+LOCAL void os__pathWalkName(os__PathWalker* walker, i32 fd, u8* path, u64 nameOffset, const char* name, u8 type) {
+    if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+        return;
+    }
+    u64 nameSize = strlen(name);
+    if (nameOffset + nameSize >= PATH_MAX) {
+        return;
+    }
+    mem_copy(path + nameOffset, name, nameSize + 1);
+    if (type == DT_UNKNOWN) {
+        // not every file system fills in the type
+        struct stat st;
+        if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+            return;
+        }
+        type = S_ISDIR(st.st_mode) ? DT_DIR : DT_REG;
+    }
+    os__pathWalkEntry(walker, path, nameOffset + nameSize, type == DT_DIR);
+}
+
+LOCAL void os__pathWalkDirectory(os__PathWalker* walker, S8 directory) {
+    os__PathWalk* walk = walker->walk;
+    u8 path[PATH_MAX + 1];
+    if (directory.size + 2 >= PATH_MAX) {
+        return;
+    }
+    i32 fd = openat(walk->rootFd, directory.size > 0 ? (const char*) directory.content : ".", O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd == -1) {
+        return;
+    }
+    u64 nameOffset = 0;
+    if (directory.size > 0) {
+        mem_copy(path, directory.content, directory.size);
+        path[directory.size] = '/';
+        nameOffset = directory.size + 1;
+    }
+#if OS_LINUX || OS_ANDROID
+    for (;;) {
+        long size = syscall(SYS_getdents64, fd, walker->buffer, OS__PATH_WALK_BUFFER_SIZE);
+        if (size <= 0) {
+            break;
+        }
+        for (long offset = 0; offset < size;) {
+            os__LinuxDirent64* entry = (os__LinuxDirent64*) (walker->buffer + offset);
+            offset += entry->recordSize;
+            os__pathWalkName(walker, fd, path, nameOffset, entry->name, entry->type);
+        }
+    }
+    close(fd);
+#else
+    DIR* dir = fdopendir(fd);
+    if (!dir) {
+        close(fd);
+        return;
+    }
+    for (struct dirent* entry = readdir(dir); entry; entry = readdir(dir)) {
+        os__pathWalkName(walker, fd, path, nameOffset, entry->d_name, entry->d_type);
+    }
+    closedir(dir);
+#endif
+}
+
+LOCAL i32 os__pathWalkRun(os_Thread* thread, void* userData) {
+    unusedVars(thread);
+    os__PathWalker* walker = (os__PathWalker*) userData;
+    os__PathWalk* walk = walker->walk;
+    for (;;) {
+        S8 directory = {0};
+        bx hasWork = false;
+        bx done = false;
+        os_mutexScoped(&walk->lock) {
+            if (walk->queueCount > 0) {
+                directory = walk->queue[--walk->queueCount];
+                hasWork = true;
+            } else {
+                done = walk->pending == 0;
+            }
+        }
+        if (done) {
+            break;
+        }
+        if (!hasWork) {
+            os_semaphoreWait(&walk->workAvailable, -1);
+            continue;
+        }
+        os__pathWalkDirectory(walker, directory);
+        bx finished = false;
+        os_mutexScoped(&walk->lock) {
+            walk->pending--;
+            finished = walk->pending == 0;
+        }
+        if (finished) {
+            // wake every walker so they see that there is nothing left
+            os_semaphorePost(&walk->workAvailable, walk->threadCount);
+        }
+    }
+    return 0;
+}
+
+S8* os_pathListFiltered(Arena* arena, S8 pathName, os_PathListDesc* desc, u64* pathCount) {
+    ASSERT(arena && desc && pathCount);
+    *pathCount = 0;
+    mem_defineMakeStackArena(tmpMem, PATH_MAX + 1);
+    if (!str_isNullTerminated(pathName)) {
+        pathName = str_copyNullTerminated(tmpMem, pathName);
+    }
+    i32 rootFd = open((const char*) pathName.content, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (rootFd == -1) {
+        return NULL;
+    }
+
+    BaseMemory baseMem = os_getBaseMemory();
+    os__PathWalk walk;
+    mem_structSetZero(&walk);
+    walk.flags = desc->flags;
+    walk.rootFd = rootFd;
+    walk.threadCount = (desc->flags & os_pathListFlag_recursive) ? maxVal(desc->threadCount, 1) : 1;
+    walk.queueArena = mem_makeArena(&baseMem, MEGABYTE(256));
+
+    S8 root = str_lit("");
+    if (desc->pattern.size > 0) {
+        walk.glob = str_globCompile(walk.queueArena, desc->pattern);
+        if (!walk.glob) {
+            // an invalid pattern lists nothing instead of everything
+            mem_destroyArena(walk.queueArena);
+            close(rootFd);
+            return NULL;
+        }
+        if (walk.glob->prefix.size > 0) {
+            // literal leading directories are not listed, the walk starts below them
+            root = os__pathCopy(walk.queueArena, walk.glob->prefix.content, walk.glob->prefix.size - 1);
+        }
+    }
+    os_mutexInit(&walk.lock);
+    os_semaphoreInit(&walk.workAvailable);
+
+    os__PathWalker* walkers = mem_arenaPushArrayZero(walk.queueArena, os__PathWalker, walk.threadCount);
+    for (u32 idx = 0; idx < walk.threadCount; idx++) {
+        walkers[idx].walk = &walk;
+        // the calling thread keeps its strings in the result arena, so only the other walkers need to be copied
+        walkers[idx].strings = idx == 0 ? arena : mem_makeArena(&baseMem, GIGABYTE(1));
+        walkers[idx].list = mem_makeArena(&baseMem, GIGABYTE(1));
+        walkers[idx].buffer = (u8*) mem_arenaPush(walk.queueArena, OS__PATH_WALK_BUFFER_SIZE);
+    }
+    os__pathWalkQueue(&walk, root);
+    for (u32 idx = 1; idx < walk.threadCount; idx++) {
+        // the calling thread walks until the queue is empty, so missing helpers only make the walk slower
+        walkers[idx].started = os_threadCreate(&walkers[idx].thread, os__pathWalkRun, &walkers[idx], KILOBYTE(64), str_lit("os_pathList"));
+    }
+    os__pathWalkRun(NULL, &walkers[0]);
+
+    u64 count = 0;
+    for (u32 idx = 0; idx < walk.threadCount; idx++) {
+        if (walkers[idx].started) {
+            os_threadShutdown(&walkers[idx].thread);
+        }
+        count += walkers[idx].count;
+    }
+    S8* paths = mem_arenaPushArray(arena, S8, count);
+    u64 offset = 0;
+    for (u32 idx = 0; idx < walk.threadCount; idx++) {
+        for (u64 entry = 0; entry < walkers[idx].count; entry++) {
+            S8 path = walkers[idx].entries[entry];
+            paths[offset++] = idx == 0 ? path : os__pathCopy(arena, path.content, path.size);
+        }
+        if (idx > 0) {
+            mem_destroyArena(walkers[idx].strings);
+        }
+        mem_destroyArena(walkers[idx].list);
+    }
+
+    os_semaphoreDestroy(&walk.workAvailable);
+    os_mutexDestroy(&walk.lock);
+    mem_destroyArena(walk.queueArena);
+    close(rootFd);
+    *pathCount = count;
+    return paths;
+}
+
+S8* os_pathList(Arena* arena, S8 pathName, u64* pathCount) {
+    os_PathListDesc desc;
+    mem_structSetZero(&desc);
+    desc.flags = os_pathListFlag_directories;
+    return os_pathListFiltered(arena, pathName, &desc, pathCount);
+}
+
+/////////////////////////
+// Filesystem watching
+
+#if OS_LINUX || OS_ANDROID
+// NOTE(pjako): inotify watches single directories, so recursive watches add one inotify watch per subdirectory and
+// follow the directories that get created or moved in. Events are read in batches from a non blocking descriptor and
+// merged per path, a path is reported once nothing happened to it for OS_FS_WATCH_DEBOUNCE_MS.
+// Pending events are found through an open addressing table keyed by the path hash (or the move cookie), their arrays
+// come from the OS so they are given back when they grow. When the kernel queue overflows the watched trees are listed
+// again, see os__fsWatchRescan.
+
+#define OS__FS_WATCH_BUFFER_SIZE KILOBYTE(64)
+#define OS__FS_WATCH_MASK (IN_CREATE | IN_DELETE | IN_MODIFY | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | IN_DONT_FOLLOW | IN_EXCL_UNLINK)
+// a pending change that canceled itself out (created and deleted again)
+#define OS__FS_ACTION_NONE ((os_fsAction) 0)
+// the path arena is compacted once it holds more than this and twice the paths of the pending events
+#define OS__FS_WATCH_COMPACT_SIZE KILOBYTE(64)
+
+typedef struct os__FsWatch {
+    os_fsPathWatchCallback* callback;
+    void* custom;
+    os_fsPathWatchFlags flags;
+    bx active;
+    S8 path;   // null terminated, listed again after a queue overflow
+} os__FsWatch;
+
+typedef struct os__FsWatchDir {
+    u32 watch; // watch index + 1, 0 for unused watch descriptors
+    S8 path;   // null terminated
+} os__FsWatchDir;
+
+typedef struct os__FsWatchEvent {
+    u64 key;         // hash of the path, of the cookie for move markers
+    S8 path;
+    u64 lastNs;
+    u32 watch;
+    os_fsAction action;
+    u32 cookie;      // != 0 for the marker of a move source that waits for its destination
+    bx isDirectory;
+} os__FsWatchEvent;
+
+struct os_fsPathWatchCtx {
+    i32 fd;
+    Arena* arena;      // watches, directories and their paths
+    Arena* eventArena; // paths of pending events, reset when nothing is pending or compacted into spareArena
+    Arena* spareArena;
+    os__FsWatch* watches;
+    u32 watchCount;
+    u32 watchCapacity;
+    os__FsWatchDir* dirs; // indexed by the inotify watch descriptor
+    u32 dirCapacity;
+    os__FsWatchEvent* events;
+    u32 eventCount;
+    u32 eventCapacity;
+    u32* slots;        // event index + 1, 0 = empty, twice eventCapacity so probes end on an empty slot
+    u32 slotCapacity;
+    os__FsWatchEvent* due;
+    u32 dueCapacity;
+    u8* buffer;
+};
+
+LOCAL u64 os__fsWatchNow(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return u64_cast(ts.tv_sec) * 1000000000 + u64_cast(ts.tv_nsec);
+}
+
+LOCAL void os__fsWatchAddDir(os_fsPathWatchCtx* ctx, i32 wd, u32 watch, S8 path) {
+    if (u32_cast(wd) >= ctx->dirCapacity) {
+        // watch descriptors are handed out increasing over the lifetime of the inotify instance
+        u32 capacity = maxVal(ctx->dirCapacity * 2, maxVal(u32_cast(wd) + 1, 64));
+        os__FsWatchDir* dirs = mem_arenaPushArrayZero(ctx->arena, os__FsWatchDir, capacity);
+        if (ctx->dirCapacity > 0) {
+            mem_copy(dirs, ctx->dirs, sizeof(os__FsWatchDir) * ctx->dirCapacity);
+        }
+        ctx->dirs = dirs;
+        ctx->dirCapacity = capacity;
+    }
+    os__FsWatchDir* dir = ctx->dirs + wd;
+    dir->watch = watch;
+    // adding the same directory again returns the same descriptor, the path is still the same then
+    if (!str_isEqual(dir->path, path)) {
+        dir->path = os__pathCopy(ctx->arena, path.content, path.size);
+    }
+}
+
+// moves count elements to new OS memory for capacity elements and gives the old memory back
+LOCAL void* os__fsWatchRealloc(void* data, u32 count, u32 oldCapacity, u32 capacity, u64 elementSize) {
+    u64 pageSize = os_memoryPageSize();
+    u64 size = alignUp(capacity * elementSize, pageSize);
+    void* result = os_memoryReserve(size);
+    os_memoryCommit(result, size);
+    if (data) {
+        mem_copy(result, data, count * elementSize);
+        os_memoryRelease(data, alignUp(oldCapacity * elementSize, pageSize));
+    }
+    return result;
+}
+
+INLINE u64 os__fsWatchCookieKey(u32 cookie) {
+    return u64_cast(cookie) * u64_val(0x9E3779B97F4A7C15);
+}
+
+// a path event (cookie 0) or the move marker of cookie
+LOCAL os__FsWatchEvent* os__fsWatchFind(os_fsPathWatchCtx* ctx, u64 key, S8 path, u32 cookie) {
+    if (ctx->slotCapacity == 0) {
+        return NULL;
+    }
+    u32 mask = ctx->slotCapacity - 1;
+    for (u32 slot = u32_cast(key) & mask; ctx->slots[slot] != 0; slot = (slot + 1) & mask) {
+        os__FsWatchEvent* event = ctx->events + ctx->slots[slot] - 1;
+        if (event->key == key && event->cookie == cookie && (cookie != 0 || str_isEqual(event->path, path))) {
+            return event;
+        }
+    }
+    return NULL;
+}
+
+LOCAL void os__fsWatchSlotInsert(os_fsPathWatchCtx* ctx, u32 index) {
+    u32 mask = ctx->slotCapacity - 1;
+    u32 slot = u32_cast(ctx->events[index].key) & mask;
+    while (ctx->slots[slot] != 0) {
+        slot = (slot + 1) & mask;
+    }
+    ctx->slots[slot] = index + 1;
+}
+
+LOCAL u32 os__fsWatchSlotOf(os_fsPathWatchCtx* ctx, u32 index) {
+    u32 mask = ctx->slotCapacity - 1;
+    u32 slot = u32_cast(ctx->events[index].key) & mask;
+    while (ctx->slots[slot] != index + 1) {
+        slot = (slot + 1) & mask;
+    }
+    return slot;
+}
+
+// backward shift deletion, the entries after the slot move up unless that puts them before their home slot
+LOCAL void os__fsWatchSlotRemove(os_fsPathWatchCtx* ctx, u32 index) {
+    u32 mask = ctx->slotCapacity - 1;
+    u32 slot = os__fsWatchSlotOf(ctx, index);
+    for (u32 next = (slot + 1) & mask; ctx->slots[next] != 0; next = (next + 1) & mask) {
+        u32 home = u32_cast(ctx->events[ctx->slots[next] - 1].key) & mask;
+        if (((next - home) & mask) >= ((next - slot) & mask)) {
+            ctx->slots[slot] = ctx->slots[next];
+            slot = next;
+        }
+    }
+    ctx->slots[slot] = 0;
+}
+
+LOCAL void os__fsWatchSlotsRebuild(os_fsPathWatchCtx* ctx) {
+    mem_setZero(ctx->slots, sizeof(u32) * ctx->slotCapacity);
+    for (u32 idx = 0; idx < ctx->eventCount; idx++) {
+        os__fsWatchSlotInsert(ctx, idx);
+    }
+}
+
+// removes the event at index, the last event takes its place
+LOCAL void os__fsWatchRemove(os_fsPathWatchCtx* ctx, u32 index) {
+    os__fsWatchSlotRemove(ctx, index);
+    u32 last = --ctx->eventCount;
+    if (index != last) {
+        ctx->slots[os__fsWatchSlotOf(ctx, last)] = index + 1;
+        ctx->events[index] = ctx->events[last];
+    }
+}
+
+LOCAL void os__fsWatchRecord(os_fsPathWatchCtx* ctx, u32 watch, S8 path, os_fsAction action, u32 cookie, bx isDirectory, u64 now);
+
+// path is null terminated, report lists the entries as created (for directories that appear after the watch started)
+LOCAL bx os__fsWatchAddTree(os_fsPathWatchCtx* ctx, u32 watch, S8 path, bx report, u64 now) {
+    i32 wd = inotify_add_watch(ctx->fd, (const char*) path.content, OS__FS_WATCH_MASK | IN_ONLYDIR);
+    if (wd < 0) {
+        return false;
+    }
+    os__fsWatchAddDir(ctx, wd, watch, path);
+    bx recursive = (ctx->watches[watch - 1].flags & os_fsPathTrackFlag_recursive) != 0;
+    if (!recursive && !report) {
+        return true;
+    }
+    // the watch is added before listing, whatever is created in between shows up as an event or in the listing
+    DIR* dir = opendir((const char*) path.content);
+    if (!dir) {
+        return true;
+    }
+    u8 entryPath[PATH_MAX + 1];
+    for (struct dirent* entry = readdir(dir); entry; entry = readdir(dir)) {
+        S8 name = str_fromNullTerminatedCharPtr(entry->d_name);
+        if (str_isEqual(name, str_lit(".")) || str_isEqual(name, str_lit("..")) || path.size + 1 + name.size > PATH_MAX) {
+            continue;
+        }
+        mem_copy(entryPath, path.content, path.size);
+        entryPath[path.size] = '/';
+        mem_copy(entryPath + path.size + 1, name.content, name.size);
+        entryPath[path.size + 1 + name.size] = '\0';
+        S8 child = str_fromCharPtr(entryPath, path.size + 1 + name.size);
+
+        bx isDirectory = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat info;
+            isDirectory = lstat((const char*) entryPath, &info) == 0 && S_ISDIR(info.st_mode);
+        }
+        if (report) {
+            os__fsWatchRecord(ctx, watch, child, os_fsAction_create, 0, isDirectory, now);
+        }
+        if (isDirectory && recursive) {
+            os__fsWatchAddTree(ctx, watch, child, report, now);
+        }
+    }
+    closedir(dir);
+    return true;
+}
+
+// removes the watches of path and everything below it
+LOCAL void os__fsWatchRemoveTree(os_fsPathWatchCtx* ctx, S8 path) {
+    for (u32 wd = 0; wd < ctx->dirCapacity; wd++) {
+        os__FsWatchDir* dir = ctx->dirs + wd;
+        if (dir->watch == 0 || dir->path.size < path.size || !str_isEqual(str_subStr(dir->path, 0, path.size), path)) {
+            continue;
+        }
+        if (dir->path.size == path.size || dir->path.content[path.size] == '/') {
+            inotify_rm_watch(ctx->fd, i32_cast(wd));
+            dir->watch = 0;
+        }
+    }
+}
+
+// a directory moved inside of the watched tree keeps its watch descriptors, only the paths change
+LOCAL void os__fsWatchRenameTree(os_fsPathWatchCtx* ctx, S8 from, S8 to) {
+    for (u32 wd = 0; wd < ctx->dirCapacity; wd++) {
+        os__FsWatchDir* dir = ctx->dirs + wd;
+        if (dir->watch == 0 || dir->path.size < from.size || !str_isEqual(str_subStr(dir->path, 0, from.size), from)) {
+            continue;
+        }
+        if (dir->path.size == from.size || dir->path.content[from.size] == '/') {
+            S8 rest = str_from(dir->path, from.size);
+            S8 path = str_alloc(ctx->arena, to.size + rest.size + 1);
+            mem_copy(path.content, to.content, to.size);
+            if (rest.size > 0) {
+                mem_copy(path.content + to.size, rest.content, rest.size);
+            }
+            path.size = to.size + rest.size;
+            path.content[path.size] = '\0';
+            dir->path = path;
+        }
+    }
+}
+
+LOCAL os_fsAction os__fsWatchMerge(os_fsAction pending, os_fsAction action) {
+    switch (action) {
+        case os_fsAction_create: return pending == os_fsAction_delete ? os_fsAction_modifiy : (pending == OS__FS_ACTION_NONE ? os_fsAction_create : pending);
+        case os_fsAction_delete: return pending == os_fsAction_create ? OS__FS_ACTION_NONE : os_fsAction_delete;
+        case os_fsAction_modifiy: return pending == OS__FS_ACTION_NONE ? os_fsAction_modifiy : pending;
+        default: return action;
+    }
+}
+
+LOCAL void os__fsWatchRecord(os_fsPathWatchCtx* ctx, u32 watch, S8 path, os_fsAction action, u32 cookie, bx isDirectory, u64 now) {
+    u64 key = cookie == 0 ? str_hash64(path) : os__fsWatchCookieKey(cookie);
+    if (cookie == 0) {
+        os__FsWatchEvent* event = os__fsWatchFind(ctx, key, path, 0);
+        if (event) {
+            event->action = os__fsWatchMerge(event->action, action);
+            event->lastNs = now;
+            event->watch = watch;
+            return;
+        }
+    }
+    if (ctx->eventCount == ctx->eventCapacity) {
+        u32 capacity = maxVal(ctx->eventCapacity * 2, 64);
+        ctx->events = (os__FsWatchEvent*) os__fsWatchRealloc(ctx->events, ctx->eventCount, ctx->eventCapacity, capacity, sizeof(os__FsWatchEvent));
+        ctx->slots = (u32*) os__fsWatchRealloc(ctx->slots, 0, ctx->slotCapacity, capacity * 2, sizeof(u32));
+        ctx->eventCapacity = capacity;
+        ctx->slotCapacity = capacity * 2;
+        os__fsWatchSlotsRebuild(ctx);
+    }
+    u32 index = ctx->eventCount++;
+    os__FsWatchEvent* event = ctx->events + index;
+    event->key = key;
+    event->path = os__pathCopy(ctx->eventArena, path.content, path.size);
+    event->lastNs = now;
+    event->watch = watch;
+    event->action = os__fsWatchMerge(OS__FS_ACTION_NONE, action);
+    event->cookie = cookie;
+    event->isDirectory = isDirectory;
+    os__fsWatchSlotInsert(ctx, index);
+}
+
+// The kernel dropped events, what happened in the meantime is unknown. Files that are still there are reported as
+// modified and directories without a watch as created (with their content), so a consumer that reloads what it is
+// told about catches up. Deleted directories still report through their watches, deleted files are lost.
+LOCAL void os__fsWatchRescan(os_fsPathWatchCtx* ctx, u32 watch, S8 path, u64 now) {
+    bx recursive = (ctx->watches[watch - 1].flags & os_fsPathTrackFlag_recursive) != 0;
+    DIR* dir = opendir((const char*) path.content);
+    if (!dir) {
+        return;
+    }
+    u8 entryPath[PATH_MAX + 1];
+    for (struct dirent* entry = readdir(dir); entry; entry = readdir(dir)) {
+        S8 name = str_fromNullTerminatedCharPtr(entry->d_name);
+        if (str_isEqual(name, str_lit(".")) || str_isEqual(name, str_lit("..")) || path.size + 1 + name.size > PATH_MAX) {
+            continue;
+        }
+        mem_copy(entryPath, path.content, path.size);
+        entryPath[path.size] = '/';
+        mem_copy(entryPath + path.size + 1, name.content, name.size);
+        entryPath[path.size + 1 + name.size] = '\0';
+        S8 child = str_fromCharPtr(entryPath, path.size + 1 + name.size);
+
+        bx isDirectory = entry->d_type == DT_DIR;
+        if (entry->d_type == DT_UNKNOWN) {
+            struct stat info;
+            isDirectory = lstat((const char*) entryPath, &info) == 0 && S_ISDIR(info.st_mode);
+        }
+        if (!isDirectory) {
+            os__fsWatchRecord(ctx, watch, child, os_fsAction_modifiy, 0, false, now);
+            continue;
+        }
+        if (!recursive) {
+            continue;
+        }
+        // adding a watch that exists returns its descriptor
+        i32 wd = inotify_add_watch(ctx->fd, (const char*) entryPath, OS__FS_WATCH_MASK | IN_ONLYDIR);
+        if (wd < 0) {
+            continue;
+        }
+        if (u32_cast(wd) < ctx->dirCapacity && ctx->dirs[wd].watch == watch && str_isEqual(ctx->dirs[wd].path, child)) {
+            os__fsWatchRescan(ctx, watch, child, now);
+        } else {
+            os__fsWatchRecord(ctx, watch, child, os_fsAction_create, 0, true, now);
+            os__fsWatchAddTree(ctx, watch, child, true, now);
+        }
+    }
+    closedir(dir);
+}
+
+LOCAL void os__fsWatchHandle(os_fsPathWatchCtx* ctx, struct inotify_event* event, u64 now) {
+    if (event->mask & IN_Q_OVERFLOW) {
+        for (u32 idx = 0; idx < ctx->watchCount; idx++) {
+            if (ctx->watches[idx].active) {
+                os__fsWatchRescan(ctx, idx + 1, ctx->watches[idx].path, now);
+            }
+        }
+        return;
+    }
+    if (event->wd < 0 || u32_cast(event->wd) >= ctx->dirCapacity || ctx->dirs[event->wd].watch == 0) {
+        return;
+    }
+    os__FsWatchDir* dir = ctx->dirs + event->wd;
+    if (event->mask & IN_IGNORED) {
+        // the directory is gone or the watch was removed, the parent reports the delete
+        dir->watch = 0;
+        return;
+    }
+    if (event->len == 0) {
+        return;
+    }
+    u32 watch = dir->watch;
+    bx recursive = (ctx->watches[watch - 1].flags & os_fsPathTrackFlag_recursive) != 0;
+    bx isDirectory = (event->mask & IN_ISDIR) != 0;
+
+    S8 name = str_fromNullTerminatedCharPtr(event->name);
+    u8 pathBuffer[PATH_MAX + 1];
+    if (dir->path.size + 1 + name.size > PATH_MAX) {
+        return;
+    }
+    mem_copy(pathBuffer, dir->path.content, dir->path.size);
+    pathBuffer[dir->path.size] = '/';
+    mem_copy(pathBuffer + dir->path.size + 1, name.content, name.size);
+    pathBuffer[dir->path.size + 1 + name.size] = '\0';
+    S8 path = str_fromCharPtr(pathBuffer, dir->path.size + 1 + name.size);
+
+    if (event->mask & IN_CREATE) {
+        os__fsWatchRecord(ctx, watch, path, os_fsAction_create, 0, isDirectory, now);
+        if (isDirectory && recursive) {
+            os__fsWatchAddTree(ctx, watch, path, true, now);
+        }
+    }
+    if ((event->mask & (IN_MODIFY | IN_CLOSE_WRITE)) && !isDirectory) {
+        os__fsWatchRecord(ctx, watch, path, os_fsAction_modifiy, 0, false, now);
+    }
+    if (event->mask & IN_DELETE) {
+        os__fsWatchRecord(ctx, watch, path, os_fsAction_delete, 0, isDirectory, now);
+    }
+    if (event->mask & IN_MOVED_FROM) {
+        // the path is gone either way, the marker only pairs it with the destination
+        os__fsWatchRecord(ctx, watch, path, os_fsAction_delete, 0, isDirectory, now);
+        os__fsWatchRecord(ctx, watch, path, OS__FS_ACTION_NONE, event->cookie, isDirectory, now);
+    }
+    if (event->mask & IN_MOVED_TO) {
+        os__FsWatchEvent* source = event->cookie != 0 ? os__fsWatchFind(ctx, os__fsWatchCookieKey(event->cookie), STR_NULL, event->cookie) : NULL;
+        if (source) {
+            // both ends of the rename are watched, the old path was reported as deleted and the new one is moved
+            if (isDirectory) {
+                os__fsWatchRenameTree(ctx, source->path, path);
+            }
+            os__fsWatchRemove(ctx, u32_cast(source - ctx->events));
+            os__fsWatchRecord(ctx, watch, path, os_fsAction_move, 0, isDirectory, now);
+        } else {
+            // moved in from outside of the watched tree
+            os__fsWatchRecord(ctx, watch, path, os_fsAction_create, 0, isDirectory, now);
+            if (isDirectory && recursive) {
+                os__fsWatchAddTree(ctx, watch, path, true, now);
+            }
+        }
+    }
+}
+
+os_fsPathWatchCtx* os_fsWatchPathCreatCtx(Arena* arena) {
+    ASSERT(arena);
+    i32 fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0) {
+        return NULL;
+    }
+    BaseMemory baseMem = os_getBaseMemory();
+    os_fsPathWatchCtx* ctx = mem_arenaPushStructZero(arena, os_fsPathWatchCtx);
+    ctx->fd = fd;
+    ctx->arena = mem_makeArena(&baseMem, MEGABYTE(256));
+    ctx->eventArena = mem_makeArena(&baseMem, MEGABYTE(256));
+    ctx->spareArena = mem_makeArena(&baseMem, MEGABYTE(256));
+    ctx->buffer = (u8*) mem_arenaPush(ctx->arena, OS__FS_WATCH_BUFFER_SIZE);
+    return ctx;
+}
+
+void os_fsWatchPathDestroyCtx(os_fsPathWatchCtx* ctx) {
+    if (!ctx) {
+        return;
+    }
+    close(ctx->fd);
+    u64 pageSize = os_memoryPageSize();
+    if (ctx->eventCapacity > 0) {
+        os_memoryRelease(ctx->events, alignUp(ctx->eventCapacity * sizeof(os__FsWatchEvent), pageSize));
+        os_memoryRelease(ctx->slots, alignUp(ctx->slotCapacity * sizeof(u32), pageSize));
+    }
+    if (ctx->dueCapacity > 0) {
+        os_memoryRelease(ctx->due, alignUp(ctx->dueCapacity * sizeof(os__FsWatchEvent), pageSize));
+    }
+    mem_destroyArena(ctx->spareArena);
+    mem_destroyArena(ctx->eventArena);
+    mem_destroyArena(ctx->arena);
+    mem_structSetZero(ctx);
+    ctx->fd = -1;
+}
+
+os_fsPathWatchId os_fsWatchPathStart(os_fsPathWatchCtx* ctx, S8 folder, os_fsPathWatchFlags trackFlags, os_fsPathWatchCallback* callback, void* custom) {
+    ASSERT(ctx && callback);
+    os_fsPathWatchId id = {0};
+    while (folder.size > 1 && folder.content[folder.size - 1] == '/') {
+        folder.size--;
+    }
+    if (folder.size == 0 || folder.size > PATH_MAX) {
+        return id;
+    }
+    if (ctx->watchCount == ctx->watchCapacity) {
+        u32 capacity = maxVal(ctx->watchCapacity * 2, 16);
+        os__FsWatch* watches = mem_arenaPushArrayZero(ctx->arena, os__FsWatch, capacity);
+        if (ctx->watchCount > 0) {
+            mem_copy(watches, ctx->watches, sizeof(os__FsWatch) * ctx->watchCount);
+        }
+        ctx->watches = watches;
+        ctx->watchCapacity = capacity;
+    }
+    os__FsWatch* watch = ctx->watches + ctx->watchCount++;
+    watch->callback = callback;
+    watch->custom = custom;
+    watch->flags = trackFlags;
+    watch->active = true;
+    watch->path = os__pathCopy(ctx->arena, folder.content, folder.size);
+
+    if (!os__fsWatchAddTree(ctx, ctx->watchCount, watch->path, false, 0)) {
+        watch->active = false;
+        return id;
+    }
+    id.id = ctx->watchCount;
+    return id;
+}
+
+void os_fsWatchPathStop(os_fsPathWatchCtx* ctx, os_fsPathWatchId handle) {
+    ASSERT(ctx);
+    if (handle.id == 0 || handle.id > ctx->watchCount || !ctx->watches[handle.id - 1].active) {
+        return;
+    }
+    ctx->watches[handle.id - 1].active = false;
+    for (u32 wd = 0; wd < ctx->dirCapacity; wd++) {
+        if (ctx->dirs[wd].watch == handle.id) {
+            inotify_rm_watch(ctx->fd, i32_cast(wd));
+            ctx->dirs[wd].watch = 0;
+        }
+    }
+    // pending events of the watch are dropped when they are due
+}
+
+void os_fsWatchPathTick(os_fsPathWatchCtx* ctx) {
+    ASSERT(ctx);
+    u64 now = os__fsWatchNow();
+    for (;;) {
+        ssize_t size = read(ctx->fd, ctx->buffer, OS__FS_WATCH_BUFFER_SIZE);
+        if (size <= 0) {
+            // EAGAIN once everything is read
+            break;
+        }
+        for (u8* at = ctx->buffer; at < ctx->buffer + size;) {
+            struct inotify_event* event = (struct inotify_event*) at;
+            at += sizeof(struct inotify_event) + event->len;
+            os__fsWatchHandle(ctx, event, now);
+        }
+    }
+    if (ctx->eventCount == 0) {
+        return;
+    }
+
+    u64 debounceNs = u64_cast(OS_FS_WATCH_DEBOUNCE_MS) * 1000000;
+    u32 eventCount = ctx->eventCount;
+    for (u32 idx = 0; idx < eventCount; idx++) {
+        os__FsWatchEvent* event = ctx->events + idx;
+        if (now - event->lastNs < debounceNs) {
+            continue;
+        }
+        if (event->cookie != 0 && event->isDirectory) {
+            // moved out of the watched tree, its watches would report changes with stale paths
+            os__fsWatchRemoveTree(ctx, event->path);
+        }
+    }
+    // callbacks may start and stop watches, so the due events are taken out of the list before the first call
+    if (ctx->dueCapacity < eventCount) {
+        u32 capacity = maxVal(ctx->dueCapacity * 2, ctx->eventCapacity);
+        ctx->due = (os__FsWatchEvent*) os__fsWatchRealloc(ctx->due, 0, ctx->dueCapacity, capacity, sizeof(os__FsWatchEvent));
+        ctx->dueCapacity = capacity;
+    }
+    os__FsWatchEvent* due = ctx->due;
+    u32 dueCount = 0;
+    u32 keptCount = 0;
+    for (u32 idx = 0; idx < eventCount; idx++) {
+        os__FsWatchEvent event = ctx->events[idx];
+        if (now - event.lastNs < debounceNs) {
+            ctx->events[keptCount++] = event;
+        } else if (event.action != OS__FS_ACTION_NONE && ctx->watches[event.watch - 1].active) {
+            due[dueCount++] = event;
+        }
+    }
+    ctx->eventCount = keptCount;
+    if (keptCount != eventCount) {
+        os__fsWatchSlotsRebuild(ctx);
+    }
+    for (u32 idx = 0; idx < dueCount; idx++) {
+        os__FsWatch* watch = ctx->watches + due[idx].watch - 1;
+        os_fsPathWatchId id = {due[idx].watch};
+        watch->callback(id, due[idx].path, due[idx].action, watch->custom);
+    }
+    if (ctx->eventCount == 0) {
+        mem_arenaPopTo(ctx->eventArena, 0);
+        return;
+    }
+    // under steady churn something is always pending, the live paths move to the spare arena instead
+    u64 used = mem_getArenaMemOffsetPos(ctx->eventArena);
+    if (used > OS__FS_WATCH_COMPACT_SIZE) {
+        u64 live = 0;
+        for (u32 idx = 0; idx < ctx->eventCount; idx++) {
+            live += ctx->events[idx].path.size + 1;
+        }
+        if (used > live * 2) {
+            for (u32 idx = 0; idx < ctx->eventCount; idx++) {
+                S8 path = ctx->events[idx].path;
+                ctx->events[idx].path = os__pathCopy(ctx->spareArena, path.content, path.size);
+            }
+            mem_arenaPopTo(ctx->eventArena, 0);
+            Arena* spare = ctx->eventArena;
+            ctx->eventArena = ctx->spareArena;
+            ctx->spareArena = spare;
+        }
+    }
+}
+#endif // OS_LINUX || OS_ANDROID
+
 S8 os_filepath(Arena* arena, os_systemPath path) {
 	S8 result = {0};
 	
@@ -482,6 +1528,18 @@ void os_log(S8 msg) {
     //}
 }
 
+void os_logSpans(S8* spans, u32 spanCount) {
+#if OS_ANDROID
+    for (u32 idx = 0; idx < spanCount; idx++) {
+        __android_log_print(ANDROID_LOG_UNKNOWN, "os", "%.*s", (int) spans[idx].size, spans[idx].content);
+    }
+#else
+    // os_log goes through stdio, whatever it buffered has to come first
+    fflush(stdout);
+    os__writeSpans(STDOUT_FILENO, spans, spanCount);
+#endif // OS_ANDROID
+}
+
 typedef struct os__ThreadInternal {
     pthread_t handle;
     char* tmpThreadName;
@@ -518,13 +1576,13 @@ bx os_threadCreate(os_Thread* thread, os_threadFunc threadFunc, void* userData,
     }
     // See:
     // https://man7.org/linux/man-pages/man3/pthread_attr_setstacksize.3.html
-    // PTHREAD_STACK_MIN (16384)
-    stackSize = maxVal(stackSize, 16384);
-
+    // PTHREAD_STACK_MIN (16384), a stack size of 0 keeps the default of the platform
     if (stackSize != 0) {
+        stackSize = maxVal(stackSize, 16384);
         result = pthread_attr_setstacksize(&attr, stackSize);
 
         if (result != 0) {
+            pthread_attr_destroy(&attr);
             return false;
         }
     }
@@ -546,7 +1604,9 @@ bx os_threadCreate(os_Thread* thread, os_threadFunc threadFunc, void* userData,
 
     os_semaphoreInit(&thread->sem);
     result = pthread_create(&ti->handle, &attr, os_threadEntry, thread);
+    pthread_attr_destroy(&attr);
     if (result != 0) {
+        os_semaphoreDestroy(&thread->sem);
         return false;
     }
     
@@ -762,6 +1822,219 @@ void os_semaphoreDestroy(os_Semaphore* sem) {
 
     UNUSED(result);
 }
+
+/////////////////////////
+// Fiber
+
+// NOTE(pjako): a switch pushes the callee saved registers onto the current stack, swaps the stack pointer and pops
+// them from the other stack. Everything else is caller saved and already spilled by the compiler around the call.
+// A new fiber gets a prepared frame so that the first switch returns into os__fiberMain.
+
+#if OS_APPLE
+#define OS__ASM_SYMBOL(NAME) "_" #NAME
+#define OS__ASM_HIDDEN(NAME) ".private_extern _" #NAME "\n"
+#else
+#define OS__ASM_SYMBOL(NAME) #NAME
+#define OS__ASM_HIDDEN(NAME) ".hidden " #NAME "\n" ".type " #NAME ", %function\n"
+#endif
+
+// stores the stack pointer into *saveSp and continues on loadSp
+void os__fiberSwitch(void** saveSp, void* loadSp);
+
+#if ARCH_X64
+// rbp, rbx, r12 - r15 and the sse/x87 control words are callee saved in the System V ABI
+#define OS__FIBER_FRAME_SIZE (8 * 8)
+__asm__(
+    ".text\n"
+    ".globl " OS__ASM_SYMBOL(os__fiberSwitch) "\n"
+    OS__ASM_HIDDEN(os__fiberSwitch)
+    ".p2align 4\n"
+    OS__ASM_SYMBOL(os__fiberSwitch) ":\n"
+    "    pushq %rbp\n"
+    "    pushq %rbx\n"
+    "    pushq %r12\n"
+    "    pushq %r13\n"
+    "    pushq %r14\n"
+    "    pushq %r15\n"
+    "    subq $8, %rsp\n"
+    "    stmxcsr (%rsp)\n"
+    "    fnstcw 4(%rsp)\n"
+    "    movq %rsp, (%rdi)\n"
+    "    movq %rsi, %rsp\n"
+    "    ldmxcsr (%rsp)\n"
+    "    fldcw 4(%rsp)\n"
+    "    addq $8, %rsp\n"
+    "    popq %r15\n"
+    "    popq %r14\n"
+    "    popq %r13\n"
+    "    popq %r12\n"
+    "    popq %rbx\n"
+    "    popq %rbp\n"
+    "    ret\n"
+);
+#elif ARCH_ARM64
+// x19 - x28, the frame pointer, the link register and the lower halves of v8 - v15 are callee saved in AAPCS64
+#define OS__FIBER_FRAME_SIZE (20 * 8)
+__asm__(
+    ".text\n"
+    ".globl " OS__ASM_SYMBOL(os__fiberSwitch) "\n"
+    OS__ASM_HIDDEN(os__fiberSwitch)
+    ".p2align 4\n"
+    OS__ASM_SYMBOL(os__fiberSwitch) ":\n"
+    "    sub sp, sp, #160\n"
+    "    stp x19, x20, [sp, #0]\n"
+    "    stp x21, x22, [sp, #16]\n"
+    "    stp x23, x24, [sp, #32]\n"
+    "    stp x25, x26, [sp, #48]\n"
+    "    stp x27, x28, [sp, #64]\n"
+    "    stp x29, x30, [sp, #80]\n"
+    "    stp d8, d9, [sp, #96]\n"
+    "    stp d10, d11, [sp, #112]\n"
+    "    stp d12, d13, [sp, #128]\n"
+    "    stp d14, d15, [sp, #144]\n"
+    "    mov x2, sp\n"
+    "    str x2, [x0]\n"
+    "    mov sp, x1\n"
+    "    ldp x19, x20, [sp, #0]\n"
+    "    ldp x21, x22, [sp, #16]\n"
+    "    ldp x23, x24, [sp, #32]\n"
+    "    ldp x25, x26, [sp, #48]\n"
+    "    ldp x27, x28, [sp, #64]\n"
+    "    ldp x29, x30, [sp, #80]\n"
+    "    ldp d8, d9, [sp, #96]\n"
+    "    ldp d10, d11, [sp, #112]\n"
+    "    ldp d12, d13, [sp, #128]\n"
+    "    ldp d14, d15, [sp, #144]\n"
+    "    add sp, sp, #160\n"
+    "    ret\n"
+);
+#else
+#error "os_Fiber has no context switch for this architecture"
+#endif
+
+typedef struct os__FiberInternal {
+    void* sp;       // stack pointer of the fiber while it is not running
+    void* callerSp; // stack pointer of the thread that resumed it while it runs
+    os_fiberEntryFunc* entry;
+    void* userPtr;
+    bx done;
+} os__FiberInternal;
+
+LOCAL THREAD_LOCAL os__FiberInternal* os__fiberCurrent;
+
+LOCAL void os__fiberMain(void) {
+    os__FiberInternal* fiber = os__fiberCurrent;
+    fiber->entry(fiber->userPtr);
+    fiber->done = true;
+    // thread locals are not touched after the entry returned, the fiber may have moved to another thread
+    os__fiberSwitch(&fiber->sp, fiber->callerSp);
+    ASSERT(!"Finished fiber was resumed");
+}
+
+void os_fiberInit(os_Fiber* fiber, os_fiberEntryFunc* entry, void* stackPointer, umm stackSize, void* userPtr) {
+    STATIC_ASSERT(sizeof(os_Fiber) >= sizeof(os__FiberInternal));
+    ASSERT(fiber && entry && stackPointer && stackSize >= KILOBYTE(4));
+    os__FiberInternal* fi = (os__FiberInternal*) fiber->internal;
+    mem_structSetZero(fi);
+    fi->entry = entry;
+    fi->userPtr = userPtr;
+
+    u64* top = (u64*) ((u64_cast(stackPointer) + stackSize) & ~u64_val(15));
+#if ARCH_X64
+    // first switch: control words, six zeroed registers, then "returns" into os__fiberMain with the stack aligned
+    // like after a call. The zero return address above it ends stack walks.
+    u64* frame = top - 1 - (OS__FIBER_FRAME_SIZE / 8);
+    mem_setZero(frame, OS__FIBER_FRAME_SIZE + 8);
+    frame[0] = u64_val(0x1F80) | (u64_val(0x037F) << 32); // default mxcsr and x87 control word
+    frame[7] = u64_cast(os__fiberMain);
+#elif ARCH_ARM64
+    u64* frame = top - (OS__FIBER_FRAME_SIZE / 8);
+    mem_setZero(frame, OS__FIBER_FRAME_SIZE);
+    frame[11] = u64_cast(os__fiberMain); // x30, the frame pointer x29 stays zero
+#endif
+    fi->sp = frame;
+}
+
+void os_fiberResume(os_Fiber* fiber) {
+    ASSERT(fiber);
+    ASSERT(!os__fiberCurrent && "Fibers can only be resumed from a thread");
+    os__FiberInternal* fi = (os__FiberInternal*) fiber->internal;
+    ASSERT(!fi->done && "Fiber already finished");
+    os__fiberCurrent = fi;
+    os__fiberSwitch(&fi->callerSp, fi->sp);
+    os__fiberCurrent = NULL;
+}
+
+void os_fiberYield(void) {
+    os__FiberInternal* fi = os__fiberCurrent;
+    ASSERT(fi && "os_fiberYield called outside of a fiber");
+    os__fiberSwitch(&fi->sp, fi->callerSp);
+}
+
+bx os_fiberIsDone(os_Fiber* fiber) {
+    ASSERT(fiber);
+    return ((os__FiberInternal*) fiber->internal)->done;
+}
+
+bx os_fiberStackPoolInit(os_FiberStackPool* pool, Arena* arena, u32 stackCount, umm stackSize) {
+    ASSERT(pool && arena && stackCount > 0);
+    mem_structSetZero(pool);
+    umm pageSize = os_memoryPageSize();
+    stackSize = (maxVal(stackSize, KILOBYTE(16)) + pageSize - 1) & ~(pageSize - 1);
+    // [guard][stack][guard][stack]..., guard pages stay reserved only
+    umm stride = stackSize + pageSize;
+    u8* memory = (u8*) os_memoryReserve(stride * stackCount);
+    if (!memory || memory == (u8*) MAP_FAILED) {
+        return false;
+    }
+    for (u32 idx = 0; idx < stackCount; idx++) {
+        os_memoryCommit(memory + stride * idx + pageSize, stackSize);
+    }
+    pool->memory = memory;
+    pool->memorySize = stride * stackCount;
+    pool->stackSize = stackSize;
+    pool->stackCount = stackCount;
+    pool->freeList = mem_arenaPushArray(arena, u32, stackCount);
+    // handed out from the front first, so a partially used pool touches the lowest stacks
+    for (u32 idx = 0; idx < stackCount; idx++) {
+        pool->freeList[idx] = stackCount - 1 - idx;
+    }
+    pool->freeCount = stackCount;
+    os_mutexInit(&pool->lock);
+    return true;
+}
+
+void os_fiberStackPoolDestroy(os_FiberStackPool* pool) {
+    ASSERT(pool);
+    if (pool->memory) {
+        os_memoryRelease(pool->memory, pool->memorySize);
+        os_mutexDestroy(&pool->lock);
+    }
+    mem_structSetZero(pool);
+}
+
+void* os_fiberStackAcquire(os_FiberStackPool* pool) {
+    ASSERT(pool && pool->memory);
+    u8* stack = NULL;
+    os_mutexScoped(&pool->lock) {
+        if (pool->freeCount > 0) {
+            u32 idx = pool->freeList[--pool->freeCount];
+            stack = pool->memory + (pool->stackSize + os_memoryPageSize()) * idx + os_memoryPageSize();
+        }
+    }
+    return stack;
+}
+
+void os_fiberStackRelease(os_FiberStackPool* pool, void* stack) {
+    ASSERT(pool && pool->memory && stack);
+    umm stride = pool->stackSize + os_memoryPageSize();
+    umm offset = u64_cast((u8*) stack - pool->memory);
+    ASSERT(offset < pool->memorySize && offset % stride == os_memoryPageSize() && "Stack is not from this pool");
+    os_mutexScoped(&pool->lock) {
+        ASSERT(pool->freeCount < pool->stackCount);
+        pool->freeList[pool->freeCount++] = u32_cast(offset / stride);
+    }
+}
 #endif // OS_APPLE || OS_ANDROID || OS_UNIX || OS_LINUX
 
 #elif OS_WIN
@@ -898,6 +2171,77 @@ bool os_fileWrite(S8 fileName, S8 data) {
 }
 
 
+bx os_fileWriteSpans(S8 fileName, S8* spans, u32 spanCount) {
+    mem_defineMakeStackArena(arena, 1024 * sizeOf(u32));
+    S16 fileMame16 = str_toS16(arena, fileName);
+    HANDLE file = CreateFileW((WCHAR*)fileMame16.content, GENERIC_WRITE, 0, 0, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    bx result = true;
+    for (u32 idx = 0; idx < spanCount && result; idx++) {
+        u64 offset = 0;
+        while (offset < spans[idx].size) {
+            DWORD chunk = (DWORD) minVal(spans[idx].size - offset, 0x40000000ull);
+            DWORD actualWrite = 0;
+            if (!WriteFile(file, spans[idx].content + offset, chunk, &actualWrite, 0) || actualWrite == 0) {
+                result = false;
+                break;
+            }
+            offset += actualWrite;
+        }
+    }
+    CloseHandle(file);
+    return result;
+}
+
+bx os_fileMapOpen(os_FileMap* map, S8 fileName, u64 size) {
+    ASSERT(map);
+    ASSERT(size > 0);
+    map->content = NULL;
+    map->size = 0;
+    mem_defineMakeStackArena(arena, 1024 * sizeOf(u32));
+    S16 fileMame16 = str_toS16(arena, fileName);
+    HANDLE file = CreateFileW((WCHAR*)fileMame16.content, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, 0, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, 0);
+    if (file == INVALID_HANDLE_VALUE) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    fileSize.QuadPart = (LONGLONG) size;
+    void* content = NULL;
+    if (SetFilePointerEx(file, fileSize, NULL, FILE_BEGIN) && SetEndOfFile(file)) {
+        HANDLE mapping = CreateFileMappingW(file, NULL, PAGE_READWRITE, (DWORD) (size >> 32), (DWORD) size, NULL);
+        if (mapping) {
+            content = MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, size);
+            // the view keeps the mapping and the file alive
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+    if (!content) {
+        return false;
+    }
+    map->content = (u8*) content;
+    map->size = size;
+    return true;
+}
+
+void os_fileMapSync(os_FileMap* map) {
+    ASSERT(map);
+    if (map->content) {
+        FlushViewOfFile(map->content, map->size);
+    }
+}
+
+void os_fileMapClose(os_FileMap* map) {
+    ASSERT(map);
+    if (map->content) {
+        UnmapViewOfFile(map->content);
+    }
+    map->content = NULL;
+    map->size = 0;
+}
+
 bx os_dirCreate(S8 dirname) {
     mem_defineMakeStackArena(tmpMem, 1024 * sizeof(u32) + 1);
     S16 dirname16 = str_toS16(tmpMem, dirname);
@@ -1301,6 +2645,13 @@ void os_log(S8 msg) {
     //}
 }
 
+void os_logSpans(S8* spans, u32 spanCount) {
+    for (u32 idx = 0; idx < spanCount; idx++) {
+        fwrite(spans[idx].content, spans[idx].size, 1, stdout);
+    }
+    fflush(stdout);
+}
+
 typedef struct os__SemaphoreInternal {
     HANDLE handle;
 } os__SemaphoreInternal;
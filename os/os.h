@@ -41,6 +41,8 @@ API u64 os_timeMicrosecondsNow(void);
 
 API S8 os_fileRead(Arena* arena, S8 fileName);
 API bx os_fileWrite(S8 fileName, S8 data);
+// writes the concatenation of all spans (gather write), see str_builderSpans
+API bx os_fileWriteSpans(S8 fileName, S8* spans, u32 spanCount);
 API bx os_fileDelete(S8 fileName);
 API bx os_fileExists(S8 fileName);
 typedef enum os_systemPath {
@@ -64,41 +66,32 @@ INLINE S8 os_getDirectoryFromFilepath(S8 filepath) {
     }
     return result;
 }
+
+typedef enum os_pathListFlag {
+    os_pathListFlag_none        = 0,
+    os_pathListFlag_recursive   = (1 << 0),
+    os_pathListFlag_directories = (1 << 1), // list directories as well, only files are listed otherwise
+} os_pathListFlag;
+
+typedef struct os_PathListDesc {
+    S8 pattern;      // glob relative to the listed directory (see str_globCompile), empty lists everything
+    flags32 flags;
+    u32 threadCount; // recursive listings walk the tree with this many threads, 0 and 1 use the calling thread only
+} os_PathListDesc;
+
+// names of all files and directories in pathName
 API S8* os_pathList(Arena* arena, S8 pathName, u64* pathCount);
+// paths relative to pathName, in no particular order. Subtrees the pattern can not match are not opened
+// and symbolic links are listed but never followed. Returns NULL for a missing directory or an invalid pattern.
+API S8* os_pathListFiltered(Arena* arena, S8 pathName, os_PathListDesc* desc, u64* pathCount);
 API bx os_pathMakeDirectory(S8 pathName);
 API bx os_pathDirectoryExist(S8 pathName);
 
 /////////////////////////
 // File Helper
 
-INLINE S8 os_fixFilepath(Arena* arena, S8 path) {
-    S8 resultPath = STR_NULL;
-    mem_scoped(scratch, arena) {
-        resultPath = str_alloc(arena, path.size);
-
-        S8 fixedPath = path;
-        fixedPath = str_replaceAll(scratch.arena, fixedPath, s8("\\"), s8("/"));
-        fixedPath = str_replaceAll(scratch.arena, fixedPath, s8("/./"), s8("/"));
-        while (true) {
-            u64 dotdot = str_findFirst(fixedPath, s8(".."), 0);
-            if (dotdot == fixedPath.size) break;
-            
-            u64 lastSlash = str_findLast(fixedPath, s8("/"), dotdot - 1);
-            
-            u64 range = (dotdot + 3) - lastSlash;
-            S8 old = fixedPath;
-            fixedPath = str_alloc(scratch.arena, fixedPath.size - range);
-            memcpy(fixedPath.content, old.content, lastSlash);
-            memcpy(fixedPath.content + lastSlash, old.content + dotdot + 3, old.size - range - lastSlash + 1);
-        }
-        ASSERT(fixedPath.size >= path.size);
-        mem_copy(resultPath.content, fixedPath.content, fixedPath.size);
-        resultPath.size = fixedPath.size;
-        // manipulate scratch to not free our result path and only free the temporary strings
-        scratch.start += resultPath.size;
-    }
-    return resultPath;
-}
+// single pass: '\\' becomes '/', "/./" segments are dropped and "/../" removes the segment before it
+API S8 os_fixFilepath(Arena* arena, S8 path);
 
 /////////////////////////
 // File properties
@@ -123,6 +116,18 @@ typedef struct os_FileProperties {
 
 API os_FileProperties os_fileProperties(S8 fileName);
 
+// A file mapped read/write into memory. Stores to content land in the page cache of the file
+// and survive a crash (or kill) of the process, os_fileMapSync is only needed against power loss.
+typedef struct os_FileMap {
+    u8* content;
+    u64 size;
+} os_FileMap;
+
+// opens or creates fileName and resizes it to size, existing content within size is kept
+API bx   os_fileMapOpen(os_FileMap* map, S8 fileName, u64 size);
+API void os_fileMapSync(os_FileMap* map);
+API void os_fileMapClose(os_FileMap* map);
+
 
 /////////////////////////
 // Filesystem watching
@@ -138,17 +143,29 @@ typedef enum os_fsAction {
     os_fsAction_move
 } os_fsAction;
 
-typedef enum os_fsPathWatchFlag {os_fsPathTrackFlag_none = 0x0} os_fsPathWatchFlag;
+typedef enum os_fsPathWatchFlag {
+    os_fsPathTrackFlag_none      = 0x0,
+    os_fsPathTrackFlag_recursive = 0x1, // subdirectories too, including the ones created or moved in later
+} os_fsPathWatchFlag;
 typedef flags32 os_fsPathWatchFlags;
 
+// path is folder + '/' + the path below it, for os_fsAction_move it is the new path
 typedef void(os_fsPathWatchCallback)(os_fsPathWatchId id, S8 path, os_fsAction fsAction, void* custom);
 
+// Changes of one path are collected until the path was quiet for OS_FS_WATCH_DEBOUNCE_MS and reported as one callback
+// (an editor that writes, truncates and rewrites a file causes one os_fsAction_modifiy, create + delete causes none).
+#ifndef OS_FS_WATCH_DEBOUNCE_MS
+#define OS_FS_WATCH_DEBOUNCE_MS 50
+#endif
+
 typedef struct os_fsPathWatchCtx os_fsPathWatchCtx;
+// returns id 0 if folder can not be watched
 API os_fsPathWatchId os_fsWatchPathStart(os_fsPathWatchCtx* ctx, S8 folder, os_fsPathWatchFlags trackFlags, os_fsPathWatchCallback* callback, void* custom);
 API void os_fsWatchPathStop(os_fsPathWatchCtx* ctx, os_fsPathWatchId handle);
 
 API os_fsPathWatchCtx* os_fsWatchPathCreatCtx(Arena* arena);
 API void os_fsWatchPathDestroyCtx(os_fsPathWatchCtx* ctx);
+// never blocks, reads what happened since the last tick and calls the callbacks of paths that settled
 API void os_fsWatchPathTick(os_fsPathWatchCtx* ctx);
 
 
@@ -175,6 +192,8 @@ API void os_yield(void);
 /////////////////////////
 // Logging
 void os_log(S8 msg);
+// writes the spans back to back with one gather write where possible, line breaks have to be part of the spans
+API void os_logSpans(S8* spans, u32 spanCount);
 
 /////////////////////////
 // Mutex
@@ -231,11 +250,32 @@ typedef struct os_Fiber {
 
 typedef void (os_fiberEntryFunc) (void* ptr);
 
+// stackPointer is the lowest address of the stack memory, see os_fiberStackAcquire
 API void os_fiberInit(os_Fiber* fiber, os_fiberEntryFunc* entry, void *stackPointer, umm stackSize, void* userPtr);
-// Can only be called from the a thread, not within a running fiber
+// Can only be called from the a thread, not within a running fiber. A yielded fiber can be resumed by any thread.
 API void os_fiberResume(os_Fiber* fiber);
 // Yield the current fiber, will assert when it is called from the current thread
 API void os_fiberYield(void);
+// the entry function returned, the fiber can not be resumed anymore
+API bx os_fiberIsDone(os_Fiber* fiber);
+
+// Fixed size stacks in one reserved range, every stack has an inaccessible guard page below it so an overflow faults
+// instead of silently writing into the neighbouring stack.
+typedef struct os_FiberStackPool {
+    u8* memory;
+    umm memorySize;
+    umm stackSize;  // usable size of every stack, rounded up to the page size
+    u32 stackCount;
+    u32 freeCount;
+    u32* freeList;
+    os_Mutex lock;
+} os_FiberStackPool;
+
+API bx os_fiberStackPoolInit(os_FiberStackPool* pool, Arena* arena, u32 stackCount, umm stackSize);
+API void os_fiberStackPoolDestroy(os_FiberStackPool* pool);
+// returns the lowest address of a stack with pool->stackSize bytes, NULL when all stacks are in use
+API void* os_fiberStackAcquire(os_FiberStackPool* pool);
+API void os_fiberStackRelease(os_FiberStackPool* pool, void* stack);
 
 #ifdef __cplusplus
 } /* extern "C" */
@@ -11,6 +11,9 @@ bool scf_next(scf_Global* scf) {
         scf->line += 1;
     }
     for (bool running = true; running;) {
+        if (scf->needle >= scf->str.size) {
+            return false;
+        }
         char c = scf->str.content[scf->needle++];
         switch (c) {
             case '[': {
@@ -62,13 +65,8 @@ bool scf_next(scf_Global* scf) {
                 return true;
             } break;
             case '#': {
-                // skip line
-                for (;scf->needle < scf->str.size && c != '\n'; scf->needle++) {
-                    c = scf->str.content[scf->needle];
-                    if (c == '\n') {
-                        break;
-                    }
-                }
+                // skip the comment, the line break is counted by the next iteration
+                scf->needle = str_findNextChar(scf->str, scf->needle, '\n');
             } break;
             case '\n': {
                 scf->line += 1;
@@ -219,10 +219,9 @@ tn_Token tn_getTokenRaw(tn_Tokenizer *tokenizer) {
             } else if ((C == '/') && (tokenizer->at[0] == '/')) {
                 token.type = tn_tokenType_comment;
                 
-                tn_advanceChars(tokenizer, 2);
-                while(tokenizer->at[0] && !tn_isEndOfLine(tokenizer->at[0])) {
-                    tn_advanceChars(tokenizer, 1);
-                }
+                // the comment runs up to the line break, C was already consumed
+                u64 lineBreak = str_findNextLineBreak(tokenizer->input, 1);
+                tn_advanceChars(tokenizer, u32_cast(lineBreak));
             } else if ((C == '/') && (tokenizer->at[0] == '*')) {
                 token.type = tn_tokenType_comment;
                 
@@ -250,28 +249,22 @@ tn_Token tn_getTokenRaw(tn_Tokenizer *tokenizer) {
                 }
             }
             else if(tn_isNumber(C)) {
-                float Number = (float)(C - '0');
-                
-                while(tn_isNumber(tokenizer->at[0])) {
-                    float Digit = (float)(tokenizer->at[0] - '0');
-                    Number = 10.0f * Number + Digit;
-                    tn_advanceChars(tokenizer, 1);
-                }
-                
-                if(tokenizer->at[0] == '.') {
-                    tn_advanceChars(tokenizer, 1);
-                    float Coefficient = 0.1f;
-                    while (tn_isNumber(tokenizer->at[0])) {
-                        float Digit = (float)(tokenizer->at[0] - '0');
-                        Number += Coefficient*Digit;
-                        Coefficient *= 0.1f;
-                        tn_advanceChars(tokenizer, 1);
-                    }
-                }
+                // C was already consumed, parse from its position
+                S8 numberStr = {.content = tokenizer->input.content - 1, .size = tokenizer->input.size + 1};
+                f32 number = 0;
+                u64 numberSize = str_parseF32N(numberStr, &number);
+                i64 integer = 0;
+                u64 integerSize = str_parseS64N(numberStr, &integer);
+                tn_advanceChars(tokenizer, u32_cast(numberSize - 1));
                 
                 token.type = tn_tokenType_number;
-                token.f32 = Number;
-                token.i32 = tn_roundReal32ToInt32(Number);
+                token.f32 = number;
+                if (integerSize == numberSize && integer >= -0x80000000ll && integer <= 0x7FFFFFFF) {
+                    // plain integers keep full precision
+                    token.i32 = i32_cast(integer);
+                } else {
+                    token.i32 = tn_roundReal32ToInt32(number);
+                }
             } else {
                 token.type = tn_tokenType_unknown;
             }
@@ -2,6 +2,7 @@
 #include "base/base_types.h"
 #include "base/base_mem.h"
 #include "base/base_str.h"
+#include "base/base_str.hpp"
 #include "base/base_args.h"
 
 #include "os/os.h"
@@ -116,22 +117,24 @@ typedef struct S8Pair {
 
 arrTypeDef(S8Pair);
 
-static const S8 constTypeList[constType__count] = {
-    str_lit("float"),
-    str_lit("float2"),
-    str_lit("float3"),
-    str_lit("float4"),
-    str_lit("float4x4"),
-    str_lit("uint"),
-};
+// same order as constType
+static constexpr auto constTypeKeywords = str_perfectHashT("float", "float2", "float3", "float4", "float4x4", "uint");
+static_assert(constTypeKeywords.count == constType__count, "constTypeKeywords is out of sync with constType");
 
 constType getConstType(S8 str) {
-    for (u32 idx = 0; idx < countOf(constTypeList); idx++) {
-        if (str_isEqual(str, constTypeList[idx])) {
-            return (constType) idx;
-        }
+    u32 idx = constTypeKeywords.find(str);
+    return idx < constType__count ? (constType) idx : constType_invalid;
+}
+
+static constexpr auto resourceTypeKeywords = str_perfectHashT("Texture2D", "SamplerState");
+
+// todo properly parse all supported types
+resourceType getResourceType(S8 typeName) {
+    switch (resourceTypeKeywords.find(typeName)) {
+        case resourceTypeKeywords.indexOf("Texture2D"): return resourceType_texture;
+        case resourceTypeKeywords.indexOf("SamplerState"): return resourceType_sampler;
+        default: return resourceType_constant;
     }
-    return constType_invalid;
 }
 
 static const u32 constTypeByteSize[constType__count] = {
@@ -231,10 +234,10 @@ typedef struct ShaderCode {
     u32 size;
 } ShaderCode;
 #endif
-    str_fmt(recordArena, str8("typedef struct {}ShaderCode {{"), prefix);
-    str_join(recordArena, str8("    u8* code;"));
-    str_join(recordArena, str8("    u32 size;"));
-    str_fmt(recordArena, str8("}} {}ShaderCode;"), prefix);
+    str_fmtT(recordArena, "typedef struct {}ShaderCode {{", prefix);
+    str_joinT(recordArena, str8("    u8* code;"));
+    str_joinT(recordArena, str8("    u32 size;"));
+    str_fmtT(recordArena, "}} {}ShaderCode;", prefix);
 
 #if 0
 typedef struct ShaderDesc {
@@ -242,10 +245,10 @@ typedef struct ShaderDesc {
     S8 entry;
 } ShaderDesc;
 #endif
-    str_fmt(recordArena, str8("typedef struct {}ShaderDesc {{"), prefix);
-    str_join(recordArena, str8("    u32 codeIndex;"));
-    str_join(recordArena, str8("    u32 entry;"));
-    str_fmt(recordArena, str8("}} {}ShaderDesc;"), prefix);
+    str_fmtT(recordArena, "typedef struct {}ShaderDesc {{", prefix);
+    str_joinT(recordArena, str8("    u32 codeIndex;"));
+    str_joinT(recordArena, str8("    u32 entry;"));
+    str_fmtT(recordArena, "}} {}ShaderDesc;", prefix);
 
 #if 0
 typedef struct RenderProgramDesc {
@@ -254,11 +257,11 @@ typedef struct RenderProgramDesc {
     ShaderDesc ps;
 } RenderProgramDesc;
 #endif
-    str_fmt(recordArena, str8("typedef struct {}RenderProgramDesc {{"), prefix);
-    str_join(recordArena, str8("    S8 name;"));
-    str_join(recordArena, str8("    ShaderDesc vs;"));
-    str_join(recordArena, str8("    ShaderDesc ps;"));
-    str_fmt(recordArena, str8("}} {}RenderProgramDesc;"), prefix);
+    str_fmtT(recordArena, "typedef struct {}RenderProgramDesc {{", prefix);
+    str_joinT(recordArena, str8("    S8 name;"));
+    str_joinT(recordArena, str8("    ShaderDesc vs;"));
+    str_joinT(recordArena, str8("    ShaderDesc ps;"));
+    str_fmtT(recordArena, "}} {}RenderProgramDesc;", prefix);
 
 /*
 static ShaderCode shaderCode[] = {{}};
@@ -268,13 +271,13 @@ static RenderProgramDesc renderPrograms[] = {{}};
 }
 
 void shd_recordCodeGen(Arena* recordArena, S8 prefix, S8 fileName) {
-    str_join(recordArena, str8("#ifndef _RX_SHADERS_"));
-    str_join(recordArena, str8("#define _RX_SHADERS_"));
+    str_joinT(recordArena, str8("#ifndef _RX_SHADERS_"));
+    str_joinT(recordArena, str8("#define _RX_SHADERS_"));
     shd_recordHeaderCode(recordArena, prefix);
 
     
 
-    str_join(recordArena, str8("#endif /*_RX_SHADERS_*/"));
+    str_joinT(recordArena, str8("#endif /*_RX_SHADERS_*/"));
 }
 
 // PARSING SHADER SOURCE
@@ -315,6 +318,10 @@ enum resGroup {
     dynGroup__count,
 };
 
+// same order as resGroup
+static constexpr auto resGroupKeywords = str_perfectHashT("resGroup0", "resGroup1", "resGroup2", "resGroup3", "dynResGroup0", "dynResGroup1");
+static_assert(resGroupKeywords.count == dynGroup__count, "resGroupKeywords is out of sync with resGroup");
+
 struct MetaDataReplaceBlock {
     tn_Token start;
     tn_Token end;
@@ -532,7 +539,7 @@ void shd_parseSpirvShaderDetails(Arena* arena, shd_Shader* shader, CompilerRefle
             S8 inputName = str_fromCppStd(resAttr.name);
             u32 startIdxShort = str_lastIndexOfChar(inputName, u8'.') + 1;
             S8 inputNameShort = str_from(inputName, startIdxShort);
-            S8 newInputName = str_join(arena, s8("varying_"), inputNameShort);
+            S8 newInputName = str_joinT(arena, s8("varying_"), inputNameShort);
             std::string inputStdString( reinterpret_cast<char const*>(newInputName.content), newInputName.size );
             compiler.set_name(resAttr.id, inputStdString);
 
@@ -576,7 +583,7 @@ void shd_parseSpirvShaderDetails(Arena* arena, shd_Shader* shader, CompilerRefle
             // overwrite in/out name to match each other
             u32 startIdxShort = str_lastIndexOfChar(outputName, u8'.') + 1;
             S8 outputNameShort = str_from(outputName, startIdxShort);
-            S8 newOutputName = str_join(arena, s8("varying_"), outputNameShort);
+            S8 newOutputName = str_joinT(arena, s8("varying_"), outputNameShort);
             std::string outputStdString( reinterpret_cast<char const*>(newOutputName.content), newOutputName.size );
             compiler.set_name(resAttr.id, outputStdString);
 
@@ -739,92 +746,77 @@ typedef struct shd_Shader {
     str_record(generatedCode, arena) {
         // write spirv code
 
-        str_fmt(arena, str8("static const u32 {0}shader{1}Code_{2}[] = {{\n"), prefix, shaderShort, name);
-        {
-            u32* spirv = (u32*) shader->source.content;
-            u32  size  = shader->source.size / 4;
-            ASSERT(size * 4 == shader->source.size);
-            for (u32 idx = 0;;) {
-                str_join(arena, tab);
-                for (u32 j = minVal(idx + 8, size);;) {
-                    u32 val = spirv[idx];
-                    S8 hexVal = str_u32ToHex(arena, val);
-                    idx++;
-                    if (idx >= j) break;
-                    str_join(arena, str8(", "));
-                }
-                if (idx >= size) break;
-                str_join(arena, str8(",\n"));
-            }
-        }
-        str_join(arena, str8("\n};\n\n"));
+        str_fmtT(arena, "static const u32 {0}shader{1}Code_{2}[] = {{\n", prefix, shaderShort, name);
+        ASSERT((shader->source.size % 4) == 0);
+        str_cArrayLiteral(arena, shader->source, 4, 8, tab);
+        str_joinT(arena, str8("\n};\n\n"));
 
         // in
         if (shader->inputs.count > 0) {
-            str_fmt(arena, str8("static {0}ShaderInOutValue {0}shader{1}In_{2}[] = {{\n"), prefix, shaderShort, name);
+            str_fmtT(arena, "static {0}ShaderInOutValue {0}shader{1}In_{2}[] = {{\n", prefix, shaderShort, name);
             arrFor(&shader->inputs, idx) {
                 shd_ShaderParam* param = shader->inputs.elements + idx;
                 S8 type = shd_getVertexFormatStr(param->type);
-                str_join(arena, tab, str8("{"), type, str8(", {(u8*)\""), param->name,str8("\", "), param->name.size, str8("}},\n"));
+                str_joinT(arena, tab, str8("{"), type, str8(", {(u8*)\""), param->name,str8("\", "), param->name.size, str8("}},\n"));
             }
-            str_join(arena, str8("};\n\n"));
+            str_joinT(arena, str8("};\n\n"));
         }
 
         // out
         if (shader->outputs.count > 0) {
-            str_fmt(arena, str8("static {0}ShaderInOutValue {0}shader{1}Out_{2}[] = {{\n"), prefix, shaderShort, name);
+            str_fmtT(arena, "static {0}ShaderInOutValue {0}shader{1}Out_{2}[] = {{\n", prefix, shaderShort, name);
             arrFor(&shader->outputs, idx) {
                 shd_ShaderParam* param = shader->outputs.elements + idx;
                 S8 type = shd_getVertexFormatStr(param->type);
-                str_join(arena, tab, str8("{"), type, str8(", {(u8*) \""), param->name,str8("\", "), param->name.size, str8("}},\n"));
+                str_joinT(arena, tab, str8("{"), type, str8(", {(u8*) \""), param->name,str8("\", "), param->name.size, str8("}},\n"));
             }
-            str_join(arena, str8("};\n\n"));
+            str_joinT(arena, str8("};\n\n"));
         }
 
         // storage buffer
         if (shader->storageBuffers.count > 0) {
-            str_fmt(arena, str8("static {0}StorageBuffer {0}shader{1}StorageBuffers_{2}[] = {{\n"), prefix, shaderShort, name);
+            str_fmtT(arena, "static {0}StorageBuffer {0}shader{1}StorageBuffers_{2}[] = {{\n", prefix, shaderShort, name);
             arrFor(&shader->storageBuffers, idx) {
                 shd_ShaderStorageBuffer* param = shader->storageBuffers.elements + idx;
-                str_join(arena, tab, str8("{"), param->slot, str8(", {(u8*) \""), param->name, str8("\", "), param->name.size, str8("}},\n"));
+                str_joinT(arena, tab, str8("{"), param->slot, str8(", {(u8*) \""), param->name, str8("\", "), param->name.size, str8("}},\n"));
             }
-            str_join(arena, str8("};\n\n"));
+            str_joinT(arena, str8("};\n\n"));
         }
 
 
         // write shader struct
-        str_fmt(arena, str8("static {0}Shader {0}shader{1}_{2} = {{\n"), prefix, shaderShort, name);
+        str_fmtT(arena, "static {0}Shader {0}shader{1}_{2} = {{\n", prefix, shaderShort, name);
 
         // entry
-        str_join(arena, tab, str8("{(u8*) \""), shader->entry, str8("\", "), shader->entry.size, str8("},\n"));
+        str_joinT(arena, tab, str8("{(u8*) \""), shader->entry, str8("\", "), shader->entry.size, str8("},\n"));
 
         // in
         if (shader->inputs.count == 0) {
-            str_join(arena, str8("    {NULL, 0},\n"));
+            str_joinT(arena, str8("    {NULL, 0},\n"));
         } else {
-            str_fmt(arena,  str8("    {{&{0}shader{1}In_{2}[0], {3}}},\n"), prefix, shaderShort, name, shader->inputs.count);
+            str_fmtT(arena,  "    {{&{0}shader{1}In_{2}[0], {3}}},\n", prefix, shaderShort, name, shader->inputs.count);
         }
 
         // out
         if (shader->outputs.count == 0) {
-            str_join(arena, str8("    {NULL, 0},\n"));
+            str_joinT(arena, str8("    {NULL, 0},\n"));
         } else {
-            str_fmt(arena,  str8("    {{&{0}shader{1}Out_{2}[0], {3}}},\n"), prefix, shaderShort, name, shader->outputs.count);
+            str_fmtT(arena,  "    {{&{0}shader{1}Out_{2}[0], {3}}},\n", prefix, shaderShort, name, shader->outputs.count);
         }
         // storage buffer
         if (shader->storageBuffers.count == 0) {
-            str_join(arena, str8("    {NULL, 0},\n"));
+            str_joinT(arena, str8("    {NULL, 0},\n"));
         } else {
-            str_fmt(arena, str8("    {{&{0}shader{1}StorageBuffers_{2}[0], {3}}},\n"), prefix, shaderShort, name, shader->storageBuffers.count);
+            str_fmtT(arena, "    {{&{0}shader{1}StorageBuffers_{2}[0], {3}}},\n", prefix, shaderShort, name, shader->storageBuffers.count);
         }
 
         // push size
-        str_fmt(arena, str8("    {0},\n"), shader->pushSize);
+        str_fmtT(arena, "    {0},\n", shader->pushSize);
         // push size
-        str_fmt(arena, str8("    {{(u8*) &{0}shader{1}Code_{2}[0], {3}}},\n"), prefix, shaderShort, name, shader->source.size);
+        str_fmtT(arena, "    {{(u8*) &{0}shader{1}Code_{2}[0], {3}}},\n", prefix, shaderShort, name, shader->source.size);
 
         // spirv code
-        str_join(arena, str8("};\n\n"));
+        str_joinT(arena, str8("};\n\n"));
     }
     return generatedCode;
 }
@@ -834,13 +826,13 @@ typedef struct shd_Shader {
 void shd_generateHeaderProgramVariant(Arena* arena, S8 prefix, S8 name, shd_RenderProgramVariant* program, CodeInfo* codeInfo) {
     switch (program->variant) {
         case shd_shaderVariant_gl400: {
-            str_join(arena, s8("static rx_RenderShaderDesc "), prefix, name, s8("ShaderDescGl400 = {\n"));
+            str_joinT(arena, s8("static rx_RenderShaderDesc "), prefix, name, s8("ShaderDescGl400 = {\n"));
         } break;
 
         default: ASSERT(!"Unimplemented shader variant");
     }
     // name
-    str_join(arena, s8("  \""), name, s8("\",\n"));
+    str_joinT(arena, s8("  \""), name, s8("\",\n"));
 
     // vs shader
 
@@ -851,8 +843,8 @@ void shd_generateHeaderProgramVariant(Arena* arena, S8 prefix, S8 name, shd_Rend
     S8 shaderTypes[] = {str_lit("Vertex Shader"), str_lit("Fragment Shader")};
     for (i32 idxShader = 0; idxShader < countOf(shaders); idxShader++) {
         shd_CompiledShader* shader = shaders[idxShader];
-        str_join(arena, s8("  // "), shaderTypes[idxShader], s8("\n"));
-        str_join(arena, s8("  {\n"));
+        str_joinT(arena, s8("  // "), shaderTypes[idxShader], s8("\n"));
+        str_joinT(arena, s8("  {\n"));
         switch (program->variant) {
             case shd_shaderVariant_gl400:
             case shd_shaderVariant_gles3: {
@@ -861,23 +853,23 @@ void shd_generateHeaderProgramVariant(Arena* arena, S8 prefix, S8 name, shd_Rend
                     i32 endIdx = str_findChar(str_from(shader->sourceCode, idx), '\n');
                     S8 line = str_subStr(shader->sourceCode, idx, endIdx == -1 ? shader->sourceCode.size : (endIdx));
                     if (line.size > 0) {
-                        str_join(arena, s8("    \""), line, s8("\\n\"\n"));
+                        str_joinT(arena, s8("    \""), line, s8("\\n\"\n"));
                     } else {
-                        str_join(arena, s8("    \"\\n\"\n"));
+                        str_joinT(arena, s8("    \"\\n\"\n"));
                     }
                     if (endIdx == -1) {
                         break;
                     }
                     idx = idx + endIdx + 1;
                 }
-                str_join(arena, s8("    "), s8(",\n"));
-                str_join(arena, s8("    {0,0},\n"));
+                str_joinT(arena, s8("    "), s8(",\n"));
+                str_joinT(arena, s8("    {0,0},\n"));
         
             } break;
             default: ASSERT(!"Unimplemented shader variant");
         }
-        str_join(arena, s8("    \""), shader->reflection.entryPoint, s8("\",\n"));
-        str_join(arena, s8("    {\n"));
+        str_joinT(arena, s8("    \""), shader->reflection.entryPoint, s8("\",\n"));
+        str_joinT(arena, s8("    {\n"));
 
         for (u32 idx = 0; idx < shader->reflection.textureSamplers.count; idx++) {
             shd_TextureSampler* ts = &shader->reflection.textureSamplers.elements[0];
@@ -940,15 +932,15 @@ void shd_generateHeaderProgramVariant(Arena* arena, S8 prefix, S8 name, shd_Rend
             }
             exitSamplerSearch:
 
-            str_fmt(arena, s8("      {{true, {}, {}, {}, {}, {}, \"{}\"}},\n"), ts->slot, texResGroupSlot, texSlotRes, samplerResGroupSlot, samplerSlotRes, ts->name);
+            str_fmtT(arena, "      {{true, {}, {}, {}, {}, {}, \"{}\"}},\n", ts->slot, texResGroupSlot, texSlotRes, samplerResGroupSlot, samplerSlotRes, ts->name);
         }
-        str_join(arena, s8("    },\n"));
-        str_join(arena, s8("  },\n"));
+        str_joinT(arena, s8("    },\n"));
+        str_joinT(arena, s8("  },\n"));
     }
     
     // ResGroups
-    str_join(arena, s8("  // ResGroups\n"));
-    str_join(arena, s8("  {},\n"));
+    str_joinT(arena, s8("  // ResGroups\n"));
+    str_joinT(arena, s8("  {},\n"));
     for (u32 resIdx = 0; resIdx < countOf(codeInfo->resGroups); resIdx++) {
         ResGroupInfo* resGroup = &codeInfo->resGroups[resIdx];
         resourceType resTypes[] = {resourceType_texture, resourceType_sampler};
@@ -988,10 +980,10 @@ void shd_generateHeaderProgramVariant(Arena* arena, S8 prefix, S8 name, shd_Rend
     
 
     // Dynamic Constants
-    str_join(arena, s8("  // Dynamic constants\n"));
-    str_join(arena, s8("  {},\n"));
+    str_joinT(arena, s8("  // Dynamic constants\n"));
+    str_joinT(arena, s8("  {},\n"));
 
-    str_join(arena, s8("};\n"));
+    str_joinT(arena, s8("};\n"));
 }
 
 S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInfo* codeInfo, S8PairArray* typeMap) {
@@ -1057,74 +1049,74 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
         } RenderProgram;
 #endif
 
-        str_fmt(arena, str8("typedef struct {}StorageBuffer {{\n"), prefix);
-        str_join(arena, str8("    u32 slot;\n"));
-        str_join(arena, str8("    S8 name;\n"));
-        str_fmt(arena, str8("}} {}StorageBuffer;\n"), prefix);
+        str_fmtT(arena, "typedef struct {}StorageBuffer {{\n", prefix);
+        str_joinT(arena, str8("    u32 slot;\n"));
+        str_joinT(arena, str8("    S8 name;\n"));
+        str_fmtT(arena, "}} {}StorageBuffer;\n", prefix);
         
-        str_join(arena, str8("\n"));
+        str_joinT(arena, str8("\n"));
 
-        str_fmt(arena, str8("typedef enum {}generatedShaderType {{\n"), prefix);
-        str_fmt(arena, str8("    {}generatedShaderType_bindless,\n"), prefix);
-        str_fmt(arena, str8("    {}generatedShaderType_bindGroups,\n"), prefix);
-        str_fmt(arena, str8("}} {}generatedShaderType;\n"), prefix);
+        str_fmtT(arena, "typedef enum {}generatedShaderType {{\n", prefix);
+        str_fmtT(arena, "    {}generatedShaderType_bindless,\n", prefix);
+        str_fmtT(arena, "    {}generatedShaderType_bindGroups,\n", prefix);
+        str_fmtT(arena, "}} {}generatedShaderType;\n", prefix);
         
-        str_join(arena, str8("\n"));
+        str_joinT(arena, str8("\n"));
 
-        str_fmt(arena, str8("typedef struct {}ShaderInOutValue {{\n"), prefix);
-        str_join(arena, str8("    rx_vertexFormat type;\n"));
-        str_join(arena, str8("    S8 name;\n"));
-        str_fmt(arena, str8("}} {}ShaderInOutValue;\n"), prefix);
+        str_fmtT(arena, "typedef struct {}ShaderInOutValue {{\n", prefix);
+        str_joinT(arena, str8("    rx_vertexFormat type;\n"));
+        str_joinT(arena, str8("    S8 name;\n"));
+        str_fmtT(arena, "}} {}ShaderInOutValue;\n", prefix);
         
-        str_join(arena, str8("\n"));
-
-        str_fmt(arena, str8("typedef struct {}Shader {{\n"), prefix);
-        str_join(arena, str8("    S8 entry;\n"));
-        str_join(arena, str8("    struct {\n"));
-        str_fmt(arena, str8("        {}ShaderInOutValue* elements;\n"), prefix);
-        str_join(arena, str8("        uint32_t count;\n"));
-        str_join(arena, str8("    } in;\n"));
-        str_join(arena, str8("    struct {\n"));
-        str_fmt(arena, str8("        {}ShaderInOutValue* elements;\n"), prefix);
-        str_join(arena, str8("        uint32_t count;\n"));
-        str_join(arena, str8("    } out;\n"));
-        str_join(arena, str8("    struct {\n"));
-        str_fmt(arena,  str8("        {}StorageBuffer* elements;\n"), prefix);
-        str_join(arena, str8("        u32 count;\n"));
-        str_join(arena, str8("    } storageBuffers;\n"));
-        str_join(arena, str8("    u32 pushSize;\n"));
-        str_join(arena, str8("    S8 code;\n"));
-        str_fmt(arena, str8("}} {}Shader;\n"), prefix);
+        str_joinT(arena, str8("\n"));
+
+        str_fmtT(arena, "typedef struct {}Shader {{\n", prefix);
+        str_joinT(arena, str8("    S8 entry;\n"));
+        str_joinT(arena, str8("    struct {\n"));
+        str_fmtT(arena, "        {}ShaderInOutValue* elements;\n", prefix);
+        str_joinT(arena, str8("        uint32_t count;\n"));
+        str_joinT(arena, str8("    } in;\n"));
+        str_joinT(arena, str8("    struct {\n"));
+        str_fmtT(arena, "        {}ShaderInOutValue* elements;\n", prefix);
+        str_joinT(arena, str8("        uint32_t count;\n"));
+        str_joinT(arena, str8("    } out;\n"));
+        str_joinT(arena, str8("    struct {\n"));
+        str_fmtT(arena,  "        {}StorageBuffer* elements;\n", prefix);
+        str_joinT(arena, str8("        u32 count;\n"));
+        str_joinT(arena, str8("    } storageBuffers;\n"));
+        str_joinT(arena, str8("    u32 pushSize;\n"));
+        str_joinT(arena, str8("    S8 code;\n"));
+        str_fmtT(arena, "}} {}Shader;\n", prefix);
         
-        str_join(arena, str8("\n"));
+        str_joinT(arena, str8("\n"));
 
-        str_fmt(arena, str8("typedef struct {}ResBlocks {{\n"), prefix);
-        str_join(arena, str8("    u32 constantSize;\n"));
-        str_join(arena, str8("    u32 textureCount;\n"));
-        str_join(arena, str8("    u32 samplerCount;\n"));
-        str_fmt(arena, str8("}} {}ResBlocks;\n"), prefix);
+        str_fmtT(arena, "typedef struct {}ResBlocks {{\n", prefix);
+        str_joinT(arena, str8("    u32 constantSize;\n"));
+        str_joinT(arena, str8("    u32 textureCount;\n"));
+        str_joinT(arena, str8("    u32 samplerCount;\n"));
+        str_fmtT(arena, "}} {}ResBlocks;\n", prefix);
         
-        str_join(arena, str8("\n"));
-
-        str_fmt(arena, str8("typedef struct {}RenderProgram {{\n"), prefix);
-        str_join(arena, str8("    S8 name;\n"));
-        str_fmt(arena, str8("    {}Shader* vs;\n"), prefix);
-        str_fmt(arena, str8("    {}Shader* ps;\n"), prefix);
-        str_fmt(arena, str8("    {0}ResBlocks resBlocks[{1}];\n"), prefix, dynGroup__count);
-        str_fmt(arena, str8("}} {}RenderProgram;\n"), prefix);
+        str_joinT(arena, str8("\n"));
+
+        str_fmtT(arena, "typedef struct {}RenderProgram {{\n", prefix);
+        str_joinT(arena, str8("    S8 name;\n"));
+        str_fmtT(arena, "    {}Shader* vs;\n", prefix);
+        str_fmtT(arena, "    {}Shader* ps;\n", prefix);
+        str_fmtT(arena, "    {0}ResBlocks resBlocks[{1}];\n", prefix, dynGroup__count);
+        str_fmtT(arena, "}} {}RenderProgram;\n", prefix);
         
-        str_join(arena, str8("\n\n"));
+        str_joinT(arena, str8("\n\n"));
 
         // generate ResBlock structs
 
         
-        str_join(arena, str8("// Global ResBlocks\n"));
+        str_joinT(arena, str8("// Global ResBlocks\n"));
 
         for (u32 idx = 0; idx < fileInfo->resGroups.count; idx++) {
             mem_defineMakeStackArena(nameArena, 200);
             shd_ResGroup* resGroup = fileInfo->resGroups.elements + idx;
             S8 name = resGroup->genName.size == 0 ? resGroup->name : resGroup->genName;
-            str_fmt(arena, str8("typedef struct {0}{1} {{\n"), prefix, name);
+            str_fmtT(arena, "typedef struct {0}{1} {{\n", prefix, name);
             for (u32 resTypeIdx = 0; resTypeIdx < resourceType__count; resTypeIdx++) {
                 ResArr* resArr = &resGroup->info.resTypes[resTypeIdx];
                 for (u32 idx = 0; idx < resArr->count; idx++) {
@@ -1137,22 +1129,22 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
                         }
                     }
                     ASSERT(mapName.size > 0 && "Undefined type mapping");
-                    str_fmt(arena, str8("    {0} {1};\n"), mapName, resInfo->name);
+                    str_fmtT(arena, "    {0} {1};\n", mapName, resInfo->name);
                 }
             }
-            str_fmt(arena, str8("}} {0}{1};\n\n"), prefix, name);
+            str_fmtT(arena, "}} {0}{1};\n\n", prefix, name);
             
-            S8 handleName = str_join(nameArena, str_toLowerAscii(str_copy(nameArena, str_to(name, 1))), str_from(name, 1));
-            str_fmt(arena, str8("typedef struct {0}{1} {{\n"), prefix, handleName);
-            str_join(arena, str8("    uint32_t handleOrOffset;\n"));
-            str_fmt(arena, str8("}} {0}{1};\n\n"), prefix, handleName);
+            S8 handleName = str_joinT(nameArena, str_copyLowerAscii(nameArena, str_to(name, 1)), str_from(name, 1));
+            str_fmtT(arena, "typedef struct {0}{1} {{\n", prefix, handleName);
+            str_joinT(arena, str8("    uint32_t handleOrOffset;\n"));
+            str_fmtT(arena, "}} {0}{1};\n\n", prefix, handleName);
         }
 
-        str_join(arena, str8("\n"));
+        str_joinT(arena, str8("\n"));
 
         S8 resDefaultNames[] = {str8("_ResGroup0"), str8("_ResGroup1"), str8("_ResGroup2"), str8("_ResGroup3"), str8("_DynGroup0"), str8("_DynGroup1")};
         for (u32 idx = 0; idx < fileInfo->codeInfos.count; idx++) {
-            str_fmt(arena, str8("// Code {} ResGroups\n"), codeInfo->name);
+            str_fmtT(arena, "// Code {} ResGroups\n", codeInfo->name);
             for (u32 resGroupIdx = 0; resGroupIdx < countOf(codeInfo->resGroups); resGroupIdx++) {
                 ResGroupInfo* resGroupInfo = &codeInfo->resGroups[resGroupIdx];
                 S8 groupPrefix = str8("");
@@ -1167,7 +1159,7 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
                         }
                     }
                     if (globalResGroup) {
-                        str_fmt(arena, str8("typedef {0}{1} {0}{2}{3};\n\n"), prefix, resBlockName, codeInfo->name, resDefaultNames[resGroupIdx]);
+                        str_fmtT(arena, "typedef {0}{1} {0}{2}{3};\n\n", prefix, resBlockName, codeInfo->name, resDefaultNames[resGroupIdx]);
                         continue;
                     }
                 } else {
@@ -1186,7 +1178,7 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
                 }
 
                 if (hasValues) {
-                    str_fmt(arena, str8("typedef struct {0}{1}{2} {{\n"), prefix, groupPrefix, resBlockName);
+                    str_fmtT(arena, "typedef struct {0}{1}{2} {{\n", prefix, groupPrefix, resBlockName);
 
                     for (u32 resTypeIdx = 0; resTypeIdx < resourceType__count; resTypeIdx++) {
                         ResArr* resArr = &resGroupInfo->resTypes[resTypeIdx];
@@ -1199,39 +1191,39 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
                                 }
                             }
                             ASSERT(mapName.size > 0 && "Undefined type mapping");
-                            str_fmt(arena, str8("    {0} {1};\n"), mapName, resInfo->name);
+                            str_fmtT(arena, "    {0} {1};\n", mapName, resInfo->name);
                         }
                     }
 
-                    str_fmt(arena, str8("}} {0}{1}{2};\n\n"), prefix, groupPrefix, resBlockName);
+                    str_fmtT(arena, "}} {0}{1}{2};\n\n", prefix, groupPrefix, resBlockName);
                 }
             }
         }
         
-        str_join(arena, str8("\n"));
+        str_joinT(arena, str8("\n"));
 
         // build enums with render programs
-        str_join(arena, str8("// Render Programs\n"));
+        str_joinT(arena, str8("// Render Programs\n"));
 
-        str_join(arena, str8("typedef enum "), prefix, str8("renderProgram {\n"));
+        str_joinT(arena, str8("typedef enum "), prefix, str8("renderProgram {\n"));
 
         for (u32 idx = 0; idx < fileInfo->renderPrograms.count; idx++) {
             RenderProgram* renderProgram = fileInfo->renderPrograms.elements + idx;
-            str_join(arena, tab, prefix, str8("renderProgram_"), renderProgram->name, str8(",\n"));
+            str_joinT(arena, tab, prefix, str8("renderProgram_"), renderProgram->name, str8(",\n"));
         }
 
-        str_join(arena, tab, prefix, str8("renderProgram__count,\n"));
-        str_join(arena, str8("} "), prefix, str8("renderProgram;\n"));
+        str_joinT(arena, tab, prefix, str8("renderProgram__count,\n"));
+        str_joinT(arena, str8("} "), prefix, str8("renderProgram;\n"));
 
-        str_join(arena, str8("\n\n"));
+        str_joinT(arena, str8("\n\n"));
 
         for (u32 idx = 0; idx < fileInfo->renderPrograms.count; idx++) {
             RenderProgram* renderProgram = fileInfo->renderPrograms.elements + idx;
-            str_join(arena, str8("// RenderProgram: "), renderProgram->name, str8("\n\n"));
+            str_joinT(arena, str8("// RenderProgram: "), renderProgram->name, str8("\n\n"));
 
             // write (spirv) code
 
-            str_fmt(arena, str8("typedef struct {0}{1}Vertex {{\n"), prefix, renderProgram->name, renderProgram->vs.entry);
+            str_fmtT(arena, "typedef struct {0}{1}Vertex {{\n", prefix, renderProgram->name);
 
             for (u32 inputIdx = 0; inputIdx < renderProgram->vs.inputs.count; inputIdx++) {
                 shd_ShaderParam* input = renderProgram->vs.inputs.elements + inputIdx;
@@ -1242,16 +1234,16 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
                     str_lit("Vec4"),
                 };
                 S8 typeName = typeNames[input->type];
-                str_fmt(arena, str8("   {0}{1} {2};\n"), prefix, typeName, input->shortName);
+                str_fmtT(arena, "   {0}{1} {2};\n", prefix, typeName, input->shortName);
 
                 //input->
                 //shd_shaderParamType
                 //input->stortName
             }
 
-            str_fmt(arena, str8("}} {0}{1}Vertex;\n"), prefix, renderProgram->name, renderProgram->vs.entry);
+            str_fmtT(arena, "}} {0}{1}Vertex;\n", prefix, renderProgram->name);
 
-            str_join(arena, str8("\n"));
+            str_joinT(arena, str8("\n"));
 
             shd_generateHeaderShader(arena, &renderProgram->vs, renderProgram->name, prefix);
             shd_generateHeaderShader(arena, &renderProgram->ps, renderProgram->name, prefix);
@@ -1261,29 +1253,29 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
                 shd_generateHeaderProgramVariant(arena, prefix, renderProgram->name, &renderProgram->variants.elements[idx], codeInfo);
                 // switch (variant) {
                 //     case shd_shaderVariant_gl400: {
-                //         str_join(arena, s8("case rx_backend_gl400: "), prefix, renderProgram->name, s8("ShaderDescGl400();\n"));
+                //         str_joinT(arena, s8("case rx_backend_gl400: "), prefix, renderProgram->name, s8("ShaderDescGl400();\n"));
                 //     } break;
                 //     default: ASSERT(!"Unimplemented shader variant");
                 // }
             }
 
-            str_join(arena, s8("static rx_RenderShaderDesc "), prefix, renderProgram->name, s8("ShaderDesc(rx_backend backend) {\n"));
-            str_join(arena, s8("  switch (backend) {\n"));
+            str_joinT(arena, s8("static rx_RenderShaderDesc "), prefix, renderProgram->name, s8("ShaderDesc(rx_backend backend) {\n"));
+            str_joinT(arena, s8("  switch (backend) {\n"));
             for (u32 idx = 0; idx < renderProgram->variants.count; idx++) {
                 shd_shaderVariant variant = renderProgram->variants.elements[idx].variant;
                 switch (variant) {
                     case shd_shaderVariant_gl400: {
-                        str_join(arena, s8("    case rx_backend_gl400: return "), prefix, renderProgram->name, s8("ShaderDescGl400;\n"));
+                        str_joinT(arena, s8("    case rx_backend_gl400: return "), prefix, renderProgram->name, s8("ShaderDescGl400;\n"));
                     } break;
                     default: ASSERT(!"Unimplemented shader variant");
                 }
             }
-            str_join(arena, s8("    default: ASSERT(!\"Variant not generated\");\n"));
+            str_joinT(arena, s8("    default: ASSERT(!\"Variant not generated\");\n"));
 
-            str_join(arena, s8("  }\n"));
-            str_join(arena, s8("  return (rx_RenderShaderDesc) {0};\n"));
+            str_joinT(arena, s8("  }\n"));
+            str_joinT(arena, s8("  return (rx_RenderShaderDesc) {0};\n"));
 
-            str_join(arena, s8("}\n\n"));
+            str_joinT(arena, s8("}\n\n"));
 
             // writer ResGroups (Uniforms)
             /*
@@ -1293,11 +1285,11 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
                 Shader ps;
                 ResBlocks resBlocks[6];
             } RenderProgram;*/
-            str_fmt(arena, str8("static {0}RenderProgram {0}{1} = {{\n"), prefix, renderProgram->name);
-            str_fmt(arena, str8("    {{(u8*) \"{1}\", {2}}}, \n"), prefix, renderProgram->name, renderProgram->name.size);
-            str_fmt(arena, str8("    &{0}shaderVs_{1},\n"), prefix, renderProgram->name);
-            str_fmt(arena, str8("    &{0}shaderPs_{1},\n"), prefix, renderProgram->name);
-            str_fmt(arena, str8("    {{\n"), prefix, renderProgram->name);
+            str_fmtT(arena, "static {0}RenderProgram {0}{1} = {{\n", prefix, renderProgram->name);
+            str_fmtT(arena, "    {{(u8*) \"{1}\", {2}}}, \n", prefix, renderProgram->name, renderProgram->name.size);
+            str_fmtT(arena, "    &{0}shaderVs_{1},\n", prefix, renderProgram->name);
+            str_fmtT(arena, "    &{0}shaderPs_{1},\n", prefix, renderProgram->name);
+            str_joinT(arena, s8("    {\n"));
             for (u32 idx = 0; idx < countOf(codeInfo->resGroups); idx++) {
                 ResGroupInfo* info = codeInfo->resGroups + idx;
 
@@ -1315,42 +1307,42 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
                 ResArr* textures  = info->resTypes + resourceType_texture;
                 ResArr* samplers  = info->resTypes + resourceType_sampler;
 
-                str_fmt(arena, str8("        {{{0}, {1}, {2}}},\n"), constants->count, textures->count, samplers->count);
+                str_fmtT(arena, "        {{{0}, {1}, {2}}},\n", constants->count, textures->count, samplers->count);
             }
-            str_fmt(arena, str8("    }}\n"), prefix, renderProgram->name);
-            str_join(arena, str8("};\n"));
+            str_joinT(arena, s8("    }\n"));
+            str_joinT(arena, str8("};\n"));
         }
 
 
-        str_fmt(arena, str8("static {0}RenderProgram* {0}renderPrograms[] = {{\n"), prefix);
+        str_fmtT(arena, "static {0}RenderProgram* {0}renderPrograms[] = {{\n", prefix);
         for (u32 idx = 0; idx < fileInfo->renderPrograms.count; idx++) {
             RenderProgram* renderProgram = fileInfo->renderPrograms.elements + idx;
-            str_fmt(arena, str8("    &{0}{1},\n"), prefix, renderProgram->name);
+            str_fmtT(arena, "    &{0}{1},\n", prefix, renderProgram->name);
         }
 
-        str_join(arena, str8("};\n"));
+        str_joinT(arena, str8("};\n"));
 
         // push rest group & cmd builder
-        str_join(arena, str8("\n\n"));
+        str_joinT(arena, str8("\n\n"));
 
 
 
         for (u32 idx = 0; idx < fileInfo->renderPrograms.count; idx++) {
             RenderProgram* renderProgram = fileInfo->renderPrograms.elements + idx;
             
-            str_fmt(arena, str8("typedef struct {0}{1}CmdBuilder {{ rx_RenderCmdBuilder* builder; }} {0}{1}CmdBuilder;\n"), prefix, renderProgram->name);
+            str_fmtT(arena, "typedef struct {0}{1}CmdBuilder {{ rx_RenderCmdBuilder* builder; }} {0}{1}CmdBuilder;\n", prefix, renderProgram->name);
         }
         
 #if 0
-        str_fmt(arena, str8("{}RenderProgram* {}getRenderProgram({}renderProgram program) {{\n"), prefix);
-        str_join(arena, tab, str8("switch (program) {\n"));
+        str_fmtT(arena, "{0}RenderProgram* {0}getRenderProgram({0}renderProgram program) {{\n", prefix);
+        str_joinT(arena, tab, str8("switch (program) {\n"));
         for (u32 idx = 0; idx < count; idx++) {
             RenderProgram* renderProgram = renderPrograms + idx;
-            str_join(arena, tab, tab, str8("case "), prefix, str8("renderProgram_"), renderProgram->name, str8(": {\n"));
+            str_joinT(arena, tab, tab, str8("case "), prefix, str8("renderProgram_"), renderProgram->name, str8(": {\n"));
 
 
 
-            str_join(arena, tab, tab, str8("} break;"));
+            str_joinT(arena, tab, tab, str8("} break;"));
         }
 #endif
     }
@@ -1358,6 +1350,23 @@ S8 shd_generateHeader(Arena* arena, ShaderFileInfo* fileInfo, S8 prefix, CodeInf
     return generatedCode;
 }
 
+static constexpr auto shd__categoryKeywords = str_perfectHashT(
+    "RenderProgram", "Code", "DepthStencil", "RasterState", "ResGroup", "Material", "SamplerState"
+);
+static constexpr auto shd__renderProgramKeys = str_perfectHashT("name", "vsEntry", "psEntry");
+static constexpr auto shd__depthStencilKeys = str_perfectHashT(
+    "name", "disabled", "format", "depthWriteEnabled", "stencilEnabled", "stencilReadMask", "stencilWriteMask", "stencilRef",
+    "stencilFrontFailOp", "stencilFrontDepthFailOp", "stencilFrontPassOp", "stencilFrontCompareFunc",
+    "stencilBackFailOp", "stencilBackDepthFailOp", "stencilBackPassOp", "stencilBackCompareFunc"
+);
+static constexpr auto shd__rasterStateKeys = str_perfectHashT(
+    "name", "cullMode", "faceWinding", "depthBias", "depthBiasSlopeScale", "depthBiasClamp"
+);
+static constexpr auto shd__samplerStateKeys = str_perfectHashT(
+    "name", "addressModeU", "addressModeV", "addressModeW", "magFilter", "minFilter", "mipmapMode",
+    "lodMinClamp", "lodMaxClamp", "compare", "maxAnisotropy"
+);
+
 bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileName, S8 shaderFile) {
     //Arena* arena = os_tempMemory();
     log_trace(arena, s8("Compile..."));
@@ -1376,18 +1385,18 @@ bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileNam
     //CodeInfo* codeInfo = NULL;
     for (bx running = scf_next(&scf); running;) {
         //log_warn(str8("category: \""), scf.category, "\"");
-        if (str_isEqual(scf.category, str8("RenderProgram"))) {
+        u32 category = shd__categoryKeywords.find(scf.category);
+        if (category == shd__categoryKeywords.indexOf("RenderProgram")) {
             // record RenderProgram
             S8 name = {};
             S8 vsEntry = {};
             S8 psEntry = {};
             for (running = scf_next(&scf); running && scf.valueType != scf_type_category; running = scf_next(&scf)) {
-                if (str_isEqual(scf.key, str8("name"))) {
-                    name = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("vsEntry"))) {
-                    vsEntry = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("psEntry"))) {
-                    psEntry = scf.valueStr;
+                switch (shd__renderProgramKeys.find(scf.key)) {
+                    case shd__renderProgramKeys.indexOf("name"): name = scf.valueStr; break;
+                    case shd__renderProgramKeys.indexOf("vsEntry"): vsEntry = scf.valueStr; break;
+                    case shd__renderProgramKeys.indexOf("psEntry"): psEntry = scf.valueStr; break;
+                    default: break;
                 }
             }
             //log_traceFmt("RenderProgram: {0} vsEtry: {1} psEntry: {2}", name, vsEntry, psEntry);
@@ -1396,7 +1405,7 @@ bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileNam
             newProgram->vs.entry = vsEntry;
             newProgram->ps.entry = psEntry;
             continue;
-        } else if (str_isEqual(scf.category, str8("Code"))) {
+        } else if (category == shd__categoryKeywords.indexOf("Code")) {
             CodeInfo* codeInfo = arrPushGet(arena, &outFileInfo->codeInfos);
             for (u32 resGroupIdx = 0; resGroupIdx < countOf(codeInfo->resGroups); resGroupIdx++) {
                 for (u32 resTypeIdx = 0; resTypeIdx < countOf(codeInfo->resGroups[0].resTypes); resTypeIdx++) {
@@ -1405,39 +1414,22 @@ bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileNam
             }
             arrInit(arena, &codeInfo->replaceBlocks, 20);
 
-            S8 cname = {};
-            S8 cresGroup0 = {};
-            S8 cresGroup1 = {};
-            S8 cresGroup2 = {};
-            S8 cresGroup3 = {};
-            S8 cdynResGroup0 = {};
-            S8 cdynResGroup1 = {};
+            codeInfo->name = S8{};
+            for (u32 idx = 0; idx < countOf(codeInfo->resGroupNames); idx++) {
+                codeInfo->resGroupNames[idx] = S8{};
+            }
 
             // run ini parser till we run into code
             for (running = scf_next(&scf); running && scf.valueType != scf_type_category; running = scf_next(&scf)) {
                 if (str_isEqual(scf.key, str8("name"))) {
-                    cname = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("resGroup0"))) {
-                    cresGroup0 = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("resGroup1"))) {
-                    cresGroup1 = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("resGroup2"))) {
-                    cresGroup2 = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("resGroup3"))) {
-                    cresGroup3 = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("dynResGroup0"))) {
-                    cdynResGroup0 = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("dynResGroup1"))) {
-                    cdynResGroup1 = scf.valueStr;
+                    codeInfo->name = scf.valueStr;
+                    continue;
+                }
+                u32 group = resGroupKeywords.find(scf.key);
+                if (group < resGroupKeywords.count) {
+                    codeInfo->resGroupNames[group] = scf.valueStr;
                 }
             }
-            codeInfo->name = cname;
-            codeInfo->resGroupNames[0] = cresGroup0;
-            codeInfo->resGroupNames[1] = cresGroup1;
-            codeInfo->resGroupNames[2] = cresGroup2;
-            codeInfo->resGroupNames[3] = cresGroup3;
-            codeInfo->resGroupNames[4] = cdynResGroup0;
-            codeInfo->resGroupNames[5] = cdynResGroup1;
 
             // Parse shader code metadata
             log_trace(arena, s8("Parse code..."));
@@ -1490,23 +1482,12 @@ bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileNam
 
                     resourceType resType = resourceType_invalid;
 
-                    resGroup group = resGroup0;
                     // ResGroup0-3, DynResGroup0-1
-                    if (str_isEqual(resTypeToken.text, str8("resGroup0"))) {
-                        group = resGroup0;
-                    } else if (str_isEqual(resTypeToken.text, str8("resGroup1"))) {
-                        group = resGroup1;
-                    } else if (str_isEqual(resTypeToken.text, str8("resGroup2"))) {
-                        group = resGroup2;
-                    } else if (str_isEqual(resTypeToken.text, str8("resGroup3"))) {
-                        group = resGroup3;
-                    } else if (str_isEqual(resTypeToken.text, str8("dynResGroup0"))) {
-                        group = dynGroup0;
-                    } else if (str_isEqual(resTypeToken.text, str8("dynResGroup1"))) {
-                        group = dynGroup1;
-                    } else {
+                    u32 groupIdx = resGroupKeywords.find(resTypeToken.text);
+                    if (groupIdx == resGroupKeywords.count) {
                         break; // error unknown resource type name
                     }
+                    resGroup group = (resGroup) groupIdx;
 
                     if (!tn_parsing(&tkn)) break;
                     nextToken = tn_getToken(&tkn);
@@ -1564,14 +1545,7 @@ bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileNam
                         break; // expected TYPE
                     }
 
-                    // todo properly parse all supported types
-                    if (str_isEqual(fnTypeToken.text, str8("Texture2D"))) {
-                        resType = resourceType_texture;
-                    } else if (str_isEqual(fnTypeToken.text, str8("SamplerState"))) {
-                        resType = resourceType_sampler;
-                    } else {
-                        resType = resourceType_constant;
-                    }
+                    resType = getResourceType(fnTypeToken.text);
 
                     if (!tn_parsing(&tkn)) break;
                     tn_Token fnNameToken = tn_getToken(&tkn);
@@ -1656,69 +1630,49 @@ bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileNam
                 firstLineSymbol = token.type == tn_tokenType_endOfLine ? true : false;
                 running = tn_parsing(&tokenizer);
             }
-        } else if (str_isEqual(scf.category, str8("DepthStencil"))) {
+        } else if (category == shd__categoryKeywords.indexOf("DepthStencil")) {
             shd_DepthStencil* depthStencil = arrPushGet(arena, &outFileInfo->depthStencils);
             mem_setZero(depthStencil, sizeof(shd_DepthStencil));
             for (running = scf_next(&scf); running && scf.valueType != scf_type_category; running = scf_next(&scf)) {
-                if (str_isEqual(scf.key, str8("name"))) {
-                    depthStencil->name = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("disabled"))) {
-                    depthStencil->disabled = str_isEqual(scf.valueStr, str8("true")) ? true : false;
-                } else if (str_isEqual(scf.key, str8("format"))) {
-                    depthStencil->format = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("depthWriteEnabled"))) {
-                    depthStencil->depthWriteEnabled = str_isEqual(scf.valueStr, str8("true")) ? true : false;
-                } else if (str_isEqual(scf.key, str8("stencilEnabled"))) {
-                    depthStencil->stencilEnabled = str_isEqual(scf.valueStr, str8("true")) ? true : false;
-                } else if (str_isEqual(scf.key, str8("stencilReadMask"))) {
-                    depthStencil->stencilReadMask = str_parseU32(scf.valueStr);
-                } else if (str_isEqual(scf.key, str8("stencilWriteMask"))) {
-                    depthStencil->stencilWriteMask = str_parseU32(scf.valueStr);
-                } else if (str_isEqual(scf.key, str8("stencilRef"))) {
-                    depthStencil->stencilRef = str_parseU32(scf.valueStr);
-                } else if (str_isEqual(scf.key, str8("stencilFrontFailOp"))) {
-                    depthStencil->stencilFrontFailOp = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("stencilFrontDepthFailOp"))) {
-                    depthStencil->stencilFrontDepthFailOp = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("stencilFrontPassOp"))) {
-                    depthStencil->stencilFrontPassOp = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("stencilFrontCompareFunc"))) {
-                    depthStencil->stencilFrontCompareFunc = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("stencilBackFailOp"))) {
-                    depthStencil->stencilBackFailOp = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("stencilBackDepthFailOp"))) {
-                    depthStencil->stencilBackDepthFailOp = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("stencilBackPassOp"))) {
-                    depthStencil->stencilBackPassOp = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("stencilBackCompareFunc"))) {
-                    depthStencil->stencilBackCompareFunc = scf.valueStr;
-                } else {
-                    // unknown value
+                switch (shd__depthStencilKeys.find(scf.key)) {
+                    case shd__depthStencilKeys.indexOf("name"): depthStencil->name = scf.valueStr; break;
+                    case shd__depthStencilKeys.indexOf("disabled"): depthStencil->disabled = str_isEqual(scf.valueStr, str8("true")) ? true : false; break;
+                    case shd__depthStencilKeys.indexOf("format"): depthStencil->format = scf.valueStr; break;
+                    case shd__depthStencilKeys.indexOf("depthWriteEnabled"): depthStencil->depthWriteEnabled = str_isEqual(scf.valueStr, str8("true")) ? true : false; break;
+                    case shd__depthStencilKeys.indexOf("stencilEnabled"): depthStencil->stencilEnabled = str_isEqual(scf.valueStr, str8("true")) ? true : false; break;
+                    case shd__depthStencilKeys.indexOf("stencilReadMask"): depthStencil->stencilReadMask = str_parseU32(scf.valueStr); break;
+                    case shd__depthStencilKeys.indexOf("stencilWriteMask"): depthStencil->stencilWriteMask = str_parseU32(scf.valueStr); break;
+                    case shd__depthStencilKeys.indexOf("stencilRef"): depthStencil->stencilRef = str_parseU32(scf.valueStr); break;
+                    case shd__depthStencilKeys.indexOf("stencilFrontFailOp"): depthStencil->stencilFrontFailOp = scf.valueStr; break;
+                    case shd__depthStencilKeys.indexOf("stencilFrontDepthFailOp"): depthStencil->stencilFrontDepthFailOp = scf.valueStr; break;
+                    case shd__depthStencilKeys.indexOf("stencilFrontPassOp"): depthStencil->stencilFrontPassOp = scf.valueStr; break;
+                    case shd__depthStencilKeys.indexOf("stencilFrontCompareFunc"): depthStencil->stencilFrontCompareFunc = scf.valueStr; break;
+                    case shd__depthStencilKeys.indexOf("stencilBackFailOp"): depthStencil->stencilBackFailOp = scf.valueStr; break;
+                    case shd__depthStencilKeys.indexOf("stencilBackDepthFailOp"): depthStencil->stencilBackDepthFailOp = scf.valueStr; break;
+                    case shd__depthStencilKeys.indexOf("stencilBackPassOp"): depthStencil->stencilBackPassOp = scf.valueStr; break;
+                    case shd__depthStencilKeys.indexOf("stencilBackCompareFunc"): depthStencil->stencilBackCompareFunc = scf.valueStr; break;
+                    default: break; // unknown value
                 }
             }
             //log_traceFmt("DepthStencil: {0}", depthStencil->name);
             continue;
-        } else if (str_isEqual(scf.category, str8("RasterState"))) {
+        } else if (category == shd__categoryKeywords.indexOf("RasterState")) {
             shd_RasterState* rasterState = arrPushGet(arena, &outFileInfo->rasterStates);
             mem_setZero(rasterState, sizeof(shd_RasterState));
             for (running = scf_next(&scf); running && scf.valueType != scf_type_category; running = scf_next(&scf)) {
-                if (str_isEqual(scf.key, str8("name"))) {
-                    rasterState->name = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("cullMode"))) {
-                    rasterState->cullMode = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("faceWinding"))) {
-                    rasterState->faceWinding = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("depthBias"))) {
-                    rasterState->depthBias = str_parseF32(scf.valueStr);
-                } else if (str_isEqual(scf.key, str8("depthBiasSlopeScale"))) {
-                    rasterState->depthBiasSlopeScale = str_parseF32(scf.valueStr);
-                } else if (str_isEqual(scf.key, str8("depthBiasClamp"))) {
-                    rasterState->depthBiasClamp = str_parseF32(scf.valueStr);
+                switch (shd__rasterStateKeys.find(scf.key)) {
+                    case shd__rasterStateKeys.indexOf("name"): rasterState->name = scf.valueStr; break;
+                    case shd__rasterStateKeys.indexOf("cullMode"): rasterState->cullMode = scf.valueStr; break;
+                    case shd__rasterStateKeys.indexOf("faceWinding"): rasterState->faceWinding = scf.valueStr; break;
+                    case shd__rasterStateKeys.indexOf("depthBias"): rasterState->depthBias = str_parseF32(scf.valueStr); break;
+                    case shd__rasterStateKeys.indexOf("depthBiasSlopeScale"): rasterState->depthBiasSlopeScale = str_parseF32(scf.valueStr); break;
+                    case shd__rasterStateKeys.indexOf("depthBiasClamp"): rasterState->depthBiasClamp = str_parseF32(scf.valueStr); break;
+                    default: break; // unknown value
                 }
             }
             //log_traceFmt("RasterState: {0}", rasterState->name);
             continue;
-        } else if (str_isEqual(scf.category, str8("ResGroup"))) {
+        } else if (category == shd__categoryKeywords.indexOf("ResGroup")) {
             shd_ResGroup* resGroup = arrPushGet(arena, &outFileInfo->resGroups);
             mem_setZero(resGroup, sizeof(shd_ResGroup));
             arrInit(arena, &resGroup->info.resTypes[resourceType_constant], 8);
@@ -1731,14 +1685,7 @@ bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileNam
                 } else if (str_isEqual(scf.key, str8("genName"))) {
                     resGroup->genName = scf.valueStr;
                 } else {
-                    resourceType resType;
-                    if (str_isEqual(scf.valueStr, str8("Texture2D"))) {
-                        resType = resourceType_texture;
-                    } else if (str_isEqual(scf.valueStr, str8("SamplerState"))) {
-                        resType = resourceType_sampler;
-                    } else {
-                        resType = resourceType_constant;
-                    }
+                    resourceType resType = getResourceType(scf.valueStr);
                     ResArr* resArr = &resGroup->info.resTypes[resType];
                     ResInfo* resInfo = arrPushGet(arena, resArr);
                     resInfo->name = scf.key;
@@ -1774,7 +1721,7 @@ bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileNam
             }
             //log_traceFmt("ResGroup: {0}", resGroup->name);
             continue;
-        } else if (str_isEqual(scf.category, str8("Material"))) {
+        } else if (category == shd__categoryKeywords.indexOf("Material")) {
             shd_Material* material = arrPushGet(arena, &outFileInfo->materials);
             arrInit(arena, &material->properties, 8);
 
@@ -1792,33 +1739,24 @@ bx shd_parseFromFile(Arena* arena, ShaderFileInfo* outFileInfo, S8 shaderFileNam
             }
             //log_traceFmt("Material: {0}", material->name);
             continue;
-        }  else if (str_isEqual(scf.category, str8("SamplerState"))) {
+        }  else if (category == shd__categoryKeywords.indexOf("SamplerState")) {
             shd_SamplerState* samplerState = arrPushGet(arena, &outFileInfo->samplerStates);
 
             mem_setZero(samplerState, sizeof(shd_SamplerState));
             for (running = scf_next(&scf); running && scf.valueType != scf_type_category; running = scf_next(&scf)) {
-                if (str_isEqual(scf.key, str8("name"))) {
-                    samplerState->name = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("addressModeU"))) {
-                    samplerState->addressModeU = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("addressModeV"))) {
-                    samplerState->addressModeV = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("addressModeW"))) {
-                    samplerState->addressModeW = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("magFilter"))) {
-                    samplerState->magFilter = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("minFilter"))) {
-                    samplerState->minFilter = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("mipmapMode"))) {
-                    samplerState->mipmapMode = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("lodMinClamp"))) {
-                    samplerState->lodMinClamp = str_parseF32(scf.valueStr);
-                } else if (str_isEqual(scf.key, str8("lodMaxClamp"))) {
-                    samplerState->lodMaxClamp = str_parseF32(scf.valueStr);
-                } else if (str_isEqual(scf.key, str8("compare"))) {
-                    samplerState->compare = scf.valueStr;
-                } else if (str_isEqual(scf.key, str8("maxAnisotropy"))) {
-                    samplerState->maxAnisotropy = str_parseF32(scf.valueStr);
+                switch (shd__samplerStateKeys.find(scf.key)) {
+                    case shd__samplerStateKeys.indexOf("name"): samplerState->name = scf.valueStr; break;
+                    case shd__samplerStateKeys.indexOf("addressModeU"): samplerState->addressModeU = scf.valueStr; break;
+                    case shd__samplerStateKeys.indexOf("addressModeV"): samplerState->addressModeV = scf.valueStr; break;
+                    case shd__samplerStateKeys.indexOf("addressModeW"): samplerState->addressModeW = scf.valueStr; break;
+                    case shd__samplerStateKeys.indexOf("magFilter"): samplerState->magFilter = scf.valueStr; break;
+                    case shd__samplerStateKeys.indexOf("minFilter"): samplerState->minFilter = scf.valueStr; break;
+                    case shd__samplerStateKeys.indexOf("mipmapMode"): samplerState->mipmapMode = scf.valueStr; break;
+                    case shd__samplerStateKeys.indexOf("lodMinClamp"): samplerState->lodMinClamp = str_parseF32(scf.valueStr); break;
+                    case shd__samplerStateKeys.indexOf("lodMaxClamp"): samplerState->lodMaxClamp = str_parseF32(scf.valueStr); break;
+                    case shd__samplerStateKeys.indexOf("compare"): samplerState->compare = scf.valueStr; break;
+                    case shd__samplerStateKeys.indexOf("maxAnisotropy"): samplerState->maxAnisotropy = str_parseF32(scf.valueStr); break;
+                    default: break; // unknown value
                 }
             }
             //log_traceFmt("SamplerState: {0}", samplerState->name);
@@ -1846,7 +1784,7 @@ static void shd__toCombinedImageSamplers(CompilerGLSL& compiler) {
         mem_scoped(scopedMem, nameArena) {
             S8 img_name0 = str_fromCppStd(img_name);
             S8 smp_name0 = str_fromCppStd(smp_name);
-            S8 name = str_join(scopedMem.arena, img_name0, s8("_"), smp_name0);
+            S8 name = str_joinT(scopedMem.arena, img_name0, s8("_"), smp_name0);
             const std::string stdName((const char*) name.content, (size_t) name.size);
             compiler.set_name(remap.combined_id, stdName);
         }
@@ -2270,7 +2208,7 @@ static shd_CompiledShader* shd_toGlsl(Arena* arena, S8 spirvByteCode, uint32_t o
                 S8 inputName = str_fromCppStd(resAttr.name);
                 u32 startIdxShort = str_lastIndexOfChar(inputName, u8'.') + 1;
                 S8 inputNameShort = str_from(inputName, startIdxShort);
-                S8 newInputName = str_join(arena, s8("varying_"), inputNameShort);
+                S8 newInputName = str_joinT(arena, s8("varying_"), inputNameShort);
                 std::string inputStdString( reinterpret_cast<char const*>(newInputName.content), newInputName.size );
                 compiler.set_name(resAttr.id, inputStdString);
             }
@@ -2287,7 +2225,7 @@ static shd_CompiledShader* shd_toGlsl(Arena* arena, S8 spirvByteCode, uint32_t o
                 // overwrite in/out name to match each other
                 u32 startIdxShort = str_lastIndexOfChar(outputName, u8'.') + 1;
                 S8 outputNameShort = str_from(outputName, startIdxShort);
-                S8 newOutputName = str_join(arena, s8("varying_"), outputNameShort);
+                S8 newOutputName = str_joinT(arena, s8("varying_"), outputNameShort);
                 std::string outputStdString( reinterpret_cast<char const*>(newOutputName.content), newOutputName.size );
                 compiler.set_name(resAttr.id, outputStdString);
             }
@@ -2358,7 +2296,7 @@ void shd__generateShaderGenLegacy(Arena* arena, ShaderFileInfo* shaderFileInfo,
             ResArr* namedResArr = &namedResGroup->resTypes[resTypeIdx];
             if (namedResArr->count) { // cbuffer MVPBuffer : register(b0)
                 // write res groups
-                str_join(arena, str8("cbuffer "), str8("rx__resGroup"), resGroupIdx, s8(" : register(b0, space"), resGroupIdx, str8(") {\n"));
+                str_joinT(arena, str8("cbuffer "), str8("rx__resGroup"), resGroupIdx, s8(" : register(b0, space"), resGroupIdx, str8(") {\n"));
                 for (u32 idx = 0; idx < namedResArr->count; idx++) {
                     ResInfo* namedResInfo = namedResArr->elements + idx;
 
@@ -2372,14 +2310,14 @@ void shd__generateShaderGenLegacy(Arena* arena, ShaderFileInfo* shaderFileInfo,
                             //u32 size = constTypeByteSize[namedResInfo->type];;
                             switch ((resourceType)resTypeIdx) {
                                 case resourceType_constant: {
-                                    str_join(arena, s8("  "), namedResInfo->typeName, str8(" rx__"), namedResInfo->name, str8(";\n"));
+                                    str_joinT(arena, s8("  "), namedResInfo->typeName, str8(" rx__"), namedResInfo->name, str8(";\n"));
                                 } break;
                                 default: ASSERT(!"Unreachable!");
                             }
                         }
                     }
                 }
-                str_join(arena, str8("};\n"));
+                str_joinT(arena, str8("};\n"));
 
                 // write getter body
                 for (u32 idx = 0; idx < namedResArr->count; idx++) {
@@ -2395,9 +2333,9 @@ void shd__generateShaderGenLegacy(Arena* arena, ShaderFileInfo* shaderFileInfo,
                             //u32 size = constTypeByteSize[namedResInfo->type];;
                             switch ((resourceType)resTypeIdx) {
                                 case resourceType_constant: {
-                                    str_join(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
-                                    str_join(arena, s8("  return "), str8("rx__"), namedResInfo->name, str8(";\n"));
-                                    str_join(arena, str8("}\n"));
+                                    str_joinT(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
+                                    str_joinT(arena, s8("  return "), str8("rx__"), namedResInfo->name, str8(";\n"));
+                                    str_joinT(arena, str8("}\n"));
                                 } break;
                                 default: ASSERT(!"Unreachable!");
                             }
@@ -2426,18 +2364,18 @@ void shd__generateShaderGenLegacy(Arena* arena, ShaderFileInfo* shaderFileInfo,
                         //u32 size = constTypeByteSize[namedResInfo->type];;
                         switch ((resourceType)resTypeIdx) {
                             case resourceType_texture: {
-                                str_join(arena, namedResInfo->typeName, s8(" rx__"), namedResInfo->name, s8(": register(t"), samplerIdx, s8(", space"), resGroupIdx, s8(");\n"));
+                                str_joinT(arena, namedResInfo->typeName, s8(" rx__"), namedResInfo->name, s8(": register(t"), samplerIdx, s8(", space"), resGroupIdx, s8(");\n"));
                                 textureIdx += 1;
-                                str_join(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
-                                str_join(arena, s8("    return "), s8("rx__"), namedResInfo->name, s8(";\n")); 
-                                str_join(arena, str8("}\n\n"));
+                                str_joinT(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
+                                str_joinT(arena, s8("    return "), s8("rx__"), namedResInfo->name, s8(";\n")); 
+                                str_joinT(arena, str8("}\n\n"));
                             }; break;
                             case resourceType_sampler: {
-                                str_join(arena, namedResInfo->typeName, s8(" rx__"), namedResInfo->name, s8(": register(s"), samplerIdx, s8(", space"), resGroupIdx, s8(");\n"));
+                                str_joinT(arena, namedResInfo->typeName, s8(" rx__"), namedResInfo->name, s8(": register(s"), samplerIdx, s8(", space"), resGroupIdx, s8(");\n"));
                                 samplerIdx += 1;
-                                str_join(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
-                                str_join(arena, s8("    return "), s8("rx__"), namedResInfo->name, s8(";\n")); 
-                                str_join(arena, str8("}\n\n"));
+                                str_joinT(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
+                                str_joinT(arena, s8("    return "), s8("rx__"), namedResInfo->name, s8(";\n")); 
+                                str_joinT(arena, str8("}\n\n"));
                             }; break;
                             default: break;
                         }
@@ -2449,18 +2387,18 @@ void shd__generateShaderGenLegacy(Arena* arena, ShaderFileInfo* shaderFileInfo,
 }
 
 void shd__generateShaderGenBindless(Arena* arena, ShaderFileInfo* shaderFileInfo, CodeInfo* codeInfo) {
-    str_join(arena, str8("[[vk::push_constant]]"), str8("\n"));
-    str_join(arena, str8("struct rx_pushConstants {"), str8("\n"));
-    str_join(arena, str8("	uint instanceRefIndicies[6];"), str8("\n"));
-    str_join(arena, str8("} rx_pushConstants;"), str8("\n\n"));
+    str_joinT(arena, str8("[[vk::push_constant]]"), str8("\n"));
+    str_joinT(arena, str8("struct rx_pushConstants {"), str8("\n"));
+    str_joinT(arena, str8("	uint instanceRefIndicies[6];"), str8("\n"));
+    str_joinT(arena, str8("} rx_pushConstants;"), str8("\n\n"));
 
 
-    str_join(arena, str8("[[vk::binding(0, 0)]] ByteAddressBuffer   rx_staticResBlocks;"), str8("\n"));
-    str_join(arena, str8("[[vk::binding(1, 0)]] ByteAddressBuffer   rx_dynamicResBlocks;"), str8("\n"));
-    str_join(arena, str8("[[vk::binding(2, 0)]] Texture2D			rx_textures[];"), str8("\n"));
-    str_join(arena, str8("[[vk::binding(3, 0)]] SamplerState		rx_samplers[];"), str8("\n\n"));
+    str_joinT(arena, str8("[[vk::binding(0, 0)]] ByteAddressBuffer   rx_staticResBlocks;"), str8("\n"));
+    str_joinT(arena, str8("[[vk::binding(1, 0)]] ByteAddressBuffer   rx_dynamicResBlocks;"), str8("\n"));
+    str_joinT(arena, str8("[[vk::binding(2, 0)]] Texture2D			rx_textures[];"), str8("\n"));
+    str_joinT(arena, str8("[[vk::binding(3, 0)]] SamplerState		rx_samplers[];"), str8("\n\n"));
     // this maybe only needed for compute shader probably...
-    //str_join(arena, str8("[[vk::binding(3, 0)]] RWByteAddressBuffer		rx_buffer[];"), str8("\n"));
+    //str_joinT(arena, str8("[[vk::binding(3, 0)]] RWByteAddressBuffer		rx_buffer[];"), str8("\n"));
 
     for (u32 resGroupIdx = 0; resGroupIdx < countOf(codeInfo->resGroups); resGroupIdx++) {
         ResGroupInfo* resGroupInfo = &codeInfo->resGroups[resGroupIdx];
@@ -2492,23 +2430,23 @@ void shd__generateShaderGenBindless(Arena* arena, ShaderFileInfo* shaderFileInfo
                         //u32 size = constTypeByteSize[namedResInfo->type];;
                         switch ((resourceType)resTypeIdx) {
                             case resourceType_constant: {
-                                str_join(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
-                                str_fmt(arena, str8("	return {0}.Load<{1}>(rx_pushConstants.instanceRefIndicies[{2}] * sizeof(uint) + sizeof(uint) * {3});\n"), resBlockName, namedResInfo->typeName, resGroupIdx, byteOffset);   
-                                str_join(arena, str8("}\n"));
+                                str_joinT(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
+                                str_fmtT(arena, "	return {0}.Load<{1}>(rx_pushConstants.instanceRefIndicies[{2}] * sizeof(uint) + sizeof(uint) * {3});\n", resBlockName, namedResInfo->typeName, resGroupIdx, byteOffset);   
+                                str_joinT(arena, str8("}\n"));
                                 byteOffset += namedResInfo->byteSize / 4;
                             } break;
                             case resourceType_texture: {
-                                str_join(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
-                                str_fmt(arena,  str8("    uint index = {0}.Load(rx_pushConstants.instanceRefIndicies[{2}] * sizeof(uint) + sizeof(uint) * {3});\n"), resBlockName, namedResInfo->typeName, resGroupIdx, byteOffset);   
-                                str_join(arena, str8("    return rx_textures[index];\n")); 
-                                str_join(arena, str8("}\n"));  
+                                str_joinT(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
+                                str_fmtT(arena,  "    uint index = {0}.Load(rx_pushConstants.instanceRefIndicies[{2}] * sizeof(uint) + sizeof(uint) * {3});\n", resBlockName, namedResInfo->typeName, resGroupIdx, byteOffset);   
+                                str_joinT(arena, str8("    return rx_textures[index];\n")); 
+                                str_joinT(arena, str8("}\n"));  
                                 byteOffset += namedResInfo->byteSize / 4;
                             }; break;
                             case resourceType_sampler: {
-                                str_join(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
-                                str_fmt(arena,  str8("    uint index = {0}.Load(rx_pushConstants.instanceRefIndicies[{2}] * sizeof(uint) + sizeof(uint) * {3});\n"), resBlockName, namedResInfo->typeName, resGroupIdx, byteOffset);     
-                                str_join(arena, str8("    return rx_samplers[index];\n")); 
-                                str_join(arena, str8("}\n"));  
+                                str_joinT(arena, namedResInfo->typeName, str8(" "), namedResInfo->name, str8("() {\n"));
+                                str_fmtT(arena,  "    uint index = {0}.Load(rx_pushConstants.instanceRefIndicies[{2}] * sizeof(uint) + sizeof(uint) * {3});\n", resBlockName, namedResInfo->typeName, resGroupIdx, byteOffset);     
+                                str_joinT(arena, str8("    return rx_samplers[index];\n")); 
+                                str_joinT(arena, str8("}\n"));  
                                 byteOffset += namedResInfo->byteSize / 4;
                             }; break;
                             default: break;
@@ -2526,7 +2464,7 @@ bx shd_generateShaders(Arena* arena, DxCompiler* dxCompiler, ShaderFileInfo* sha
     str_record(generatedCode, arena) {
 
         for (u64 idx = 0; idx < codeInfo->line; idx++) {
-            str_join(arena, str8("// padding for getting the correct error line\n"));
+            str_joinT(arena, str8("// padding for getting the correct error line\n"));
         }
 
         // Generate code for
@@ -2537,38 +2475,38 @@ bx shd_generateShaders(Arena* arena, DxCompiler* dxCompiler, ShaderFileInfo* sha
             u64 currOffset = ((u64)block->start.text.content);
             u64 length = currOffset - lastOffset;
             mem_copy(mem_arenaPush(arena, length), lastPointer, length);
-            str_join(arena, str8("/*"));
+            str_joinT(arena, str8("/*"));
             lastOffset = ((u64) block->end.text.content) + block->end.text.size;
             lastPointer = block->end.text.content + block->end.text.size;
             length =  lastOffset - currOffset;
             mem_copy(mem_arenaPush(arena, length), block->start.text.content, length);
-            str_join(arena, str8("*/"));
+            str_joinT(arena, str8("*/"));
         }
         u64 lastLength = (((u64)codeInfo->code.content) + codeInfo->code.size) - lastOffset;
         mem_copy(mem_arenaPush(arena, lastLength), lastPointer, lastLength);
 
-        str_join(arena, str8("\n\n"));
-        str_join(arena, str8("//******************************************************************//"), str8("\n"));
-        str_join(arena, str8("//******************************************************************//"), str8("\n"));
-        str_join(arena, str8("//************************ GENERATED CODE **************************//"), str8("\n"));
-        str_join(arena, str8("//******************************************************************//"), str8("\n"));
-        str_join(arena, str8("//******************************************************************//"), str8("\n"));
-        str_join(arena, str8("\n\n"));
+        str_joinT(arena, str8("\n\n"));
+        str_joinT(arena, str8("//******************************************************************//"), str8("\n"));
+        str_joinT(arena, str8("//******************************************************************//"), str8("\n"));
+        str_joinT(arena, str8("//************************ GENERATED CODE **************************//"), str8("\n"));
+        str_joinT(arena, str8("//******************************************************************//"), str8("\n"));
+        str_joinT(arena, str8("//******************************************************************//"), str8("\n"));
+        str_joinT(arena, str8("\n\n"));
 
         shd__generateShaderGenLegacy(arena, shaderFileInfo, codeInfo);
 
-        //str_join(arena, str8("\n\n"));
+        //str_joinT(arena, str8("\n\n"));
 
-        //str_join(arena, str8("#if 0"));
+        //str_joinT(arena, str8("#if 0"));
         //shd__generateShaderGenBindless(arena, shaderFileInfo, codeInfo);
-        //str_join(arena, str8("#endif"));
+        //str_joinT(arena, str8("#endif"));
 
         
         #if 0
         for (u32 resGroupIdx = 0; resGroupIdx < countOf(codeInfo->resGroups); resGroupIdx++) {
             if (codeInfo->resGroups[resGroupIdx].count == 0) continue;
-            str_join(arena, str8("\n"));
-            str_join(arena, resGroupIdx >= dynGroup0 ? str8("// DynResGroup") : str8("// ResGroup"), resGroupIdx >= dynGroup0 ? (resGroupIdx - dynGroup0) : resGroupIdx,str8("\n"));
+            str_joinT(arena, str8("\n"));
+            str_joinT(arena, resGroupIdx >= dynGroup0 ? str8("// DynResGroup") : str8("// ResGroup"), resGroupIdx >= dynGroup0 ? (resGroupIdx - dynGroup0) : resGroupIdx,str8("\n"));
             S8 resBlockName = resGroupIdx >= dynGroup0 ? str8("rx_dynamicResBlocks") : str8("rx_staticResBlocks");
             uint32_t byteOffset = 0;
             // constants
@@ -2578,9 +2516,9 @@ bx shd_generateShaders(Arena* arena, DxCompiler* dxCompiler, ShaderFileInfo* sha
                 for (u32 idx = 0; idx < constantsArr->count; idx++) {
                     ResInfo* info = constantsArr->elements + idx;
                     
-                    str_join(arena, info->typeName, str8(" "), info->name, str8("() {\n"));
-                    str_fmt(arena, str8("	return {0}.Load<{1}>(rx_pushConstants.instanceRefIndicies[{2}] + {3});\n"), resBlockName, info->typeName, resGroupIdx, byteOffset);   
-                    str_join(arena, str8("}\n"));
+                    str_joinT(arena, info->typeName, str8(" "), info->name, str8("() {\n"));
+                    str_fmtT(arena, "	return {0}.Load<{1}>(rx_pushConstants.instanceRefIndicies[{2}] + {3});\n", resBlockName, info->typeName, resGroupIdx, byteOffset);   
+                    str_joinT(arena, str8("}\n"));
                     byteOffset += info->byteSize;
                 }
 
@@ -2591,10 +2529,10 @@ bx shd_generateShaders(Arena* arena, DxCompiler* dxCompiler, ShaderFileInfo* sha
 
                 for (u32 idx = 0; idx < texturesArr->count; idx++) {
                     ResInfo* info = texturesArr->elements + idx;
-                    str_join(arena, info->typeName, str8(" "), info->name, str8("() {\n"));
-                    str_fmt(arena,  str8("    uint index = {0}.Load(rx_pushConstants.instanceRefIndicies[{2}] + {3});\n"), resBlockName, info->typeName, resGroupIdx, byteOffset);   
-                    str_join(arena, str8("    return rx_textures[index];\n")); 
-                    str_join(arena, str8("}\n"));  
+                    str_joinT(arena, info->typeName, str8(" "), info->name, str8("() {\n"));
+                    str_fmtT(arena,  "    uint index = {0}.Load(rx_pushConstants.instanceRefIndicies[{2}] + {3});\n", resBlockName, info->typeName, resGroupIdx, byteOffset);   
+                    str_joinT(arena, str8("    return rx_textures[index];\n")); 
+                    str_joinT(arena, str8("}\n"));  
                     byteOffset += info->byteSize;
                 }
 
@@ -2605,10 +2543,10 @@ bx shd_generateShaders(Arena* arena, DxCompiler* dxCompiler, ShaderFileInfo* sha
 
                 for (u32 idx = 0; idx < samplersArr->count; idx++) {
                     ResInfo* info = samplersArr->elements + idx;
-                    str_join(arena, info->typeName, str8(" "), info->name, str8("() {\n"));
-                    str_fmt(arena,  str8("    uint index = {0}.Load(rx_pushConstants.instanceRefIndicies[{2}] + {3});\n"), resBlockName, info->typeName, resGroupIdx, byteOffset);     
-                    str_join(arena, str8("    return rx_samplers[index];\n")); 
-                    str_join(arena, str8("}\n"));  
+                    str_joinT(arena, info->typeName, str8(" "), info->name, str8("() {\n"));
+                    str_fmtT(arena,  "    uint index = {0}.Load(rx_pushConstants.instanceRefIndicies[{2}] + {3});\n", resBlockName, info->typeName, resGroupIdx, byteOffset);     
+                    str_joinT(arena, str8("    return rx_samplers[index];\n")); 
+                    str_joinT(arena, str8("}\n"));  
                     byteOffset += info->byteSize;
                 }
 
@@ -2620,7 +2558,7 @@ bx shd_generateShaders(Arena* arena, DxCompiler* dxCompiler, ShaderFileInfo* sha
             */
         }
         #endif
-        str_join(arena, str8("\0"));
+        str_joinT(arena, str8("\0"));
     }
     //codeInfo->programs
     //log_trace(str8("\ngenerated code:\n"), generatedCode, str8("\n gen done"));
@@ -2826,8 +2764,8 @@ i32 main(i32 argc, char* argv[]) {
 
         //for (u32 idx = 0; idx < fileInfo.renderPrograms.count; ++idx) {
         //    RenderProgram* program = &fileInfo.renderPrograms.elements[idx];
-        //    os_fileWrite(str_join(arena, shaderFilePath, str8("."), program->name, str8(".spirv.vs")), program->vs.source);
-        //    os_fileWrite(str_join(arena, shaderFilePath, str8("."), program->name, str8(".spirv.ps")), program->ps.source);
+        //    os_fileWrite(str_joinT(arena, shaderFilePath, str8("."), program->name, str8(".spirv.vs")), program->vs.source);
+        //    os_fileWrite(str_joinT(arena, shaderFilePath, str8("."), program->name, str8(".spirv.ps")), program->ps.source);
         //}
 
         if (!os_fileWrite(headerTargetPath, generatedHeader)) {
@@ -0,0 +1,52 @@
+#include "base/base.h"
+#include "base/base_types.h"
+#include "base/base_mem.h"
+#include "base/base_str.h"
+#include "os/os.h"
+#include "log/log.h"
+
+#include <stdio.h>
+
+// Expands binary logs written with log_binaryStart into text, files of an mmap sink are unwrapped into their lines.
+//
+// Usage: blog app.blog [out.txt], the text goes to stdout without an output file
+
+i32 main(i32 argc, char* argv[]) {
+    if (argc < 2) {
+        fprintf(stderr, "usage: blog <file.blog|mmap sink file> [output]\n");
+        return 1;
+    }
+    BaseMemory baseMem = os_getBaseMemory();
+    Arena* arena = mem_makeArena(&baseMem, GIGABYTE(16));
+    Arena* tmpArena = mem_makeArena(&baseMem, GIGABYTE(4));
+
+    S8 fileName = str_fromNullTerminatedCharPtr(argv[1]);
+    S8 data = os_fileRead(arena, fileName);
+    if (data.size == 0) {
+        fprintf(stderr, "blog: can not read %s\n", argv[1]);
+        return 1;
+    }
+    u32 spanCount = 0;
+    S8* spans = NULL;
+    S8 lines = log_mmapDecode(arena, data);
+    if (lines.content) {
+        spans = &lines;
+        spanCount = 1;
+    } else {
+        str_Builder builder = str_builderInit(arena, MEGABYTE(4));
+        if (!log_binaryDecode(tmpArena, data, &builder)) {
+            fprintf(stderr, "blog: %s is not a binary log\n", argv[1]);
+            return 1;
+        }
+        spans = str_builderSpans(&builder, arena, &spanCount);
+    }
+    if (argc > 2) {
+        if (!os_fileWriteSpans(str_fromNullTerminatedCharPtr(argv[2]), spans, spanCount)) {
+            fprintf(stderr, "blog: can not write %s\n", argv[2]);
+            return 1;
+        }
+    } else {
+        os_logSpans(spans, spanCount);
+    }
+    return 0;
+}
@@ -0,0 +1,104 @@
+#include "base/base.h"
+#include "base/base_types.h"
+#include "base/base_mem.h"
+#include "base/base_str.h"
+
+#include <stdio.h>
+
+// Emits a str_PerfectHash for a fixed keyword set as C source, so the table costs nothing at startup.
+// C++ code can build the same table at compile time with str_perfectHashT instead.
+//
+// Usage: phash shd_keyword float float2 float3 > shd_keyword.h
+// Declares shd_keyword (str_PerfectHash) and an enum with shd_keyword_<key> for every key that is a valid identifier.
+
+LOCAL bx phash_isIdentifier(S8 key) {
+    if (key.size == 0 || (key.content[0] >= '0' && key.content[0] <= '9')) {
+        return false;
+    }
+    for (u64 i = 0; i < key.size; i++) {
+        u8 c = key.content[i];
+        if (!((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_')) {
+            return false;
+        }
+    }
+    return true;
+}
+
+LOCAL void phash_printLiteral(S8 key) {
+    putchar('"');
+    for (u64 i = 0; i < key.size; i++) {
+        u8 c = key.content[i];
+        if (c == '"' || c == '\\') {
+            printf("\\%c", c);
+        } else if (c < 0x20 || c >= 0x7F) {
+            // octal escapes can not swallow the next char like hex escapes do
+            printf("\\%03o", c);
+        } else {
+            putchar(c);
+        }
+    }
+    putchar('"');
+}
+
+i32 main(i32 argc, char* argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <name> <key>...\n", argc > 0 ? argv[0] : "phash");
+        return 1;
+    }
+    BaseMemory baseMem = mem_getMallocBaseMem();
+    Arena* arena = mem_makeArena(&baseMem, MEGABYTE(64));
+
+    S8 name = str_fromNullTerminatedCharPtr(argv[1]);
+    u32 count = u32_cast(argc - 2);
+    S8* keys = mem_arenaPushArray(arena, S8, count);
+    for (u32 i = 0; i < count; i++) {
+        keys[i] = str_fromNullTerminatedCharPtr(argv[i + 2]);
+    }
+
+    str_PerfectHash table;
+    if (!str_perfectHashBuild(arena, keys, count, &table)) {
+        fprintf(stderr, "phash: the key set contains duplicates\n");
+        return 1;
+    }
+
+    i32 nameSize = i32_cast(name.size);
+    printf("// generated by tools_src/phash.c, do not edit\n");
+    printf("// phash");
+    for (i32 i = 1; i < argc; i++) {
+        printf(" %s", argv[i]);
+    }
+    printf("\n\n");
+
+    printf("enum {\n");
+    for (u32 i = 0; i < count; i++) {
+        if (phash_isIdentifier(keys[i])) {
+            printf("    %.*s_%.*s = %u,\n", nameSize, name.content, i32_cast(keys[i].size), keys[i].content, i);
+        }
+    }
+    printf("    %.*s__count = %u,\n", nameSize, name.content, count);
+    printf("};\n\n");
+
+    printf("static const S8 %.*s__keys[%u] = {\n", nameSize, name.content, count);
+    for (u32 slot = 0; slot < count; slot++) {
+        printf("    {(u8*) ");
+        phash_printLiteral(table.keys[slot]);
+        printf(", %llu},\n", (unsigned long long) table.keys[slot].size);
+    }
+    printf("};\n\n");
+
+    printf("static const u32 %.*s__indices[%u] = {", nameSize, name.content, count);
+    for (u32 slot = 0; slot < count; slot++) {
+        printf(slot % 16 == 0 ? "\n    %u," : " %u,", table.indices[slot]);
+    }
+    printf("\n};\n\n");
+
+    printf("static const u32 %.*s__seeds[%u] = {", nameSize, name.content, table.bucketCount);
+    for (u32 bucket = 0; bucket < table.bucketCount; bucket++) {
+        printf(bucket % 16 == 0 ? "\n    %u," : " %u,", table.seeds[bucket]);
+    }
+    printf("\n};\n\n");
+
+    printf("static const str_PerfectHash %.*s = {%.*s__keys, %.*s__indices, %.*s__seeds, %u, %u};\n",
+        nameSize, name.content, nameSize, name.content, nameSize, name.content, nameSize, name.content, count, table.bucketCount);
+    return 0;
+}